@@ -0,0 +1,126 @@
+/**
+ * \file bench/corpus/main.cpp
+ *
+ * \brief Entry point for the benchmark corpus generator.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "../lib/bench_corpus.h"
+
+/* forward decls. */
+static void usage(const char* name);
+static bool parse_size(size_t* size, const char* text);
+
+/**
+ * \brief Write a corpus file.
+ *
+ * Usage: eroccorpus [-s seed] kind size[K|M|G] path
+ *
+ * The kind is one of log, source, long, empty, crlf, or binary. The same kind,
+ * size, and seed always give the same file, so a corpus can be regenerated
+ * instead of being kept around.
+ */
+int main(int argc, char* argv[])
+{
+    uint64_t seed = 1;
+    bench_corpus_kind kind;
+    bench_corpus_stats stats;
+    size_t size;
+    int i = 1;
+
+    if (i + 1 < argc && !strcmp(argv[i], "-s"))
+    {
+        seed = strtoull(argv[i + 1], NULL, 10);
+        i += 2;
+    }
+
+    if (argc - i != 3)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!bench_corpus_kind_parse(&kind, argv[i]))
+    {
+        fprintf(stderr, "Unknown corpus kind %s.\n", argv[i]);
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (!parse_size(&size, argv[i + 1]))
+    {
+        fprintf(stderr, "Bad size %s.\n", argv[i + 1]);
+        usage(argv[0]);
+        return 1;
+    }
+
+    if (0 != bench_corpus_write(&stats, argv[i + 2], kind, size, seed))
+    {
+        perror(argv[i + 2]);
+        return 1;
+    }
+
+    printf("%zu bytes, %zu lines\n", stats.bytes, stats.lines);
+
+    return 0;
+}
+
+/**
+ * \brief Print the usage of this tool.
+ */
+static void usage(const char* name)
+{
+    fprintf(stderr, "Usage: %s [-s seed] kind size[K|M|G] path\n", name);
+    fprintf(stderr, "Kinds:");
+    for (int i = 0; i < BENCH_CORPUS_KIND_COUNT; ++i)
+    {
+        fprintf(stderr, " %s", bench_corpus_kind_name((bench_corpus_kind)i));
+    }
+    fprintf(stderr, "\n");
+}
+
+/**
+ * \brief Parse a size with an optional K, M, or G suffix.
+ */
+static bool parse_size(size_t* size, const char* text)
+{
+    char* end;
+    size_t value = strtoull(text, &end, 10);
+
+    if (end == text)
+    {
+        return false;
+    }
+
+    switch (*end)
+    {
+        case 'G':
+            value *= 1024;
+            /* fall through */
+        case 'M':
+            value *= 1024;
+            /* fall through */
+        case 'K':
+            value *= 1024;
+            ++end;
+            break;
+
+        default:
+            break;
+    }
+
+    if (0 != *end)
+    {
+        return false;
+    }
+
+    *size = value;
+
+    return true;
+}
@@ -0,0 +1,280 @@
+/**
+ * \file bench/lib/bench.h
+ *
+ * \brief Minimal benchmark harness for eroc.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * \brief Options shared by every benchmark.
+ */
+struct bench_options
+{
+    /* largest generated input, in bytes. */
+    size_t max_size = 100 * 1024 * 1024;
+    /* largest data structure, in elements. */
+    size_t max_elements = 10 * 1000 * 1000;
+    /* number of timed repetitions per measurement. */
+    int repetitions = 3;
+    /* report results as a JSON document instead of a table. */
+    bool json = false;
+    /* only run benchmarks whose name contains this string. */
+    std::string filter;
+};
+
+/**
+ * \brief Get the number of allocations made so far by the library, or -1 if
+ * allocations aren't counted in this build.
+ */
+long bench_allocations();
+
+/**
+ * \brief The runner times measurements and reports results.
+ */
+class bench_runner
+{
+public:
+    explicit bench_runner(const bench_options& options)
+        : options_(options)
+    {
+    }
+
+    const bench_options& options() const
+    {
+        return options_;
+    }
+
+    /**
+     * \brief Element counts from 1e3 to 1e7, up to the configured maximum.
+     */
+    std::vector<size_t> element_counts() const
+    {
+        std::vector<size_t> counts;
+
+        for (size_t count = 1000; count <= 10 * 1000 * 1000; count *= 10)
+        {
+            if (count > options_.max_elements)
+            {
+                break;
+            }
+
+            counts.push_back(count);
+        }
+
+        return counts;
+    }
+
+    /**
+     * \brief Start the report.
+     */
+    void begin()
+    {
+        if (options_.json)
+        {
+            printf(
+                "{\n  \"repetitions\": %d,\n  \"max_size\": %zu,\n"
+                "  \"max_elements\": %zu,\n  \"results\": [",
+                options_.repetitions, options_.max_size,
+                options_.max_elements);
+        }
+    }
+
+    /**
+     * \brief Finish the report.
+     */
+    void end()
+    {
+        if (options_.json)
+        {
+            printf("\n  ]\n}\n");
+        }
+    }
+
+    /**
+     * \brief Time fn, which performs ops operations over bytes bytes, and
+     * report the best repetition, the spread of the repetitions, and the
+     * library allocations made per operation.
+     *
+     * \param name          The name of this measurement.
+     * \param ops           The number of operations performed by one call.
+     * \param bytes         The number of bytes processed by one call, or 0.
+     * \param fn            The function to time.
+     * \param reset         If set, called untimed before each repetition to
+     *                      restore the state that fn expects.
+     */
+    void measure(
+        const std::string& name, size_t ops, size_t bytes,
+        const std::function<void()>& fn,
+        const std::function<void()>& reset = nullptr)
+    {
+        std::vector<double> samples;
+        long allocations = 0;
+
+        for (int i = 0; i < options_.repetitions; ++i)
+        {
+            if (reset)
+            {
+                reset();
+            }
+
+            long allocations_before = bench_allocations();
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            auto end = std::chrono::steady_clock::now();
+            allocations += bench_allocations() - allocations_before;
+
+            samples.push_back(
+                std::chrono::duration<double, std::nano>(end - start).count()
+                    / (ops ? ops : 1));
+        }
+
+        std::sort(samples.begin(), samples.end());
+        double best = samples.front();
+        double allocs_per_op =
+            (bench_allocations() < 0)
+                ? -1.0
+                : (double)allocations / options_.repetitions / (ops ? ops : 1);
+        double mb_per_s =
+            (bytes / (1024.0 * 1024.0)) / (best * (ops ? ops : 1) / 1e9);
+
+        if (options_.json)
+        {
+            printf(
+                "%s\n    {\"name\": \"%s\", \"ops\": %zu, \"bytes\": %zu, "
+                "\"ns_per_op\": {\"min\": %.2f, \"p50\": %.2f, \"p90\": %.2f, "
+                "\"p99\": %.2f, \"max\": %.2f}, \"ops_per_s\": %.0f",
+                separator(), escaped(name).c_str(), ops, bytes, best,
+                percentile(samples, 50), percentile(samples, 90),
+                percentile(samples, 99), samples.back(), 1e9 / best);
+            if (bytes > 0)
+            {
+                printf(", \"mb_per_s\": %.1f", mb_per_s);
+            }
+            if (allocs_per_op >= 0.0)
+            {
+                printf(", \"allocs_per_op\": %.3f", allocs_per_op);
+            }
+            printf("}");
+        }
+        else
+        {
+            printf("%-48s %12.2f ns/op", name.c_str(), best);
+            if (bytes > 0)
+            {
+                printf(" %10.1f MB/s", mb_per_s);
+            }
+            printf(" %14.0f ops/s", 1e9 / best);
+            if (allocs_per_op >= 0.0)
+            {
+                printf(" %10.3f allocs/op", allocs_per_op);
+            }
+            printf("\n");
+        }
+        fflush(stdout);
+    }
+
+    /**
+     * \brief Report a value that isn't a timing, such as a hit rate.
+     *
+     * \param name          The name of this value.
+     * \param value         The value.
+     * \param unit          The unit of this value.
+     */
+    void report(const std::string& name, double value, const char* unit)
+    {
+        if (options_.json)
+        {
+            printf(
+                "%s\n    {\"name\": \"%s\", \"value\": %.2f, \"unit\": \"%s\"}",
+                separator(), escaped(name).c_str(), value, unit);
+        }
+        else
+        {
+            printf("%-48s %12.2f %s\n", name.c_str(), value, unit);
+        }
+        fflush(stdout);
+    }
+
+private:
+    bench_options options_;
+    bool first_ = true;
+
+    /**
+     * \brief The text that goes before a result in the JSON array.
+     */
+    const char* separator()
+    {
+        const char* text = first_ ? "" : ",";
+        first_ = false;
+
+        return text;
+    }
+
+    /**
+     * \brief Get the sample at the given percentile of sorted samples, by the
+     * nearest rank.
+     */
+    static double percentile(const std::vector<double>& samples, int p)
+    {
+        size_t rank = (samples.size() * p + 99) / 100;
+
+        return samples[(rank > 0) ? rank - 1 : 0];
+    }
+
+    /**
+     * \brief Escape a name for a JSON string.
+     */
+    static std::string escaped(const std::string& text)
+    {
+        std::string result;
+
+        for (char ch : text)
+        {
+            if ('"' == ch || '\\' == ch)
+            {
+                result += '\\';
+            }
+
+            result += ch;
+        }
+
+        return result;
+    }
+};
+
+/**
+ * \brief A registered benchmark.
+ */
+struct bench_case
+{
+    const char* name;
+    void (*fn)(bench_runner&);
+};
+
+std::vector<bench_case>& bench_registry();
+
+struct bench_registration
+{
+    bench_registration(const char* name, void (*fn)(bench_runner&))
+    {
+        bench_registry().push_back({name, fn});
+    }
+};
+
+#define BENCH(name) \
+    static void bench_##name(bench_runner&); \
+    static bench_registration bench_registration_##name( \
+        #name, &bench_##name); \
+    static void bench_##name(bench_runner& runner)
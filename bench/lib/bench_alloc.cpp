@@ -0,0 +1,74 @@
+/**
+ * \file bench/lib/bench_alloc.cpp
+ *
+ * \brief Count the allocations made by the library under benchmark.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+#include "bench.h"
+
+/*
+ * When the benchmark is linked with --wrap for the allocation functions, every
+ * call that the library makes to one of them comes here first. Allocations
+ * made inside the C library, such as by getline, aren't seen.
+ */
+#ifdef EROC_BENCH_WRAP_MALLOC
+
+static std::atomic<long> allocation_count;
+
+extern "C" {
+
+void* __real_malloc(size_t size);
+void* __real_calloc(size_t count, size_t size);
+void* __real_realloc(void* ptr, size_t size);
+char* __real_strdup(const char* str);
+
+void* __wrap_malloc(size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    return __real_malloc(size);
+}
+
+void* __wrap_calloc(size_t count, size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    return __real_calloc(count, size);
+}
+
+void* __wrap_realloc(void* ptr, size_t size)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    return __real_realloc(ptr, size);
+}
+
+char* __wrap_strdup(const char* str)
+{
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+
+    return __real_strdup(str);
+}
+
+} /* extern "C" */
+
+long bench_allocations()
+{
+    return allocation_count.load(std::memory_order_relaxed);
+}
+
+#else
+
+long bench_allocations()
+{
+    return -1;
+}
+
+#endif /* EROC_BENCH_WRAP_MALLOC */
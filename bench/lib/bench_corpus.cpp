@@ -0,0 +1,389 @@
+/**
+ * \file bench/lib/bench_corpus.cpp
+ *
+ * \brief Deterministic, seeded generator of benchmark input files.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+#include "bench_corpus.h"
+
+using namespace std;
+
+/* output is written in blocks of this size. */
+static const size_t BLOCK_SIZE = 1024 * 1024;
+
+static const char* KIND_NAMES[BENCH_CORPUS_KIND_COUNT] = {
+    "log", "source", "long", "empty", "crlf", "binary",
+};
+
+static const char* WORDS[] = {
+    "alpha", "beta", "gamma", "delta", "request", "completed", "buffer",
+    "line", "index", "timeout", "value", "the", "of", "and", "to", "in",
+    "cache", "miss", "host", "disk", "user", "error", "retry", "page",
+};
+
+static const char* LOG_MESSAGES[] = {
+    "request completed in %ums",
+    "cache miss for key user:%u",
+    "connection accepted on port %u",
+    "ERROR upstream timeout after %ums",
+    "WARN disk usage at %u percent",
+    "ERROR disk full on /dev/sd%u",
+};
+
+namespace {
+
+/**
+ * \brief A splitmix64 generator, which gives the same sequence everywhere,
+ * unlike the standard library distributions.
+ */
+class corpus_random
+{
+public:
+    explicit corpus_random(uint64_t seed)
+        : state_(seed)
+    {
+    }
+
+    uint64_t next()
+    {
+        uint64_t z = (state_ += 0x9e3779b97f4a7c15ULL);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+
+        return z ^ (z >> 31);
+    }
+
+    /* a value in [0, bound). */
+    unsigned below(unsigned bound)
+    {
+        return (unsigned)(next() % bound);
+    }
+
+    const char* word()
+    {
+        return WORDS[below(sizeof(WORDS) / sizeof(WORDS[0]))];
+    }
+
+private:
+    uint64_t state_;
+};
+
+/**
+ * \brief Buffers generated text and writes it out a block at a time.
+ */
+class corpus_writer
+{
+public:
+    explicit corpus_writer(FILE* fp)
+        : fp_(fp)
+    {
+        block_.reserve(2 * BLOCK_SIZE);
+    }
+
+    void append(const char* text, size_t length)
+    {
+        if (0 == length)
+        {
+            return;
+        }
+
+        block_.append(text, length);
+        bytes_ += length;
+        last_ = text[length - 1];
+        if (block_.size() >= BLOCK_SIZE)
+        {
+            flush();
+        }
+    }
+
+    void newline(bool crlf = false)
+    {
+        append(crlf ? "\r\n" : "\n", crlf ? 2 : 1);
+        ++lines_;
+    }
+
+    bool flush()
+    {
+        if (!block_.empty())
+        {
+            ok_ =
+                ok_
+             && block_.size() == fwrite(block_.data(), 1, block_.size(), fp_);
+            block_.clear();
+        }
+
+        return ok_;
+    }
+
+    size_t bytes() const
+    {
+        return bytes_;
+    }
+
+    /* a last line without a newline still counts. */
+    size_t lines() const
+    {
+        return lines_ + ((bytes_ > 0 && '\n' != last_) ? 1 : 0);
+    }
+
+private:
+    FILE* fp_;
+    string block_;
+    size_t bytes_ = 0;
+    size_t lines_ = 0;
+    char last_ = '\n';
+    bool ok_ = true;
+};
+
+void log_line(corpus_writer& out, corpus_random& rng, bool crlf)
+{
+    char message[128];
+    char line[256];
+
+    /* errors are rare, as in real logs. */
+    unsigned kind = rng.below(100);
+    unsigned index = kind < 90 ? kind % 3 : 3 + kind % 3;
+
+    snprintf(
+        message, sizeof(message), LOG_MESSAGES[index], rng.below(10000));
+    int length =
+        snprintf(
+            line, sizeof(line),
+            "2025-01-01T%02u:%02u:%02u.%06u host%u service[%u]: %s",
+            rng.below(24), rng.below(60), rng.below(60), rng.below(1000000),
+            rng.below(16), rng.below(65536), message);
+    out.append(line, length);
+    out.newline(crlf);
+}
+
+void source_line(corpus_writer& out, corpus_random& rng)
+{
+    static const char INDENT[] = "                ";
+    char line[256];
+    int length;
+
+    /* one line in ten is blank. */
+    if (0 == rng.below(10))
+    {
+        out.newline();
+        return;
+    }
+
+    const char* a = rng.word();
+    const char* b = rng.word();
+    const char* c = rng.word();
+    unsigned n = rng.below(1000);
+
+    out.append(INDENT, rng.below(5) * 4);
+    switch (rng.below(10))
+    {
+        case 0:
+            length =
+                snprintf(
+                    line, sizeof(line), "int %s_%u(%s_t* %s, size_t count)",
+                    a, n, b, c);
+            break;
+
+        case 1:
+            length =
+                snprintf(
+                    line, sizeof(line), "if (NULL == %s || count > %u)", a, n);
+            break;
+
+        case 2:
+            length =
+                snprintf(
+                    line, sizeof(line), "for (size_t i = 0; i < %u; ++i)", n);
+            break;
+
+        case 3:
+            length =
+                snprintf(
+                    line, sizeof(line), "%s->%s = %s_%u(%s, i);", a, b, c, n,
+                    a);
+            break;
+
+        case 4:
+            length =
+                snprintf(line, sizeof(line), "return %s_%u(%s);", a, n, b);
+            break;
+
+        case 5:
+            length =
+                snprintf(
+                    line, sizeof(line), "/* %s the %s before the %s. */", a,
+                    b, c);
+            break;
+
+        case 6:
+            length =
+                snprintf(
+                    line, sizeof(line), "retval = eroc_%s_%s(&%s, %u);", a, b,
+                    c, n);
+            break;
+
+        case 7:
+            length = snprintf(line, sizeof(line), "goto cleanup_%s;", a);
+            break;
+
+        case 8:
+            length = snprintf(line, sizeof(line), "{");
+            break;
+
+        default:
+            length = snprintf(line, sizeof(line), "}");
+            break;
+    }
+
+    out.append(line, length);
+    out.newline();
+}
+
+void words_line(corpus_writer& out, corpus_random& rng, size_t length)
+{
+    size_t written = 0;
+
+    while (written < length)
+    {
+        const char* word = rng.word();
+        size_t word_length = strlen(word);
+
+        if (written > 0)
+        {
+            out.append(" ", 1);
+            ++written;
+        }
+
+        out.append(word, word_length);
+        written += word_length;
+    }
+
+    out.newline();
+}
+
+void binary_block(corpus_writer& out, corpus_random& rng, size_t length)
+{
+    char block[4096];
+
+    if (length > sizeof(block))
+    {
+        length = sizeof(block);
+    }
+
+    for (size_t i = 0; i < length; i += 8)
+    {
+        uint64_t bits = rng.next();
+        for (size_t j = i; j < i + 8 && j < length; ++j, bits >>= 8)
+        {
+            block[j] = (char)(bits & 0xff);
+        }
+    }
+
+    /* newlines that happen to come up end lines. */
+    const char* start = block;
+    const char* end = block + length;
+    const char* newline;
+    while (nullptr
+        != (newline = (const char*)memchr(start, '\n', end - start)))
+    {
+        out.append(start, newline - start);
+        out.newline();
+        start = newline + 1;
+    }
+
+    out.append(start, end - start);
+}
+
+} /* namespace */
+
+/**
+ * \brief Get the name of a corpus kind, as used on the command line.
+ */
+const char* bench_corpus_kind_name(bench_corpus_kind kind)
+{
+    return KIND_NAMES[kind];
+}
+
+/**
+ * \brief Look up a corpus kind by name.
+ */
+bool bench_corpus_kind_parse(bench_corpus_kind* kind, const char* name)
+{
+    for (int i = 0; i < BENCH_CORPUS_KIND_COUNT; ++i)
+    {
+        if (0 == strcmp(KIND_NAMES[i], name))
+        {
+            *kind = (bench_corpus_kind)i;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * \brief Write a file of the given kind and of at least the given size.
+ */
+int bench_corpus_write(
+    bench_corpus_stats* stats, const char* path, bench_corpus_kind kind,
+    size_t size, uint64_t seed)
+{
+    FILE* fp = fopen(path, "wb");
+    corpus_random rng(seed);
+
+    if (nullptr == fp)
+    {
+        return 1;
+    }
+
+    corpus_writer out(fp);
+    while (out.bytes() < size)
+    {
+        switch (kind)
+        {
+            case BENCH_CORPUS_LOG:
+                log_line(out, rng, false);
+                break;
+
+            case BENCH_CORPUS_SOURCE:
+                source_line(out, rng);
+                break;
+
+            case BENCH_CORPUS_LONG_LINES:
+                words_line(out, rng, 64 * 1024 + rng.below(960 * 1024));
+                break;
+
+            case BENCH_CORPUS_EMPTY_LINES:
+                if (rng.below(10) < 7)
+                {
+                    out.newline();
+                }
+                else
+                {
+                    words_line(out, rng, 1 + rng.below(40));
+                }
+                break;
+
+            case BENCH_CORPUS_CRLF:
+                log_line(out, rng, true);
+                break;
+
+            default:
+                binary_block(out, rng, size - out.bytes());
+                break;
+        }
+    }
+
+    bool ok = out.flush();
+    stats->bytes = out.bytes();
+    stats->lines = out.lines();
+
+    return (0 == fclose(fp) && ok) ? 0 : 2;
+}
@@ -0,0 +1,74 @@
+/**
+ * \file bench/lib/bench_corpus.h
+ *
+ * \brief Deterministic, seeded generator of benchmark input files.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * \brief The kinds of file that the generator can write.
+ */
+enum bench_corpus_kind
+{
+    /* timestamped log lines, with occasional errors. */
+    BENCH_CORPUS_LOG,
+    /* C-like source code, indented, with comments and blank lines. */
+    BENCH_CORPUS_SOURCE,
+    /* lines of 64 KB to 1 MB of words. */
+    BENCH_CORPUS_LONG_LINES,
+    /* mostly empty lines. */
+    BENCH_CORPUS_EMPTY_LINES,
+    /* log lines ending with CR LF. */
+    BENCH_CORPUS_CRLF,
+    /* random bytes, including NULs; newlines occur by chance. */
+    BENCH_CORPUS_BINARY,
+    BENCH_CORPUS_KIND_COUNT
+};
+
+/**
+ * \brief What the generator wrote.
+ */
+struct bench_corpus_stats
+{
+    size_t bytes;
+    size_t lines;
+};
+
+/**
+ * \brief Get the name of a corpus kind, as used on the command line.
+ */
+const char* bench_corpus_kind_name(bench_corpus_kind kind);
+
+/**
+ * \brief Look up a corpus kind by name.
+ *
+ * \returns true if the name is a corpus kind and false otherwise.
+ */
+bool bench_corpus_kind_parse(bench_corpus_kind* kind, const char* name);
+
+/**
+ * \brief Write a file of the given kind and of at least the given size.
+ *
+ * The same kind, size, and seed always give the same bytes, on any platform,
+ * so results from different machines and runs can be compared. Text stops at
+ * the end of the first line that reaches the size; binary data stops at the
+ * size.
+ *
+ * \param stats             Set to the size and line count of the file.
+ * \param path              The file to write.
+ * \param kind              The kind of file.
+ * \param size              The size of the file, in bytes.
+ * \param seed              The seed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int bench_corpus_write(
+    bench_corpus_stats* stats, const char* path, bench_corpus_kind kind,
+    size_t size, uint64_t seed);
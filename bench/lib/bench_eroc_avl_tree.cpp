@@ -0,0 +1,246 @@
+/**
+ * \file bench/lib/bench_eroc_avl_tree.cpp
+ *
+ * \brief Measure keyed AVL tree inserts, finds, positional lookups, deletes,
+ * bulk builds, merges, splits, and joins.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdint>
+#include <eroc/avltree.h>
+#include <random>
+
+#include "bench.h"
+
+using namespace std;
+
+/**
+ * \brief A tree node keyed by an integer.
+ */
+struct keyed_node
+{
+    eroc_avl_tree_node node;
+    uint64_t key;
+};
+
+static int compare(void*, const void* lhs, const void* rhs)
+{
+    uint64_t left = *(const uint64_t*)lhs;
+    uint64_t right = *(const uint64_t*)rhs;
+
+    return (left > right) - (left < right);
+}
+
+static const void* key(void*, const void* elem)
+{
+    return &((const keyed_node*)elem)->key;
+}
+
+/**
+ * \brief The nodes belong to the benchmark, so the tree doesn't release them.
+ */
+static int node_release(void*, eroc_avl_tree_node*)
+{
+    return 0;
+}
+
+/**
+ * \brief Forget every node in a tree without releasing them.
+ */
+static void tree_reset(eroc_avl_tree* tree)
+{
+    tree->root = nullptr;
+    tree->count = 0;
+}
+
+BENCH(avl_tree)
+{
+    for (size_t count : runner.element_counts())
+    {
+        vector<keyed_node> nodes(count);
+        eroc_avl_tree* tree;
+        string suffix = "/" + to_string(count);
+
+        if (0 != eroc_avl_tree_create(
+                    &tree, &compare, &key, &node_release, nullptr))
+        {
+            return;
+        }
+
+        /* distinct keys in random order. */
+        mt19937_64 rng(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            nodes[i].key = i * 2;
+        }
+        shuffle(nodes.begin(), nodes.end(), rng);
+
+        auto insert_all = [&]() {
+            for (auto& node : nodes)
+            {
+                eroc_avl_tree_insert(tree, &node.node);
+            }
+        };
+
+        runner.measure(
+            "avl_tree/insert" + suffix, count, 0, insert_all,
+            [&]() { tree_reset(tree); });
+
+        /* every other lookup misses. */
+        vector<uint64_t> keys(count);
+        for (auto& lookup : keys)
+        {
+            lookup = rng() % (count * 2);
+        }
+
+        runner.measure(
+            "avl_tree/find" + suffix, count, 0,
+            [&]() {
+                eroc_avl_tree_node* found;
+                for (uint64_t lookup : keys)
+                {
+                    (void)eroc_avl_tree_find(&found, tree, &lookup);
+                }
+            });
+
+        /* the same lookups by position and by rank of key. */
+        runner.measure(
+            "avl_tree/select" + suffix, count, 0,
+            [&]() {
+                for (uint64_t lookup : keys)
+                {
+                    (void)eroc_avl_tree_select(tree, lookup / 2);
+                }
+            });
+
+        runner.measure(
+            "avl_tree/rank" + suffix, count, 0,
+            [&]() {
+                for (auto& node : nodes)
+                {
+                    (void)eroc_avl_tree_rank(tree, &node.node);
+                }
+            });
+
+        runner.measure(
+            "avl_tree/rank_key" + suffix, count, 0,
+            [&]() {
+                for (uint64_t lookup : keys)
+                {
+                    (void)eroc_avl_tree_rank_key(tree, &lookup);
+                }
+            });
+
+        /* delete in a different random order than the inserts. */
+        vector<uint64_t> victims(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            victims[i] = i * 2;
+        }
+        shuffle(victims.begin(), victims.end(), rng);
+
+        runner.measure(
+            "avl_tree/delete" + suffix, count, 0,
+            [&]() {
+                eroc_avl_tree_node* deleted;
+                for (uint64_t victim : victims)
+                {
+                    (void)eroc_avl_tree_delete(&deleted, tree, &victim);
+                }
+            },
+            [&]() {
+                tree_reset(tree);
+                insert_all();
+            });
+
+        /* the same nodes in key order, built one at a time and in bulk. */
+        vector<eroc_avl_tree_node*> sorted(count);
+        for (auto& node : nodes)
+        {
+            sorted[node.key / 2] = &node.node;
+        }
+
+        runner.measure(
+            "avl_tree/insert_sorted" + suffix, count, 0,
+            [&]() {
+                for (auto* node : sorted)
+                {
+                    eroc_avl_tree_insert(tree, node);
+                }
+            },
+            [&]() { tree_reset(tree); });
+
+        runner.measure(
+            "avl_tree/build_sorted" + suffix, count, 0,
+            [&]() {
+                (void)eroc_avl_tree_build_sorted(tree, sorted.data(), count);
+            },
+            [&]() { tree_reset(tree); });
+
+        /* merge the odd positions into the even ones, or insert them. */
+        eroc_avl_tree* other;
+        vector<eroc_avl_tree_node*> evens, odds;
+        for (size_t i = 0; i < count; ++i)
+        {
+            (i % 2 ? odds : evens).push_back(sorted[i]);
+        }
+
+        if (0 != eroc_avl_tree_create(
+                    &other, &compare, &key, &node_release, nullptr))
+        {
+            tree_reset(tree);
+            (void)eroc_avl_tree_release(tree);
+            return;
+        }
+
+        auto build_halves = [&]() {
+            tree_reset(tree);
+            tree_reset(other);
+            (void)eroc_avl_tree_build_sorted(tree, evens.data(), evens.size());
+            (void)eroc_avl_tree_build_sorted(other, odds.data(), odds.size());
+        };
+
+        runner.measure(
+            "avl_tree/merge_insert" + suffix, count, 0,
+            [&]() {
+                for (auto* node : odds)
+                {
+                    eroc_avl_tree_insert(tree, node);
+                }
+            },
+            build_halves);
+
+        runner.measure(
+            "avl_tree/merge" + suffix, count, 0,
+            [&]() { eroc_avl_tree_merge(tree, other); }, build_halves);
+
+        /* cut the tree at a random position and paste it back together. */
+        vector<size_t> cuts(1000);
+        for (auto& cut : cuts)
+        {
+            cut = rng() % count;
+        }
+
+        runner.measure(
+            "avl_tree/split_concat" + suffix, cuts.size(), 0,
+            [&]() {
+                for (size_t cut : cuts)
+                {
+                    (void)eroc_avl_tree_split_at(tree, other, cut);
+                    eroc_avl_tree_concat(tree, other);
+                }
+            },
+            [&]() {
+                tree_reset(tree);
+                tree_reset(other);
+                (void)eroc_avl_tree_build_sorted(tree, sorted.data(), count);
+            });
+
+        tree_reset(other);
+        (void)eroc_avl_tree_release(other);
+        tree_reset(tree);
+        (void)eroc_avl_tree_release(tree);
+    }
+}
@@ -0,0 +1,147 @@
+/**
+ * \file bench/lib/bench_eroc_avl_tree_teardown.cpp
+ *
+ * \brief Measure clearing large AVL trees, node by node and in bulk.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdlib>
+#include <eroc/arena.h>
+#include <eroc/avltree.h>
+
+#include "bench.h"
+
+using namespace std;
+
+/**
+ * \brief Each node was allocated on its own, so it is freed on its own.
+ */
+static int node_free(void*, eroc_avl_tree_node* node)
+{
+    free(node);
+
+    return 0;
+}
+
+/**
+ * \brief The nodes belong to the benchmark, so the tree only visits them.
+ */
+static int node_keep(void*, eroc_avl_tree_node*)
+{
+    return 0;
+}
+
+/**
+ * \brief The nodes live in the arena that is the context, so releasing it
+ * releases them all.
+ */
+static int arena_bulk_release(void* context, eroc_avl_tree_node*)
+{
+    eroc_arena_release((eroc_arena*)context);
+
+    return 0;
+}
+
+/**
+ * \brief Build a tree of the given nodes in order.
+ */
+template <typename alloc_fn>
+static void tree_build(eroc_avl_tree* tree, size_t count, alloc_fn alloc)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        eroc_avl_tree_insert_after(tree, nullptr, alloc(i));
+    }
+}
+
+BENCH(avl_tree_teardown)
+{
+    /* 1e6 to 1e8 nodes, up to the configured maximum. */
+    for (size_t count = 1000 * 1000; count <= 100 * 1000 * 1000; count *= 10)
+    {
+        if (count > runner.options().max_elements)
+        {
+            break;
+        }
+
+        string suffix = "/" + to_string(count);
+        eroc_avl_tree* tree;
+
+        /* node by node, freeing each node. */
+        if (0 != eroc_avl_tree_create(
+                    &tree, nullptr, nullptr, &node_free, nullptr))
+        {
+            return;
+        }
+
+        runner.measure(
+            "avl_tree_teardown/clear_free" + suffix, count, 0,
+            [&]() { (void)eroc_avl_tree_clear(tree); },
+            [&]() {
+                (void)eroc_avl_tree_clear(tree);
+                tree_build(tree, count, [](size_t) {
+                    return (eroc_avl_tree_node*)
+                        calloc(1, sizeof(eroc_avl_tree_node));
+                });
+            });
+
+        (void)eroc_avl_tree_release(tree);
+
+        /* node by node, releasing nothing: the cost of the walk alone. */
+        vector<eroc_avl_tree_node> nodes(count);
+        if (0 != eroc_avl_tree_create(
+                    &tree, nullptr, nullptr, &node_keep, nullptr))
+        {
+            return;
+        }
+
+        runner.measure(
+            "avl_tree_teardown/clear_walk" + suffix, count, 0,
+            [&]() { (void)eroc_avl_tree_clear(tree); },
+            [&]() {
+                (void)eroc_avl_tree_clear(tree);
+                tree_build(tree, count, [&](size_t i) {
+                    nodes[i] = eroc_avl_tree_node{};
+                    return &nodes[i];
+                });
+            });
+
+        (void)eroc_avl_tree_release(tree);
+        nodes = vector<eroc_avl_tree_node>();
+
+        /* in bulk, dropping the arena that holds the nodes. */
+        eroc_arena* arena = nullptr;
+        if (0 != eroc_avl_tree_create(
+                    &tree, nullptr, nullptr, &node_keep, nullptr))
+        {
+            return;
+        }
+
+        eroc_avl_tree_bulk_release_set(tree, &arena_bulk_release);
+
+        runner.measure(
+            "avl_tree_teardown/clear_bulk_arena" + suffix, count, 0,
+            [&]() { (void)eroc_avl_tree_clear(tree); },
+            [&]() {
+                (void)eroc_avl_tree_clear(tree);
+                if (0 != eroc_arena_create(&arena, 0))
+                {
+                    return;
+                }
+
+                tree->context = arena;
+                tree_build(tree, count, [&](size_t) {
+                    auto node =
+                        (eroc_avl_tree_node*)eroc_arena_alloc(
+                            arena, sizeof(eroc_avl_tree_node),
+                            alignof(eroc_avl_tree_node));
+                    *node = eroc_avl_tree_node{};
+                    return node;
+                });
+            });
+
+        (void)eroc_avl_tree_release(tree);
+    }
+}
@@ -0,0 +1,96 @@
+/**
+ * \file bench/lib/bench_eroc_buffer_io.cpp
+ *
+ * \brief Measure loading and saving buffers on generated files.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bench_corpus.h"
+
+using namespace std;
+
+/**
+ * \brief Release the buffer from the previous repetition, if there is one.
+ */
+static void buffer_reset(eroc_buffer*& buffer)
+{
+    if (nullptr != buffer)
+    {
+        (void)eroc_buffer_release(buffer);
+        buffer = nullptr;
+    }
+}
+
+BENCH(buffer_io)
+{
+    char path[] = "/tmp/erocbench.XXXXXX";
+    char save_path[] = "/tmp/erocbench_save.XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    fd = mkstemp(save_path);
+    close(fd);
+
+    /* 1 MB to 1 GB, up to the configured maximum. */
+    for (size_t size_mb : { 1, 10, 100, 1024 })
+    {
+        size_t size = size_mb * 1024 * 1024;
+        if (size > runner.options().max_size)
+        {
+            break;
+        }
+
+        bench_corpus_stats corpus;
+        (void)bench_corpus_write(&corpus, path, BENCH_CORPUS_LOG, size, 1);
+        size_t lines = corpus.lines;
+        string suffix = "/" + to_string(size_mb) + "MB";
+        eroc_buffer* buffer = nullptr;
+        size_t io_size;
+
+        runner.measure(
+            "buffer_io/load" + suffix, lines, size,
+            [&]() { (void)eroc_buffer_load(&buffer, &io_size, path); },
+            [&]() { buffer_reset(buffer); });
+
+        /* save the list buffer from the last load. */
+        if (nullptr != buffer)
+        {
+            runner.measure(
+                "buffer_io/save" + suffix, lines, size,
+                [&]() {
+                    (void)eroc_buffer_save(buffer, &io_size, save_path);
+                });
+        }
+        buffer_reset(buffer);
+
+        runner.measure(
+            "buffer_io/load_mapped" + suffix, lines, size,
+            [&]() { (void)eroc_buffer_load_mapped(&buffer, &io_size, path); },
+            [&]() { buffer_reset(buffer); });
+        buffer_reset(buffer);
+
+        runner.measure(
+            "buffer_io/load_pieces" + suffix, lines, size,
+            [&]() { (void)eroc_buffer_load_pieces(&buffer, &io_size, path); },
+            [&]() { buffer_reset(buffer); });
+
+        if (nullptr != buffer)
+        {
+            runner.measure(
+                "buffer_io/save_pieces" + suffix, lines, size,
+                [&]() {
+                    (void)eroc_buffer_save(buffer, &io_size, save_path);
+                });
+        }
+        buffer_reset(buffer);
+    }
+
+    unlink(path);
+    unlink(save_path);
+}
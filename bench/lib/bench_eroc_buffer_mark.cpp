@@ -0,0 +1,97 @@
+/**
+ * \file bench/lib/bench_eroc_buffer_mark.cpp
+ *
+ * \brief Measure how the mark phase of g/re/cmd scales with worker threads.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/threadpool.h>
+#include <cstdio>
+
+#include "bench.h"
+
+using namespace std;
+
+/* the generated lines average about this many bytes. */
+static const size_t LINE_SIZE = 64;
+
+/* never generate more than this many lines. */
+static const size_t MAX_LINES = 20 * 1000 * 1000;
+
+BENCH(buffer_mark)
+{
+    size_t line_count = runner.options().max_size / LINE_SIZE;
+    size_t bytes = 0;
+    eroc_buffer* buffer;
+    char text[128];
+
+    if (line_count > MAX_LINES)
+    {
+        line_count = MAX_LINES;
+    }
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return;
+    }
+
+    unsigned int seed = 1;
+    for (size_t i = 0; i < line_count; ++i)
+    {
+        int length =
+            snprintf(
+                text, sizeof(text),
+                "2025-01-01T00:00:%02u host%u service[%u]: %s %u",
+                seed % 60, seed % 16, seed % 65536,
+                (seed >> 8) % 50 ? "request completed in" : "ERROR timeout",
+                seed % 10000);
+
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text, length))
+        {
+            break;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+        bytes += length + 1;
+        seed = seed * 1103515245 + 12345;
+    }
+
+    line_count = buffer->lines->count;
+
+    /* double the worker count up to, and including, the CPU count. */
+    size_t cpus = eroc_thread_pool_cpu_count();
+    for (size_t workers = 1; ; workers *= 2)
+    {
+        if (workers > cpus)
+        {
+            workers = cpus;
+        }
+
+        runner.measure(
+            "buffer_mark/ERROR.*timeout/workers:" + to_string(workers),
+            line_count, bytes, [&]() {
+                (void)eroc_buffer_mark(
+                    buffer, "ERROR.*timeout", false, 0, line_count - 1,
+                    workers);
+            });
+
+        runner.measure(
+            "buffer_mark/[0-9]+ ERROR/workers:" + to_string(workers),
+            line_count, bytes, [&]() {
+                (void)eroc_buffer_mark(
+                    buffer, "[0-9]+ ERROR", false, 0, line_count - 1,
+                    workers);
+            });
+
+        if (workers == cpus)
+        {
+            break;
+        }
+    }
+
+    eroc_buffer_release(buffer);
+}
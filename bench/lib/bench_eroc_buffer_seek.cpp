@@ -0,0 +1,106 @@
+/**
+ * \file bench/lib/bench_eroc_buffer_seek.cpp
+ *
+ * \brief Measure cursor moves in an editing session that moves locally through
+ * a large buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <random>
+#include <string>
+
+#include "bench.h"
+
+using namespace std;
+
+/* the number of moves in a session. */
+static const size_t SESSION_MOVES = 1000 * 1000;
+
+/**
+ * \brief Generate a session of moves: mostly short steps, some longer jumps,
+ * and the occasional trip to the head or the tail.
+ */
+static vector<unsigned long> make_session(size_t count)
+{
+    vector<unsigned long> moves(SESSION_MOVES);
+    mt19937_64 rng(count);
+    long position = (long)count / 2;
+
+    for (auto& move : moves)
+    {
+        unsigned kind = rng() % 100;
+        if (kind < 2)
+        {
+            position = 0;
+        }
+        else if (kind < 4)
+        {
+            position = (long)count - 1;
+        }
+        else if (kind < 10)
+        {
+            position += (long)(rng() % 2001) - 1000;
+        }
+        else
+        {
+            position += (long)(rng() % 33) - 16;
+        }
+
+        position = clamp<long>(position, 0, (long)count - 1);
+        move = (unsigned long)position;
+    }
+
+    return moves;
+}
+
+BENCH(buffer_seek)
+{
+    for (size_t count : runner.element_counts())
+    {
+        eroc_buffer* buffer;
+        string suffix = "/" + to_string(count);
+
+        if (0 != eroc_buffer_create(&buffer))
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            string text = "line " + to_string(i);
+            eroc_buffer_line* line;
+            if (0 != eroc_buffer_line_create_in(
+                        &line, buffer, text.data(), text.size()))
+            {
+                break;
+            }
+
+            eroc_buffer_append(buffer, nullptr, line);
+        }
+
+        vector<unsigned long> moves = make_session(buffer->lines->count);
+
+        runner.measure(
+            "buffer_seek/cursor_move" + suffix, moves.size(), 0,
+            [&]() {
+                for (unsigned long lineno : moves)
+                {
+                    (void)eroc_buffer_cursor_move(buffer, lineno);
+                }
+            });
+
+        runner.measure(
+            "buffer_seek/cursor_seek" + suffix, moves.size(), 0,
+            [&]() {
+                for (unsigned long lineno : moves)
+                {
+                    (void)eroc_buffer_cursor_seek(buffer, lineno);
+                }
+            });
+
+        (void)eroc_buffer_release(buffer);
+    }
+}
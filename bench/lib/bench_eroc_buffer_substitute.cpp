@@ -0,0 +1,140 @@
+/**
+ * \file bench/lib/bench_eroc_buffer_substitute.cpp
+ *
+ * \brief Measure s/foo/bar/g over every line of a large buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <cstdio>
+
+#include "bench.h"
+
+using namespace std;
+
+/* the generated lines average about this many bytes. */
+static const size_t LINE_SIZE = 48;
+
+/* never generate more than this many lines. */
+static const size_t MAX_LINES = 1000 * 1000;
+
+/**
+ * \brief Substitute over the whole buffer, alternating between two
+ * substitutions which undo each other, so that every call does the same work.
+ */
+static void substitute_toggle(
+    bench_runner& runner, const string& name, eroc_buffer* buffer,
+    size_t bytes, eroc_regex_substitution* forward,
+    eroc_regex_substitution* backward)
+{
+    unsigned long line_count = buffer->lines->count;
+    bool toggle = false;
+
+    runner.measure(
+        name, line_count, bytes, [&]() {
+            unsigned long count;
+            (void)eroc_buffer_substitute(
+                buffer, toggle ? backward : forward, 0, line_count - 1,
+                &count);
+            toggle = !toggle;
+        });
+
+    /* leave the buffer as it was found. */
+    if (toggle)
+    {
+        unsigned long count;
+        (void)eroc_buffer_substitute(
+            buffer, backward, 0, line_count - 1, &count);
+    }
+}
+
+BENCH(buffer_substitute)
+{
+    size_t line_count = runner.options().max_size / LINE_SIZE;
+    size_t bytes = 0;
+    eroc_buffer* buffer;
+    eroc_regex_substitution* foo_bar;
+    eroc_regex_substitution* bar_foo;
+    eroc_regex_substitution* grow;
+    eroc_regex_substitution* shrink;
+    char text[128];
+
+    if (line_count > MAX_LINES)
+    {
+        line_count = MAX_LINES;
+    }
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return;
+    }
+
+    /* every line has two foos; one line in ten has none. */
+    unsigned int seed = 1;
+    for (size_t i = 0; i < line_count; ++i)
+    {
+        int length =
+            snprintf(
+                text, sizeof(text), "%u the %s jumped over the %s fence %u",
+                seed % 1000, (seed >> 8) % 10 ? "foo" : "cat",
+                (seed >> 8) % 10 ? "foo" : "dog", seed % 100000);
+
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text, length))
+        {
+            break;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+        bytes += length + 1;
+        seed = seed * 1103515245 + 12345;
+    }
+
+    if (0 == buffer->lines->count)
+    {
+        goto cleanup_buffer;
+    }
+
+    if (0 != eroc_regex_substitution_create(&foo_bar, "foo", "bar", 0, true))
+    {
+        goto cleanup_buffer;
+    }
+
+    if (0 != eroc_regex_substitution_create(&bar_foo, "bar", "foo", 0, true))
+    {
+        goto cleanup_foo_bar;
+    }
+
+    if (0 != eroc_regex_substitution_create(
+                &grow, "f(o+)", "F\\1\\1", 0, true))
+    {
+        goto cleanup_bar_foo;
+    }
+
+    if (0 != eroc_regex_substitution_create(&shrink, "Fo+", "foo", 0, true))
+    {
+        goto cleanup_grow;
+    }
+
+    /* same length: every rewrite happens in place. */
+    substitute_toggle(
+        runner, "buffer_substitute/foo:bar/g", buffer, bytes, foo_bar,
+        bar_foo);
+
+    /* longer, then shorter: lines grow once, then are reused in place. */
+    substitute_toggle(
+        runner, "buffer_substitute/f(o+):F\\1\\1/g", buffer, bytes, grow,
+        shrink);
+
+    eroc_regex_substitution_release(shrink);
+cleanup_grow:
+    eroc_regex_substitution_release(grow);
+cleanup_bar_foo:
+    eroc_regex_substitution_release(bar_foo);
+cleanup_foo_bar:
+    eroc_regex_substitution_release(foo_bar);
+cleanup_buffer:
+    eroc_buffer_release(buffer);
+}
@@ -0,0 +1,158 @@
+/**
+ * \file bench/lib/bench_eroc_end_to_end.cpp
+ *
+ * \brief Measure the eroc binary in script mode on generated corpora.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <libgen.h>
+#include <limits.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bench_corpus.h"
+
+using namespace std;
+
+/* forward decls. */
+static string eroc_path();
+static bool write_script(const char* path, const string& text);
+
+/**
+ * \brief Each run loads the file, runs one command, and exits, so every
+ * measurement includes the load. The load measurement is the baseline to
+ * subtract from the others.
+ */
+BENCH(end_to_end)
+{
+    string eroc = eroc_path();
+    if (0 != access(eroc.c_str(), X_OK))
+    {
+        fprintf(
+            stderr, "end_to_end: can't run %s; set EROC_BENCH_EROC.\n",
+            eroc.c_str());
+        return;
+    }
+
+    char path[] = "/tmp/erocbench_e2e.XXXXXX";
+    char script_path[] = "/tmp/erocbench_e2e_script.XXXXXX";
+    char save_path[] = "/tmp/erocbench_e2e_save.XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+    fd = mkstemp(script_path);
+    close(fd);
+    fd = mkstemp(save_path);
+    close(fd);
+
+    /* 1 MB to 10 GB, up to the configured maximum. */
+    for (size_t size_mb : { 1, 10, 100, 1024, 10240 })
+    {
+        size_t size = size_mb * 1024 * 1024;
+        if (size > runner.options().max_size)
+        {
+            break;
+        }
+
+        for (int i = 0; i < BENCH_CORPUS_KIND_COUNT; ++i)
+        {
+            bench_corpus_kind kind = (bench_corpus_kind)i;
+            bench_corpus_stats corpus;
+
+            if (0 != bench_corpus_write(&corpus, path, kind, size, 1))
+            {
+                fprintf(stderr, "end_to_end: can't write %s.\n", path);
+                break;
+            }
+
+            string suffix =
+                string("/") + bench_corpus_kind_name(kind) + "/"
+                    + to_string(size_mb) + "MB";
+            string command =
+                eroc + " -s " + script_path + " " + path + " >/dev/null";
+
+            struct { const char* name; string script; } runs[] = {
+                { "load", "q\n" },
+                { "search", "g/timeout/p\nq\n" },
+                { "range_delete",
+                  "2," + to_string(max<size_t>(2, corpus.lines / 2))
+                    + "d\nq\n" },
+                { "save", string("w ") + save_path + "\nq\n" },
+            };
+
+            for (const auto& run : runs)
+            {
+                int status = 0;
+
+                if (!write_script(script_path, run.script))
+                {
+                    fprintf(stderr, "end_to_end: can't write %s.\n",
+                        script_path);
+                    continue;
+                }
+
+                /* ops are lines, so ops/s is lines/s. */
+                runner.measure(
+                    string("end_to_end/") + run.name + suffix, corpus.lines,
+                    corpus.bytes,
+                    [&]() { status = system(command.c_str()); });
+
+                if (0 != status)
+                {
+                    fprintf(
+                        stderr, "end_to_end: %s%s exited with %d.\n",
+                        run.name, suffix.c_str(), status);
+                }
+            }
+        }
+    }
+
+    unlink(path);
+    unlink(script_path);
+    unlink(save_path);
+}
+
+/**
+ * \brief Get the path of the eroc binary: EROC_BENCH_EROC if it is set, and
+ * the eroc next to this benchmark otherwise.
+ */
+static string eroc_path()
+{
+    char self[PATH_MAX];
+    const char* env = getenv("EROC_BENCH_EROC");
+
+    if (nullptr != env)
+    {
+        return env;
+    }
+
+    ssize_t length = readlink("/proc/self/exe", self, sizeof(self) - 1);
+    if (length <= 0)
+    {
+        return "eroc";
+    }
+
+    self[length] = 0;
+
+    return string(dirname(self)) + "/eroc";
+}
+
+/**
+ * \brief Replace the contents of the script file.
+ */
+static bool write_script(const char* path, const string& text)
+{
+    FILE* fp = fopen(path, "w");
+
+    if (nullptr == fp)
+    {
+        return false;
+    }
+
+    bool ok = text.size() == fwrite(text.data(), 1, text.size(), fp);
+
+    return 0 == fclose(fp) && ok;
+}
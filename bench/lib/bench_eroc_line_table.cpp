@@ -0,0 +1,138 @@
+/**
+ * \file bench/lib/bench_eroc_line_table.cpp
+ *
+ * \brief Compare the vectorized line splitter with a getline loop.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/linetable.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "bench.h"
+#include "bench_corpus.h"
+
+using namespace std;
+
+static const size_t BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * \brief Split a file into lines with the given scanner over fread blocks,
+ * returning the line count.
+ */
+static size_t scan_file(
+    const char* path,
+    int (*scan)(eroc_line_table*, const char*, size_t))
+{
+    eroc_line_table* table;
+    char* block = (char*)malloc(BLOCK_SIZE);
+    FILE* fp = fopen(path, "r");
+    size_t lines = 0, read_bytes;
+
+    (void)eroc_line_table_create(&table);
+    while ((read_bytes = fread(block, 1, BLOCK_SIZE, fp)) > 0)
+    {
+        (void)scan(table, block, read_bytes);
+        lines += table->count;
+    }
+
+    eroc_line_table_release(table);
+    fclose(fp);
+    free(block);
+
+    return lines;
+}
+
+/**
+ * \brief The line splitting loop that eroc_buffer_load used before the line
+ * table: one getline call and one fresh allocation per line.
+ */
+static size_t getline_loop(const char* path)
+{
+    vector<char*> lines;
+    FILE* fp = fopen(path, "r");
+
+    for (;;)
+    {
+        size_t linecap = 0;
+        char* line = NULL;
+        ssize_t read_bytes = getline(&line, &linecap, fp);
+        if (read_bytes < 0)
+        {
+            free(line);
+            break;
+        }
+
+        lines.push_back(line);
+    }
+
+    fclose(fp);
+    for (char* line : lines)
+    {
+        free(line);
+    }
+
+    return lines.size();
+}
+
+BENCH(line_table_load)
+{
+    char path[] = "/tmp/erocbench.XXXXXX";
+    int fd = mkstemp(path);
+    close(fd);
+
+    /* 10 MB to 4 GB, up to the configured maximum. */
+    for (size_t size_mb : { 10, 100, 1024, 4096 })
+    {
+        size_t size = size_mb * 1024 * 1024;
+        if (size > runner.options().max_size)
+        {
+            break;
+        }
+
+        bench_corpus_stats corpus;
+        (void)bench_corpus_write(&corpus, path, BENCH_CORPUS_LOG, size, 1);
+        size_t lines = corpus.lines;
+        string suffix = "/" + to_string(size_mb) + "MB";
+
+        runner.measure(
+            "line_table/getline_loop" + suffix, lines, size,
+            [&]{ (void)getline_loop(path); });
+
+        runner.measure(
+            "line_table/scan_scalar" + suffix, lines, size,
+            [&]{ (void)scan_file(path, &eroc_line_table_scan_scalar); });
+
+        runner.measure(
+            "line_table/scan" + suffix, lines, size,
+            [&]{ (void)scan_file(path, &eroc_line_table_scan); });
+
+        runner.measure(
+            "line_table/buffer_load" + suffix, lines, size,
+            [&]{
+                eroc_buffer* buffer;
+                size_t read_size;
+                if (0 == eroc_buffer_load(&buffer, &read_size, path))
+                {
+                    eroc_buffer_release(buffer);
+                }
+            });
+
+        runner.measure(
+            "line_table/buffer_load_mapped" + suffix, lines, size,
+            [&]{
+                eroc_buffer* buffer;
+                size_t read_size;
+                if (0 == eroc_buffer_load_mapped(&buffer, &read_size, path))
+                {
+                    eroc_buffer_release(buffer);
+                }
+            });
+    }
+
+    unlink(path);
+}
@@ -0,0 +1,118 @@
+/**
+ * \file bench/lib/bench_eroc_list.cpp
+ *
+ * \brief Measure list appends, inserts, positional lookups, and seeks.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/list.h>
+#include <random>
+
+#include "bench.h"
+
+using namespace std;
+
+/* positional lookups walk the list, so large lists get fewer of them. */
+static const size_t LOOKUP_BUDGET = 10 * 1000 * 1000;
+static const size_t MIN_LOOKUPS = 16;
+
+/**
+ * \brief The nodes belong to the benchmark, so the list doesn't release them.
+ */
+static int node_release(eroc_list_node*)
+{
+    return 0;
+}
+
+/**
+ * \brief Forget every node in a list without releasing them.
+ */
+static void list_reset(eroc_list* list)
+{
+    list->head = list->tail = nullptr;
+    list->count = 0;
+}
+
+BENCH(list)
+{
+    for (size_t count : runner.element_counts())
+    {
+        vector<eroc_list_node> nodes(count);
+        eroc_list* list;
+        string suffix = "/" + to_string(count);
+
+        if (0 != eroc_list_create(&list, &node_release))
+        {
+            return;
+        }
+
+        runner.measure(
+            "list/append" + suffix, count, 0,
+            [&]() {
+                for (auto& node : nodes)
+                {
+                    eroc_list_append(list, &node);
+                }
+            },
+            [&]() { list_reset(list); });
+
+        runner.measure(
+            "list/insert" + suffix, count, 0,
+            [&]() {
+                for (auto& node : nodes)
+                {
+                    eroc_list_insert(list, &node);
+                }
+            },
+            [&]() { list_reset(list); });
+
+        /* uniformly spread lookups, in a fixed order. */
+        size_t lookup_count = max(MIN_LOOKUPS, LOOKUP_BUDGET / count);
+        vector<unsigned long> indices(lookup_count);
+        mt19937_64 rng(count);
+        for (auto& index : indices)
+        {
+            index = rng() % count;
+        }
+
+        runner.measure(
+            "list/node_at" + suffix, lookup_count, 0,
+            [&]() {
+                eroc_list_node* node;
+                for (unsigned long index : indices)
+                {
+                    (void)eroc_list_node_at(&node, list, index);
+                }
+            });
+
+        /* a session of short moves from the previous node. */
+        vector<unsigned long> steps(lookup_count);
+        unsigned long position = count / 2;
+        for (auto& step : steps)
+        {
+            long next = (long)position + (long)(rng() % 33) - 16;
+            position = (unsigned long)clamp<long>(next, 0, (long)count - 1);
+            step = position;
+        }
+
+        eroc_list_node* middle;
+        (void)eroc_list_node_at(&middle, list, count / 2);
+
+        runner.measure(
+            "list/node_seek_local" + suffix, lookup_count, 0,
+            [&]() {
+                eroc_list_node* node = middle;
+                unsigned long from = count / 2;
+                for (unsigned long index : steps)
+                {
+                    (void)eroc_list_node_seek(&node, list, node, from, index);
+                    from = index;
+                }
+            });
+
+        list_reset(list);
+        (void)eroc_list_release(list);
+    }
+}
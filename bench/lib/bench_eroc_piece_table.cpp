@@ -0,0 +1,86 @@
+/**
+ * \file bench/lib/bench_eroc_piece_table.cpp
+ *
+ * \brief Measure line lookups in a piece table that edits have split into many
+ * pieces.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <random>
+#include <string>
+
+#include "bench.h"
+
+using namespace std;
+
+/* the number of lines in the original text. */
+static const size_t TEXT_LINES = 1000 * 1000;
+
+/* the number of lookups in a measurement. */
+static const size_t LOOKUPS = 100 * 1000;
+
+BENCH(piece_table)
+{
+    string text;
+    for (size_t i = 0; i < TEXT_LINES; ++i)
+    {
+        text += "line " + to_string(i) + "\n";
+    }
+
+    /* each edit in the middle of a piece adds two pieces. */
+    for (size_t count : runner.element_counts())
+    {
+        eroc_piece_table* table;
+        string suffix = "/" + to_string(count) + "_edits";
+        mt19937_64 rng(count);
+
+        if (count > TEXT_LINES)
+        {
+            break;
+        }
+
+        if (0 != eroc_piece_table_create(&table, text.data(), text.size()))
+        {
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+        {
+            (void)eroc_piece_table_insert(
+                table, rng() % table->lines, "added", 5);
+        }
+
+        vector<size_t> lookups(LOOKUPS);
+        for (auto& lineno : lookups)
+        {
+            lineno = rng() % table->lines;
+        }
+
+        runner.measure(
+            "piece_table/line_random" + suffix, lookups.size(), 0,
+            [&]() {
+                const char* line;
+                size_t length;
+                for (size_t lineno : lookups)
+                {
+                    (void)eroc_piece_table_line(&line, &length, table, lineno);
+                }
+            });
+
+        runner.measure(
+            "piece_table/line_in_order" + suffix, table->lines, 0,
+            [&]() {
+                const char* line;
+                size_t length;
+                for (size_t lineno = 0; lineno < table->lines; ++lineno)
+                {
+                    (void)eroc_piece_table_line(&line, &length, table, lineno);
+                }
+            });
+
+        eroc_piece_table_release(table);
+    }
+}
@@ -0,0 +1,87 @@
+/**
+ * \file bench/lib/bench_eroc_regex_compiler.cpp
+ *
+ * \brief Measure parsing and compiling a corpus of regex patterns.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+
+#include "bench.h"
+
+using namespace std;
+
+/* each pattern is parsed this many times per repetition. */
+static const size_t ROUNDS = 1000;
+
+/* a mix of the patterns people type at an editor, from trivial to busy. */
+static const char* PATTERNS[] = {
+    "a",
+    "hello",
+    "ERROR.*timeout",
+    "(ERROR|WARN).*disk",
+    "host7 service\\[[0-9]+\\]",
+    "[A-Za-z_][A-Za-z0-9_]*",
+    "[0-9]+\\.[0-9]+\\.[0-9]+\\.[0-9]+",
+    "(foo|bar|baz|qux)+(quux)?",
+    "([a-z]+)@([a-z]+)\\.(com|org|net)",
+    "a?a?a?a?a?a?a?a?aaaaaaaa",
+    "(((((x)))))*y",
+    "2025-01-0[1-9]T[0-9][0-9]:[0-9][0-9]:[0-9][0-9]",
+};
+
+BENCH(regex_compiler)
+{
+    size_t pattern_count = sizeof(PATTERNS) / sizeof(PATTERNS[0]);
+
+    for (const char* pattern : PATTERNS)
+    {
+        runner.measure(
+            string("regex_compiler/parse/") + pattern, ROUNDS, 0,
+            [&]() {
+                for (size_t i = 0; i < ROUNDS; ++i)
+                {
+                    eroc_regex_ast_node* ast;
+                    if (0 == eroc_regex_compiler_parse(&ast, pattern))
+                    {
+                        eroc_regex_ast_node_release(ast);
+                    }
+                }
+            });
+    }
+
+    /* the whole corpus, parsed, and then compiled down to a searcher. */
+    runner.measure(
+        "regex_compiler/parse/corpus", ROUNDS * pattern_count, 0,
+        [&]() {
+            for (size_t i = 0; i < ROUNDS; ++i)
+            {
+                for (const char* pattern : PATTERNS)
+                {
+                    eroc_regex_ast_node* ast;
+                    if (0 == eroc_regex_compiler_parse(&ast, pattern))
+                    {
+                        eroc_regex_ast_node_release(ast);
+                    }
+                }
+            }
+        });
+
+    runner.measure(
+        "regex_compiler/create/corpus", ROUNDS * pattern_count, 0,
+        [&]() {
+            for (size_t i = 0; i < ROUNDS; ++i)
+            {
+                for (const char* pattern : PATTERNS)
+                {
+                    eroc_regex* regex;
+                    if (0 == eroc_regex_create(&regex, pattern))
+                    {
+                        eroc_regex_release(regex);
+                    }
+                }
+            }
+        });
+}
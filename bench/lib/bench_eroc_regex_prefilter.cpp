@@ -0,0 +1,183 @@
+/**
+ * \file bench/lib/bench_eroc_regex_prefilter.cpp
+ *
+ * \brief Measure how many lines the literal prefilter skips, and what that is
+ * worth compared to running the regex engines on every line.
+ *
+ * The corpus is a synthetic log unless EROC_BENCH_CORPUS names a real one.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include "bench.h"
+
+using namespace std;
+
+static const size_t CORPUS_SIZE = 16 * 1024 * 1024;
+
+/**
+ * \brief Build a synthetic log of roughly the given size, with a mix of levels
+ * and messages.
+ */
+static string synthetic_log(size_t size)
+{
+    static const char* MESSAGES[] = {
+        "request completed in %ums",
+        "cache miss for key user:%u",
+        "connection from 10.0.%u.1 accepted",
+        "ERROR upstream timeout after %ums",
+        "WARN disk usage at %u percent",
+        "ERROR disk full on /dev/sd%u",
+    };
+    string log;
+    unsigned int seed = 1;
+    char line[256];
+    char message[128];
+
+    log.reserve(size + sizeof(line));
+    while (log.size() < size)
+    {
+        /* errors are rare, as in real logs. */
+        size_t kind = (seed >> 8) % 100;
+        size_t index = kind < 90 ? kind % 3 : 3 + kind % 3;
+
+        snprintf(message, sizeof(message), MESSAGES[index], seed % 10000);
+        int length =
+            snprintf(
+                line, sizeof(line),
+                "2025-01-01T00:00:%02u.%06u host%u service[%u]: %s\n",
+                seed % 60, seed % 1000000, seed % 16, seed % 65536, message);
+        log.append(line, length);
+        seed = seed * 1103515245 + 12345;
+    }
+
+    return log;
+}
+
+/**
+ * \brief Load the corpus named by EROC_BENCH_CORPUS, or build a synthetic one.
+ */
+static string load_corpus(size_t size)
+{
+    const char* path = getenv("EROC_BENCH_CORPUS");
+
+    if (NULL != path)
+    {
+        ifstream in(path, ios::binary);
+        stringstream contents;
+        contents << in.rdbuf();
+        string corpus = contents.str();
+        if (corpus.size() > size)
+        {
+            corpus.resize(size);
+        }
+
+        return corpus;
+    }
+
+    return synthetic_log(size);
+}
+
+/**
+ * \brief Split the corpus into lines, without the newlines.
+ */
+static vector<pair<const char*, size_t>> split_lines(const string& corpus)
+{
+    vector<pair<const char*, size_t>> lines;
+    const char* start = corpus.data();
+    const char* end = start + corpus.size();
+
+    while (start < end)
+    {
+        const char* newline = (const char*)memchr(start, '\n', end - start);
+        if (NULL == newline)
+        {
+            newline = end;
+        }
+
+        lines.emplace_back(start, newline - start);
+        start = newline + 1;
+    }
+
+    return lines;
+}
+
+BENCH(regex_prefilter)
+{
+    static const char* PATTERNS[] = {
+        "ERROR.*timeout",
+        "(ERROR|WARN).*disk",
+        "host7 service\\[[0-9]+\\]",
+        "user:[0-9]+",
+        "[0-9]+ms",
+    };
+    string corpus =
+        load_corpus(min(CORPUS_SIZE, runner.options().max_size));
+    auto lines = split_lines(corpus);
+
+    for (const char* pattern : PATTERNS)
+    {
+        eroc_regex* regex;
+        eroc_regex_vm* vm;
+        size_t matches = 0;
+
+        if (0 != eroc_regex_create(&regex, pattern)
+         || 0 != eroc_regex_vm_create(&vm, regex->program))
+        {
+            fprintf(stderr, "could not compile %s\n", pattern);
+            continue;
+        }
+
+        string name = string("regex_prefilter/") + pattern;
+
+        runner.measure(
+            name + "/nfa", lines.size(), corpus.size(), [&]() {
+                for (const auto& line : lines)
+                {
+                    matches +=
+                        eroc_regex_vm_search(
+                            vm, nullptr, line.first, line.second);
+                }
+            });
+
+        runner.measure(
+            name + "/dfa", lines.size(), corpus.size(), [&]() {
+                for (const auto& line : lines)
+                {
+                    matches +=
+                        eroc_regex_dfa_search(
+                            regex->dfa, nullptr, line.first, line.second);
+                }
+            });
+
+        regex->searches = regex->skipped = 0;
+        runner.measure(
+            name + "/prefilter+dfa", lines.size(), corpus.size(), [&]() {
+                for (const auto& line : lines)
+                {
+                    matches +=
+                        eroc_regex_search(
+                            regex, nullptr, line.first, line.second);
+                }
+            });
+
+        runner.report(
+            name + "/skip_rate",
+            regex->searches
+                ? 100.0 * regex->skipped / regex->searches : 0.0,
+            "% lines skipped");
+        runner.report(
+            name + "/literals", regex->prefilter.count, "literals");
+
+        eroc_regex_vm_release(vm);
+        eroc_regex_release(regex);
+    }
+}
@@ -0,0 +1,78 @@
+/**
+ * \file bench/lib/main.cpp
+ *
+ * \brief Entry point for the eroc benchmark suite.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "bench.h"
+
+std::vector<bench_case>& bench_registry()
+{
+    static std::vector<bench_case> registry;
+
+    return registry;
+}
+
+/**
+ * \brief Run the registered benchmarks.
+ *
+ * Usage: erocbench [-j] [-m max-size-in-MB] [-n max-elements]
+ *                  [-r repetitions] [filter]
+ *
+ * With -j, the results are written to standard output as a JSON document, so
+ * that runs can be saved and compared. Percentiles are taken over the
+ * repetitions, so more repetitions give a better picture of the spread.
+ */
+int main(int argc, char* argv[])
+{
+    bench_options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!strcmp(argv[i], "-j"))
+        {
+            options.json = true;
+        }
+        else if (!strcmp(argv[i], "-m") && i + 1 < argc)
+        {
+            options.max_size = strtoull(argv[++i], NULL, 10) * 1024 * 1024;
+        }
+        else if (!strcmp(argv[i], "-n") && i + 1 < argc)
+        {
+            options.max_elements = strtoull(argv[++i], NULL, 10);
+        }
+        else if (!strcmp(argv[i], "-r") && i + 1 < argc)
+        {
+            options.repetitions = atoi(argv[++i]);
+        }
+        else
+        {
+            options.filter = argv[i];
+        }
+    }
+
+    if (options.repetitions < 1)
+    {
+        options.repetitions = 1;
+    }
+
+    bench_runner runner(options);
+    runner.begin();
+    for (const auto& bench : bench_registry())
+    {
+        if (options.filter.empty()
+         || strstr(bench.name, options.filter.c_str()))
+        {
+            bench.fn(runner);
+        }
+    }
+    runner.end();
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * \file eroc/arena.h
+ *
+ * \brief A bump allocator whose memory is all released at once.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief The default size of an arena block.
+ */
+#define EROC_ARENA_DEFAULT_BLOCK_SIZE (1024 * 1024)
+
+/**
+ * \brief An arena block is a header followed by its data.
+ */
+typedef struct eroc_arena_block eroc_arena_block;
+
+struct eroc_arena_block
+{
+    eroc_arena_block* next;
+    size_t size;
+    size_t used;
+};
+
+/**
+ * \brief An arena hands out memory by bumping a pointer through large blocks.
+ * Allocations can't be freed individually; every block is freed when the arena
+ * is released, at a cost proportional to the number of blocks rather than the
+ * number of allocations.
+ */
+typedef struct eroc_arena eroc_arena;
+
+struct eroc_arena
+{
+    /* the block being filled is first. */
+    eroc_arena_block* blocks;
+    size_t block_size;
+    /* total data bytes in all blocks. */
+    size_t reserved;
+};
+
+/**
+ * \brief Create an arena.
+ *
+ * \param arena             Pointer to the arena pointer to be set to the
+ *                          created arena on success.
+ * \param block_size        The size of each block, or 0 for
+ *                          \ref EROC_ARENA_DEFAULT_BLOCK_SIZE.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_arena_create(eroc_arena** arena, size_t block_size);
+
+/**
+ * \brief Release an arena and every allocation made from it.
+ *
+ * \param arena             The arena to release.
+ */
+void eroc_arena_release(eroc_arena* arena);
+
+/**
+ * \brief Allocate memory from an arena.
+ *
+ * Requests larger than a quarter of the block size get a block of their own, so
+ * that they don't waste the rest of the current block.
+ *
+ * \param arena             The arena for this allocation.
+ * \param size              The number of bytes to allocate.
+ * \param alignment         The alignment of the allocation, which must be a
+ *                          power of two.
+ *
+ * \returns the allocation, or NULL on failure.
+ */
+void* eroc_arena_alloc(eroc_arena* arena, size_t size, size_t alignment);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
@@ -19,6 +19,11 @@ extern "C" {
 
 /**
  * \brief Type erased AVL tree node.
+ *
+ * Each node keeps the number of nodes in its subtree, which every operation
+ * that links or rotates nodes keeps up to date. This makes every tree an
+ * order-statistic tree, in which nodes can be found by position as well as by
+ * key in O(log n).
  */
 typedef struct eroc_avl_tree_node eroc_avl_tree_node;
 
@@ -28,6 +33,8 @@ struct eroc_avl_tree_node
     eroc_avl_tree_node* left;
     eroc_avl_tree_node* right;
     int height;
+    /* number of nodes in the subtree rooted at this node. */
+    size_t count;
 };
 
 /**
@@ -66,6 +73,43 @@ typedef const void* (*eroc_avl_tree_key_fn)(void* context, const void* elem);
 typedef int (*eroc_avl_tree_release_fn)(
     void* context, eroc_avl_tree_node* node);
 
+/**
+ * \brief Return the next of a sequence of nodes given in order.
+ *
+ * \param context       Context data to be passed to the function.
+ *
+ * \returns the next node.
+ */
+typedef eroc_avl_tree_node* (*eroc_avl_tree_next_fn)(void* context);
+
+/**
+ * \brief Release all of the nodes of a tree at once.
+ *
+ * This lets a tree whose nodes come from an arena, or are owned elsewhere, be
+ * cleared without visiting every node.
+ *
+ * \param context       Context data to be passed to the release function.
+ * \param root          The root of the tree, which is not empty.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+typedef int (*eroc_avl_tree_bulk_release_fn)(
+    void* context, eroc_avl_tree_node* root);
+
+/**
+ * \brief Recompute the user-defined aggregate of a node, such as the total size
+ * of the elements in its subtree, from the node and its children.
+ *
+ * The tree calls this on every node whose children change, bottom up, after
+ * the node's height and subtree count are up to date, so the aggregates of the
+ * children are always current when it is called.
+ *
+ * \param context       Context data to be passed to the update function.
+ * \param node          The node to update.
+ */
+typedef void (*eroc_avl_tree_update_fn)(
+    void* context, eroc_avl_tree_node* node);
+
 /**
  * \brief AVL tree.
  */
@@ -76,6 +120,10 @@ struct eroc_avl_tree
     eroc_avl_tree_compare_fn compare_fn;
     eroc_avl_tree_key_fn key_fn;
     eroc_avl_tree_release_fn release_fn;
+    /* if set, clearing the tree calls this instead of release_fn. */
+    eroc_avl_tree_bulk_release_fn bulk_release_fn;
+    /* if set, this keeps a user-defined aggregate up to date in each node. */
+    eroc_avl_tree_update_fn update_fn;
     void* context;
     eroc_avl_tree_node* root;
     size_t count;
@@ -108,9 +156,39 @@ int eroc_avl_tree_create(
  */
 int eroc_avl_tree_release(eroc_avl_tree* tree);
 
+/**
+ * \brief Set the function that releases all of the nodes of a tree at once
+ * when the tree is cleared or released.
+ *
+ * \param tree          The tree for this operation.
+ * \param bulk_release_fn   The function, or NULL to release nodes one by one.
+ */
+void eroc_avl_tree_bulk_release_set(
+    eroc_avl_tree* tree, eroc_avl_tree_bulk_release_fn bulk_release_fn);
+
+/**
+ * \brief Set the function that keeps a user-defined aggregate up to date in
+ * each node.
+ *
+ * Rotations, inserts, removals, and the bulk operations call the function on
+ * every node whose subtree changes, bottom up, so an aggregate such as the
+ * total length of a subtree can be used to descend the tree in O(log n). When
+ * the value that a node contributes changes in place, call
+ * \ref eroc_avl_tree_rebalance on the node to update it and its ancestors. If
+ * the tree already has nodes, every node is updated, in O(n).
+ *
+ * \param tree          The tree for this operation.
+ * \param update_fn     The function, or NULL to keep no aggregate.
+ */
+void eroc_avl_tree_update_set(
+    eroc_avl_tree* tree, eroc_avl_tree_update_fn update_fn);
+
 /**
  * \brief Clear all nodes in an AVL tree, and set the count to 0.
  *
+ * A tree with a bulk release function hands it the root instead of releasing
+ * the nodes one by one.
+ *
  * \param tree          The tree instance to clear.
  *
  * \returns 0 on success and non-zero on failure.
@@ -118,16 +196,153 @@ int eroc_avl_tree_release(eroc_avl_tree* tree);
 int eroc_avl_tree_clear(eroc_avl_tree* tree);
 
 /**
- * \brief Recursively release all nodes under a given node as well as this node
- * in a tree.
+ * \brief Release all nodes under a given node as well as this node in a tree.
+ *
+ * This uses no recursion and O(1) extra space, so it is safe for trees of any
+ * size. The links of the subtree are destroyed, so the caller must detach it
+ * from the rest of the tree first.
  *
  * \param tree          The tree instance for this delete operation.
- * \param node          The node to recursively delete.
+ * \param node          The root of the subtree to delete.
  *
  * \returns 0 on success and non-zero on failure.
  */
 int eroc_avl_tree_delete_nodes(eroc_avl_tree* tree, eroc_avl_tree_node* node);
 
+/**
+ * \brief Build a balanced AVL tree from nodes given in order.
+ *
+ * The nodes are taken one at a time from \p next_fn, in in-order position, and
+ * linked into a tree whose left and right subtrees differ in size by at most
+ * one at every node, with heights, subtree counts, and parent links set. No
+ * keys are compared, so the caller is responsible for giving the nodes in key
+ * order if the tree is keyed. This is O(n) time, where inserting the nodes one
+ * at a time would be O(n log n).
+ *
+ * \note The AVL tree takes ownership of these nodes.
+ *
+ * \param tree          The tree for this operation, which must be empty.
+ * \param count         The number of nodes.
+ * \param next_fn       Function that returns the next node.
+ * \param context       The context passed to \p next_fn.
+ *
+ * \returns 0 on success and non-zero if the tree isn't empty.
+ */
+int eroc_avl_tree_build(
+    eroc_avl_tree* tree, size_t count, eroc_avl_tree_next_fn next_fn,
+    void* context);
+
+/**
+ * \brief Build a balanced AVL tree from an array of nodes in order.
+ *
+ * See \ref eroc_avl_tree_build.
+ *
+ * \param tree          The tree for this operation, which must be empty.
+ * \param nodes         The nodes, in in-order position.
+ * \param count         The number of nodes.
+ *
+ * \returns 0 on success and non-zero if the tree isn't empty.
+ */
+int eroc_avl_tree_build_sorted(
+    eroc_avl_tree* tree, eroc_avl_tree_node** nodes, size_t count);
+
+/**
+ * \brief Move every node of one keyed AVL tree into another in linear time.
+ *
+ * Both trees are flattened in place, merged by key, and rebuilt balanced, which
+ * is O(n + m) time where inserting the nodes one at a time would be
+ * O(m log(n + m)). Nodes with equal keys are all kept, with those already in
+ * \p tree first.
+ *
+ * \param tree          The tree to merge into, whose compare and key functions
+ *                      order the result.
+ * \param other         The tree to merge from, which is left empty. It must be
+ *                      ordered by the same keys.
+ */
+void eroc_avl_tree_merge(eroc_avl_tree* tree, eroc_avl_tree* other);
+
+/**
+ * \brief Join two AVL trees around a node.
+ *
+ * Every node of \p tree comes before \p node, which comes before every node of
+ * \p other. The node is linked in where the shorter tree meets the spine of
+ * the taller one, so this is O(1 + |h(tree) - h(other)|) time. No keys are
+ * compared, so the caller is responsible for the order if the trees are keyed.
+ *
+ * \note The AVL tree takes ownership of this node.
+ *
+ * \param tree          The tree that comes first, which receives the result.
+ * \param node          The node that goes between the trees.
+ * \param other         The tree that comes last, which is left empty.
+ */
+void eroc_avl_tree_join(
+    eroc_avl_tree* tree, eroc_avl_tree_node* node, eroc_avl_tree* other);
+
+/**
+ * \brief Append every node of one AVL tree to another.
+ *
+ * The first node of \p other is removed and used to join the trees, so this is
+ * O(log n) time. See \ref eroc_avl_tree_join.
+ *
+ * \param tree          The tree that comes first, which receives the result.
+ * \param other         The tree that comes last, which is left empty.
+ */
+void eroc_avl_tree_concat(eroc_avl_tree* tree, eroc_avl_tree* other);
+
+/**
+ * \brief Split an AVL tree before the given node.
+ *
+ * The node and every node after it move to \p right. The pieces on each side
+ * of the path from the node to the root are joined back together, which is
+ * O(log n) time in all.
+ *
+ * \param tree          The tree to split, which keeps the nodes before
+ *                      \p node.
+ * \param right         The tree that receives \p node and the nodes after it,
+ *                      which must be empty.
+ * \param node          The node to split before, which must be a member of
+ *                      \p tree.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split_node(
+    eroc_avl_tree* tree, eroc_avl_tree* right, eroc_avl_tree_node* node);
+
+/**
+ * \brief Split a keyed AVL tree by key.
+ *
+ * Every node whose key is not less than \p key moves to \p right, in O(log n)
+ * time. See \ref eroc_avl_tree_split_node.
+ *
+ * \param tree          The tree to split, which keeps the nodes whose keys are
+ *                      less than \p key.
+ * \param right         The tree that receives the other nodes, which must be
+ *                      empty.
+ * \param key           The key to split at.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split(
+    eroc_avl_tree* tree, eroc_avl_tree* right, const void* key);
+
+/**
+ * \brief Split an AVL tree by in-order index.
+ *
+ * The node at \p index and every node after it move to \p right, in O(log n)
+ * time. See \ref eroc_avl_tree_split_node.
+ *
+ * \param tree          The tree to split, which keeps its first \p index
+ *                      nodes.
+ * \param right         The tree that receives the other nodes, which must be
+ *                      empty.
+ * \param index         The in-order index to split at. If it is past the end,
+ *                      no nodes move.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split_at(
+    eroc_avl_tree* tree, eroc_avl_tree* right, size_t index);
+
 /**
  * \brief Insert a node into the AVL tree instance.
  *
@@ -138,6 +353,39 @@ int eroc_avl_tree_delete_nodes(eroc_avl_tree* tree, eroc_avl_tree_node* node);
  */
 void eroc_avl_tree_insert(eroc_avl_tree* tree, eroc_avl_tree_node* node);
 
+/**
+ * \brief Insert a node into the AVL tree instance immediately after the given
+ * node in in-order position, ignoring keys.
+ *
+ * \note The AVL tree takes ownership of this node. Positional insertion is
+ * meant for trees that are ordered by position rather than by key, such as a
+ * line index. Mixing positional and keyed insertion in the same tree is only
+ * valid if the caller preserves key order.
+ *
+ * \param tree          The tree instance for this insert operation.
+ * \param after         The node after which this node is inserted, or NULL if
+ *                      this node should be inserted at the end of the tree.
+ * \param node          The node to insert.
+ */
+void eroc_avl_tree_insert_after(
+    eroc_avl_tree* tree, eroc_avl_tree_node* after, eroc_avl_tree_node* node);
+
+/**
+ * \brief Insert a node into the AVL tree instance immediately before the given
+ * node in in-order position, ignoring keys.
+ *
+ * \note The AVL tree takes ownership of this node. See
+ * \ref eroc_avl_tree_insert_after for restrictions on positional insertion.
+ *
+ * \param tree          The tree instance for this insert operation.
+ * \param before        The node before which this node is inserted, or NULL if
+ *                      this node should be inserted at the beginning of the
+ *                      tree.
+ * \param node          The node to insert.
+ */
+void eroc_avl_tree_insert_before(
+    eroc_avl_tree* tree, eroc_avl_tree_node* before, eroc_avl_tree_node* node);
+
 /**
  * \brief Find a node in the AVL tree matching the given user defined key.
  *
@@ -223,21 +471,95 @@ eroc_avl_tree_node* eroc_avl_tree_predecessor_node(
  * \brief Perform a right rotation on an AVL tree.
  *
  * Root will become root->left's right-most child, and root->left will become
- * the new root of this subtree.
+ * the new root of this subtree. The tree's update function, if any, is called
+ * on the old root and then on the new root.
  *
+ * \param tree          The tree for this rotation.
  * \param root          The root for this rotation.
  */
-void eroc_avl_tree_rotate_right(eroc_avl_tree_node** root);
+void eroc_avl_tree_rotate_right(
+    eroc_avl_tree* tree, eroc_avl_tree_node** root);
 
 /**
  * \brief Perform a left rotation on an AVL tree.
  *
  * Root will become root->right's left-most child, and root->right will become
- * the new root of this subtree.
+ * the new root of this subtree. The tree's update function, if any, is called
+ * on the old root and then on the new root.
  *
+ * \param tree          The tree for this rotation.
  * \param root          The root for this rotation.
  */
-void eroc_avl_tree_rotate_left(eroc_avl_tree_node** root);
+void eroc_avl_tree_rotate_left(
+    eroc_avl_tree* tree, eroc_avl_tree_node** root);
+
+/**
+ * \brief Walk from the given node to the root, recomputing heights, subtree
+ * counts, and user-defined aggregates, and performing any rotations needed to
+ * restore the AVL invariant.
+ *
+ * \param tree          The tree for this operation.
+ * \param node          The lowest node whose children changed, or NULL.
+ */
+void eroc_avl_tree_rebalance(eroc_avl_tree* tree, eroc_avl_tree_node* node);
+
+/**
+ * \brief Return the node at the given zero-based in-order index, or NULL.
+ *
+ * This descends by subtree counts, in O(log n).
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param index         The in-order index of the node to find.
+ *
+ * \returns the node at this index, or NULL if the index is out of bounds.
+ */
+eroc_avl_tree_node* eroc_avl_tree_select(eroc_avl_tree* tree, size_t index);
+
+/**
+ * \brief Return the zero-based in-order index of the given node.
+ *
+ * This walks up the parent links from the node, in O(log n), so it works for
+ * trees ordered by position as well as by key.
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param node          The node, which must be a member of this tree.
+ *
+ * \returns the in-order index of this node.
+ */
+size_t eroc_avl_tree_rank(eroc_avl_tree* tree, const eroc_avl_tree_node* node);
+
+/**
+ * \brief Return the number of nodes in a keyed AVL tree whose keys are less
+ * than the given key.
+ *
+ * This is the in-order index of the first node whose key is not less than
+ * \p key, or the count of the tree if there is none, found in O(log n). With
+ * \ref eroc_avl_tree_select, it answers questions such as how many nodes fall
+ * in a range of keys, or which node is the tenth after a key, without visiting
+ * the nodes in between.
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param key           The key to rank.
+ *
+ * \returns the number of nodes whose keys are less than \p key.
+ */
+size_t eroc_avl_tree_rank_key(eroc_avl_tree* tree, const void* key);
+
+/**
+ * \brief Put newnode in the place of oldnode in the tree.
+ *
+ * \note After this operation, the caller owns oldnode, and the tree owns
+ * newnode. The caller is responsible for ensuring that newnode preserves the
+ * ordering of the tree. This is O(1), or O(log n) if the tree has an update
+ * function, since the aggregates of newnode's ancestors may change.
+ *
+ * \param tree          The tree for this replace operation.
+ * \param oldnode       The node to replace.
+ * \param newnode       The node that takes the place of oldnode.
+ */
+void eroc_avl_tree_replace_node(
+    eroc_avl_tree* tree, eroc_avl_tree_node* oldnode,
+    eroc_avl_tree_node* newnode);
 
 /**
  * \brief Remove the given node from the tree, transplanting nodes as needed.
@@ -9,7 +9,13 @@
 
 #pragma once
 
+#include <eroc/arena.h>
+#include <eroc/avltree.h>
 #include <eroc/list.h>
+#include <eroc/piecetable.h>
+#include <eroc/regex.h>
+#include <stdbool.h>
+#include <sys/types.h>
 
 /* C++ compatibility. */
 # ifdef   __cplusplus
@@ -17,31 +23,172 @@ extern "C" {
 # endif /*__cplusplus*/
 
 /**
- * \brief A buffer line is a linked list node with a string.
+ * \brief A buffer line is a linked list node with a string. It is also a node
+ * in the buffer's positional line index.
+ *
+ * A line either owns its string, or borrows it from the buffer's file mapping.
+ * Owned strings are NUL terminated. Borrowed strings are not, so consumers must
+ * always use the length. The capacity is the number of bytes that an owned
+ * string can hold, not counting its NUL terminator, and is 0 for a borrowed
+ * string.
+ *
+ * Lines created by a buffer, such as those loaded from a file, are allocated
+ * from the buffer's arena, and have \ref EROC_BUFFER_LINE_FLAG_ARENA set. Their
+ * memory is recycled by the buffer and reclaimed all at once when the buffer is
+ * released, so they must not be moved to another buffer.
  */
 typedef struct eroc_buffer_line eroc_buffer_line;
 
 struct eroc_buffer_line
 {
     eroc_list_node hdr;
+    eroc_avl_tree_node index;
     char* line;
+    size_t length;
+    size_t capacity;
+    int flags;
+};
+
+#define EROC_BUFFER_LINE_FLAG_BORROWED                                  0x0001
+#define EROC_BUFFER_LINE_FLAG_MARKED                                    0x0002
+#define EROC_BUFFER_LINE_FLAG_ARENA                                     0x0004
+
+/**
+ * \brief The number of size classes of released line strings that a buffer
+ * keeps for reuse.
+ */
+#define EROC_BUFFER_TEXT_CLASSES 32
+
+/**
+ * \brief Seeking walks the line list when the line is at most this many lines
+ * from the cursor, the head, or the tail, and uses the index otherwise.
+ */
+#define EROC_BUFFER_SEEK_WALK_LIMIT 64
+
+/**
+ * \brief A read-only private mapping of the file that a buffer was loaded from.
+ *
+ * The device and inode identify the file, so that a save which would
+ * overwrite it in place can first copy the mapping with
+ * \ref eroc_buffer_mapping_detach.
+ */
+typedef struct eroc_buffer_mapping eroc_buffer_mapping;
+
+struct eroc_buffer_mapping
+{
+    void* data;
+    size_t size;
+    dev_t dev;
+    ino_t ino;
+};
+
+/**
+ * \brief The default memory limit of a buffer's journal.
+ */
+#define EROC_BUFFER_JOURNAL_DEFAULT_LIMIT (64 * 1024 * 1024)
+
+/**
+ * \brief A journal record describes a run of changed lines.
+ *
+ * After the change, lines [lineno, lineno + count) of the buffer are the new
+ * lines, and the lines that they replaced are held by the record, linked
+ * through their list headers. Undoing the change swaps the two runs, after
+ * which the record holds the new lines, ready to be redone by swapping them
+ * back. Lines are moved between the buffer and the record, never copied.
+ */
+typedef struct eroc_buffer_journal_record eroc_buffer_journal_record;
+
+struct eroc_buffer_journal_record
+{
+    eroc_buffer_journal_record* prev;
+    eroc_buffer_journal_record* next;
+    /* the records of one command share a group. */
+    unsigned long group;
+    unsigned long lineno;
+    unsigned long count;
+    eroc_buffer_line* removed;
+    eroc_buffer_line* removed_tail;
+    unsigned long removed_count;
+    /* the memory held by this record, including its removed lines. */
+    size_t size;
+};
+
+/**
+ * \brief A journal is the undo and redo history of a buffer.
+ *
+ * Records are kept oldest first. The records up to and including the current
+ * record can be undone, and the records after it can be redone. Consecutive
+ * changes made by one command to adjacent lines share a record, so deleting or
+ * substituting a range of lines costs one record however long the range is.
+ */
+typedef struct eroc_buffer_journal eroc_buffer_journal;
+
+struct eroc_buffer_journal
+{
+    eroc_buffer_journal_record* head;
+    eroc_buffer_journal_record* tail;
+    eroc_buffer_journal_record* current;
+    unsigned long group;
+    size_t size;
+    size_t limit;
+    /* set while records are applied, or when the rest of a command can't be
+     * recorded. */
+    bool paused;
 };
 
 /**
  * \brief A buffer is a linked list of buffer lines.
+ *
+ * The index is an order-statistic AVL tree over the same lines, in the same
+ * order, which allows a line to be found by line number in O(log n). The list
+ * owns the lines; the index only references them.
+ *
+ * A buffer loaded with \ref eroc_buffer_load_pieces keeps its text in a piece
+ * table instead, and its line list and index stay empty. Its cursor points to
+ * the view, a line whose string borrows the text of the cursor's line from the
+ * piece table. Lines are addressed through the cursor: every line passed to
+ * \ref eroc_buffer_append, \ref eroc_buffer_insert,
+ * \ref eroc_buffer_replace, or \ref eroc_buffer_line_delete must be either the
+ * cursor or NULL, and added lines are copied into the piece table. A buffer
+ * loaded with \ref eroc_buffer_load_lazy is also a piece table buffer, whose
+ * text is still being indexed.
  */
 typedef struct eroc_buffer eroc_buffer;
 
 struct eroc_buffer
 {
     eroc_list* lines;
+    eroc_avl_tree* index;
+    eroc_buffer_mapping map;
     char* name;
     int flags;
     eroc_buffer_line* cursor;
     unsigned long lineno;
+    /* number of lines with EROC_BUFFER_LINE_FLAG_MARKED set. */
+    unsigned long marked;
+    /* the arena for lines created by this buffer. */
+    eroc_arena* arena;
+    /* released arena line headers, linked through hdr.next. */
+    eroc_buffer_line* free_lines;
+    /* released arena line strings; class k holds strings of 2^k bytes or
+     * more, linked through their first bytes. */
+    char* free_text[EROC_BUFFER_TEXT_CLASSES];
+    /* number of lines in this buffer which are not from its arena. */
+    unsigned long heap_lines;
+    /* the text of a piece table buffer, or NULL for a list buffer. */
+    eroc_piece_table* pieces;
+    /* the cursor's line in a piece table buffer. */
+    eroc_buffer_line view;
+    /* the undo history, or NULL if changes aren't recorded. */
+    eroc_buffer_journal* journal;
 };
 
 #define EROC_BUFFER_FLAG_MODIFIED                                       0x0001
+/* suppress diagnostics, such as the byte count printed by a write. */
+#define EROC_BUFFER_FLAG_QUIET                                          0x0002
+/* the current line is the last line, which a lazy buffer doesn't know until it
+ * is indexed; the cursor holds the first line until then. */
+#define EROC_BUFFER_FLAG_CURSOR_PENDING                                 0x0004
 #define EROC_BUFFER_FLAG_QUIT_REQUESTED                                 0x8000
 
 /**
@@ -50,6 +197,10 @@ struct eroc_buffer
  * \note This method takes ownership of the line string and will reclaim this
  * string when it is released via \ref eroc_buffer_line_release.
  *
+ * The length of the line is taken from its NUL terminator, so a line with
+ * embedded NULs must be created with \ref eroc_buffer_line_create_in or
+ * \ref eroc_buffer_line_create_copy instead.
+ *
  * \param line              Pointer to the buffer line pointer to set with this
  *                          buffer line on success.
  * \param linestr           The string representation of this line, with newline
@@ -59,9 +210,158 @@ struct eroc_buffer
  */
 int eroc_buffer_line_create(eroc_buffer_line** line, char* linestr);
 
+/**
+ * \brief Create a buffer line with its own copy of the given string.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param linestr           The line string to copy, which need not be NUL
+ *                          terminated.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_copy(
+    eroc_buffer_line** line, const char* linestr, size_t length);
+
+/**
+ * \brief Create a buffer line that borrows its string from a file mapping.
+ *
+ * \note The line string is not NUL terminated, and remains owned by the
+ * mapping. It must outlive this line, or be copied with
+ * \ref eroc_buffer_line_own first.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param linestr           The start of this line in the mapping.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_borrowed(
+    eroc_buffer_line** line, const char* linestr, size_t length);
+
+/**
+ * \brief Make sure that a buffer line owns its string, copying a borrowed
+ * string out of the file mapping.
+ *
+ * This must be called before a line's string is modified in place. It must not
+ * be called on an arena line; use \ref eroc_buffer_line_set instead.
+ *
+ * \param line              The buffer line for this operation.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_own(eroc_buffer_line* line);
+
+/**
+ * \brief Create a buffer line from the buffer's arena, with a copy of the given
+ * string.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param buffer            The buffer whose arena holds this line. The line
+ *                          may only be added to this buffer.
+ * \param linestr           The line string to copy, which need not be NUL
+ *                          terminated.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_in(
+    eroc_buffer_line** line, eroc_buffer* buffer, const char* linestr,
+    size_t length);
+
+/**
+ * \brief Create a buffer line from the buffer's arena, which borrows its string
+ * from the buffer's file mapping.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param buffer            The buffer whose arena holds this line. The line
+ *                          may only be added to this buffer.
+ * \param linestr           The start of this line in the mapping.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_borrowed_in(
+    eroc_buffer_line** line, eroc_buffer* buffer, const char* linestr,
+    size_t length);
+
+/**
+ * \brief Allocate an empty line header from the buffer's arena, reusing a
+ * released header if there is one.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          line header on success.
+ * \param buffer            The buffer whose arena holds this line.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_header_alloc(
+    eroc_buffer_line** line, eroc_buffer* buffer);
+
+/**
+ * \brief Allocate a line string from the buffer's arena, reusing a released
+ * string if one is large enough.
+ *
+ * \param text              Pointer to be set to the string on success.
+ * \param capacity          Set to the string's capacity, not counting its NUL
+ *                          terminator, on success.
+ * \param buffer            The buffer whose arena holds this string.
+ * \param length            The least capacity needed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_text_alloc(
+    char** text, size_t* capacity, eroc_buffer* buffer, size_t length);
+
+/**
+ * \brief Release a line string allocated from the buffer's arena, so that it
+ * can be reused.
+ *
+ * \param buffer            The buffer whose arena holds this string.
+ * \param text              The string to release.
+ * \param capacity          The string's capacity.
+ */
+void eroc_buffer_text_free(eroc_buffer* buffer, char* text, size_t capacity);
+
+/**
+ * \brief Release a line which is no longer in the buffer, recycling its memory
+ * if it came from the buffer's arena.
+ *
+ * \param buffer            The buffer which the line was removed from.
+ * \param line              The line to release.
+ */
+void eroc_buffer_line_recycle(eroc_buffer* buffer, eroc_buffer_line* line);
+
+/**
+ * \brief Replace the string of a buffer line with a copy of the given string.
+ *
+ * The copy is made in place when it fits in the line's capacity, so a line
+ * that is rewritten to the same or a shorter length never reallocates. Arena
+ * lines get their new string from the buffer's arena.
+ *
+ * \param buffer            The buffer holding the line.
+ * \param line              The buffer line for this operation.
+ * \param linestr           The new line string, which need not be NUL
+ *                          terminated, and which must not overlap the line's
+ *                          current string.
+ * \param length            The length of the new line string.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_set(
+    eroc_buffer* buffer, eroc_buffer_line* line, const char* linestr,
+    size_t length);
+
 /**
  * \brief Release a buffer line.
  *
+ * \note Arena lines are not released individually; their memory is reclaimed
+ * with the buffer, so this does nothing for them.
+ *
  * \param line              The buffer line to release.
  *
  * \returns 0 on success and non-zero on failure.
@@ -100,13 +400,18 @@ int eroc_buffer_name_set(eroc_buffer* buffer, const char* name);
 /**
  * \brief Append the given line to the given buffer, after the given line.
  *
+ * A piece table buffer copies the line's string and releases the line.
+ *
  * \param buffer            The buffer for this append operation.
  * \param after             The line after this line should be appended, or NULL
  *                          if this line should be appended at the end of the
  *                          buffer.
  * \param line              The line to append.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the caller
+ * still owns the line. Appending to a list buffer never fails.
  */
-void eroc_buffer_append(
+int eroc_buffer_append(
     eroc_buffer* buffer, eroc_buffer_line* after, eroc_buffer_line* line);
 
 /**
@@ -115,35 +420,58 @@ void eroc_buffer_append(
  *
  * \param buffer            The buffer for this delete operation.
  * \param line              The line to delete.
+ *
+ * \returns 0 on success and non-zero on failure. Deleting from a list buffer
+ * never fails.
  */
-void eroc_buffer_line_delete(eroc_buffer* buffer, eroc_buffer_line* line);
+int eroc_buffer_line_delete(eroc_buffer* buffer, eroc_buffer_line* line);
 
 /**
  * \brief Insert the given line into the given buffer, before the given line.
  *
+ * A piece table buffer copies the line's string and releases the line.
+ *
  * \param buffer            The buffer for this insert operation.
  * \param before            The line before this line should be inserted, or
  *                          NULL if this line should be inserted at the
  *                          beginning of the buffer.
  * \param line              The line to insert.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the caller
+ * still owns the line. Inserting into a list buffer never fails.
  */
-void eroc_buffer_insert(
+int eroc_buffer_insert(
     eroc_buffer* buffer, eroc_buffer_line* before, eroc_buffer_line* line);
 
 /**
  * \brief Replace oldline with newline.
  *
- * \note After this operation, the caller owns oldline.
+ * \note The buffer releases oldline, or moves it into its journal, unless the
+ * buffer is a piece table buffer, in which case oldline is the view, which the
+ * buffer keeps, and newline is copied and released.
  *
  * \param buffer            The buffer for this replace operation.
- * \param oldline           The line to replace, owned by caller after the
- *                          operation.
+ * \param oldline           The line to replace.
  * \param newline           The line that \p oldline is replaced with, owned by
  *                          the buffer after the operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case nothing
+ * changes. Replacing a line of a list buffer never fails.
  */
-void eroc_buffer_replace(
+int eroc_buffer_replace(
     eroc_buffer* buffer, eroc_buffer_line* oldline, eroc_buffer_line* newline);
 
+/**
+ * \brief Build the line index of a list buffer over its whole line list.
+ *
+ * Loaders append their lines to the list alone and then build the index once,
+ * in O(n), where indexing each line as it is appended costs O(n log n). The
+ * cursor is left alone.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_index_build(eroc_buffer* buffer);
+
 /**
  * \brief Move the cursor to the head of the buffer.
  *
@@ -161,11 +489,88 @@ void eroc_buffer_cursor_move_tail(eroc_buffer* buffer);
 /**
  * \brief Move the cursor to the given zero-indexed line number.
  *
+ * Moving the cursor settles a pending current line.
+ *
  * \param buffer            The buffer for this operation.
  * \param lineno            The line number for this buffer.
  */
 int eroc_buffer_cursor_move(eroc_buffer* buffer, unsigned long lineno);
 
+/**
+ * \brief Move the cursor to the given zero-indexed line number, walking from
+ * the cursor, the head, or the tail when one of them is near.
+ *
+ * Relative addresses such as +5, -3, and $ then cost O(distance) instead of a
+ * lookup in the index. The cursor and the buffer's line number must agree, as
+ * they do between commands; code that changes lines behind the cursor's back
+ * uses \ref eroc_buffer_cursor_move instead.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number for this buffer.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_cursor_seek(eroc_buffer* buffer, unsigned long lineno);
+
+/**
+ * \brief Get the number of lines in the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns the number of lines.
+ */
+unsigned long eroc_buffer_line_count(const eroc_buffer* buffer);
+
+/**
+ * \brief Check whether a buffer has a line with the given zero-indexed number.
+ *
+ * Unlike comparing against \ref eroc_buffer_line_count, this waits only until
+ * a piece table buffer has indexed the line, not the whole text.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to check.
+ *
+ * \returns true if the line exists and false otherwise.
+ */
+bool eroc_buffer_line_exists(const eroc_buffer* buffer, unsigned long lineno);
+
+/**
+ * \brief Get the line at the given zero-indexed line number.
+ *
+ * \note This fails for a piece table buffer, whose lines are reached by moving
+ * the cursor.
+ *
+ * \param line              Pointer to the line pointer to be set to this line
+ *                          on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_at(
+    eroc_buffer_line** line, const eroc_buffer* buffer, unsigned long lineno);
+
+/**
+ * \brief Get the line at the given zero-indexed line number, walking from the
+ * cursor, the head, or the tail when one of them is within
+ * \ref EROC_BUFFER_SEEK_WALK_LIMIT lines, and using the index otherwise.
+ *
+ * As with \ref eroc_buffer_cursor_seek, the cursor and the buffer's line number
+ * must agree.
+ *
+ * \note This fails for a piece table buffer, whose lines are reached by moving
+ * the cursor.
+ *
+ * \param line              Pointer to the line pointer to be set to this line
+ *                          on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_seek(
+    eroc_buffer_line** line, eroc_buffer* buffer, unsigned long lineno);
+
 /**
  * \brief Advance the cursor by one.
  *
@@ -185,17 +590,310 @@ int eroc_buffer_cursor_advance(eroc_buffer* buffer);
  */
 int eroc_buffer_load(eroc_buffer** buffer, size_t* size, const char* path);
 
+/**
+ * \brief Attempt to load a text file with the given path into a buffer by
+ * mapping it into memory.
+ *
+ * Lines borrow their strings from the mapping until they are edited, so loading
+ * costs a newline scan rather than a copy and an allocation per line string.
+ * Files that can't be mapped, such as pipes or empty files, are loaded with
+ * \ref eroc_buffer_load instead.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the number of bytes read on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_mapped(
+    eroc_buffer** buffer, size_t* size, const char* path);
+
+/**
+ * \brief Attempt to load a text file with the given path into a piece table
+ * buffer.
+ *
+ * The file is mapped into memory and becomes the original text of the buffer's
+ * piece table, so loading costs a newline scan and a few bytes of index per
+ * line, and no line is created until it is edited. Files that can't be mapped,
+ * such as pipes, are loaded with \ref eroc_buffer_load instead.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the number of bytes read on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_pieces(
+    eroc_buffer** buffer, size_t* size, const char* path);
+
+/**
+ * \brief Attempt to load a text file with the given path into a piece table
+ * buffer, without waiting for the file to be indexed.
+ *
+ * The file is mapped into memory, and its lines are indexed by a background
+ * thread, so this returns in constant time whatever the size of the file. The
+ * pages of the file are read in as lines on them are reached. Moving to a line
+ * waits only until the indexer has passed it; counting the lines, addressing
+ * the last line, or editing waits for the whole file to be indexed.
+ *
+ * As with \ref eroc_buffer_load, the current line is the last line, but it is
+ * left pending until a command uses it, since finding it means waiting for the
+ * whole file. Files that can't be mapped, such as pipes, are loaded with
+ * \ref eroc_buffer_load instead.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the size of the file on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_lazy(
+    eroc_buffer** buffer, size_t* size, const char* path);
+
+/**
+ * \brief Copy a buffer's file mapping into private memory, so that the file it
+ * was loaded from can be overwritten in place.
+ *
+ * Every page of the mapping is written once, which gives the buffer its own
+ * copy of the page, so borrowed lines and piece table text no longer see the
+ * file change or shrink. This costs memory for the whole file. It does nothing
+ * to a buffer without a mapping.
+ *
+ * \param buffer            The buffer whose mapping is copied.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_buffer_mapping_detach(const eroc_buffer* buffer);
+
+/**
+ * \brief Turn a piece table buffer into a list buffer, so that it supports
+ * every buffer operation.
+ *
+ * Lines of the original text borrow their strings from the buffer's file
+ * mapping, as with \ref eroc_buffer_load_mapped; added lines are copied. The
+ * cursor stays on the same line number, and the conversion isn't recorded in
+ * the journal. This does nothing to a list buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the buffer is
+ * unchanged.
+ */
+int eroc_buffer_materialize(eroc_buffer* buffer);
+
 /**
  * \brief Save the contents of the given buffer into the file at the given path.
  *
+ * The buffer is written to a temporary file, which is synced and renamed over
+ * the target, so a failed save leaves the old file as it was. A target that
+ * has to be written in place, and is the file the buffer was mapped from, has
+ * its mapping copied into private memory first.
+ *
  * \param buffer            The buffer to save.
  * \param size              The number of bytes written on success.
  * \param path              The path to which the buffer is saved.
  *
- * \returns 0 on success and non-zero on failure.
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
  */
 int eroc_buffer_save(const eroc_buffer* buffer, size_t* size, const char* path);
 
+/**
+ * \brief Mark every line in the range [start, end] which matches the given
+ * pattern, or which doesn't match it if invert is set.
+ *
+ * Lines are tested in parallel, in contiguous chunks spread across a pool of
+ * worker threads. Marks from any previous call are cleared first. Piece table
+ * buffers can't be marked.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param pattern           The pattern to match.
+ * \param invert            If true, mark the lines which don't match.
+ * \param start             The first line of the range.
+ * \param end               The last line of the range.
+ * \param workers           The number of worker threads, or 0 for one per
+ *                          online CPU.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_mark(
+    eroc_buffer* buffer, const char* pattern, bool invert, unsigned long start,
+    unsigned long end, size_t workers);
+
+/**
+ * \brief Apply a substitution to every line in the range [start, end].
+ *
+ * Each changed line is rewritten in place when the result fits in its
+ * capacity. The cursor is moved to the last changed line. Piece table buffers
+ * aren't supported.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param substitution      The substitution to apply.
+ * \param start             The first line of the range.
+ * \param end               The last line of the range.
+ * \param count             Set to the number of lines changed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_substitute(
+    eroc_buffer* buffer, eroc_regex_substitution* substitution,
+    unsigned long start, unsigned long end, unsigned long* count);
+
+/**
+ * \brief Start recording the changes made to a buffer, so that they can be
+ * undone.
+ *
+ * Changes made through \ref eroc_buffer_append, \ref eroc_buffer_insert,
+ * \ref eroc_buffer_replace, and \ref eroc_buffer_line_delete are recorded.
+ * Changes to piece table buffers aren't.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param limit             The most memory that the journal may hold, after
+ *                          which the oldest changes are forgotten.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_journal_create(eroc_buffer* buffer, size_t limit);
+
+/**
+ * \brief Release a buffer's journal, along with the lines that it holds.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_release(eroc_buffer* buffer);
+
+/**
+ * \brief Start a new group of changes, which are undone and redone together.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_checkpoint(eroc_buffer* buffer);
+
+/**
+ * \brief Forget every recorded change.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_clear(eroc_buffer* buffer);
+
+/**
+ * \brief Forget the oldest changes until the journal fits in its limit.
+ *
+ * If the changes of the current group alone don't fit, every change is
+ * forgotten, and recording stops until the next checkpoint.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_trim(eroc_buffer* buffer);
+
+/**
+ * \brief Add a new record at the end of the journal, forgetting any changes
+ * that could be redone.
+ *
+ * \param record            Pointer to be set to the new record on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The number of the first changed line.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_journal_record_create(
+    eroc_buffer_journal_record** record, eroc_buffer* buffer,
+    unsigned long lineno);
+
+/**
+ * \brief Remove a record from the journal and release the lines that it holds.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param record            The record to release.
+ */
+void eroc_buffer_journal_record_release(
+    eroc_buffer* buffer, eroc_buffer_journal_record* record);
+
+/**
+ * \brief Swap the lines held by a record with the lines it describes in the
+ * buffer, which undoes or redoes the record.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param record            The record to apply.
+ */
+void eroc_buffer_journal_record_apply(
+    eroc_buffer* buffer, eroc_buffer_journal_record* record);
+
+/**
+ * \brief Record that a line was added to the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param line              The line, which is in the buffer.
+ */
+void eroc_buffer_journal_insert(eroc_buffer* buffer, eroc_buffer_line* line);
+
+/**
+ * \brief Record that a line was removed from the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param line              The line, which is no longer in the buffer.
+ * \param lineno            The number that the line had.
+ *
+ * \returns true if the journal took the line, or false if the caller should
+ * release it.
+ */
+bool eroc_buffer_journal_delete(
+    eroc_buffer* buffer, eroc_buffer_line* line, unsigned long lineno);
+
+/**
+ * \brief Record that a line of the buffer was replaced.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param oldline           The replaced line, which is no longer in the
+ *                          buffer.
+ * \param lineno            The number of the line.
+ *
+ * \returns true if the journal took the old line, or false if the caller
+ * should release it.
+ */
+bool eroc_buffer_journal_replace(
+    eroc_buffer* buffer, eroc_buffer_line* oldline, unsigned long lineno);
+
+/**
+ * \brief Undo the most recent group of changes that hasn't been undone.
+ *
+ * The cursor moves to the last line that the group restored.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero if there is nothing to undo.
+ */
+int eroc_buffer_undo(eroc_buffer* buffer);
+
+/**
+ * \brief Redo the group of changes that was undone most recently.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero if there is nothing to redo.
+ */
+int eroc_buffer_redo(eroc_buffer* buffer);
+
+/**
+ * \brief Clear every mark in the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_mark_clear(eroc_buffer* buffer);
+
 /* C++ compatibility. */
 # ifdef   __cplusplus
 }
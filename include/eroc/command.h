@@ -12,6 +12,7 @@
 #include <eroc/buffer.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdio.h>
 
 /* C++ compatibility. */
 # ifdef   __cplusplus
@@ -20,7 +21,8 @@ extern "C" {
 
 /**
  * \brief A command consists of an optional start location, optional end
- * location, command function, buffer, line, and optional parameters.
+ * location, command function, buffer, line, optional parameters, and the
+ * stream from which commands such as append read their text.
  */
 typedef struct eroc_command eroc_command;
 
@@ -39,11 +41,58 @@ struct eroc_command
     eroc_buffer_line* line;
     const char* parameters;
     eroc_command_fn command_fn;
+    FILE* input;
+};
+
+/**
+ * \brief What an address is relative to.
+ */
+enum eroc_command_address_base
+{
+    /* there is no address. */
+    EROC_COMMAND_ADDRESS_NONE,
+    /* a one-indexed line number. */
+    EROC_COMMAND_ADDRESS_LINE,
+    /* the current line. */
+    EROC_COMMAND_ADDRESS_CURRENT,
+    /* the last line. */
+    EROC_COMMAND_ADDRESS_LAST,
+};
+
+/**
+ * \brief An address as written, before it is resolved against a buffer.
+ */
+typedef struct eroc_command_address eroc_command_address;
+
+struct eroc_command_address
+{
+    int base;
+    long line;
+    long offset;
+};
+
+/**
+ * \brief A command template is a parsed command which has not yet been
+ * resolved against a buffer, so that it can be parsed once and run many times.
+ */
+typedef struct eroc_command_template eroc_command_template;
+
+struct eroc_command_template
+{
+    eroc_command_address first;
+    eroc_command_address second;
+    /* 0 for one address or none, or the , or ; between two addresses. */
+    char separator;
+    eroc_command_fn command_fn;
+    const char* parameters;
 };
 
 /**
  * \brief Given a command string and a buffer, parse the string into a command.
  *
+ * The command is parsed with \ref eroc_command_template_parse and resolved
+ * against the buffer with \ref eroc_command_template_resolve.
+ *
  * \param command           Pointer to the command pointer to set with this
  *                          command on success.
  * \param buffer            The buffer on which this command is executed.
@@ -54,6 +103,52 @@ struct eroc_command
 int eroc_command_parse(
     eroc_command** command, eroc_buffer* buffer, const char* input);
 
+/**
+ * \brief Parse a command string into a template, without reference to any
+ * buffer.
+ *
+ * A command may be preceded by an address range. An address is a line number,
+ * . for the current line or $ for the last line, followed by any number of +N
+ * or -N offsets; offsets alone are relative to the current line. A range is one
+ * address, or two separated by , or by ;, which makes the second relative to
+ * the first. , and % alone are the whole buffer, and ; alone is the current
+ * line through the last.
+ *
+ * \param tmpl              The template to populate on success.
+ * \param input             The input string to parse, which must outlive the
+ *                          template, since the template's parameters point into
+ *                          it.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_template_parse(
+    eroc_command_template* tmpl, const char* input);
+
+/**
+ * \brief Resolve a command template against a buffer into a command that is
+ * ready to run.
+ *
+ * Addresses are resolved against the buffer's current line and line count. An
+ * address omitted before , is the first line, and before ; is the current
+ * line; an address omitted after either is the last line if both are omitted,
+ * or the first address otherwise.
+ *
+ * A command that only reads or writes out a piece table buffer runs on it as
+ * it is, so it waits only for the lines it addresses to be indexed. Any other
+ * command needs a list buffer, so the buffer is materialized first. A pending
+ * current line is settled on the last line only once a command uses it.
+ *
+ * \param command           The command to populate on success.
+ * \param tmpl              The template to resolve.
+ * \param buffer            The buffer on which the command is executed.
+ *
+ * \returns 0 on success and non-zero on failure, including an address outside
+ * of the buffer or a range that runs backward.
+ */
+int eroc_command_template_resolve(
+    eroc_command* command, const eroc_command_template* tmpl,
+    eroc_buffer* buffer);
+
 /**
  * \brief Release a command.
  *
@@ -72,6 +167,74 @@ int eroc_command_release(eroc_command* command);
  */
 int eroc_command_run(eroc_command* command);
 
+/**
+ * \brief Run the global command described by the command's parameters, which
+ * take the form /re/cmd.
+ *
+ * Every line in the command's range (the whole buffer by default) is first
+ * tested against the pattern in parallel, and the matching lines (or the
+ * non-matching lines, if invert is set) are marked. Then cmd is run serially on
+ * each marked line in order, with that line as the current line. Lines deleted
+ * along the way are skipped. An empty cmd is p.
+ *
+ * \param command           The command instance.
+ * \param invert            If true, run cmd on the lines which don't match.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_global(eroc_command* command, bool invert);
+
+/**
+ * \brief Read one delimited field of a command's parameters, such as the re in
+ * g/re/cmd or the re and repl in s/re/repl/.
+ *
+ * The field ends at the first unescaped delimiter, or at the end of input. An
+ * escaped delimiter is copied as a bare delimiter; any other escape is copied
+ * unchanged, so that it can be interpreted by the consumer of the field.
+ *
+ * \param field             Pointer to be set to the field, which the caller
+ *                          must free.
+ * \param input             Pointer to the input, which is advanced past the
+ *                          field and its closing delimiter, if any.
+ * \param delimiter         The delimiter.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_field_read(char** field, const char** input, char delimiter);
+
+/**
+ * \brief Split the parameters of a global command, /re/cmd, into the pattern
+ * and the command list.
+ *
+ * The first character is the delimiter, which may appear escaped in the
+ * pattern. A missing closing delimiter ends the pattern at the end of input.
+ * An empty command list is p.
+ *
+ * \param pattern           Pointer to be set to the pattern, which the caller
+ *                          must free.
+ * \param command_list      Pointer to be set to the command list, which points
+ *                          into \p parameters.
+ * \param parameters        The parameters to parse.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_global_parse(
+    char** pattern, const char** command_list, const char* parameters);
+
+/**
+ * \brief Parse the parameters of a substitute command, /re/repl/flags, into a
+ * substitution.
+ *
+ * \param substitution      Pointer to be set to the substitution on success.
+ * \param print             Set to true if the p flag is given.
+ * \param parameters        The parameters to parse.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_substitution_parse(
+    eroc_regex_substitution** substitution, bool* print,
+    const char* parameters);
+
 /**
  * \brief Advance the cursor by one, printing this new line.
  *
@@ -117,6 +280,24 @@ int eroc_command_function_delete(eroc_command* command);
  */
 int eroc_command_function_display_line_number(eroc_command* command);
 
+/**
+ * \brief Run a command on every line matching a pattern: g/re/cmd.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_global(eroc_command* command);
+
+/**
+ * \brief Run a command on every line not matching a pattern: v/re/cmd.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_global_invert(eroc_command* command);
+
 /**
  * \brief Insert lines terminated by . to the buffer.
  *
@@ -153,6 +334,40 @@ int eroc_command_function_print(eroc_command* command);
  */
 int eroc_command_function_quit(eroc_command* command);
 
+/**
+ * \brief Redo the changes undone most recently.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_redo(eroc_command* command);
+
+/**
+ * \brief The substitute command returns this when no line changes, so that a
+ * global command can tell a line it left alone from a real failure.
+ */
+#define EROC_COMMAND_SUBSTITUTE_NO_MATCH 16
+
+/**
+ * \brief Substitute text matching a pattern: s/re/repl/flags.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success, EROC_COMMAND_SUBSTITUTE_NO_MATCH if no line changes,
+ * and another non-zero value on failure.
+ */
+int eroc_command_function_substitute(eroc_command* command);
+
+/**
+ * \brief Undo the most recent command that changed the buffer.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_undo(eroc_command* command);
+
 /**
  * \brief Write the buffer to the named file.
  *
@@ -0,0 +1,105 @@
+/**
+ * \file eroc/linetable.h
+ *
+ * \brief Vectorized newline scanner that builds a table of line boundaries.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <stddef.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief A line table holds the offset of every newline found in a block of
+ * data, relative to the start of that block.
+ *
+ * Line i of the block spans from one past newline i - 1 (or the start of the
+ * block) up to, but not including, newline i. Any bytes after the last newline
+ * are an incomplete line, which the caller either carries over into the next
+ * block or treats as the final line.
+ */
+typedef struct eroc_line_table eroc_line_table;
+
+struct eroc_line_table
+{
+    size_t* newlines;
+    size_t count;
+    size_t capacity;
+    /* number of newlines preceded by a carriage return. */
+    size_t crlf_count;
+};
+
+/**
+ * \brief Create an empty line table.
+ *
+ * \param table         Pointer to the line table pointer to set to the created
+ *                      table on success.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_create(eroc_line_table** table);
+
+/**
+ * \brief Release a line table.
+ *
+ * \param table         The table to release.
+ */
+void eroc_line_table_release(eroc_line_table* table);
+
+/**
+ * \brief Make sure that the table can hold at least the given number of
+ * newlines without growing.
+ *
+ * \param table         The table for this operation.
+ * \param capacity      The minimum capacity.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_reserve(eroc_line_table* table, size_t capacity);
+
+/**
+ * \brief Scan a block of data for newlines, replacing the contents of the table
+ * with the offset of each newline found.
+ *
+ * The scan uses AVX2 or SSE2 when the CPU supports them, and a scalar loop
+ * otherwise.
+ *
+ * \note A carriage return at the very start of the block can't be attributed
+ * to a CRLF pair in this block, so a CRLF split across two blocks is not
+ * counted in \ref eroc_line_table.crlf_count.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_scan(
+    eroc_line_table* table, const char* data, size_t size);
+
+/**
+ * \brief Scan a block of data for newlines one byte at a time.
+ *
+ * This is the portable fallback for \ref eroc_line_table_scan, and produces an
+ * identical table.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_scan_scalar(
+    eroc_line_table* table, const char* data, size_t size);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
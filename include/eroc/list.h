@@ -133,6 +133,8 @@ void eroc_list_node_splice(
 /**
  * \brief Attempt to get the node at the given 0-based index.
  *
+ * The list is walked from the head or the tail, whichever is nearer.
+ *
  * \param node          Pointer to the node pointer to be updated on success.
  * \param list          The list for this operation.
  * \param index         The index to find.
@@ -142,6 +144,25 @@ void eroc_list_node_splice(
 int eroc_list_node_at(
     eroc_list_node** node, eroc_list* list, unsigned long index);
 
+/**
+ * \brief Attempt to get the node at the given 0-based index, walking from the
+ * nearest of the head, the tail, and a node whose index is known.
+ *
+ * This is O(distance) from the nearest of the three, so seeking near a cursor
+ * is cheap however long the list is.
+ *
+ * \param node          Pointer to the node pointer to be updated on success.
+ * \param list          The list for this operation.
+ * \param from          A node of this list, or NULL.
+ * \param from_index    The index of \p from, if it is set.
+ * \param index         The index to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_list_node_seek(
+    eroc_list_node** node, eroc_list* list, eroc_list_node* from,
+    unsigned long from_index, unsigned long index);
+
 /* C++ compatibility. */
 # ifdef   __cplusplus
 }
@@ -0,0 +1,317 @@
+/**
+ * \file eroc/piecetable.h
+ *
+ * \brief A line-oriented piece table over a read-only original text.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <eroc/arena.h>
+#include <eroc/avltree.h>
+#include <eroc/writer.h>
+#include <pthread.h>
+#include <stdbool.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief The piece table records the start of every line of the original text
+ * whose number is a multiple of this stride.
+ */
+#define EROC_PIECE_TABLE_STRIDE 64
+
+/**
+ * \brief A piece is a run of consecutive lines from one of the two sources of a
+ * piece table: the original text, or the add buffer.
+ *
+ * A piece always holds whole lines. Pieces from the original text also record
+ * their span in bytes, including the newline that ends each line, so that they
+ * can be written out without being split into lines.
+ */
+typedef struct eroc_piece eroc_piece;
+
+struct eroc_piece
+{
+    eroc_avl_tree_node node;
+    /* the number of the first line of this piece in its source. */
+    size_t first;
+    size_t lines;
+    /* the number of lines in the subtree of pieces rooted at this piece. */
+    size_t subtree_lines;
+    /* the byte span of an original piece; unused for added lines. */
+    size_t offset;
+    size_t length;
+    bool added;
+};
+
+/**
+ * \brief A line in the add buffer.
+ */
+typedef struct eroc_piece_line eroc_piece_line;
+
+struct eroc_piece_line
+{
+    const char* text;
+    size_t length;
+};
+
+/**
+ * \brief A piece table describes a text as a sequence of pieces, each of which
+ * refers to lines of the original text or of the append-only add buffer.
+ *
+ * Neither source is ever modified, so an edit only splits, trims, or adds
+ * pieces. The cost of an edit depends on the number of pieces, not on the
+ * number of lines, and the table needs no per-line memory for lines that are
+ * never edited.
+ */
+typedef struct eroc_piece_table eroc_piece_table;
+
+struct eroc_piece_table
+{
+    /* the original text, which the table borrows. */
+    const char* original;
+    size_t original_size;
+    /* checkpoints[i] is the offset of original line i * STRIDE. The array is
+     * reserved up front for the most lines the text can hold, so it never
+     * moves while it is being filled. */
+    size_t* checkpoints;
+    size_t checkpoint_count;
+    size_t checkpoint_capacity;
+    /* the pieces are built once the whole original text is indexed; until
+     * then, the table is the original text. */
+    bool indexed;
+    /* a background indexer is running, or has yet to be joined. */
+    bool indexing;
+    pthread_t indexer;
+    /* the lock guards the index fields below while the indexer runs. */
+    pthread_mutex_t index_lock;
+    pthread_cond_t index_cond;
+    /* the number of newlines indexed, and the offset just past the last. */
+    size_t index_lines;
+    size_t index_end;
+    bool index_done;
+    bool index_cancel;
+    int index_status;
+    /* the add buffer; line text lives in the arena. */
+    eroc_piece_line* added;
+    size_t added_count;
+    size_t added_capacity;
+    /* pieces in text order. */
+    eroc_avl_tree* pieces;
+    eroc_arena* arena;
+    eroc_piece* free_pieces;
+    /* total number of lines. */
+    size_t lines;
+    /* the piece found by the last lookup, and the number of its first line. */
+    eroc_piece* recent;
+    size_t recent_first;
+};
+
+/**
+ * \brief Create a piece table over the given original text.
+ *
+ * Every line of the original text ends with a newline, except possibly the
+ * last, which is copied into the add buffer.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          created table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_create(
+    eroc_piece_table** table, const char* original, size_t size);
+
+/**
+ * \brief Create a piece table over the given original text, indexing the text
+ * in a background thread.
+ *
+ * The table can be read as soon as it is created: reading a line waits only
+ * until the indexer has passed that line. Edits wait for the whole text to be
+ * indexed, and the line count of the table is only valid once it has been; see
+ * \ref eroc_piece_table_finish. If the thread can't be started, the text is
+ * indexed before this returns.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          created table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_create_lazy(
+    eroc_piece_table** table, const char* original, size_t size);
+
+/**
+ * \brief Allocate a piece table with no pieces and an empty index.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          allocated table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_init(
+    eroc_piece_table** table, const char* original, size_t size);
+
+/**
+ * \brief Index the original text of a piece table, recording checkpoints and
+ * publishing progress to readers as each block is scanned.
+ *
+ * This runs on the indexer thread of a lazy table, and on the caller's thread
+ * otherwise. The result is also kept in the table's index status.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero on failure or cancellation.
+ */
+int eroc_piece_table_index(eroc_piece_table* table);
+
+/**
+ * \brief Wait until a line of the original text has been indexed.
+ *
+ * This blocks only until the indexer passes the line, or until indexing ends
+ * if there is no such line, so it is cheap for lines near the start of a huge
+ * text. Once indexing has ended, the table is finished, and this just checks
+ * the line count.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The zero-based number of the line.
+ *
+ * \returns 0 if the line exists and non-zero if it doesn't, or if indexing
+ * failed.
+ */
+int eroc_piece_table_wait(eroc_piece_table* table, size_t lineno);
+
+/**
+ * \brief Wait for the whole original text to be indexed, and build the pieces
+ * that describe it.
+ *
+ * This does nothing for a table that has already been finished.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero if indexing failed.
+ */
+int eroc_piece_table_finish(eroc_piece_table* table);
+
+/**
+ * \brief Release a piece table.
+ *
+ * A running indexer is stopped first.
+ *
+ * \param table             The table to release.
+ */
+void eroc_piece_table_release(eroc_piece_table* table);
+
+/**
+ * \brief Get a line of a piece table.
+ *
+ * Before the table is finished, this waits only until the line is indexed.
+ *
+ * \param text              Set to the start of the line on success. The line
+ *                          is not NUL terminated.
+ * \param length            Set to the length of the line, without its newline,
+ *                          on success.
+ * \param table             The table for this operation.
+ * \param lineno            The zero-based number of the line.
+ *
+ * \returns 0 on success and non-zero if there is no such line.
+ */
+int eroc_piece_table_line(
+    const char** text, size_t* length, eroc_piece_table* table,
+    size_t lineno);
+
+/**
+ * \brief Insert a copy of the given line before a line of a piece table.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line before which the new line is
+ *                          inserted, or the number of lines in the table to add
+ *                          the new line at the end.
+ * \param text              The text of the line, without a newline.
+ * \param length            The length of the line.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the table is
+ * unchanged.
+ */
+int eroc_piece_table_insert(
+    eroc_piece_table* table, size_t lineno, const char* text, size_t length);
+
+/**
+ * \brief Delete a line of a piece table.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line to delete.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the table is
+ * unchanged.
+ */
+int eroc_piece_table_delete(eroc_piece_table* table, size_t lineno);
+
+/**
+ * \brief Write the text of a piece table, which must be finished.
+ *
+ * \param writer            The writer to add the text to. The caller flushes
+ *                          the writer.
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_piece_table_write(eroc_writer* writer, const eroc_piece_table* table);
+
+/**
+ * \brief Find the piece holding a line of a piece table.
+ *
+ * A lookup that lands in the piece found by the previous lookup, or in the
+ * piece after it, takes O(1), so walking the lines in order visits each piece
+ * once. Any other lookup descends the tree by the line totals of the pieces,
+ * in O(log p) for p pieces.
+ *
+ * \param piece             Set to the piece holding the line on success.
+ * \param first             Set to the number of the first line of this piece
+ *                          on success.
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line to find.
+ *
+ * \returns 0 on success and non-zero if there is no such line.
+ */
+int eroc_piece_table_find(
+    eroc_piece** piece, size_t* first, eroc_piece_table* table, size_t lineno);
+
+/**
+ * \brief Make sure that the table has at least the given number of free pieces,
+ * so that an edit can't fail halfway through.
+ *
+ * \param table             The table for this operation.
+ * \param count             The number of free pieces needed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_reserve(eroc_piece_table* table, size_t count);
+
+/**
+ * \brief Get the offset of a line of the original text.
+ *
+ * \param table             The table for this operation.
+ * \param piece             An original piece holding this line.
+ * \param index             The number of the line in the original text.
+ *
+ * \returns the offset of the start of the line.
+ */
+size_t eroc_piece_table_original_offset(
+    const eroc_piece_table* table, const eroc_piece* piece, size_t index);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
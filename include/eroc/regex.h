@@ -54,6 +54,32 @@ enum eroc_regex_compiler_state
     EROC_REGEX_COMPILER_STATE_EOF,
 };
 
+/**
+ * \brief Opcodes for the compiled NFA program.
+ */
+enum eroc_regex_opcode
+{
+    /* consume one byte equal to byte. */
+    EROC_REGEX_OP_BYTE,
+    /* consume any one byte. */
+    EROC_REGEX_OP_ANY,
+    /* consume one byte that is a member of class x. */
+    EROC_REGEX_OP_CLASS,
+    /* continue at x, or at y with lower priority. */
+    EROC_REGEX_OP_SPLIT,
+    /* continue at x. */
+    EROC_REGEX_OP_JUMP,
+    /* record the current offset in capture slot x. */
+    EROC_REGEX_OP_SAVE,
+    /* the program has matched. */
+    EROC_REGEX_OP_MATCH,
+};
+
+/**
+ * \brief Offset stored in a capture slot that did not participate in a match.
+ */
+#define EROC_REGEX_UNSET ((size_t)-1)
+
 /**
  * \brief The regular expression AST node is used by the parser to represent a
  * regular expression operation.
@@ -109,6 +135,222 @@ struct eroc_regex_compiler_instance
     int captures;
 };
 
+/**
+ * \brief A single NFA program instruction.
+ */
+typedef struct eroc_regex_instruction eroc_regex_instruction;
+
+struct eroc_regex_instruction
+{
+    uint8_t opcode;
+    uint8_t byte;
+    uint32_t x;
+    uint32_t y;
+};
+
+/**
+ * \brief A compiled NFA program.
+ *
+ * The program records the whole match in capture slots 0 and 1, and capture
+ * group g in slots 2g + 2 and 2g + 3, where g is the group_index assigned by
+ * the parser.
+ */
+typedef struct eroc_regex_program eroc_regex_program;
+
+struct eroc_regex_program
+{
+    eroc_regex_instruction* instructions;
+    size_t count;
+    /* 256-bit membership bitmaps, already inverted where needed. */
+    uint32_t (*classes)[8];
+    size_t class_count;
+    /* number of capture groups, not counting the whole match. */
+    int captures;
+};
+
+/**
+ * \brief A Pike VM, which simulates an NFA program over its input in lock step,
+ * in O(n * m) time for input length n and program size m.
+ *
+ * A VM holds all of the scratch memory needed for a search, so it can be reused
+ * across many searches without allocating.
+ */
+typedef struct eroc_regex_vm eroc_regex_vm;
+
+struct eroc_regex_vm
+{
+    const eroc_regex_program* program;
+    size_t slot_count;
+    /* current and next thread lists: program counters and capture slots. */
+    uint32_t* pcs[2];
+    size_t* slots[2];
+    size_t thread_count[2];
+    /* generation marks, so each pc is added once per step. */
+    unsigned int* marks;
+    unsigned int generation;
+    /* explicit stack for following empty transitions. */
+    size_t* stack;
+    /* capture slots of the thread being followed, and of the best match. */
+    size_t* scratch;
+    size_t* best;
+};
+
+/**
+ * \brief Default size of the lazy DFA state cache, in bytes.
+ */
+#define EROC_REGEX_DFA_DEFAULT_CACHE_SIZE (1024 * 1024)
+
+/**
+ * \brief A lazy DFA state, which is a set of NFA program counters.
+ */
+typedef struct eroc_regex_dfa_state eroc_regex_dfa_state;
+
+struct eroc_regex_dfa_state
+{
+    /* offset and length of this state's sorted pc set in the set pool. */
+    uint32_t set;
+    uint32_t length;
+    uint32_t hash;
+    /* does this set contain a MATCH instruction? */
+    bool match;
+};
+
+/**
+ * \brief A lazily built DFA over a compiled NFA program.
+ *
+ * States and transitions are created on demand during a search and kept in a
+ * cache of fixed size, which is flushed when full. The cache persists across
+ * searches, so scanning many lines with one pattern quickly reaches a point
+ * where every transition is a table lookup.
+ *
+ * Input bytes are mapped to equivalence classes which no instruction in the
+ * program can tell apart, which keeps the transition tables small.
+ *
+ * A DFA only decides whether text matches; capture extraction falls back to a
+ * Pike VM for the same program.
+ */
+typedef struct eroc_regex_dfa eroc_regex_dfa;
+
+struct eroc_regex_dfa
+{
+    const eroc_regex_program* program;
+    eroc_regex_vm* vm;
+    /* byte to equivalence class, and a representative byte per class. */
+    uint8_t byte_classes[256];
+    uint8_t class_bytes[256];
+    size_t class_count;
+    /* state cache. */
+    eroc_regex_dfa_state* states;
+    size_t state_count;
+    size_t max_states;
+    /* max_states * class_count transitions; negative if not yet computed. */
+    int32_t* transitions;
+    /* pool of pc sets. */
+    uint32_t* sets;
+    size_t sets_used;
+    /* open addressed hash of states; 0 is empty, otherwise index + 1. */
+    uint32_t* table;
+    size_t table_size;
+    /* cached start state, or negative if not yet computed. */
+    int32_t start;
+    /* scratch memory for building pc sets. */
+    uint32_t* scratch;
+    uint32_t* stack;
+    unsigned int* marks;
+    unsigned int generation;
+    /* cache statistics. */
+    uint64_t hits;
+    uint64_t misses;
+    uint64_t flushes;
+};
+
+/**
+ * \brief The most literals that a prefilter will check for.
+ */
+#define EROC_REGEX_PREFILTER_MAX_LITERALS 8
+
+/**
+ * \brief The longest literal that a prefilter keeps; longer literals are
+ * truncated.
+ */
+#define EROC_REGEX_PREFILTER_MAX_LENGTH 32
+
+/**
+ * \brief Where the literals of a prefilter were found in the pattern.
+ */
+enum eroc_regex_prefilter_kind
+{
+    /* there are no required literals, so every text passes. */
+    EROC_REGEX_PREFILTER_NONE,
+    /* every match is one of the literals. */
+    EROC_REGEX_PREFILTER_EXACT,
+    /* every match starts with one of the literals. */
+    EROC_REGEX_PREFILTER_PREFIX,
+    /* every match ends with one of the literals. */
+    EROC_REGEX_PREFILTER_SUFFIX,
+    /* every match contains one of the literals. */
+    EROC_REGEX_PREFILTER_INNER,
+};
+
+/**
+ * \brief A prefilter is a set of literals, at least one of which appears in any
+ * text matched by a pattern, so that text containing none of them can be
+ * rejected without running the regex engine.
+ */
+typedef struct eroc_regex_prefilter eroc_regex_prefilter;
+
+struct eroc_regex_prefilter
+{
+    int kind;
+    size_t count;
+    size_t lengths[EROC_REGEX_PREFILTER_MAX_LITERALS];
+    char literals[EROC_REGEX_PREFILTER_MAX_LITERALS]
+                 [EROC_REGEX_PREFILTER_MAX_LENGTH];
+};
+
+/**
+ * \brief A compiled regular expression, ready for searching.
+ *
+ * A search first rejects text that lacks the literals required by the pattern,
+ * then runs the lazy DFA, and only runs the NFA when captures are needed.
+ */
+typedef struct eroc_regex eroc_regex;
+
+struct eroc_regex
+{
+    eroc_regex_ast_node* ast;
+    eroc_regex_program* program;
+    eroc_regex_dfa* dfa;
+    eroc_regex_prefilter prefilter;
+    /* number of searches, and number rejected by the prefilter. */
+    uint64_t searches;
+    uint64_t skipped;
+};
+
+/**
+ * \brief A substitution replaces matches of a regex with a replacement, in
+ * which & stands for the whole match, \1 through \9 stand for capture groups,
+ * and a backslash makes any other character literal.
+ *
+ * Results are built in a scratch buffer owned by the substitution, which is
+ * reused across calls and only grows, so substituting over many lines
+ * allocates only until the longest result fits.
+ */
+typedef struct eroc_regex_substitution eroc_regex_substitution;
+
+struct eroc_regex_substitution
+{
+    eroc_regex* regex;
+    char* replacement;
+    /* replace the nth match (1-based), and every later match if global. */
+    size_t occurrence;
+    bool global;
+    size_t* captures;
+    char* result;
+    size_t result_length;
+    size_t result_capacity;
+};
+
 /**
  * \brief Create an empty AST node.
  *
@@ -308,6 +550,228 @@ int eroc_regex_ast_char_class_member_add(eroc_regex_ast_node* ast, char ch);
 bool eroc_regex_ast_char_class_member_check(
     const eroc_regex_ast_node* ast, char ch);
 
+/**
+ * \brief Compile an AST into an NFA program.
+ *
+ * \note The AST remains owned by the caller.
+ *
+ * \param program       Pointer to the program pointer to be populated with the
+ *                      compiled program on success.
+ * \param ast           The AST to compile.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_program_compile(
+    eroc_regex_program** program, const eroc_regex_ast_node* ast);
+
+/**
+ * \brief Release a compiled NFA program.
+ *
+ * \param program       The program to release.
+ */
+void eroc_regex_program_release(eroc_regex_program* program);
+
+/**
+ * \brief Create a Pike VM for running the given program.
+ *
+ * \note The program remains owned by the caller, and must outlive the VM.
+ *
+ * \param vm            Pointer to the VM pointer to be populated with the VM on
+ *                      success.
+ * \param program       The program that this VM runs.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_vm_create(eroc_regex_vm** vm, const eroc_regex_program* program);
+
+/**
+ * \brief Release a Pike VM.
+ *
+ * \param vm            The VM to release.
+ */
+void eroc_regex_vm_release(eroc_regex_vm* vm);
+
+/**
+ * \brief Search the given text for the leftmost match of the VM's program.
+ *
+ * Among matches starting at the leftmost position, the one preferred by the
+ * pattern wins: alternation prefers its left side, and repetition is greedy.
+ *
+ * \param vm            The VM for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the match on success, or NULL. Groups
+ *                      which did not participate are set to
+ *                      \ref EROC_REGEX_UNSET.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_vm_search(
+    eroc_regex_vm* vm, size_t* captures, const char* text, size_t length);
+
+/**
+ * \brief Create a lazy DFA for the given program.
+ *
+ * \note The program remains owned by the caller, and must outlive the DFA.
+ *
+ * \param dfa           Pointer to the DFA pointer to be populated with the DFA
+ *                      on success.
+ * \param program       The program for this DFA.
+ * \param cache_size    The size of the state cache, in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_dfa_create(
+    eroc_regex_dfa** dfa, const eroc_regex_program* program,
+    size_t cache_size);
+
+/**
+ * \brief Release a lazy DFA.
+ *
+ * \param dfa           The DFA to release.
+ */
+void eroc_regex_dfa_release(eroc_regex_dfa* dfa);
+
+/**
+ * \brief Search the given text for a match of the DFA's program.
+ *
+ * \param dfa           The DFA for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the leftmost match on success, or NULL
+ *                      if only a yes or no answer is needed. Captures are
+ *                      extracted with the NFA, and only when the DFA has found
+ *                      a match.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_dfa_search(
+    eroc_regex_dfa* dfa, size_t* captures, const char* text, size_t length);
+
+/**
+ * \brief Extract the literals required by the given AST into a prefilter.
+ *
+ * Required prefix, suffix and inner literals are collected for every node,
+ * including small literal sets from alternations and char classes, and the
+ * most selective set found for the whole pattern is kept.
+ *
+ * \param prefilter     The prefilter to populate. Its kind is set to
+ *                      \ref EROC_REGEX_PREFILTER_NONE if the pattern has no
+ *                      useful required literals.
+ * \param ast           The AST to analyze.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_prefilter_extract(
+    eroc_regex_prefilter* prefilter, const eroc_regex_ast_node* ast);
+
+/**
+ * \brief Check whether the given text could match the pattern from which this
+ * prefilter was extracted.
+ *
+ * \param prefilter     The prefilter.
+ * \param text          The text to check, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns false if the text can't match, and true otherwise.
+ */
+bool eroc_regex_prefilter_check(
+    const eroc_regex_prefilter* prefilter, const char* text, size_t length);
+
+/**
+ * \brief Find the first occurrence of a literal in text.
+ *
+ * \param text          The text to search.
+ * \param length        The length of the text.
+ * \param literal       The literal to find.
+ * \param literal_length    The length of the literal, which must be at least
+ *                          one.
+ *
+ * \returns a pointer to the first occurrence, or NULL if not found.
+ */
+const char* eroc_regex_literal_find(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length);
+
+/**
+ * \brief Compile a pattern for searching.
+ *
+ * \param regex         Pointer to the regex pointer to be populated with the
+ *                      compiled regex on success.
+ * \param pattern       The pattern to compile.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_create(eroc_regex** regex, const char* pattern);
+
+/**
+ * \brief Release a compiled regex.
+ *
+ * \param regex         The regex to release.
+ */
+void eroc_regex_release(eroc_regex* regex);
+
+/**
+ * \brief Search the given text for a match of a compiled regex.
+ *
+ * \param regex         The regex for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the leftmost match on success, or NULL.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_search(
+    eroc_regex* regex, size_t* captures, const char* text, size_t length);
+
+/**
+ * \brief Compile a substitution.
+ *
+ * \param substitution  Pointer to the substitution pointer to be populated
+ *                      with the substitution on success.
+ * \param pattern       The pattern to match.
+ * \param replacement   The replacement for each match.
+ * \param occurrence    The 1-based index of the first match to replace, or 0
+ *                      for the first match.
+ * \param global        If true, replace every match from the given occurrence
+ *                      onward; otherwise, replace only that occurrence.
+ *
+ * \returns 0 on success and non-zero on failure, including a replacement
+ * which refers to a capture group that the pattern lacks.
+ */
+int eroc_regex_substitution_create(
+    eroc_regex_substitution** substitution, const char* pattern,
+    const char* replacement, size_t occurrence, bool global);
+
+/**
+ * \brief Release a substitution.
+ *
+ * \param substitution  The substitution to release.
+ */
+void eroc_regex_substitution_release(eroc_regex_substitution* substitution);
+
+/**
+ * \brief Apply a substitution to the given text.
+ *
+ * On success, the substituted text is in the substitution's result buffer,
+ * which is valid until the next call. If no replacement was made, the contents
+ * of the result buffer are unspecified.
+ *
+ * \param substitution  The substitution to apply.
+ * \param count         Set to the number of replacements made.
+ * \param text          The text to substitute, which need not be NUL
+ *                      terminated.
+ * \param length        The length of the text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_substitution_apply(
+    eroc_regex_substitution* substitution, size_t* count, const char* text,
+    size_t length);
+
 /* C++ compatibility. */
 # ifdef   __cplusplus
 }
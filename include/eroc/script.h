@@ -0,0 +1,112 @@
+/**
+ * \file eroc/script.h
+ *
+ * \brief Scripts of commands, parsed once and run against many buffers.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <stddef.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief A single command of a script.
+ */
+typedef struct eroc_script_command eroc_script_command;
+
+struct eroc_script_command
+{
+    eroc_command_template tmpl;
+    /* the text read by a, c or i, through its terminating . line, or NULL. */
+    const char* text;
+    size_t text_length;
+    /* the one-indexed script line on which this command appears. */
+    size_t line;
+};
+
+/**
+ * \brief A script is a sequence of command templates, which are resolved
+ * against a buffer only when they are run, so that a script is parsed once no
+ * matter how many buffers it runs against.
+ */
+typedef struct eroc_script eroc_script;
+
+struct eroc_script
+{
+    /* the script text, which the commands point into. */
+    char* text;
+    eroc_script_command* commands;
+    size_t count;
+};
+
+/**
+ * \brief Parse a script.
+ *
+ * Each line of the script is a command. The lines following an a, c or i
+ * command, through a line holding a single ., are the text for that command
+ * rather than commands.
+ *
+ * \param script            Pointer to the script pointer to be set to the
+ *                          parsed script on success.
+ * \param text              The script text, which is copied.
+ * \param length            The length of the script text.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that fails to parse, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_create(
+    eroc_script** script, const char* text, size_t length,
+    size_t* error_line);
+
+/**
+ * \brief Read and parse the script at the given path.
+ *
+ * \param script            Pointer to the script pointer to be set to the
+ *                          parsed script on success.
+ * \param path              The path of the script.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that fails to parse, or 0 if the script could not be
+ *                          read, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_load(
+    eroc_script** script, const char* path, size_t* error_line);
+
+/**
+ * \brief Release a script.
+ *
+ * \param script            The script to release.
+ */
+void eroc_script_release(eroc_script* script);
+
+/**
+ * \brief Run a script against a buffer.
+ *
+ * Commands run in order until one fails, or until one requests a quit. No
+ * commands are allocated or parsed while the script runs.
+ *
+ * \param script            The script to run.
+ * \param buffer            The buffer to run it against.
+ * \param error_line        Set to the one-indexed line of the command that
+ *                          failed, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_run(
+    const eroc_script* script, eroc_buffer* buffer, size_t* error_line);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
@@ -0,0 +1,154 @@
+/**
+ * \file eroc/stream.h
+ *
+ * \brief Run forward-only scripts over files one line at a time.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <eroc/regex.h>
+#include <eroc/script.h>
+#include <eroc/writer.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief The size of the chunks in which a stream reads its input. A longer
+ * line grows the chunk to fit.
+ */
+#define EROC_STREAM_CHUNK_SIZE (1024 * 1024)
+
+/**
+ * \brief What a stream stage does to a line.
+ */
+enum eroc_stream_stage_kind
+{
+    /* drop the line: g/re/d, v/re/d, or ,d. */
+    EROC_STREAM_STAGE_DELETE,
+    /* substitute on the line: ,s/re/repl/ or g/re/s/re/repl/. */
+    EROC_STREAM_STAGE_SUBSTITUTE,
+    /* print the line: ,p or g/re/p. */
+    EROC_STREAM_STAGE_PRINT,
+    /* write the line to the output file: w. */
+    EROC_STREAM_STAGE_WRITE,
+};
+
+/**
+ * \brief A stage of a stream is one script command, applied to each line in
+ * turn.
+ */
+typedef struct eroc_stream_stage eroc_stream_stage;
+
+struct eroc_stream_stage
+{
+    int kind;
+    /* the stage applies to lines that match this pattern, or that don't if
+     * invert is set, or to every line if it is NULL. */
+    eroc_regex* pattern;
+    bool invert;
+    eroc_regex_substitution* substitution;
+    /* the file named by w, or NULL for the name of the input. */
+    const char* path;
+    /* the number of lines that reached the stage. */
+    size_t reached;
+    /* the number of lines a substitution ran on, and how many it changed. */
+    size_t matched;
+    size_t changed;
+    /* the one-indexed script line of the command. */
+    size_t line;
+};
+
+/**
+ * \brief A stream runs a script whose commands only ever look at one line at a
+ * time, from first to last, so that a file can be processed in constant
+ * memory, however large it is.
+ *
+ * Each command becomes a stage. Each line read passes through the stages in
+ * script order, which gives the same result as running the commands one after
+ * another over a buffer holding the whole file. Whether a command fails, by
+ * running on an empty buffer or by substituting nothing, is only known once
+ * the whole file has been seen. The output of the commands before the first
+ * that failed then stands, and that of the rest is discarded: a print that
+ * follows a substitution is held back in a temporary file until then, as is
+ * every line written by w.
+ */
+typedef struct eroc_stream eroc_stream;
+
+struct eroc_stream
+{
+    eroc_stream_stage* stages;
+    size_t count;
+    char* chunk;
+    size_t chunk_size;
+    /* set if printed lines must wait for the end of the input. */
+    bool spool;
+};
+
+/**
+ * \brief Build a stream from a script.
+ *
+ * Only scripts that can run forward-only are accepted. A command may be
+ * s/re/repl/, p, or d over the whole file; g/re/cmd or v/re/cmd, where cmd is
+ * one of s, p, or d without an address; w; or a final q. At most one command
+ * may print, and at most one may write, since their output would otherwise be
+ * interleaved differently than when the script runs over a buffer. Anything
+ * else, such as a command on a particular line, or one that adds lines, needs
+ * random access.
+ *
+ * \param stream            Pointer to the stream pointer to be set to the
+ *                          created stream on success.
+ * \param script            The script, which must outlive the stream.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that can't be streamed, or to 0 if the stream could
+ *                          not be created, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_stream_create(
+    eroc_stream** stream, const eroc_script* script, size_t* error_line);
+
+/**
+ * \brief Release a stream.
+ *
+ * \param stream            The stream to release.
+ */
+void eroc_stream_release(eroc_stream* stream);
+
+/**
+ * \brief Run a stream over the input read from a file descriptor.
+ *
+ * Printed lines go to standard output as they are produced, unless a
+ * substitution comes before the print, in which case they are held back until
+ * the whole input has been processed. Lines written by w go to a temporary
+ * file, which replaces the target once the whole input has been processed. As
+ * when the script runs over a buffer, a command that fails stops the script
+ * there, so held back lines are printed, and the target is replaced, only if
+ * the print, or the w, comes before the first command that failed. A target
+ * that would have to be written in place, such as one with other hard links,
+ * can't be the input.
+ *
+ * \param stream            The stream to run.
+ * \param fd                The file descriptor to read from.
+ * \param name              The name of the input, which is the file that w
+ *                          writes to by default, or NULL.
+ * \param error_line        Set to the one-indexed line of the command that
+ *                          failed, or to 0 if reading or writing failed, on
+ *                          failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_stream_run(
+    eroc_stream* stream, int fd, const char* name, size_t* error_line);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
@@ -0,0 +1,95 @@
+/**
+ * \file eroc/threadpool.h
+ *
+ * \brief A small pool of worker threads for data parallel work.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief A task function runs one task of a batch on the given worker.
+ */
+typedef void (*eroc_thread_pool_task_fn)(
+    void* context, size_t worker, size_t task);
+
+/**
+ * \brief A thread pool runs batches of independent tasks across a fixed set of
+ * workers, which pull the next task from a shared counter until the batch is
+ * exhausted.
+ */
+typedef struct eroc_thread_pool eroc_thread_pool;
+
+struct eroc_thread_pool
+{
+    pthread_t* threads;
+    size_t thread_count;
+    pthread_mutex_t lock;
+    /* signaled when a batch starts or the pool shuts down. */
+    pthread_cond_t work;
+    /* signaled when the last task of a batch finishes. */
+    pthread_cond_t done;
+    /* the current batch. */
+    eroc_thread_pool_task_fn fn;
+    void* context;
+    size_t task_count;
+    size_t next_task;
+    size_t finished;
+    bool shutdown;
+};
+
+/**
+ * \brief Create a thread pool.
+ *
+ * \param pool          Pointer to the pool pointer to be set to the created
+ *                      pool on success.
+ * \param workers       The number of worker threads, or 0 for one per online
+ *                      CPU.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_thread_pool_create(eroc_thread_pool** pool, size_t workers);
+
+/**
+ * \brief Stop the workers and release a thread pool.
+ *
+ * \param pool          The pool to release.
+ */
+void eroc_thread_pool_release(eroc_thread_pool* pool);
+
+/**
+ * \brief Run a batch of tasks on the pool, returning once all have finished.
+ *
+ * \param pool          The pool.
+ * \param fn            The task function, which is called once for each task
+ *                      index in [0, task_count) along with the index of the
+ *                      worker running it.
+ * \param context       The context passed to each call.
+ * \param task_count    The number of tasks.
+ */
+void eroc_thread_pool_run(
+    eroc_thread_pool* pool, eroc_thread_pool_task_fn fn, void* context,
+    size_t task_count);
+
+/**
+ * \brief Get the number of online CPUs.
+ *
+ * \returns the number of online CPUs, which is at least one.
+ */
+size_t eroc_thread_pool_cpu_count(void);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
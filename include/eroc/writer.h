@@ -0,0 +1,165 @@
+/**
+ * \file eroc/writer.h
+ *
+ * \brief A writer gathers many small writes into a few large ones.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <sys/uio.h>
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+extern "C" {
+# endif /*__cplusplus*/
+
+/**
+ * \brief The size of a writer's staging buffer.
+ */
+#define EROC_WRITER_STAGE_SIZE (1024 * 1024)
+
+/**
+ * \brief Spans shorter than this are copied into the staging buffer; longer
+ * spans are written from where they are.
+ */
+#define EROC_WRITER_COPY_LIMIT 4096
+
+/**
+ * \brief The most spans that a writer gathers into one write.
+ */
+#define EROC_WRITER_IOV_MAX 256
+
+/**
+ * \brief A writer gathers spans into one writev call, copying short spans into
+ * a staging buffer so that a file of short lines is written in large blocks.
+ *
+ * Long spans are borrowed rather than copied, so they must stay valid until
+ * the writer is flushed.
+ */
+typedef struct eroc_writer eroc_writer;
+
+struct eroc_writer
+{
+    int fd;
+    char* stage;
+    size_t staged;
+    struct iovec iov[EROC_WRITER_IOV_MAX];
+    int iov_count;
+    size_t pending;
+    /* the number of bytes that have reached the file. */
+    size_t written;
+};
+
+/**
+ * \brief Create a writer for the given file descriptor.
+ *
+ * \param writer            Pointer to the writer pointer to be set to the
+ *                          created writer on success.
+ * \param fd                The file descriptor to write to, which the writer
+ *                          does not own.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_writer_create(eroc_writer** writer, int fd);
+
+/**
+ * \brief Release a writer, discarding anything that hasn't been flushed.
+ *
+ * \param writer            The writer to release.
+ */
+void eroc_writer_release(eroc_writer* writer);
+
+/**
+ * \brief Add a span to a writer.
+ *
+ * \param writer            The writer for this operation.
+ * \param data              The span to write.
+ * \param length            The length of the span.
+ *
+ * \returns 0 on success and non-zero if a write failed, in which case errno
+ * describes the failure.
+ */
+int eroc_writer_add(eroc_writer* writer, const void* data, size_t length);
+
+/**
+ * \brief Write everything that the writer has gathered.
+ *
+ * Short writes are resumed, and interrupted writes are retried.
+ *
+ * \param writer            The writer for this operation.
+ *
+ * \returns 0 on success and non-zero if a write failed, in which case errno
+ * describes the failure.
+ */
+int eroc_writer_flush(eroc_writer* writer);
+
+/**
+ * \brief A file that replaces its target atomically.
+ *
+ * The text is written to a temporary file next to the target, which is synced
+ * and renamed over the target on commit, so a failed write leaves the old file
+ * as it was. A target that isn't a regular file, such as a device, is written
+ * in place instead.
+ */
+typedef struct eroc_writer_file eroc_writer_file;
+
+struct eroc_writer_file
+{
+    int fd;
+    /* the target, with any symbolic link resolved. */
+    char* path;
+    /* the temporary file, or NULL if the target is written in place. */
+    char* temp;
+};
+
+/**
+ * \brief Open a file to replace the file at the given path.
+ *
+ * The new file keeps the permissions and the owner of the file that it
+ * replaces. A symbolic link is followed, even if the file it names doesn't
+ * exist yet. A file with other hard links, or whose owner can't be given to a
+ * new file, is written in place instead, so that the links and the owner
+ * survive, at the cost of the atomic replace. A file written in place is only
+ * cut to its new length when it is committed, so a caller whose data comes
+ * from the file can check \c fd against it before writing anything.
+ *
+ * \param file              Pointer to the file pointer to be set to the opened
+ *                          file on success.
+ * \param path              The path of the file to replace or create.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_writer_file_open(eroc_writer_file** file, const char* path);
+
+/**
+ * \brief Sync a file and move it into place, then release it.
+ *
+ * A regular file written in place is cut to the length written.
+ *
+ * \param file              The file to commit, which is released whether or
+ *                          not the commit succeeds.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure and the target is unchanged.
+ */
+int eroc_writer_file_commit(eroc_writer_file* file);
+
+/**
+ * \brief Discard a file, leaving its target unchanged, and release it.
+ *
+ * A target written in place has been changed by anything written to it, and
+ * is only closed.
+ *
+ * \param file              The file to discard.
+ */
+void eroc_writer_file_abort(eroc_writer_file* file);
+
+/* C++ compatibility. */
+# ifdef   __cplusplus
+}
+# endif /*__cplusplus*/
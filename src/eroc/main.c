@@ -9,13 +9,29 @@
 
 #include <eroc/command.h>
 #include <eroc/buffer.h>
+#include <eroc/script.h>
+#include <eroc/stream.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <unistd.h>
+
+/* output is fully buffered in blocks of this size when running a script. */
+#define SCRIPT_OUTPUT_BUFFER_SIZE (64 * 1024)
 
 eroc_buffer* global;
 
 static int repl(void);
 static int read_command(eroc_command** command, char** input_line, FILE* input);
+static int run_script(const char* path, int file_count, char* files[]);
+static int run_script_on_file(
+    const eroc_script* script, const char* script_path, const char* path);
+static int run_stream(const char* path, int file_count, char* files[]);
+static int run_stream_on_file(
+    eroc_stream* stream, const char* script_path, const char* path);
+static void usage(const char* name);
 
 /**
  * \brief Main entry point.
@@ -27,23 +43,94 @@ static int read_command(eroc_command** command, char** input_line, FILE* input);
  */
 int main(int argc, char* argv[])
 {
-    int retval;
-    /* TODO - parse options. */
+    int retval, ch;
+    const char* script = NULL;
+    bool stream = false;
+    bool lazy = false;
+    size_t undo_limit = EROC_BUFFER_JOURNAL_DEFAULT_LIMIT;
+    unsigned long megabytes;
+    char* end;
+
+    while (-1 != (ch = getopt(argc, argv, "ls:S:u:")))
+    {
+        switch (ch)
+        {
+            case 'l':
+                lazy = true;
+                break;
+
+            case 's':
+                script = optarg;
+                break;
+
+            case 'S':
+                script = optarg;
+                stream = true;
+                break;
+
+            case 'u':
+                /* the undo limit is given in megabytes. strtoul would accept
+                 * a sign and wrap a negative value around. */
+                megabytes = strtoul(optarg, &end, 10);
+                if (!isdigit((unsigned char)*optarg) || 0 != *end
+                 || megabytes > SIZE_MAX / (1024 * 1024))
+                {
+                    usage(argv[0]);
+                    return 1;
+                }
+
+                undo_limit = megabytes * 1024 * 1024;
+                break;
+
+            default:
+                usage(argv[0]);
+                return 1;
+        }
+    }
+
+    /* in stream mode, stream every file named through the script. */
+    if (stream)
+    {
+        return run_stream(script, argc - optind, argv + optind);
+    }
+
+    /* in script mode, run the script over every file named. */
+    if (NULL != script)
+    {
+        return run_script(script, argc - optind, argv + optind);
+    }
+
+    /* interactive mode edits at most one file. */
+    if (argc - optind > 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
 
     /* if a filename is specified, open it. */
-    if (argc > 1)
+    if (argc > optind)
     {
         size_t size = 0U;
-        retval = eroc_buffer_load(&global, &size, argv[1]);
+
+        /* a lazy open returns at once; a thread indexes the file. */
+        if (lazy)
+        {
+            retval = eroc_buffer_load_lazy(&global, &size, argv[optind]);
+        }
+        else
+        {
+            retval = eroc_buffer_load_mapped(&global, &size, argv[optind]);
+        }
+
         if (0 != retval)
         {
-            printf("Error loading %s.\n", argv[1]);
+            printf("Error loading %s.\n", argv[optind]);
             return 1;
         }
         else
         {
             printf("%zu\n", size);
-            retval = eroc_buffer_name_set(global, argv[1]);
+            retval = eroc_buffer_name_set(global, argv[optind]);
             if (0 != retval)
             {
                 return 2;
@@ -60,9 +147,287 @@ int main(int argc, char* argv[])
         }
     }
 
+    /* only interactive edits can be undone; a limit of 0 turns undo off. */
+    if (undo_limit > 0)
+    {
+        retval = eroc_buffer_journal_create(global, undo_limit);
+        if (0 != retval)
+        {
+            printf("Error creating undo journal.\n");
+            return 1;
+        }
+    }
+
     return repl();
 }
 
+/**
+ * \brief Print usage information.
+ *
+ * \param name          The name of this program.
+ */
+static void usage(const char* name)
+{
+    fprintf(stderr, "Usage: %s [-l] [-u undo-limit-mb] [file]\n", name);
+    fprintf(stderr, "       %s -s script [file ...]\n", name);
+    fprintf(stderr, "       %s -S script [file ...]\n", name);
+}
+
+/**
+ * \brief Parse a script once, then run it over each of the given files, or over
+ * an empty buffer if no files are given.
+ *
+ * Diagnostics, such as byte counts and ?, are suppressed, and output is fully
+ * buffered. A failing command stops the script for that file only.
+ *
+ * \param path          The path of the script.
+ * \param file_count    The number of files.
+ * \param files         The files.
+ *
+ * \returns 0 if the script ran successfully over every file and non-zero
+ * otherwise.
+ */
+static int run_script(const char* path, int file_count, char* files[])
+{
+    int retval;
+    size_t error_line;
+    eroc_script* script;
+
+    retval = eroc_script_load(&script, path, &error_line);
+    if (0 != retval)
+    {
+        if (error_line > 0)
+        {
+            fprintf(stderr, "%s:%zu: invalid command.\n", path, error_line);
+        }
+        else
+        {
+            fprintf(stderr, "Error loading %s.\n", path);
+        }
+
+        return 1;
+    }
+
+    setvbuf(stdout, NULL, _IOFBF, SCRIPT_OUTPUT_BUFFER_SIZE);
+
+    if (0 == file_count)
+    {
+        retval = run_script_on_file(script, path, NULL);
+    }
+    else
+    {
+        retval = 0;
+        for (int i = 0; i < file_count; ++i)
+        {
+            if (0 != run_script_on_file(script, path, files[i]))
+            {
+                retval = 1;
+            }
+        }
+    }
+
+    eroc_script_release(script);
+
+    return retval;
+}
+
+/**
+ * \brief Run a script over a single file, reporting any failure.
+ *
+ * \param script        The script to run.
+ * \param script_path   The path of the script, for error messages.
+ * \param path          The file to load, or NULL for an empty buffer.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int run_script_on_file(
+    const eroc_script* script, const char* script_path, const char* path)
+{
+    int retval;
+    size_t size, error_line;
+    eroc_buffer* buffer;
+
+    if (NULL == path)
+    {
+        retval = eroc_buffer_create(&buffer);
+    }
+    else
+    {
+        retval = eroc_buffer_load_mapped(&buffer, &size, path);
+    }
+
+    if (0 != retval)
+    {
+        if (NULL != path)
+        {
+            fprintf(stderr, "Error loading %s.\n", path);
+        }
+        else
+        {
+            fprintf(stderr, "Error creating buffer.\n");
+        }
+
+        return retval;
+    }
+
+    if (NULL != path)
+    {
+        retval = eroc_buffer_name_set(buffer, path);
+        if (0 != retval)
+        {
+            goto cleanup_buffer;
+        }
+    }
+
+    buffer->flags |= EROC_BUFFER_FLAG_QUIET;
+
+    retval = eroc_script_run(script, buffer, &error_line);
+    if (0 != retval)
+    {
+        fprintf(
+            stderr, "%s:%zu: command failed on %s.\n", script_path, error_line,
+            (NULL != path) ? path : "an empty buffer");
+    }
+
+cleanup_buffer:
+    eroc_buffer_release(buffer);
+
+    return retval;
+}
+
+/**
+ * \brief Parse a script that can run forward-only, then stream each of the
+ * given files through it, or standard input if no files are given.
+ *
+ * Files are read in chunks and never loaded whole, so their size isn't limited
+ * by memory. A script that needs random access is refused before any file is
+ * read.
+ *
+ * \param path          The path of the script.
+ * \param file_count    The number of files.
+ * \param files         The files.
+ *
+ * \returns 0 if the script ran successfully over every file and non-zero
+ * otherwise.
+ */
+static int run_stream(const char* path, int file_count, char* files[])
+{
+    int retval;
+    size_t error_line;
+    eroc_script* script;
+    eroc_stream* stream;
+
+    retval = eroc_script_load(&script, path, &error_line);
+    if (0 != retval)
+    {
+        if (error_line > 0)
+        {
+            fprintf(stderr, "%s:%zu: invalid command.\n", path, error_line);
+        }
+        else
+        {
+            fprintf(stderr, "Error loading %s.\n", path);
+        }
+
+        return 1;
+    }
+
+    retval = eroc_stream_create(&stream, script, &error_line);
+    if (0 != retval)
+    {
+        if (error_line > 0)
+        {
+            fprintf(
+                stderr,
+                "%s:%zu: command can't be streamed.\n",
+                path, error_line);
+        }
+        else
+        {
+            fprintf(stderr, "Error creating stream.\n");
+        }
+
+        retval = 1;
+        goto cleanup_script;
+    }
+
+    setvbuf(stdout, NULL, _IOFBF, SCRIPT_OUTPUT_BUFFER_SIZE);
+
+    if (0 == file_count)
+    {
+        retval = run_stream_on_file(stream, path, NULL);
+    }
+    else
+    {
+        retval = 0;
+        for (int i = 0; i < file_count; ++i)
+        {
+            if (0 != run_stream_on_file(stream, path, files[i]))
+            {
+                retval = 1;
+            }
+        }
+    }
+
+    eroc_stream_release(stream);
+
+cleanup_script:
+    eroc_script_release(script);
+
+    return retval;
+}
+
+/**
+ * \brief Stream a single file through a script.
+ *
+ * \param stream        The stream to run.
+ * \param script_path   The path of the script, for diagnostics.
+ * \param path          The file to read, or NULL for standard input.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int run_stream_on_file(
+    eroc_stream* stream, const char* script_path, const char* path)
+{
+    int retval;
+    size_t error_line;
+    int fd = STDIN_FILENO;
+
+    if (NULL != path)
+    {
+        fd = open(path, O_RDONLY);
+        if (fd < 0)
+        {
+            fprintf(stderr, "Error opening %s.\n", path);
+            return 1;
+        }
+    }
+
+    retval = eroc_stream_run(stream, fd, path, &error_line);
+    if (0 != retval)
+    {
+        if (error_line > 0)
+        {
+            fprintf(
+                stderr, "%s:%zu: command failed on %s.\n", script_path,
+                error_line, (NULL != path) ? path : "standard input");
+        }
+        else
+        {
+            fprintf(
+                stderr, "Error streaming %s.\n",
+                (NULL != path) ? path : "standard input");
+        }
+    }
+
+    if (NULL != path)
+    {
+        (void)close(fd);
+    }
+
+    return retval;
+}
+
 /**
  * \brief Read-Eval-Print loop for eroc.
  *
@@ -104,6 +469,9 @@ static int repl(void)
             goto reset;
         }
 
+        /* each command is undone as a whole. */
+        eroc_buffer_journal_checkpoint(global);
+
         /* evaluate the command. */
         retval = eroc_command_run(command);
         if (0 != retval)
@@ -0,0 +1,102 @@
+/**
+ * \file lib/eroc_arena_alloc.c
+ *
+ * \brief Allocate memory from an arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/arena.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+/* forward decls. */
+static void* block_alloc(
+    eroc_arena_block* block, size_t size, size_t alignment);
+
+/**
+ * \brief Allocate memory from an arena.
+ *
+ * Requests larger than a quarter of the block size get a block of their own, so
+ * that they don't waste the rest of the current block.
+ *
+ * \param arena             The arena for this allocation.
+ * \param size              The number of bytes to allocate.
+ * \param alignment         The alignment of the allocation, which must be a
+ *                          power of two.
+ *
+ * \returns the allocation, or NULL on failure.
+ */
+void* eroc_arena_alloc(eroc_arena* arena, size_t size, size_t alignment)
+{
+    eroc_arena_block* block;
+    size_t block_size = arena->block_size;
+    void* ptr;
+
+    /* the common case: bump the pointer in the current block. */
+    if (NULL != arena->blocks)
+    {
+        ptr = block_alloc(arena->blocks, size, alignment);
+        if (NULL != ptr)
+        {
+            return ptr;
+        }
+    }
+
+    /* large requests get a block of their own. */
+    if (size + alignment > block_size / 4)
+    {
+        block_size = size + alignment;
+    }
+
+    block = (eroc_arena_block*)malloc(sizeof(*block) + block_size);
+    if (NULL == block)
+    {
+        return NULL;
+    }
+
+    block->size = block_size;
+    block->used = 0;
+    arena->reserved += block_size;
+
+    /* a dedicated block goes behind the current block, which keeps filling. */
+    if (block_size != arena->block_size && NULL != arena->blocks)
+    {
+        block->next = arena->blocks->next;
+        arena->blocks->next = block;
+    }
+    else
+    {
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    return block_alloc(block, size, alignment);
+}
+
+/**
+ * \brief Allocate from the given block, if there is room.
+ *
+ * \param block             The block.
+ * \param size              The number of bytes to allocate.
+ * \param alignment         The alignment of the allocation.
+ *
+ * \returns the allocation, or NULL if the block is full.
+ */
+static void* block_alloc(
+    eroc_arena_block* block, size_t size, size_t alignment)
+{
+    char* data = (char*)(block + 1);
+    uintptr_t start = (uintptr_t)(data + block->used);
+    size_t padding = (alignment - (start & (alignment - 1))) & (alignment - 1);
+
+    if (padding + size > block->size - block->used)
+    {
+        return NULL;
+    }
+
+    block->used += padding + size;
+
+    return (void*)(start + padding);
+}
@@ -0,0 +1,41 @@
+/**
+ * \file lib/eroc_arena_create.c
+ *
+ * \brief Create an arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/arena.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create an arena.
+ *
+ * \param arena             Pointer to the arena pointer to be set to the
+ *                          created arena on success.
+ * \param block_size        The size of each block, or 0 for
+ *                          \ref EROC_ARENA_DEFAULT_BLOCK_SIZE.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_arena_create(eroc_arena** arena, size_t block_size)
+{
+    eroc_arena* tmp;
+
+    tmp = (eroc_arena*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    /* blocks are allocated on first use. */
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->block_size =
+        (0 == block_size) ? EROC_ARENA_DEFAULT_BLOCK_SIZE : block_size;
+
+    *arena = tmp;
+    return 0;
+}
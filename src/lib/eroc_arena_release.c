@@ -0,0 +1,30 @@
+/**
+ * \file lib/eroc_arena_release.c
+ *
+ * \brief Release an arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/arena.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release an arena and every allocation made from it.
+ *
+ * \param arena             The arena to release.
+ */
+void eroc_arena_release(eroc_arena* arena)
+{
+    eroc_arena_block* block = arena->blocks;
+
+    while (NULL != block)
+    {
+        eroc_arena_block* next = block->next;
+        free(block);
+        block = next;
+    }
+
+    free(arena);
+}
@@ -0,0 +1,103 @@
+/**
+ * \file lib/eroc_avl_tree_build.c
+ *
+ * \brief Build a balanced AVL tree from nodes given in order.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/* forward decls. */
+static eroc_avl_tree_node* subtree_build(
+    eroc_avl_tree* tree, size_t count, eroc_avl_tree_next_fn next_fn,
+    void* context);
+
+/**
+ * \brief Build a balanced AVL tree from nodes given in order.
+ *
+ * The nodes are taken one at a time from \p next_fn, in in-order position, and
+ * linked into a tree whose left and right subtrees differ in size by at most
+ * one at every node. No keys are compared, so the caller is responsible for
+ * giving the nodes in key order if the tree is keyed. This is O(n) time, and
+ * the recursion is only O(log n) deep.
+ *
+ * \param tree          The tree for this operation, which must be empty.
+ * \param count         The number of nodes.
+ * \param next_fn       Function that returns the next node.
+ * \param context       The context passed to \p next_fn.
+ *
+ * \returns 0 on success and non-zero if the tree isn't empty.
+ */
+int eroc_avl_tree_build(
+    eroc_avl_tree* tree, size_t count, eroc_avl_tree_next_fn next_fn,
+    void* context)
+{
+    if (NULL != tree->root)
+    {
+        return 1;
+    }
+
+    tree->root = subtree_build(tree, count, next_fn, context);
+    tree->count = count;
+
+    if (NULL != tree->root)
+    {
+        tree->root->parent = NULL;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Build a balanced subtree of the next count nodes.
+ *
+ * \param tree          The tree for this operation.
+ * \param count         The number of nodes in the subtree.
+ * \param next_fn       Function that returns the next node.
+ * \param context       The context passed to \p next_fn.
+ *
+ * \returns the root of the subtree, whose parent the caller sets, or NULL if
+ * the count is 0.
+ */
+static eroc_avl_tree_node* subtree_build(
+    eroc_avl_tree* tree, size_t count, eroc_avl_tree_next_fn next_fn,
+    void* context)
+{
+    eroc_avl_tree_node* left;
+    eroc_avl_tree_node* root;
+
+    if (0 == count)
+    {
+        return NULL;
+    }
+
+    /* the left subtree comes first in order, then the root, then the rest. */
+    left = subtree_build(tree, (count - 1) / 2, next_fn, context);
+    root = next_fn(context);
+    root->left = left;
+    root->right =
+        subtree_build(tree, count - 1 - (count - 1) / 2, next_fn, context);
+
+    if (NULL != root->left)
+    {
+        root->left->parent = root;
+    }
+
+    if (NULL != root->right)
+    {
+        root->right->parent = root;
+    }
+
+    /* the right subtree is never smaller, so it is never shorter. */
+    root->height = (NULL != root->right) ? root->right->height + 1 : 1;
+    root->count = count;
+
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, root);
+    }
+
+    return root;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file lib/eroc_avl_tree_build_sorted.c
+ *
+ * \brief Build a balanced AVL tree from an array of nodes in order.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/* forward decls. */
+static eroc_avl_tree_node* array_next(void* context);
+
+/**
+ * \brief Build a balanced AVL tree from an array of nodes in order.
+ *
+ * \param tree          The tree for this operation, which must be empty.
+ * \param nodes         The nodes, in in-order position.
+ * \param count         The number of nodes.
+ *
+ * \returns 0 on success and non-zero if the tree isn't empty.
+ */
+int eroc_avl_tree_build_sorted(
+    eroc_avl_tree* tree, eroc_avl_tree_node** nodes, size_t count)
+{
+    eroc_avl_tree_node** cursor = nodes;
+
+    return eroc_avl_tree_build(tree, count, &array_next, &cursor);
+}
+
+/**
+ * \brief Return the next node of the array.
+ *
+ * \param context       Pointer to the array cursor, which is advanced.
+ *
+ * \returns the next node.
+ */
+static eroc_avl_tree_node* array_next(void* context)
+{
+    eroc_avl_tree_node*** cursor = (eroc_avl_tree_node***)context;
+
+    return *(*cursor)++;
+}
@@ -0,0 +1,22 @@
+/**
+ * \file lib/eroc_avl_tree_bulk_release_set.c
+ *
+ * \brief Set the function that releases all of the nodes of a tree at once.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Set the function that releases all of the nodes of a tree at once.
+ *
+ * \param tree          The tree for this operation.
+ * \param bulk_release_fn   The function, or NULL to release nodes one by one.
+ */
+void eroc_avl_tree_bulk_release_set(
+    eroc_avl_tree* tree, eroc_avl_tree_bulk_release_fn bulk_release_fn)
+{
+    tree->bulk_release_fn = bulk_release_fn;
+}
@@ -12,6 +12,9 @@
 /**
  * \brief Clear all nodes in an AVL tree, and set the count to 0.
  *
+ * A tree with a bulk release function hands it the root instead of releasing
+ * the nodes one by one.
+ *
  * \param tree          The tree instance to clear.
  *
  * \returns 0 on success and non-zero on failure.
@@ -20,10 +23,18 @@ int eroc_avl_tree_clear(eroc_avl_tree* tree)
 {
     int retval = 0;
 
-    /* delete all nodes in the tree if the tree is not empty. */
+    /* delete all nodes in the tree if the tree is not empty, at once if the
+     * tree can. */
     if (NULL != tree->root)
     {
-        retval = eroc_avl_tree_delete_nodes(tree, tree->root);
+        if (NULL != tree->bulk_release_fn)
+        {
+            retval = tree->bulk_release_fn(tree->context, tree->root);
+        }
+        else
+        {
+            retval = eroc_avl_tree_delete_nodes(tree, tree->root);
+        }
     }
 
     /* now the tree is empty. */
@@ -0,0 +1,33 @@
+/**
+ * \file lib/eroc_avl_tree_concat.c
+ *
+ * \brief Append every node of one AVL tree to another.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Append every node of one AVL tree to another.
+ *
+ * The first node of \p other is removed and used to join the trees, so this is
+ * O(log n) time. See \ref eroc_avl_tree_join.
+ *
+ * \param tree          The tree that comes first, which receives the result.
+ * \param other         The tree that comes last, which is left empty.
+ */
+void eroc_avl_tree_concat(eroc_avl_tree* tree, eroc_avl_tree* other)
+{
+    eroc_avl_tree_node* node;
+
+    if (NULL == other->root)
+    {
+        return;
+    }
+
+    node = eroc_avl_tree_minimum_node(other, other->root);
+    eroc_avl_tree_remove_node(other, node);
+    eroc_avl_tree_join(tree, node, other);
+}
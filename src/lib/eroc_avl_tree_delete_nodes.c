@@ -1,7 +1,7 @@
 /**
  * \file lib/eroc_avl_tree_delete_nodes.c
  *
- * \brief Recursively release all nodes under a given node as well as this node.
+ * \brief Release all nodes under a given node as well as this node.
  *
  * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
  * distribution for the license terms under which this software is distributed.
@@ -10,11 +10,17 @@
 #include <eroc/avltree.h>
 
 /**
- * \brief Recursively release all nodes under a given node as well as this node
- * in a tree.
+ * \brief Release all nodes under a given node as well as this node in a tree.
+ *
+ * The subtree is torn down in order without recursion or a stack: while the
+ * current node has a left child, a right rotation lifts that child above it;
+ * once it has none, it is released and its right child becomes current. Each
+ * node is rotated at most once, so this is O(n) time and O(1) space however
+ * deep the tree is. The links of the subtree are destroyed along the way, so
+ * the caller must detach it from the rest of the tree first.
  *
  * \param tree          The tree instance for this delete operation.
- * \param node          The node to recursively delete.
+ * \param node          The root of the subtree to delete.
  *
  * \returns 0 on success and non-zero on failure.
  */
@@ -22,32 +28,30 @@ int eroc_avl_tree_delete_nodes(eroc_avl_tree* tree, eroc_avl_tree_node* node)
 {
     int retval = 0;
     int release_retval;
+    eroc_avl_tree_node* next;
 
-    /* recursively delete the left branch. */
-    if (NULL != node->left)
+    while (NULL != node)
     {
-        release_retval = eroc_avl_tree_delete_nodes(tree, node->left);
-        if (0 != release_retval)
+        if (NULL != node->left)
         {
-            retval = release_retval;
+            /* rotate the left child up; only left and right links matter. */
+            next = node->left;
+            node->left = next->right;
+            next->right = node;
+            node = next;
         }
-    }
-
-    /* recursively delete the right branch. */
-    if (NULL != node->right)
-    {
-        release_retval = eroc_avl_tree_delete_nodes(tree, node->right);
-        if (0 != release_retval)
+        else
         {
-            retval = release_retval;
-        }
-    }
+            /* nothing is left of this node, so release it and move on. */
+            next = node->right;
+            release_retval = tree->release_fn(tree->context, node);
+            if (0 != release_retval)
+            {
+                retval = release_retval;
+            }
 
-    /* release this node. */
-    release_retval = tree->release_fn(tree->context, node);
-    if (0 != release_retval)
-    {
-        retval = release_retval;
+            node = next;
+        }
     }
 
     /* return decoded return value. */
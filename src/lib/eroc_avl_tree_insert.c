@@ -28,13 +28,19 @@ static inline int max(int lhs, int rhs)
  */
 void eroc_avl_tree_insert(eroc_avl_tree* tree, eroc_avl_tree_node* node)
 {
-    /* make sure the node starts off as an orphan. */
+    /* make sure the node starts off as an orphan leaf. */
     node->left = node->right = node->parent = NULL;
+    node->height = 1;
+    node->count = 1;
+
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, node);
+    }
 
     /* edge case: insert this node into root if root is NULL. */
     if (NULL == tree->root)
     {
-        node->height = 1;
         tree->root = node;
     }
     else
@@ -75,7 +81,6 @@ static void insert_tree_node(
         {
             root->left = node;
             node->parent = root;
-            node->height = 1;
         }
         else
         {
@@ -88,7 +93,6 @@ static void insert_tree_node(
         {
             root->right = node;
             node->parent = root;
-            node->height = 1;
         }
         else
         {
@@ -100,6 +104,14 @@ static void insert_tree_node(
     int left_height = root->left ? root->left->height : 0;
     int right_height = root->right ? root->right->height : 0;
     root->height = max(left_height, right_height) + 1;
+    root->count =
+        1 + (root->left ? root->left->count : 0)
+          + (root->right ? root->right->count : 0);
+
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, root);
+    }
 
     /* compute the balance factor. */
     *bf = left_height - right_height;
@@ -109,12 +121,12 @@ static void insert_tree_node(
     {
         if (child_bf < 0)
         {
-            eroc_avl_tree_rotate_left(&root->left);
-            eroc_avl_tree_rotate_right(&root);
+            eroc_avl_tree_rotate_left(tree, &root->left);
+            eroc_avl_tree_rotate_right(tree, &root);
         }
         else
         {
-            eroc_avl_tree_rotate_right(&root);
+            eroc_avl_tree_rotate_right(tree, &root);
         }
     }
     /* is the tree right-heavy? */
@@ -122,12 +134,12 @@ static void insert_tree_node(
     {
         if (child_bf > 0)
         {
-            eroc_avl_tree_rotate_right(&root->right);
-            eroc_avl_tree_rotate_left(&root);
+            eroc_avl_tree_rotate_right(tree, &root->right);
+            eroc_avl_tree_rotate_left(tree, &root);
         }
         else
         {
-            eroc_avl_tree_rotate_left(&root);
+            eroc_avl_tree_rotate_left(tree, &root);
         }
     }
 
@@ -0,0 +1,70 @@
+/**
+ * \file lib/eroc_avl_tree_insert_after.c
+ *
+ * \brief Insert a node into the AVL tree after a given node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Insert a node into the AVL tree instance immediately after the given
+ * node in in-order position, ignoring keys.
+ *
+ * \note The AVL tree takes ownership of this node. Positional insertion is
+ * meant for trees that are ordered by position rather than by key, such as a
+ * line index. Mixing positional and keyed insertion in the same tree is only
+ * valid if the caller preserves key order.
+ *
+ * \param tree          The tree instance for this insert operation.
+ * \param after         The node after which this node is inserted, or NULL if
+ *                      this node should be inserted at the end of the tree.
+ * \param node          The node to insert.
+ */
+void eroc_avl_tree_insert_after(
+    eroc_avl_tree* tree, eroc_avl_tree_node* after, eroc_avl_tree_node* node)
+{
+    /* make sure the node starts off as an orphan leaf. */
+    node->left = node->right = node->parent = NULL;
+    node->height = 1;
+    node->count = 1;
+
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, node);
+    }
+
+    tree->count += 1;
+
+    /* edge case: insert this node into root if root is NULL. */
+    if (NULL == tree->root)
+    {
+        tree->root = node;
+        return;
+    }
+
+    /* appending to the end of the tree. */
+    if (NULL == after)
+    {
+        after = eroc_avl_tree_maximum_node(tree, tree->root);
+    }
+
+    /* the successor position is either after's right child... */
+    if (NULL == after->right)
+    {
+        after->right = node;
+    }
+    /* ...or the left child of the minimum node of after's right subtree. */
+    else
+    {
+        after = eroc_avl_tree_minimum_node(tree, after->right);
+        after->left = node;
+    }
+
+    node->parent = after;
+
+    /* restore heights, counts, and balance up to the root. */
+    eroc_avl_tree_rebalance(tree, after);
+}
@@ -0,0 +1,69 @@
+/**
+ * \file lib/eroc_avl_tree_insert_before.c
+ *
+ * \brief Insert a node into the AVL tree before a given node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Insert a node into the AVL tree instance immediately before the given
+ * node in in-order position, ignoring keys.
+ *
+ * \note The AVL tree takes ownership of this node. See
+ * \ref eroc_avl_tree_insert_after for restrictions on positional insertion.
+ *
+ * \param tree          The tree instance for this insert operation.
+ * \param before        The node before which this node is inserted, or NULL if
+ *                      this node should be inserted at the beginning of the
+ *                      tree.
+ * \param node          The node to insert.
+ */
+void eroc_avl_tree_insert_before(
+    eroc_avl_tree* tree, eroc_avl_tree_node* before, eroc_avl_tree_node* node)
+{
+    /* make sure the node starts off as an orphan leaf. */
+    node->left = node->right = node->parent = NULL;
+    node->height = 1;
+    node->count = 1;
+
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, node);
+    }
+
+    tree->count += 1;
+
+    /* edge case: insert this node into root if root is NULL. */
+    if (NULL == tree->root)
+    {
+        tree->root = node;
+        return;
+    }
+
+    /* inserting at the beginning of the tree. */
+    if (NULL == before)
+    {
+        before = eroc_avl_tree_minimum_node(tree, tree->root);
+    }
+
+    /* the predecessor position is either before's left child... */
+    if (NULL == before->left)
+    {
+        before->left = node;
+    }
+    /* ...or the right child of the maximum node of before's left subtree. */
+    else
+    {
+        before = eroc_avl_tree_maximum_node(tree, before->left);
+        before->right = node;
+    }
+
+    node->parent = before;
+
+    /* restore heights, counts, and balance up to the root. */
+    eroc_avl_tree_rebalance(tree, before);
+}
@@ -0,0 +1,90 @@
+/**
+ * \file lib/eroc_avl_tree_join.c
+ *
+ * \brief Join two AVL trees around a node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Join two AVL trees around a node.
+ *
+ * Every node of \p tree comes before \p node, which comes before every node of
+ * \p other. The node is linked in where the shorter tree meets the spine of
+ * the taller one, so this is O(1 + |h(tree) - h(other)|) time. No keys are
+ * compared, so the caller is responsible for the order if the trees are keyed.
+ *
+ * \note The AVL tree takes ownership of this node.
+ *
+ * \param tree          The tree that comes first, which receives the result.
+ * \param node          The node that goes between the trees.
+ * \param other         The tree that comes last, which is left empty.
+ */
+void eroc_avl_tree_join(
+    eroc_avl_tree* tree, eroc_avl_tree_node* node, eroc_avl_tree* other)
+{
+    eroc_avl_tree_node* left = tree->root;
+    eroc_avl_tree_node* right = other->root;
+    int left_height = left ? left->height : 0;
+    int right_height = right ? right->height : 0;
+    eroc_avl_tree_node* parent = NULL;
+
+    tree->count += 1 + other->count;
+    other->root = NULL;
+    other->count = 0;
+
+    /* walk down the right spine of a taller left tree. */
+    if (left_height > right_height + 1)
+    {
+        while (NULL != left && left->height > right_height + 1)
+        {
+            parent = left;
+            left = left->right;
+        }
+    }
+    /* walk down the left spine of a taller right tree. */
+    else if (right_height > left_height + 1)
+    {
+        tree->root = right;
+        while (NULL != right && right->height > left_height + 1)
+        {
+            parent = right;
+            right = right->left;
+        }
+    }
+
+    /* the node joins two subtrees whose heights differ by at most one. */
+    node->parent = parent;
+    node->left = left;
+    node->right = right;
+
+    if (NULL != left)
+    {
+        left->parent = node;
+    }
+
+    if (NULL != right)
+    {
+        right->parent = node;
+    }
+
+    /* the node takes the place of the subtree the walk stopped at. */
+    if (NULL == parent)
+    {
+        tree->root = node;
+    }
+    else if (left_height > right_height + 1)
+    {
+        parent->right = node;
+    }
+    else
+    {
+        parent->left = node;
+    }
+
+    /* only the spine above the node grew. */
+    eroc_avl_tree_rebalance(tree, node);
+}
@@ -0,0 +1,147 @@
+/**
+ * \file lib/eroc_avl_tree_merge.c
+ *
+ * \brief Move every node of one keyed AVL tree into another in linear time.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/* forward decls. */
+static eroc_avl_tree_node* vine_create(eroc_avl_tree_node* root);
+static eroc_avl_tree_node* vine_merge(
+    eroc_avl_tree* tree, eroc_avl_tree_node* left, eroc_avl_tree_node* right);
+static eroc_avl_tree_node* vine_next(void* context);
+
+/**
+ * \brief Move every node of one keyed AVL tree into another in linear time.
+ *
+ * Both trees are flattened in place into chains linked through their right
+ * pointers, the chains are merged by key, and the tree is rebuilt balanced
+ * from the merged chain. This is O(n + m) time and O(log(n + m)) space, where
+ * inserting the nodes one at a time would be O(m log(n + m)). Nodes with equal
+ * keys are all kept, with those already in \p tree first.
+ *
+ * \param tree          The tree to merge into, whose compare and key functions
+ *                      order the result.
+ * \param other         The tree to merge from, which is left empty. It must be
+ *                      ordered by the same keys.
+ */
+void eroc_avl_tree_merge(eroc_avl_tree* tree, eroc_avl_tree* other)
+{
+    size_t count = tree->count + other->count;
+    eroc_avl_tree_node* chain;
+
+    chain =
+        vine_merge(tree, vine_create(tree->root), vine_create(other->root));
+
+    tree->root = NULL;
+    tree->count = 0;
+    other->root = NULL;
+    other->count = 0;
+
+    (void)eroc_avl_tree_build(tree, count, &vine_next, &chain);
+}
+
+/**
+ * \brief Flatten a subtree in place into a chain of its nodes, in order,
+ * linked through their right pointers.
+ *
+ * While the head of the rest of the subtree has a left child, a right rotation
+ * lifts that child into its place; once it has none, it joins the chain.
+ *
+ * \param root          The root of the subtree, or NULL.
+ *
+ * \returns the first node of the chain, or NULL if the subtree is empty.
+ */
+static eroc_avl_tree_node* vine_create(eroc_avl_tree_node* root)
+{
+    eroc_avl_tree_node head = { 0 };
+    eroc_avl_tree_node* tail = &head;
+    eroc_avl_tree_node* rest = root;
+    eroc_avl_tree_node* next;
+
+    head.right = root;
+
+    while (NULL != rest)
+    {
+        if (NULL == rest->left)
+        {
+            tail = rest;
+            rest = rest->right;
+        }
+        else
+        {
+            next = rest->left;
+            rest->left = next->right;
+            next->right = rest;
+            rest = next;
+            tail->right = next;
+        }
+    }
+
+    return head.right;
+}
+
+/**
+ * \brief Merge two chains of nodes by key.
+ *
+ * \param tree          The tree whose compare and key functions are used.
+ * \param left          The first chain, whose nodes win ties.
+ * \param right         The second chain.
+ *
+ * \returns the first node of the merged chain.
+ */
+static eroc_avl_tree_node* vine_merge(
+    eroc_avl_tree* tree, eroc_avl_tree_node* left, eroc_avl_tree_node* right)
+{
+    eroc_avl_tree_node head = { 0 };
+    eroc_avl_tree_node* tail = &head;
+
+    while (NULL != left && NULL != right)
+    {
+        int compare =
+            tree->compare_fn(
+                tree->context, tree->key_fn(tree->context, left),
+                tree->key_fn(tree->context, right));
+
+        if (compare <= 0)
+        {
+            tail->right = left;
+            tail = left;
+            left = left->right;
+        }
+        else
+        {
+            tail->right = right;
+            tail = right;
+            right = right->right;
+        }
+    }
+
+    tail->right = (NULL != left) ? left : right;
+
+    return head.right;
+}
+
+/**
+ * \brief Take the next node from a chain.
+ *
+ * The chain is advanced before the node is returned, since the build then
+ * overwrites its right pointer.
+ *
+ * \param context       Pointer to the head of the chain, which is advanced.
+ *
+ * \returns the next node.
+ */
+static eroc_avl_tree_node* vine_next(void* context)
+{
+    eroc_avl_tree_node** chain = (eroc_avl_tree_node**)context;
+    eroc_avl_tree_node* node = *chain;
+
+    *chain = node->right;
+
+    return node;
+}
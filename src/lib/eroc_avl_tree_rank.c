@@ -0,0 +1,41 @@
+/**
+ * \file lib/eroc_avl_tree_rank.c
+ *
+ * \brief Get the in-order index of a node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Return the zero-based in-order index of the given node.
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param node          The node, which must be a member of this tree.
+ *
+ * \returns the in-order index of this node.
+ */
+size_t eroc_avl_tree_rank(eroc_avl_tree* tree, const eroc_avl_tree_node* node)
+{
+    (void)tree;
+
+    /* every node in the left subtree comes before this node. */
+    size_t rank = node->left ? node->left->count : 0;
+
+    /* walk up, adding each ancestor we are to the right of, along with its
+     * left subtree. */
+    for (
+        const eroc_avl_tree_node* parent = node->parent;
+        NULL != parent;
+        node = parent, parent = parent->parent)
+    {
+        if (node == parent->right)
+        {
+            rank += 1 + (parent->left ? parent->left->count : 0);
+        }
+    }
+
+    return rank;
+}
@@ -0,0 +1,43 @@
+/**
+ * \file lib/eroc_avl_tree_rank_key.c
+ *
+ * \brief Count the nodes of a keyed AVL tree whose keys are less than a key.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Return the number of nodes in a keyed AVL tree whose keys are less
+ * than the given key.
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param key           The key to rank.
+ *
+ * \returns the number of nodes whose keys are less than \p key.
+ */
+size_t eroc_avl_tree_rank_key(eroc_avl_tree* tree, const void* key)
+{
+    eroc_avl_tree_node* x = tree->root;
+    size_t rank = 0;
+
+    while (NULL != x)
+    {
+        const void* x_key = tree->key_fn(tree->context, x);
+
+        if (tree->compare_fn(tree->context, key, x_key) <= 0)
+        {
+            x = x->left;
+        }
+        else
+        {
+            /* this node and its left subtree come before the key. */
+            rank += 1 + (x->left ? x->left->count : 0);
+            x = x->right;
+        }
+    }
+
+    return rank;
+}
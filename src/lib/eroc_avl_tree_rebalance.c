@@ -0,0 +1,80 @@
+/**
+ * \file lib/eroc_avl_tree_rebalance.c
+ *
+ * \brief Rebalance an AVL tree from a given node to the root.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+static inline int max(int lhs, int rhs)
+{
+    return lhs > rhs ? lhs : rhs;
+}
+
+static inline int balance_factor(const eroc_avl_tree_node* node)
+{
+    int left_height = node->left ? node->left->height : 0;
+    int right_height = node->right ? node->right->height : 0;
+
+    return left_height - right_height;
+}
+
+/**
+ * \brief Walk from the given node to the root, recomputing heights, subtree
+ * counts, and user-defined aggregates, and performing any rotations needed to
+ * restore the AVL invariant.
+ *
+ * \param tree          The tree for this operation.
+ * \param node          The lowest node whose children changed, or NULL.
+ */
+void eroc_avl_tree_rebalance(eroc_avl_tree* tree, eroc_avl_tree_node* node)
+{
+    while (NULL != node)
+    {
+        /* recompute the height, count, and aggregate of this node. */
+        int left_height = node->left ? node->left->height : 0;
+        int right_height = node->right ? node->right->height : 0;
+        node->height = max(left_height, right_height) + 1;
+        node->count =
+            1 + (node->left ? node->left->count : 0)
+              + (node->right ? node->right->count : 0);
+
+        if (NULL != tree->update_fn)
+        {
+            tree->update_fn(tree->context, node);
+        }
+
+        /* is the tree left-heavy? */
+        if (left_height - right_height >= 2)
+        {
+            if (balance_factor(node->left) < 0)
+            {
+                eroc_avl_tree_rotate_left(tree, &node->left);
+            }
+
+            eroc_avl_tree_rotate_right(tree, &node);
+        }
+        /* is the tree right-heavy? */
+        else if (left_height - right_height <= -2)
+        {
+            if (balance_factor(node->right) > 0)
+            {
+                eroc_avl_tree_rotate_right(tree, &node->right);
+            }
+
+            eroc_avl_tree_rotate_left(tree, &node);
+        }
+
+        /* fix up the tree root if this subtree root is now the root. */
+        if (NULL == node->parent)
+        {
+            tree->root = node;
+        }
+
+        /* move up the tree. */
+        node = node->parent;
+    }
+}
@@ -11,12 +11,7 @@
 
 /* forward decls. */
 static void transplant(
-    eroc_avl_tree* tree, int* child_bf, eroc_avl_tree_node* n,
-    eroc_avl_tree_node* child);
-static inline int max(int lhs, int rhs)
-{
-    return lhs > rhs ? lhs : rhs;
-}
+    eroc_avl_tree* tree, eroc_avl_tree_node* node, eroc_avl_tree_node* child);
 
 /**
  * \brief Remove the given node from the tree, transplanting nodes as needed.
@@ -32,7 +27,6 @@ void eroc_avl_tree_remove_node(eroc_avl_tree* tree, eroc_avl_tree_node* node)
     eroc_avl_tree_node* parent = node->parent;
     eroc_avl_tree_node* left = node->left;
     eroc_avl_tree_node* right = node->right;
-    int child_bf = 0;
 
     /* there are one fewer elements in the tree. */
     tree->count -= 1;
@@ -40,12 +34,12 @@ void eroc_avl_tree_remove_node(eroc_avl_tree* tree, eroc_avl_tree_node* node)
     /* if the left child is NULL, then the right child is transplanted. */
     if (NULL == node->left)
     {
-        transplant(tree, &child_bf, node, right);
+        transplant(tree, node, right);
     }
     /* if the right child is NULL, then the left child is transplanted. */
     else if (NULL == node->right)
     {
-        transplant(tree, &child_bf, node, left);
+        transplant(tree, node, left);
     }
     /* if both children are populated, then select the rightmost left
      * descendant. */
@@ -53,105 +47,47 @@ void eroc_avl_tree_remove_node(eroc_avl_tree* tree, eroc_avl_tree_node* node)
     {
         eroc_avl_tree_node* rightmost_left =
             eroc_avl_tree_maximum_node(tree, left);
-        eroc_avl_tree_node* rightmost_left_left = rightmost_left->left;
-        eroc_avl_tree_node* rightmost_left_parent = rightmost_left->parent;
-
-        /* transplant the rightmost_left left onto the rightmost_left parent
-         * right. */
-        rightmost_left_parent->right = rightmost_left_left;
-        if (NULL != rightmost_left_left)
-        {
-            rightmost_left_left->parent = rightmost_left_parent;
-        }
 
-        /* transplant this node into our node's place. */
         if (rightmost_left != left)
-        {
-            rightmost_left->left = left;    left->parent = rightmost_left;
-        }
-        else
-        {
-            rightmost_left->left = NULL;
-        }
-        rightmost_left->right = right;      right->parent = rightmost_left;
-        rightmost_left->parent = parent;
-
-        /* fix up parent. */
-        if (NULL != parent)
-        {
-            if (node == parent->left)
-            {
-                parent->left = rightmost_left;
-            }
-            else
-            {
-                parent->right = rightmost_left;
-            }
-        }
-        /* fix up tree root. */
-        else
-        {
-            tree->root = rightmost_left;
-        }
-
-        if (NULL != rightmost_left_parent && node != rightmost_left_parent)
         {
             /* start the tree balancing below from rightmost left's former
              * parent. */
-            parent = rightmost_left_parent;
+            parent = rightmost_left->parent;
+
+            /* the rightmost left's left subtree takes its old place. */
+            transplant(tree, rightmost_left, rightmost_left->left);
+
+            /* the rightmost left adopts our node's left subtree. */
+            rightmost_left->left = left;
+            left->parent = rightmost_left;
         }
         else
         {
-            parent = left;
+            /* the left child keeps its own left subtree; balancing starts
+             * from the left child in its new position. */
+            parent = rightmost_left;
         }
 
-        child_bf = 0;
-    }
+        /* the rightmost left adopts our node's right subtree. */
+        rightmost_left->right = right;
+        right->parent = rightmost_left;
 
-    /* balance the tere after a node prune. */
-    while (NULL != parent)
-    {
-        /* compute the parent's balance factor. */
-        int parent_left_height = parent->left ? parent->left->height : 0;
-        int parent_right_height = parent->right ? parent->right->height : 0;
-        parent->height = max(parent_left_height, parent_right_height) + 1;
-        int parent_bf = parent_left_height - parent_right_height;
-
-        /* is the tree left-heavy? */
-        if (parent_bf >= 2)
-        {
-            if (child_bf < 0)
-            {
-                eroc_avl_tree_rotate_left(&parent->left);
-                eroc_avl_tree_rotate_right(&parent);
-            }
-            else
-            {
-                eroc_avl_tree_rotate_right(&parent);
-            }
-        }
-        /* is the tree right-heavy? */
-        else if (parent_bf <= -2)
-        {
-            if (child_bf > 0)
-            {
-                eroc_avl_tree_rotate_right(&parent->right);
-                eroc_avl_tree_rotate_left(&parent);
-            }
-            else
-            {
-                eroc_avl_tree_rotate_left(&parent);
-            }
-        }
+        /* transplant this node into our node's place. */
+        transplant(tree, node, rightmost_left);
+    }
 
-        /* recalculate the balance factor. */
-        parent_left_height = parent->left ? parent->left->height : 0;
-        parent_right_height = parent->right ? parent->right->height : 0;
-        child_bf = parent_left_height - parent_right_height;
+    /* prune out the node. */
+    node->parent = node->left = node->right = NULL;
+    node->height = 1;
+    node->count = 1;
 
-        /* move up the tree. */
-        parent = parent->parent;
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, node);
     }
+
+    /* balance the tree after a node prune. */
+    eroc_avl_tree_rebalance(tree, parent);
 }
 
 /**
@@ -159,30 +95,21 @@ void eroc_avl_tree_remove_node(eroc_avl_tree* tree, eroc_avl_tree_node* node)
  * from the tree.
  *
  * \param tree          The tree for this operation.
- * \param child_bf      Pointer to be populated with the balance factor of the
- *                      transplanted child.
  * \param node          The node to be pruned.
  * \param child         The child to replace this node.
  */
 static void transplant(
-    eroc_avl_tree* tree, int* child_bf, eroc_avl_tree_node* node,
-    eroc_avl_tree_node* child)
+    eroc_avl_tree* tree, eroc_avl_tree_node* node, eroc_avl_tree_node* child)
 {
     eroc_avl_tree_node* parent = node->parent;
 
     /* edge case: the child is the new root node. */
     if (NULL == parent)
     {
-        if (NULL != child)
-        {
-            child->parent = NULL;
-        }
         tree->root = child;
-        return;
     }
-
     /* the pruned node is the parent's left node. */
-    if (node == parent->left)
+    else if (node == parent->left)
     {
         parent->left = child;
     }
@@ -191,22 +118,9 @@ static void transplant(
         parent->right = child;
     }
 
-    /* prune out the node. */
-    node->parent = node->left = node->right = NULL;
-    node->height = 1;
-
+    /* the child's parent node is now this node's parent. */
     if (NULL != child)
     {
-        /* the child's parent node is now this node's parent. */
         child->parent = parent;
-
-        /* calculate the child's balance factor. */
-        int child_left_height = child->left ? child->left->height : 0;
-        int child_right_height = child->right ? child->right->height : 0;
-        *child_bf = child_left_height - child_right_height;
-    }
-    else
-    {
-        *child_bf = 0;
     }
 }
@@ -0,0 +1,70 @@
+/**
+ * \file lib/eroc_avl_tree_replace_node.c
+ *
+ * \brief Put a new node in the place of an old node in the AVL tree.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Put newnode in the place of oldnode in the tree.
+ *
+ * \note After this operation, the caller owns oldnode, and the tree owns
+ * newnode. The caller is responsible for ensuring that newnode preserves the
+ * ordering of the tree. This is O(1), or O(log n) if the tree has an update
+ * function, since the aggregates of newnode's ancestors may change.
+ *
+ * \param tree          The tree for this replace operation.
+ * \param oldnode       The node to replace.
+ * \param newnode       The node that takes the place of oldnode.
+ */
+void eroc_avl_tree_replace_node(
+    eroc_avl_tree* tree, eroc_avl_tree_node* oldnode,
+    eroc_avl_tree_node* newnode)
+{
+    /* newnode inherits the position and shape of oldnode. */
+    newnode->parent = oldnode->parent;
+    newnode->left = oldnode->left;
+    newnode->right = oldnode->right;
+    newnode->height = oldnode->height;
+    newnode->count = oldnode->count;
+
+    /* patch the parent, or the tree root if there is no parent. */
+    if (NULL == newnode->parent)
+    {
+        tree->root = newnode;
+    }
+    else if (oldnode == newnode->parent->left)
+    {
+        newnode->parent->left = newnode;
+    }
+    else
+    {
+        newnode->parent->right = newnode;
+    }
+
+    /* patch the children. */
+    if (NULL != newnode->left)
+    {
+        newnode->left->parent = newnode;
+    }
+    if (NULL != newnode->right)
+    {
+        newnode->right->parent = newnode;
+    }
+
+    /* prune out the old node. */
+    oldnode->parent = oldnode->left = oldnode->right = NULL;
+    oldnode->height = 1;
+    oldnode->count = 1;
+
+    /* the new node may contribute a different value to the aggregates. */
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, oldnode);
+        eroc_avl_tree_rebalance(tree, newnode);
+    }
+}
@@ -18,11 +18,14 @@ static inline int max(int lhs, int rhs)
  * \brief Perform a left rotation on an AVL tree.
  *
  * Root will become root->right's left-most child, and root->right will become
- * the new root of this subtree.
+ * the new root of this subtree. The tree's update function, if any, is called
+ * on the old root and then on the new root.
  *
+ * \param tree          The tree for this rotation.
  * \param root          The root for this rotation.
  */
-void eroc_avl_tree_rotate_left(eroc_avl_tree_node** root)
+void eroc_avl_tree_rotate_left(
+    eroc_avl_tree* tree, eroc_avl_tree_node** root)
 {
     eroc_avl_tree_node *root_parent = NULL, *left = NULL, *right = NULL,
                        *right_left = NULL, *right_right = NULL;
@@ -41,6 +44,8 @@ void eroc_avl_tree_rotate_left(eroc_avl_tree_node** root)
     int left_height = left ? left->height : 0;
     int right_left_height = right_left ? right_left->height : 0;
     (*root)->height = max(left_height, right_left_height) + 1;
+    (*root)->count =
+        1 + (left ? left->count : 0) + (right_left ? right_left->count : 0);
 
     /* right is the new parent. */
     right->parent = root_parent;
@@ -49,6 +54,15 @@ void eroc_avl_tree_rotate_left(eroc_avl_tree_node** root)
     int root_height = (*root)->height;
     int right_right_height = right_right ? right_right->height : 0;
     right->height = max(root_height, right_right_height) + 1;
+    right->count =
+        1 + (*root)->count + (right_right ? right_right->count : 0);
+
+    /* the old root is now below the new root, so it is updated first. */
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, *root);
+        tree->update_fn(tree->context, right);
+    }
 
     /* fix up right_left to point to root. */
     if (NULL != right_left)
@@ -18,11 +18,14 @@ static inline int max(int lhs, int rhs)
  * \brief Perform a right rotation on an AVL tree.
  *
  * Root will become root->left's right-most child, and root->left will become
- * the new root of this subtree.
+ * the new root of this subtree. The tree's update function, if any, is called
+ * on the old root and then on the new root.
  *
+ * \param tree          The tree for this rotation.
  * \param root          The root for this rotation.
  */
-void eroc_avl_tree_rotate_right(eroc_avl_tree_node** root)
+void eroc_avl_tree_rotate_right(
+    eroc_avl_tree* tree, eroc_avl_tree_node** root)
 {
     eroc_avl_tree_node *root_parent = NULL, *left = NULL, *right = NULL,
                        *left_left = NULL, *left_right = NULL;
@@ -41,6 +44,8 @@ void eroc_avl_tree_rotate_right(eroc_avl_tree_node** root)
     int left_right_height = left_right ? left_right->height : 0;
     int right_height = right ? right->height : 0;
     (*root)->height = max(left_right_height, right_height) + 1;
+    (*root)->count =
+        1 + (left_right ? left_right->count : 0) + (right ? right->count : 0);
 
     /* left is the new parent. */
     left->parent = root_parent;
@@ -49,6 +54,14 @@ void eroc_avl_tree_rotate_right(eroc_avl_tree_node** root)
     int root_height = (*root)->height;
     int left_left_height = left_left ? left_left->height : 0;
     left->height = max(root_height, left_left_height) + 1;
+    left->count = 1 + (*root)->count + (left_left ? left_left->count : 0);
+
+    /* the old root is now below the new root, so it is updated first. */
+    if (NULL != tree->update_fn)
+    {
+        tree->update_fn(tree->context, *root);
+        tree->update_fn(tree->context, left);
+    }
 
     /* fix up left_right parent to point to root. */
     if (NULL != left_right)
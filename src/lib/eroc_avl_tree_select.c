@@ -0,0 +1,50 @@
+/**
+ * \file lib/eroc_avl_tree_select.c
+ *
+ * \brief Find the node at a given in-order index.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Return the node at the given zero-based in-order index, or NULL.
+ *
+ * \param tree          The AVL tree for this operation.
+ * \param index         The in-order index of the node to find.
+ *
+ * \returns the node at this index, or NULL if the index is out of bounds.
+ */
+eroc_avl_tree_node* eroc_avl_tree_select(eroc_avl_tree* tree, size_t index)
+{
+    eroc_avl_tree_node* x = tree->root;
+
+    /* index out of bounds. */
+    if (index >= tree->count)
+    {
+        return NULL;
+    }
+
+    while (NULL != x)
+    {
+        size_t left_count = x->left ? x->left->count : 0;
+
+        if (index < left_count)
+        {
+            x = x->left;
+        }
+        else if (index == left_count)
+        {
+            return x;
+        }
+        else
+        {
+            index -= left_count + 1;
+            x = x->right;
+        }
+    }
+
+    return NULL;
+}
@@ -0,0 +1,59 @@
+/**
+ * \file lib/eroc_avl_tree_split.c
+ *
+ * \brief Split a keyed AVL tree by key.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Split a keyed AVL tree by key.
+ *
+ * Every node whose key is not less than \p key moves to \p right, in O(log n)
+ * time. See \ref eroc_avl_tree_split_node.
+ *
+ * \param tree          The tree to split, which keeps the nodes whose keys are
+ *                      less than \p key.
+ * \param right         The tree that receives the other nodes, which must be
+ *                      empty.
+ * \param key           The key to split at.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split(
+    eroc_avl_tree* tree, eroc_avl_tree* right, const void* key)
+{
+    eroc_avl_tree_node* x = tree->root;
+    eroc_avl_tree_node* first = NULL;
+
+    if (NULL != right->root)
+    {
+        return 1;
+    }
+
+    /* find the first node whose key is not less than the split key. */
+    while (NULL != x)
+    {
+        const void* x_key = tree->key_fn(tree->context, x);
+
+        if (tree->compare_fn(tree->context, key, x_key) <= 0)
+        {
+            first = x;
+            x = x->left;
+        }
+        else
+        {
+            x = x->right;
+        }
+    }
+
+    if (NULL == first)
+    {
+        return 0;
+    }
+
+    return eroc_avl_tree_split_node(tree, right, first);
+}
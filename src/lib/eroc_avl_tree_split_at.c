@@ -0,0 +1,44 @@
+/**
+ * \file lib/eroc_avl_tree_split_at.c
+ *
+ * \brief Split an AVL tree by in-order index.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/**
+ * \brief Split an AVL tree by in-order index.
+ *
+ * The node at \p index and every node after it move to \p right, in O(log n)
+ * time. See \ref eroc_avl_tree_split_node.
+ *
+ * \param tree          The tree to split, which keeps its first \p index
+ *                      nodes.
+ * \param right         The tree that receives the other nodes, which must be
+ *                      empty.
+ * \param index         The in-order index to split at. If it is past the end,
+ *                      no nodes move.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split_at(
+    eroc_avl_tree* tree, eroc_avl_tree* right, size_t index)
+{
+    eroc_avl_tree_node* node;
+
+    if (NULL != right->root)
+    {
+        return 1;
+    }
+
+    node = eroc_avl_tree_select(tree, index);
+    if (NULL == node)
+    {
+        return 0;
+    }
+
+    return eroc_avl_tree_split_node(tree, right, node);
+}
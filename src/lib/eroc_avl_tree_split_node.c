@@ -0,0 +1,92 @@
+/**
+ * \file lib/eroc_avl_tree_split_node.c
+ *
+ * \brief Split an AVL tree before the given node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/* forward decls. */
+static void subtree_detach(eroc_avl_tree* tree, eroc_avl_tree_node* root);
+
+/**
+ * \brief Split an AVL tree before the given node.
+ *
+ * The node and every node after it move to \p right. The pieces on each side
+ * of the path from the node to the root are joined back together, which is
+ * O(log n) time in all.
+ *
+ * \param tree          The tree to split, which keeps the nodes before
+ *                      \p node.
+ * \param right         The tree that receives \p node and the nodes after it,
+ *                      which must be empty.
+ * \param node          The node to split before, which must be a member of
+ *                      \p tree.
+ *
+ * \returns 0 on success and non-zero if \p right isn't empty.
+ */
+int eroc_avl_tree_split_node(
+    eroc_avl_tree* tree, eroc_avl_tree* right, eroc_avl_tree_node* node)
+{
+    eroc_avl_tree left = *tree;
+    eroc_avl_tree piece = *tree;
+    eroc_avl_tree_node* child = node;
+    eroc_avl_tree_node* parent = node->parent;
+
+    if (NULL != right->root)
+    {
+        return 1;
+    }
+
+    /* the node starts the right tree, and its left subtree the left tree. */
+    subtree_detach(&left, node->left);
+    subtree_detach(&piece, node->right);
+    eroc_avl_tree_join(right, node, &piece);
+
+    /* each ancestor goes with its other subtree to the side it is on. */
+    while (NULL != parent)
+    {
+        eroc_avl_tree_node* next = parent->parent;
+
+        if (child == parent->left)
+        {
+            subtree_detach(&piece, parent->right);
+            eroc_avl_tree_join(right, parent, &piece);
+        }
+        else
+        {
+            subtree_detach(&piece, parent->left);
+            eroc_avl_tree_join(&piece, parent, &left);
+            left = piece;
+        }
+
+        child = parent;
+        parent = next;
+    }
+
+    tree->root = left.root;
+    tree->count = left.count;
+
+    return 0;
+}
+
+/**
+ * \brief Make a subtree into a tree of its own.
+ *
+ * \param tree          The tree to hold the subtree, whose nodes are replaced.
+ * \param root          The root of the subtree, or NULL.
+ */
+static void subtree_detach(eroc_avl_tree* tree, eroc_avl_tree_node* root)
+{
+    tree->root = root;
+    tree->count = 0;
+
+    if (NULL != root)
+    {
+        root->parent = NULL;
+        tree->count = root->count;
+    }
+}
@@ -0,0 +1,79 @@
+/**
+ * \file lib/eroc_avl_tree_update_set.c
+ *
+ * \brief Set the function that keeps a user-defined aggregate up to date.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/avltree.h>
+
+/* forward decls. */
+static eroc_avl_tree_node* first_leaf(eroc_avl_tree_node* node);
+
+/**
+ * \brief Set the function that keeps a user-defined aggregate up to date in
+ * each node.
+ *
+ * If the tree already has nodes, every node is updated, children before their
+ * parents, in O(n) time and O(1) space.
+ *
+ * \param tree          The tree for this operation.
+ * \param update_fn     The function, or NULL to keep no aggregate.
+ */
+void eroc_avl_tree_update_set(
+    eroc_avl_tree* tree, eroc_avl_tree_update_fn update_fn)
+{
+    eroc_avl_tree_node* node;
+
+    tree->update_fn = update_fn;
+    if (NULL == update_fn || NULL == tree->root)
+    {
+        return;
+    }
+
+    /* walk the tree in post-order by way of the parent links. */
+    node = first_leaf(tree->root);
+    while (NULL != node)
+    {
+        eroc_avl_tree_node* parent = node->parent;
+
+        update_fn(tree->context, node);
+
+        if (NULL != parent && node == parent->left && NULL != parent->right)
+        {
+            node = first_leaf(parent->right);
+        }
+        else
+        {
+            node = parent;
+        }
+    }
+}
+
+/**
+ * \brief Return the first node of a subtree in post-order.
+ *
+ * \param node          The root of the subtree.
+ *
+ * \returns the leaf reached by going left where possible, and right otherwise.
+ */
+static eroc_avl_tree_node* first_leaf(eroc_avl_tree_node* node)
+{
+    for (;;)
+    {
+        if (NULL != node->left)
+        {
+            node = node->left;
+        }
+        else if (NULL != node->right)
+        {
+            node = node->right;
+        }
+        else
+        {
+            return node;
+        }
+    }
+}
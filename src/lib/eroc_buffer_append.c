@@ -9,24 +9,105 @@
 
 #include <eroc/buffer.h>
 
+/* forward decls. */
+static int pieces_append(
+    eroc_buffer* buffer, eroc_buffer_line* after, eroc_buffer_line* line);
+
 /**
  * \brief Append the given line to the given buffer, after the given line.
  *
+ * A piece table buffer copies the line's string and releases the line.
+ *
  * \param buffer            The buffer for this append operation.
  * \param after             The line after this line should be appended, or NULL
  *                          if this line should be appended at the end of the
  *                          buffer.
  * \param line              The line to append.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the caller
+ * still owns the line. Appending to a list buffer never fails.
  */
-void eroc_buffer_append(
+int eroc_buffer_append(
     eroc_buffer* buffer, eroc_buffer_line* after, eroc_buffer_line* line)
 {
-    eroc_list_append_after(buffer->lines, &after->hdr, &line->hdr);
+    if (NULL != buffer->pieces)
+    {
+        return pieces_append(buffer, after, line);
+    }
+
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        ++buffer->heap_lines;
+    }
+
+    eroc_list_append_after(
+        buffer->lines, (NULL != after) ? &after->hdr : NULL, &line->hdr);
+    eroc_avl_tree_insert_after(
+        buffer->index, (NULL != after) ? &after->index : NULL, &line->index);
+
+    if (NULL != buffer->journal)
+    {
+        eroc_buffer_journal_insert(buffer, line);
+    }
 
     /* if the cursor is NULL, set it to the head. */
     if (NULL == buffer->cursor)
     {
         buffer->cursor = (eroc_buffer_line*)buffer->lines->head;
-        buffer->lineno = buffer->lines->count;
+        buffer->lineno = 0;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Append a copy of the given line to a piece table buffer.
+ *
+ * \param buffer            The buffer for this append operation.
+ * \param after             The cursor, or NULL to append at the end.
+ * \param line              The line to append, which is released on success.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int pieces_append(
+    eroc_buffer* buffer, eroc_buffer_line* after, eroc_buffer_line* line)
+{
+    int retval;
+    size_t lineno;
+
+    /* the cursor is the only line of a piece table buffer. */
+    if (NULL == after)
+    {
+        lineno = eroc_buffer_line_count(buffer);
+    }
+    else if (after == buffer->cursor)
+    {
+        lineno = buffer->lineno + 1;
+    }
+    else
+    {
+        return 1;
+    }
+
+    retval =
+        eroc_piece_table_insert(
+            buffer->pieces, lineno, line->line, line->length);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    eroc_buffer_line_recycle(buffer, line);
+
+    /* the cursor stays on its line, or goes to the head of a new buffer. */
+    if (NULL == buffer->cursor)
+    {
+        return eroc_buffer_cursor_move(buffer, 0);
     }
+    else if (lineno <= buffer->lineno)
+    {
+        ++buffer->lineno;
+    }
+
+    return 0;
 }
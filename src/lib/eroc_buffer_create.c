@@ -11,6 +11,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+static int index_node_release(void* context, eroc_avl_tree_node* node);
+static int index_bulk_release(void* context, eroc_avl_tree_node* root);
+
 /**
  * \brief Create an empty buffer.
  *
@@ -42,13 +45,73 @@ int eroc_buffer_create(eroc_buffer** buffer)
         goto cleanup_tmp;
     }
 
+    /* the line index is positional, so it needs no key functions. */
+    retval =
+        eroc_avl_tree_create(
+            &tmp->index, NULL, NULL, &index_node_release, NULL);
+    if (0 != retval)
+    {
+        goto cleanup_lines;
+    }
+
+    /* the list owns the lines, so clearing the index needn't visit them. */
+    eroc_avl_tree_bulk_release_set(tmp->index, &index_bulk_release);
+
+    retval = eroc_arena_create(&tmp->arena, 0);
+    if (0 != retval)
+    {
+        goto cleanup_index;
+    }
+
     *buffer = tmp;
     retval = 0;
     goto done;
 
+cleanup_index:
+    (void)eroc_avl_tree_release(tmp->index);
+
+cleanup_lines:
+    (void)eroc_list_release(tmp->lines);
+
 cleanup_tmp:
     free(tmp);
 
 done:
     return retval;
 }
+
+/**
+ * \brief Release an index node.
+ *
+ * \note The line list owns each line, so this is a no-op.
+ *
+ * \param context           Unused.
+ * \param node              Unused.
+ *
+ * \returns 0.
+ */
+static int index_node_release(void* context, eroc_avl_tree_node* node)
+{
+    (void)context;
+    (void)node;
+
+    return 0;
+}
+
+/**
+ * \brief Release every index node at once.
+ *
+ * \note The line list owns each line, so this is a no-op.
+ *
+ * \param context           Unused.
+ * \param root              Unused.
+ *
+ * \returns 0.
+ */
+static int index_bulk_release(void* context, eroc_avl_tree_node* root)
+{
+    (void)context;
+    (void)root;
+
+    return 0;
+}
@@ -16,6 +16,11 @@
  */
 int eroc_buffer_cursor_advance(eroc_buffer* buffer)
 {
+    if (NULL != buffer->pieces)
+    {
+        return eroc_buffer_cursor_move(buffer, buffer->lineno + 1);
+    }
+
     /* can't advance past the last line. */
     if (NULL == buffer->cursor || NULL == buffer->cursor->hdr.next)
     {
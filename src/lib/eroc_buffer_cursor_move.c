@@ -12,14 +12,39 @@
 /**
  * \brief Move the cursor to the given zero-indexed line number.
  *
+ * In a piece table buffer, the cursor is the view, which borrows the text of
+ * the line from the piece table. Moving the cursor settles a pending current
+ * line.
+ *
  * \param buffer            The buffer for this operation.
  * \param lineno            The line number for this buffer.
  */
 int eroc_buffer_cursor_move(eroc_buffer* buffer, unsigned long lineno)
 {
-    int retval =
-        eroc_list_node_at(
-            (eroc_list_node**)&buffer->cursor, buffer->lines, lineno);
+    int retval;
+    const char* text;
+    size_t length;
+
+    if (NULL != buffer->pieces)
+    {
+        retval =
+            eroc_piece_table_line(&text, &length, buffer->pieces, lineno);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        buffer->view.line = (char*)text;
+        buffer->view.length = length;
+        buffer->view.capacity = 0;
+        buffer->view.flags = EROC_BUFFER_LINE_FLAG_BORROWED;
+        buffer->cursor = &buffer->view;
+        buffer->lineno = lineno;
+        buffer->flags &= ~EROC_BUFFER_FLAG_CURSOR_PENDING;
+        return 0;
+    }
+
+    retval = eroc_buffer_line_at(&buffer->cursor, buffer, lineno);
     if (0 != retval)
     {
         return retval;
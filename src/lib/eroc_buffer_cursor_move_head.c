@@ -16,6 +16,12 @@
  */
 void eroc_buffer_cursor_move_head(eroc_buffer* buffer)
 {
+    /* this waits only for the first line of a piece table to be indexed. */
+    if (NULL != buffer->pieces && 0 == eroc_buffer_cursor_move(buffer, 0))
+    {
+        return;
+    }
+
     buffer->cursor = (eroc_buffer_line*)buffer->lines->head;
     buffer->lineno = 0;
 }
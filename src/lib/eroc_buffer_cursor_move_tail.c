@@ -16,6 +16,12 @@
  */
 void eroc_buffer_cursor_move_tail(eroc_buffer* buffer)
 {
+    if (NULL != buffer->pieces && eroc_buffer_line_count(buffer) > 0)
+    {
+        (void)eroc_buffer_cursor_move(buffer, buffer->pieces->lines - 1);
+        return;
+    }
+
     buffer->cursor = (eroc_buffer_line*)buffer->lines->tail;
 
     if (buffer->lines->count > 0)
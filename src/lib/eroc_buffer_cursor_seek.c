@@ -0,0 +1,42 @@
+/**
+ * \file lib/eroc_buffer_cursor_seek.c
+ *
+ * \brief Move the cursor to the given zero-indexed line number, walking from
+ * the cursor when the line is near.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Move the cursor to the given zero-indexed line number, walking from
+ * the cursor, the head, or the tail when one of them is near.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number for this buffer.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_cursor_seek(eroc_buffer* buffer, unsigned long lineno)
+{
+    int retval;
+    eroc_buffer_line* line;
+
+    /* the view of a piece table buffer is always moved through the table. */
+    if (NULL != buffer->pieces)
+    {
+        return eroc_buffer_cursor_move(buffer, lineno);
+    }
+
+    retval = eroc_buffer_line_seek(&line, buffer, lineno);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    buffer->cursor = line;
+    buffer->lineno = lineno;
+    return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * \file lib/eroc_buffer_index_build.c
+ *
+ * \brief Build the line index of a list buffer over its whole line list.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/* forward decls. */
+static eroc_avl_tree_node* line_next(void* context);
+
+/**
+ * \brief Build the line index of a list buffer over its whole line list.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_index_build(eroc_buffer* buffer)
+{
+    eroc_list_node* node = buffer->lines->head;
+
+    /* the index only references the lines, so clearing it is free. */
+    (void)eroc_avl_tree_clear(buffer->index);
+    (void)eroc_avl_tree_build(
+        buffer->index, buffer->lines->count, &line_next, &node);
+}
+
+/**
+ * \brief Return the index node of the next line of the list.
+ *
+ * \param context       Pointer to the list node of the next line, which is
+ *                      advanced.
+ *
+ * \returns the index node of the line.
+ */
+static eroc_avl_tree_node* line_next(void* context)
+{
+    eroc_list_node** node = (eroc_list_node**)context;
+    eroc_buffer_line* line = (eroc_buffer_line*)*node;
+
+    *node = (*node)->next;
+
+    return &line->index;
+}
@@ -9,24 +9,105 @@
 
 #include <eroc/buffer.h>
 
+/* forward decls. */
+static int pieces_insert(
+    eroc_buffer* buffer, eroc_buffer_line* before, eroc_buffer_line* line);
+
 /**
  * \brief Insert the given line into the given buffer, before the given line.
  *
+ * A piece table buffer copies the line's string and releases the line.
+ *
  * \param buffer            The buffer for this insert operation.
  * \param before            The line before this line should be inserted, or
  *                          NULL if this line should be inserted at the
  *                          beginning of the buffer.
  * \param line              The line to insert.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the caller
+ * still owns the line. Inserting into a list buffer never fails.
  */
-void eroc_buffer_insert(
+int eroc_buffer_insert(
     eroc_buffer* buffer, eroc_buffer_line* before, eroc_buffer_line* line)
 {
-    eroc_list_insert_before(buffer->lines, &before->hdr, &line->hdr);
+    if (NULL != buffer->pieces)
+    {
+        return pieces_insert(buffer, before, line);
+    }
+
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        ++buffer->heap_lines;
+    }
+
+    eroc_list_insert_before(
+        buffer->lines, (NULL != before) ? &before->hdr : NULL, &line->hdr);
+    eroc_avl_tree_insert_before(
+        buffer->index, (NULL != before) ? &before->index : NULL, &line->index);
+
+    if (NULL != buffer->journal)
+    {
+        eroc_buffer_journal_insert(buffer, line);
+    }
 
     /* if the cursor is NULL, set it to the tail. */
     if (NULL == buffer->cursor)
     {
         buffer->cursor = (eroc_buffer_line*)buffer->lines->tail;
-        buffer->lineno = buffer->lines->count;
+        buffer->lineno = buffer->lines->count - 1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Insert a copy of the given line into a piece table buffer.
+ *
+ * \param buffer            The buffer for this insert operation.
+ * \param before            The cursor, or NULL to insert at the beginning.
+ * \param line              The line to insert, which is released on success.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int pieces_insert(
+    eroc_buffer* buffer, eroc_buffer_line* before, eroc_buffer_line* line)
+{
+    int retval;
+    size_t lineno;
+
+    /* the cursor is the only line of a piece table buffer. */
+    if (NULL == before)
+    {
+        lineno = 0;
+    }
+    else if (before == buffer->cursor)
+    {
+        lineno = buffer->lineno;
+    }
+    else
+    {
+        return 1;
+    }
+
+    retval =
+        eroc_piece_table_insert(
+            buffer->pieces, lineno, line->line, line->length);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    eroc_buffer_line_recycle(buffer, line);
+
+    /* the cursor stays on its line, or goes to the tail of a new buffer. */
+    if (NULL == buffer->cursor)
+    {
+        eroc_buffer_cursor_move_tail(buffer);
     }
+    else if (lineno <= buffer->lineno)
+    {
+        ++buffer->lineno;
+    }
+
+    return 0;
 }
@@ -0,0 +1,33 @@
+/**
+ * \file lib/eroc_buffer_journal_checkpoint.c
+ *
+ * \brief Start a new group of changes.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Start a new group of changes, which are undone and redone together.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_checkpoint(eroc_buffer* buffer)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+
+    if (NULL == journal)
+    {
+        return;
+    }
+
+    journal->paused = false;
+
+    /* an empty group needs no new number. */
+    if (NULL != journal->current && journal->current->group == journal->group)
+    {
+        ++journal->group;
+    }
+}
@@ -0,0 +1,23 @@
+/**
+ * \file lib/eroc_buffer_journal_clear.c
+ *
+ * \brief Forget every recorded change.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Forget every recorded change.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_clear(eroc_buffer* buffer)
+{
+    while (NULL != buffer->journal->tail)
+    {
+        eroc_buffer_journal_record_release(buffer, buffer->journal->tail);
+    }
+}
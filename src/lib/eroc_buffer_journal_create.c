@@ -0,0 +1,49 @@
+/**
+ * \file lib/eroc_buffer_journal_create.c
+ *
+ * \brief Start recording the changes made to a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Start recording the changes made to a buffer, so that they can be
+ * undone.
+ *
+ * Changes made through \ref eroc_buffer_append, \ref eroc_buffer_insert,
+ * \ref eroc_buffer_replace, and \ref eroc_buffer_line_delete are recorded.
+ * Changes to piece table buffers aren't.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param limit             The most memory that the journal may hold, after
+ *                          which the oldest changes are forgotten.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_journal_create(eroc_buffer* buffer, size_t limit)
+{
+    eroc_buffer_journal* tmp;
+
+    /* a buffer has at most one journal. */
+    if (NULL != buffer->journal)
+    {
+        return 1;
+    }
+
+    tmp = (eroc_buffer_journal*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 2;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->limit = limit;
+
+    buffer->journal = tmp;
+    return 0;
+}
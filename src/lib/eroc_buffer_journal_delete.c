@@ -0,0 +1,93 @@
+/**
+ * \file lib/eroc_buffer_journal_delete.c
+ *
+ * \brief Record that a line was removed from a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Record that a line was removed from the buffer.
+ *
+ * A line removed from just before or just after the lines of the current
+ * record joins that record, so deleting a range of lines in either direction
+ * makes one record. A line added by the current record leaves no trace.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param line              The line, which is no longer in the buffer.
+ * \param lineno            The number that the line had.
+ *
+ * \returns true if the journal took the line, or false if the caller should
+ * release it.
+ */
+bool eroc_buffer_journal_delete(
+    eroc_buffer* buffer, eroc_buffer_line* line, unsigned long lineno)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* record = journal->current;
+    bool prepend = false;
+
+    if (journal->paused)
+    {
+        return false;
+    }
+
+    if (NULL == record
+     || record != journal->tail
+     || record->group != journal->group)
+    {
+        record = NULL;
+    }
+    else if (
+        record->lineno <= lineno && lineno < record->lineno + record->count)
+    {
+        --record->count;
+        return false;
+    }
+    else if (lineno + 1 == record->lineno)
+    {
+        /* deleting backwards. */
+        --record->lineno;
+        prepend = true;
+    }
+    else if (lineno != record->lineno + record->count)
+    {
+        record = NULL;
+    }
+
+    if (NULL == record
+     && 0 != eroc_buffer_journal_record_create(&record, buffer, lineno))
+    {
+        eroc_buffer_journal_clear(buffer);
+        journal->paused = true;
+        return false;
+    }
+
+    line->hdr.prev = line->hdr.next = NULL;
+    if (NULL == record->removed)
+    {
+        record->removed = record->removed_tail = line;
+    }
+    else if (prepend)
+    {
+        line->hdr.next = &record->removed->hdr;
+        record->removed->hdr.prev = &line->hdr;
+        record->removed = line;
+    }
+    else
+    {
+        line->hdr.prev = &record->removed_tail->hdr;
+        record->removed_tail->hdr.next = &line->hdr;
+        record->removed_tail = line;
+    }
+
+    ++record->removed_count;
+    record->size += sizeof(*line) + line->capacity;
+    journal->size += sizeof(*line) + line->capacity;
+
+    eroc_buffer_journal_trim(buffer);
+    return true;
+}
@@ -0,0 +1,53 @@
+/**
+ * \file lib/eroc_buffer_journal_insert.c
+ *
+ * \brief Record that a line was added to a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Record that a line was added to the buffer.
+ *
+ * A line added next to, or among, the lines added by the current record
+ * extends that record.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param line              The line, which is in the buffer.
+ */
+void eroc_buffer_journal_insert(eroc_buffer* buffer, eroc_buffer_line* line)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* record = journal->current;
+    unsigned long lineno;
+
+    if (journal->paused)
+    {
+        return;
+    }
+
+    lineno = eroc_avl_tree_rank(buffer->index, &line->index);
+
+    if (NULL != record
+     && record == journal->tail
+     && record->group == journal->group
+     && record->lineno <= lineno
+     && lineno <= record->lineno + record->count)
+    {
+        ++record->count;
+        return;
+    }
+
+    if (0 != eroc_buffer_journal_record_create(&record, buffer, lineno))
+    {
+        eroc_buffer_journal_clear(buffer);
+        journal->paused = true;
+        return;
+    }
+
+    record->count = 1;
+    eroc_buffer_journal_trim(buffer);
+}
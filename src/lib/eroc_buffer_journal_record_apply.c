@@ -0,0 +1,123 @@
+/**
+ * \file lib/eroc_buffer_journal_record_apply.c
+ *
+ * \brief Undo or redo a journal record.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Swap the lines held by a record with the lines it describes in the
+ * buffer, which undoes or redoes the record.
+ *
+ * Lines are moved by relinking them, so the cost is proportional to the number
+ * of lines moved, and nothing is allocated.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param record            The record to apply.
+ */
+void eroc_buffer_journal_record_apply(
+    eroc_buffer* buffer, eroc_buffer_journal_record* record)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_line *line = NULL, *next, *head = NULL, *tail = NULL;
+    eroc_buffer_line* before;
+    size_t size = sizeof(*record);
+    bool paused = journal->paused;
+
+    /* moving lines back into the buffer is not a change to record. */
+    journal->paused = true;
+
+    /* take the record's lines out of the buffer. */
+    if (record->lineno < buffer->lines->count)
+    {
+        (void)eroc_buffer_line_at(&line, buffer, record->lineno);
+    }
+
+    for (unsigned long i = 0; i < record->count; ++i)
+    {
+        next = (eroc_buffer_line*)line->hdr.next;
+
+        if (buffer->cursor == line)
+        {
+            buffer->cursor = NULL;
+        }
+
+        if (line->flags & EROC_BUFFER_LINE_FLAG_MARKED)
+        {
+            line->flags &= ~EROC_BUFFER_LINE_FLAG_MARKED;
+            --buffer->marked;
+        }
+
+        if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+        {
+            --buffer->heap_lines;
+        }
+
+        eroc_avl_tree_remove_node(buffer->index, &line->index);
+        eroc_list_node_unlink(buffer->lines, &line->hdr);
+
+        line->hdr.prev = line->hdr.next = NULL;
+        if (NULL == tail)
+        {
+            head = line;
+        }
+        else
+        {
+            line->hdr.prev = &tail->hdr;
+            tail->hdr.next = &line->hdr;
+        }
+
+        tail = line;
+        size += sizeof(*line) + line->capacity;
+        line = next;
+    }
+
+    /* put the held lines in their place. */
+    before = line;
+    for (line = record->removed; NULL != line; line = next)
+    {
+        next = (eroc_buffer_line*)line->hdr.next;
+        line->flags &= ~EROC_BUFFER_LINE_FLAG_MARKED;
+
+        if (NULL != before)
+        {
+            (void)eroc_buffer_insert(buffer, before, line);
+        }
+        else
+        {
+            (void)eroc_buffer_append(buffer, NULL, line);
+        }
+    }
+
+    /* the record now holds the lines that it took out. */
+    unsigned long count = record->count;
+    record->count = record->removed_count;
+    record->removed_count = count;
+    record->removed = head;
+    record->removed_tail = tail;
+    journal->size += size - record->size;
+    record->size = size;
+
+    journal->paused = paused;
+
+    /* the cursor goes to the last line put back, or where the lines were. */
+    if (record->count > 0)
+    {
+        (void)eroc_buffer_cursor_move(
+            buffer, record->lineno + record->count - 1);
+    }
+    else if (record->lineno < buffer->lines->count)
+    {
+        (void)eroc_buffer_cursor_move(buffer, record->lineno);
+    }
+    else
+    {
+        eroc_buffer_cursor_move_tail(buffer);
+    }
+
+    buffer->flags |= EROC_BUFFER_FLAG_MODIFIED;
+}
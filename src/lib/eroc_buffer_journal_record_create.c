@@ -0,0 +1,64 @@
+/**
+ * \file lib/eroc_buffer_journal_record_create.c
+ *
+ * \brief Add a new record at the end of a journal.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Add a new record at the end of the journal, forgetting any changes
+ * that could be redone.
+ *
+ * \param record            Pointer to be set to the new record on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The number of the first changed line.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_journal_record_create(
+    eroc_buffer_journal_record** record, eroc_buffer* buffer,
+    unsigned long lineno)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* tmp;
+
+    /* a new change leaves nothing to redo. */
+    while (journal->tail != journal->current)
+    {
+        eroc_buffer_journal_record_release(buffer, journal->tail);
+    }
+
+    tmp = (eroc_buffer_journal_record*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->group = journal->group;
+    tmp->lineno = lineno;
+    tmp->size = sizeof(*tmp);
+
+    tmp->prev = journal->tail;
+    if (NULL != journal->tail)
+    {
+        journal->tail->next = tmp;
+    }
+    else
+    {
+        journal->head = tmp;
+    }
+
+    journal->tail = tmp;
+    journal->current = tmp;
+    journal->size += tmp->size;
+
+    *record = tmp;
+    return 0;
+}
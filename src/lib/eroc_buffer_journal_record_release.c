@@ -0,0 +1,58 @@
+/**
+ * \file lib/eroc_buffer_journal_record_release.c
+ *
+ * \brief Remove a record from a journal.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+
+/**
+ * \brief Remove a record from the journal and release the lines that it holds.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param record            The record to release.
+ */
+void eroc_buffer_journal_record_release(
+    eroc_buffer* buffer, eroc_buffer_journal_record* record)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_line* line = record->removed;
+
+    while (NULL != line)
+    {
+        eroc_buffer_line* next = (eroc_buffer_line*)line->hdr.next;
+        eroc_buffer_line_recycle(buffer, line);
+        line = next;
+    }
+
+    /* the changes before this record can still be undone. */
+    if (journal->current == record)
+    {
+        journal->current = record->prev;
+    }
+
+    if (NULL != record->prev)
+    {
+        record->prev->next = record->next;
+    }
+    else
+    {
+        journal->head = record->next;
+    }
+
+    if (NULL != record->next)
+    {
+        record->next->prev = record->prev;
+    }
+    else
+    {
+        journal->tail = record->prev;
+    }
+
+    journal->size -= record->size;
+    free(record);
+}
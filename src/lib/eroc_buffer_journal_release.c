@@ -0,0 +1,28 @@
+/**
+ * \file lib/eroc_buffer_journal_release.c
+ *
+ * \brief Release a buffer's journal.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a buffer's journal, along with the lines that it holds.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_release(eroc_buffer* buffer)
+{
+    if (NULL == buffer->journal)
+    {
+        return;
+    }
+
+    eroc_buffer_journal_clear(buffer);
+    free(buffer->journal);
+    buffer->journal = NULL;
+}
@@ -0,0 +1,81 @@
+/**
+ * \file lib/eroc_buffer_journal_replace.c
+ *
+ * \brief Record that a line of a buffer was replaced.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Record that a line of the buffer was replaced.
+ *
+ * Replacing the line just after the lines of the current record extends that
+ * record, so substituting a range of lines makes one record. Replacing a line
+ * added by the current record leaves no trace.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param oldline           The replaced line, which is no longer in the
+ *                          buffer.
+ * \param lineno            The number of the line.
+ *
+ * \returns true if the journal took the old line, or false if the caller
+ * should release it.
+ */
+bool eroc_buffer_journal_replace(
+    eroc_buffer* buffer, eroc_buffer_line* oldline, unsigned long lineno)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* record = journal->current;
+
+    if (journal->paused)
+    {
+        return false;
+    }
+
+    if (NULL == record
+     || record != journal->tail
+     || record->group != journal->group)
+    {
+        record = NULL;
+    }
+    else if (
+        record->lineno <= lineno && lineno < record->lineno + record->count)
+    {
+        return false;
+    }
+    else if (lineno != record->lineno + record->count)
+    {
+        record = NULL;
+    }
+
+    if (NULL == record
+     && 0 != eroc_buffer_journal_record_create(&record, buffer, lineno))
+    {
+        eroc_buffer_journal_clear(buffer);
+        journal->paused = true;
+        return false;
+    }
+
+    oldline->hdr.prev = oldline->hdr.next = NULL;
+    if (NULL == record->removed)
+    {
+        record->removed = oldline;
+    }
+    else
+    {
+        oldline->hdr.prev = &record->removed_tail->hdr;
+        record->removed_tail->hdr.next = &oldline->hdr;
+    }
+
+    record->removed_tail = oldline;
+    ++record->removed_count;
+    ++record->count;
+    record->size += sizeof(*oldline) + oldline->capacity;
+    journal->size += sizeof(*oldline) + oldline->capacity;
+
+    eroc_buffer_journal_trim(buffer);
+    return true;
+}
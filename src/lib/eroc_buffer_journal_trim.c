@@ -0,0 +1,38 @@
+/**
+ * \file lib/eroc_buffer_journal_trim.c
+ *
+ * \brief Forget the oldest changes until the journal fits in its limit.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Forget the oldest changes until the journal fits in its limit.
+ *
+ * If the changes of the current group alone don't fit, every change is
+ * forgotten, and recording stops until the next checkpoint.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_journal_trim(eroc_buffer* buffer)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+
+    while (
+        journal->size > journal->limit
+     && NULL != journal->head
+     && journal->head->group != journal->group)
+    {
+        eroc_buffer_journal_record_release(buffer, journal->head);
+    }
+
+    /* a partial group can't be undone, and nor can anything before it. */
+    if (journal->size > journal->limit)
+    {
+        eroc_buffer_journal_clear(buffer);
+        journal->paused = true;
+    }
+}
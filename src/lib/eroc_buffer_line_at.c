@@ -0,0 +1,43 @@
+/**
+ * \file lib/eroc_buffer_line_at.c
+ *
+ * \brief Get the line at a given line number.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Get the line at the given zero-indexed line number.
+ *
+ * \param line              Pointer to the line pointer to be set to this line
+ *                          on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_at(
+    eroc_buffer_line** line, const eroc_buffer* buffer, unsigned long lineno)
+{
+    /* a piece table buffer has no lines to hand out. */
+    if (NULL != buffer->pieces)
+    {
+        return 2;
+    }
+
+    /* look up this line in the index. */
+    eroc_avl_tree_node* node = eroc_avl_tree_select(buffer->index, lineno);
+    if (NULL == node)
+    {
+        return 1;
+    }
+
+    /* Success. Convert the index node back into its line. */
+    *line =
+        (eroc_buffer_line*)
+            ((char*)node - offsetof(eroc_buffer_line, index));
+    return 0;
+}
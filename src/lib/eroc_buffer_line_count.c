@@ -0,0 +1,33 @@
+/**
+ * \file lib/eroc_buffer_line_count.c
+ *
+ * \brief Get the number of lines in a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Get the number of lines in the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns the number of lines.
+ */
+unsigned long eroc_buffer_line_count(const eroc_buffer* buffer)
+{
+    /* the count of a piece table is known once its text is indexed. */
+    if (NULL != buffer->pieces)
+    {
+        if (0 != eroc_piece_table_finish(buffer->pieces))
+        {
+            return 0;
+        }
+
+        return buffer->pieces->lines;
+    }
+
+    return buffer->lines->count;
+}
@@ -35,6 +35,8 @@ int eroc_buffer_line_create(eroc_buffer_line** line, char* linestr)
     }
     memset(tmp, 0, sizeof(*tmp));
     tmp->line = linestr;
+    tmp->length = strlen(linestr);
+    tmp->capacity = tmp->length;
 
     *line = tmp;
     return 0;
@@ -0,0 +1,47 @@
+/**
+ * \file lib/eroc_buffer_line_create_borrowed.c
+ *
+ * \brief Create a buffer line that borrows its string from a file mapping.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create a buffer line that borrows its string from a file mapping.
+ *
+ * \note The line string is not NUL terminated, and remains owned by the
+ * mapping. It must outlive this line, or be copied with
+ * \ref eroc_buffer_line_own first.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param linestr           The start of this line in the mapping.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_borrowed(
+    eroc_buffer_line** line, const char* linestr, size_t length)
+{
+    eroc_buffer_line* tmp;
+
+    tmp = (eroc_buffer_line*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* the mapping is read-only; the flag keeps us from writing or freeing. */
+    tmp->line = (char*)linestr;
+    tmp->length = length;
+    tmp->flags = EROC_BUFFER_LINE_FLAG_BORROWED;
+
+    *line = tmp;
+    return 0;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file lib/eroc_buffer_line_create_borrowed_in.c
+ *
+ * \brief Create a buffer line from a buffer's arena which borrows its string.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Create a buffer line from the buffer's arena, which borrows its string
+ * from the buffer's file mapping.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param buffer            The buffer whose arena holds this line. The line
+ *                          may only be added to this buffer.
+ * \param linestr           The start of this line in the mapping.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_borrowed_in(
+    eroc_buffer_line** line, eroc_buffer* buffer, const char* linestr,
+    size_t length)
+{
+    int retval;
+    eroc_buffer_line* tmp;
+
+    retval = eroc_buffer_line_header_alloc(&tmp, buffer);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    /* the mapping is read-only; the flag keeps us from writing or freeing. */
+    tmp->line = (char*)linestr;
+    tmp->length = length;
+    tmp->flags |= EROC_BUFFER_LINE_FLAG_BORROWED;
+
+    *line = tmp;
+    return 0;
+}
@@ -0,0 +1,57 @@
+/**
+ * \file lib/eroc_buffer_line_create_copy.c
+ *
+ * \brief Create a buffer line with its own copy of a string.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create a buffer line with its own copy of the given string.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param linestr           The line string to copy, which need not be NUL
+ *                          terminated.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_copy(
+    eroc_buffer_line** line, const char* linestr, size_t length)
+{
+    eroc_buffer_line* tmp;
+
+    tmp = (eroc_buffer_line*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* copy the string, adding a NUL terminator. */
+    tmp->line = (char*)malloc(length + 1);
+    if (NULL == tmp->line)
+    {
+        free(tmp);
+        return 1;
+    }
+    /* an empty string may be NULL, which memcpy must not be given. */
+    if (length > 0)
+    {
+        memcpy(tmp->line, linestr, length);
+    }
+    tmp->line[length] = 0;
+
+    /* the length may include embedded NULs, so don't trust strlen. */
+    tmp->length = length;
+    tmp->capacity = length;
+
+    *line = tmp;
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * \file lib/eroc_buffer_line_create_in.c
+ *
+ * \brief Create a buffer line from a buffer's arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <string.h>
+
+/**
+ * \brief Create a buffer line from the buffer's arena, with a copy of the given
+ * string.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          buffer line on success.
+ * \param buffer            The buffer whose arena holds this line. The line
+ *                          may only be added to this buffer.
+ * \param linestr           The line string to copy, which need not be NUL
+ *                          terminated.
+ * \param length            The length of this line, with newline removed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_create_in(
+    eroc_buffer_line** line, eroc_buffer* buffer, const char* linestr,
+    size_t length)
+{
+    int retval;
+    eroc_buffer_line* tmp;
+
+    retval = eroc_buffer_line_header_alloc(&tmp, buffer);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_buffer_text_alloc(&tmp->line, &tmp->capacity, buffer, length);
+    if (0 != retval)
+    {
+        /* give the header back. */
+        tmp->hdr.next = (eroc_list_node*)buffer->free_lines;
+        buffer->free_lines = tmp;
+        return retval;
+    }
+
+    /* the length may include embedded NULs, so don't trust strlen. An empty
+     * string may be NULL, which memcpy must not be given. */
+    if (length > 0)
+    {
+        memcpy(tmp->line, linestr, length);
+    }
+    tmp->line[length] = 0;
+    tmp->length = length;
+
+    *line = tmp;
+    return 0;
+}
@@ -11,24 +11,61 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+/* forward decls. */
+static int pieces_delete(eroc_buffer* buffer, eroc_buffer_line* line);
+
 /**
  * \brief Delete the given line from the buffer, adjusting the cursor as
  * necessary.
  *
  * \param buffer            The buffer for this delete operation.
  * \param line              The line to delete.
+ *
+ * \returns 0 on success and non-zero on failure. Deleting from a list buffer
+ * never fails.
  */
-void eroc_buffer_line_delete(eroc_buffer* buffer, eroc_buffer_line* line)
+int eroc_buffer_line_delete(eroc_buffer* buffer, eroc_buffer_line* line)
 {
+    unsigned long lineno = 0;
+
+    if (NULL != buffer->pieces)
+    {
+        return pieces_delete(buffer, line);
+    }
+
+    /* the journal needs to know where the line was. */
+    if (NULL != buffer->journal)
+    {
+        lineno = eroc_avl_tree_rank(buffer->index, &line->index);
+    }
+
     /* fix up cursor first. */
     if (buffer->cursor == line)
     {
         buffer->cursor = (eroc_buffer_line*)buffer->cursor->hdr.next;
     }
 
-    /* we don't care about the return value, because eroc_buffer_line can be
-     * trivially released. */
-    (void)eroc_list_node_delete(buffer->lines, &line->hdr);
+    /* a deleted line takes its mark with it. */
+    if (line->flags & EROC_BUFFER_LINE_FLAG_MARKED)
+    {
+        --buffer->marked;
+    }
+
+    /* remove the line from the index before the list releases it. */
+    eroc_avl_tree_remove_node(buffer->index, &line->index);
+
+    eroc_list_node_unlink(buffer->lines, &line->hdr);
+
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        --buffer->heap_lines;
+    }
+
+    if (NULL == buffer->journal
+     || !eroc_buffer_journal_delete(buffer, line, lineno))
+    {
+        eroc_buffer_line_recycle(buffer, line);
+    }
 
     if (NULL == buffer->cursor)
     {
@@ -37,4 +74,47 @@ void eroc_buffer_line_delete(eroc_buffer* buffer, eroc_buffer_line* line)
         if (buffer->lineno > 0)
             buffer->lineno -= 1;
     }
+
+    return 0;
+}
+
+/**
+ * \brief Delete the cursor's line from a piece table buffer.
+ *
+ * \param buffer            The buffer for this delete operation.
+ * \param line              The cursor.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int pieces_delete(eroc_buffer* buffer, eroc_buffer_line* line)
+{
+    int retval;
+
+    if (NULL == line || line != buffer->cursor)
+    {
+        return 1;
+    }
+
+    retval = eroc_piece_table_delete(buffer->pieces, buffer->lineno);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    /* the cursor moves to the next line, or to the new tail. */
+    if (buffer->lineno < buffer->pieces->lines)
+    {
+        return eroc_buffer_cursor_move(buffer, buffer->lineno);
+    }
+    else if (buffer->pieces->lines > 0)
+    {
+        eroc_buffer_cursor_move_tail(buffer);
+    }
+    else
+    {
+        buffer->cursor = NULL;
+        buffer->lineno = 0;
+    }
+
+    return 0;
 }
@@ -0,0 +1,31 @@
+/**
+ * \file lib/eroc_buffer_line_exists.c
+ *
+ * \brief Check whether a buffer has a line with the given number.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Check whether a buffer has a line with the given zero-indexed number.
+ *
+ * Unlike comparing against \ref eroc_buffer_line_count, this waits only until
+ * a piece table buffer has indexed the line, not the whole text.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to check.
+ *
+ * \returns true if the line exists and false otherwise.
+ */
+bool eroc_buffer_line_exists(const eroc_buffer* buffer, unsigned long lineno)
+{
+    if (NULL != buffer->pieces)
+    {
+        return 0 == eroc_piece_table_wait(buffer->pieces, lineno);
+    }
+
+    return lineno < buffer->lines->count;
+}
@@ -0,0 +1,49 @@
+/**
+ * \file lib/eroc_buffer_line_header_alloc.c
+ *
+ * \brief Allocate a line header from a buffer's arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdalign.h>
+#include <string.h>
+
+/**
+ * \brief Allocate an empty line header from the buffer's arena, reusing a
+ * released header if there is one.
+ *
+ * \param line              Pointer to the buffer line pointer to set with this
+ *                          line header on success.
+ * \param buffer            The buffer whose arena holds this line.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_header_alloc(
+    eroc_buffer_line** line, eroc_buffer* buffer)
+{
+    eroc_buffer_line* tmp = buffer->free_lines;
+
+    if (NULL != tmp)
+    {
+        buffer->free_lines = (eroc_buffer_line*)tmp->hdr.next;
+    }
+    else
+    {
+        tmp =
+            (eroc_buffer_line*)eroc_arena_alloc(
+                buffer->arena, sizeof(*tmp), alignof(eroc_buffer_line));
+        if (NULL == tmp)
+        {
+            return 1;
+        }
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->flags = EROC_BUFFER_LINE_FLAG_ARENA;
+
+    *line = tmp;
+    return 0;
+}
@@ -0,0 +1,48 @@
+/**
+ * \file lib/eroc_buffer_line_own.c
+ *
+ * \brief Copy a borrowed line string so that the line owns it.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Make sure that a buffer line owns its string, copying a borrowed
+ * string out of the file mapping.
+ *
+ * This must be called before a line's string is modified in place.
+ *
+ * \param line              The buffer line for this operation.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_own(eroc_buffer_line* line)
+{
+    char* tmp;
+
+    /* owned lines need no work. */
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_BORROWED))
+    {
+        return 0;
+    }
+
+    /* copy the string, adding the NUL terminator that the mapping lacks. */
+    tmp = (char*)malloc(line->length + 1);
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+    memcpy(tmp, line->line, line->length);
+    tmp[line->length] = 0;
+
+    line->line = tmp;
+    line->capacity = line->length;
+    line->flags &= ~EROC_BUFFER_LINE_FLAG_BORROWED;
+
+    return 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * \file lib/eroc_buffer_line_recycle.c
+ *
+ * \brief Release a line which is no longer in a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Release a line which is no longer in the buffer, recycling its memory
+ * if it came from the buffer's arena.
+ *
+ * \param buffer            The buffer which the line was removed from.
+ * \param line              The line to release.
+ */
+void eroc_buffer_line_recycle(eroc_buffer* buffer, eroc_buffer_line* line)
+{
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        (void)eroc_buffer_line_release(line);
+        return;
+    }
+
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_BORROWED))
+    {
+        eroc_buffer_text_free(buffer, line->line, line->capacity);
+    }
+
+    line->hdr.next = (eroc_list_node*)buffer->free_lines;
+    buffer->free_lines = line;
+}
@@ -13,13 +13,27 @@
 /**
  * \brief Release a buffer line.
  *
+ * \note Arena lines are not released individually; their memory is reclaimed
+ * with the buffer, so this does nothing for them.
+ *
  * \param line              The buffer line to release.
  *
  * \returns 0 on success and non-zero on failure.
  */
 int eroc_buffer_line_release(eroc_buffer_line* line)
 {
-    free(line->line);
+    /* arena lines are reclaimed with their buffer. */
+    if (line->flags & EROC_BUFFER_LINE_FLAG_ARENA)
+    {
+        return 0;
+    }
+
+    /* borrowed strings are owned by the file mapping. */
+    if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_BORROWED))
+    {
+        free(line->line);
+    }
+
     free(line);
 
     return 0;
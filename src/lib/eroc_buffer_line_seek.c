@@ -0,0 +1,74 @@
+/**
+ * \file lib/eroc_buffer_line_seek.c
+ *
+ * \brief Get the line at a given line number, walking from the cursor, the
+ * head, or the tail when one of them is near.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Get the line at the given zero-indexed line number, walking from the
+ * cursor, the head, or the tail when one of them is near.
+ *
+ * \param line              Pointer to the line pointer to be set to this line
+ *                          on success.
+ * \param buffer            The buffer for this operation.
+ * \param lineno            The line number to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_seek(
+    eroc_buffer_line** line, eroc_buffer* buffer, unsigned long lineno)
+{
+    eroc_list* lines = buffer->lines;
+    eroc_list_node* node;
+    unsigned long distance;
+
+    /* a piece table buffer has no lines to hand out. */
+    if (NULL != buffer->pieces)
+    {
+        return 2;
+    }
+
+    if (lineno >= lines->count)
+    {
+        return 1;
+    }
+
+    /* find the distance to the nearest of the head, the tail, and the
+     * cursor. */
+    distance = lineno;
+    if (lines->count - 1 - lineno < distance)
+    {
+        distance = lines->count - 1 - lineno;
+    }
+
+    if (NULL != buffer->cursor)
+    {
+        if (lineno >= buffer->lineno && lineno - buffer->lineno < distance)
+        {
+            distance = lineno - buffer->lineno;
+        }
+        else if (lineno < buffer->lineno && buffer->lineno - lineno < distance)
+        {
+            distance = buffer->lineno - lineno;
+        }
+    }
+
+    /* past the walk limit, the index is faster. */
+    if (distance > EROC_BUFFER_SEEK_WALK_LIMIT)
+    {
+        return eroc_buffer_line_at(line, buffer, lineno);
+    }
+
+    (void)eroc_list_node_seek(
+        &node, lines, (NULL != buffer->cursor) ? &buffer->cursor->hdr : NULL,
+        buffer->lineno, lineno);
+
+    *line = (eroc_buffer_line*)node;
+    return 0;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file lib/eroc_buffer_line_set.c
+ *
+ * \brief Replace the string of a buffer line.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Replace the string of a buffer line with a copy of the given string.
+ *
+ * The copy is made in place when it fits in the line's capacity, so a line
+ * that is rewritten to the same or a shorter length never reallocates. Arena
+ * lines get their new string from the buffer's arena.
+ *
+ * \param buffer            The buffer holding the line.
+ * \param line              The buffer line for this operation.
+ * \param linestr           The new line string, which need not be NUL
+ *                          terminated, and which must not overlap the line's
+ *                          current string.
+ * \param length            The length of the new line string.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_line_set(
+    eroc_buffer* buffer, eroc_buffer_line* line, const char* linestr,
+    size_t length)
+{
+    int retval;
+    char* tmp;
+    size_t capacity;
+    bool borrowed = (line->flags & EROC_BUFFER_LINE_FLAG_BORROWED);
+
+    /* a string that is borrowed or too small is replaced, with some slack
+     * for the next edit. */
+    if (borrowed || length > line->capacity)
+    {
+        capacity = length + length / 4;
+
+        if (line->flags & EROC_BUFFER_LINE_FLAG_ARENA)
+        {
+            retval = eroc_buffer_text_alloc(&tmp, &capacity, buffer, capacity);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            if (!borrowed)
+            {
+                eroc_buffer_text_free(buffer, line->line, line->capacity);
+            }
+        }
+        else
+        {
+            /* a borrowed string can't be reallocated. */
+            tmp =
+                (char*)realloc(borrowed ? NULL : line->line, capacity + 1);
+            if (NULL == tmp)
+            {
+                return 1;
+            }
+        }
+
+        line->line = tmp;
+        line->capacity = capacity;
+        line->flags &= ~EROC_BUFFER_LINE_FLAG_BORROWED;
+    }
+
+    /* an empty string may be NULL, which memcpy must not be given. */
+    if (length > 0)
+    {
+        memcpy(line->line, linestr, length);
+    }
+    line->line[length] = 0;
+    line->length = length;
+
+    return 0;
+}
@@ -8,8 +8,16 @@
  */
 
 #include <eroc/buffer.h>
+#include <eroc/linetable.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#define LOAD_BLOCK_SIZE                                         (1024 * 1024)
+
+static int pending_append(
+    char** pending, size_t* pending_size, size_t* pending_cap,
+    const char* data, size_t size);
 
 /**
  * \brief Attempt to load a text file with the given path into a buffer.
@@ -26,6 +34,11 @@ int eroc_buffer_load(eroc_buffer** buffer, size_t* size, const char* path)
     int retval, release_retval;
     size_t tmpsize = 0U;
     eroc_buffer* tmp;
+    eroc_line_table* table;
+    eroc_buffer_line* bufline;
+    char* block;
+    char* pending = NULL;
+    size_t pending_size = 0U, pending_cap = 0U;
     FILE* fp;
 
     /* attempt to open the file for reading. */
@@ -44,37 +57,114 @@ int eroc_buffer_load(eroc_buffer** buffer, size_t* size, const char* path)
         goto cleanup_fp;
     }
 
-    /* while there are lines to read, read them. */
+    /* create the line table and read block used to split lines. */
+    retval = eroc_line_table_create(&table);
+    if (0 != retval)
+    {
+        retval = 4;
+        goto cleanup_tmp;
+    }
+
+    block = (char*)malloc(LOAD_BLOCK_SIZE);
+    if (NULL == block)
+    {
+        retval = 4;
+        goto cleanup_table;
+    }
+
+    /* read the file a block at a time, splitting each block into lines. */
     for (;;)
     {
-        size_t linecap = 0;
-        char* line = NULL;
-        ssize_t read_bytes = getline(&line, &linecap, fp);
-        if (read_bytes < 0)
+        size_t read_bytes = fread(block, 1, LOAD_BLOCK_SIZE, fp);
+        if (0 == read_bytes)
         {
-            free(line);
+            if (ferror(fp))
+            {
+                retval = 5;
+                goto cleanup_block;
+            }
+
             break;
         }
-        else if (read_bytes > 0)
+
+        tmpsize += read_bytes;
+
+        retval = eroc_line_table_scan(table, block, read_bytes);
+        if (0 != retval)
+        {
+            retval = 4;
+            goto cleanup_block;
+        }
+
+        size_t start = 0U;
+        for (size_t i = 0; i < table->count; ++i)
         {
-            if ('\n' == line[read_bytes - 1])
+            size_t newline = table->newlines[i];
+
+            /* a line that started in a previous block is finished here. */
+            if (pending_size > 0)
+            {
+                retval =
+                    pending_append(
+                        &pending, &pending_size, &pending_cap, block + start,
+                        newline - start);
+                if (0 != retval)
+                {
+                    retval = 4;
+                    goto cleanup_block;
+                }
+
+                retval =
+                    eroc_buffer_line_create_in(
+                        &bufline, tmp, pending, pending_size);
+                pending_size = 0U;
+            }
+            else
             {
-                line[read_bytes - 1] = 0;
+                retval =
+                    eroc_buffer_line_create_in(
+                        &bufline, tmp, block + start, newline - start);
             }
+
+            if (0 != retval)
+            {
+                retval = 4;
+                goto cleanup_block;
+            }
+
+            eroc_list_append(tmp->lines, &bufline->hdr);
+            start = newline + 1;
         }
 
-        eroc_buffer_line* bufline;
-        retval = eroc_buffer_line_create(&bufline, line);
+        /* carry the incomplete line at the end of this block forward. */
+        retval =
+            pending_append(
+                &pending, &pending_size, &pending_cap, block + start,
+                read_bytes - start);
         if (0 != retval)
         {
             retval = 4;
-            goto cleanup_tmp;
+            goto cleanup_block;
         }
+    }
 
-        eroc_buffer_append(tmp, NULL, bufline);
-        tmpsize += read_bytes;
+    /* the final line may not end with a newline. */
+    if (pending_size > 0)
+    {
+        retval =
+            eroc_buffer_line_create_in(&bufline, tmp, pending, pending_size);
+        if (0 != retval)
+        {
+            retval = 4;
+            goto cleanup_block;
+        }
+
+        eroc_list_append(tmp->lines, &bufline->hdr);
     }
 
+    /* index the lines all at once. */
+    eroc_buffer_index_build(tmp);
+
     /* move the cursor to the end of the buffer. */
     eroc_buffer_cursor_move_tail(tmp);
 
@@ -82,13 +172,22 @@ int eroc_buffer_load(eroc_buffer** buffer, size_t* size, const char* path)
     *buffer = tmp;
     *size = tmpsize;
     retval = 0;
-    goto cleanup_fp;
+
+cleanup_block:
+    free(block);
+    free(pending);
+
+cleanup_table:
+    eroc_line_table_release(table);
 
 cleanup_tmp:
-    release_retval = eroc_buffer_release(tmp);
-    if (0 != release_retval)
+    if (0 != retval)
     {
-        retval = release_retval;
+        release_retval = eroc_buffer_release(tmp);
+        if (0 != release_retval)
+        {
+            retval = release_retval;
+        }
     }
 
 cleanup_fp:
@@ -109,3 +208,48 @@ cleanup_fp:
 done:
     return retval;
 }
+
+/**
+ * \brief Append data to the pending line, growing it as needed.
+ *
+ * \param pending           Pointer to the pending line.
+ * \param pending_size      Pointer to the size of the pending line.
+ * \param pending_cap       Pointer to the capacity of the pending line.
+ * \param data              The data to append.
+ * \param size              The size of the data to append.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int pending_append(
+    char** pending, size_t* pending_size, size_t* pending_cap,
+    const char* data, size_t size)
+{
+    /* nothing to carry over. */
+    if (0 == size)
+    {
+        return 0;
+    }
+
+    if (*pending_size + size > *pending_cap)
+    {
+        size_t newcap = *pending_cap > 0 ? *pending_cap : 256;
+        while (newcap < *pending_size + size)
+        {
+            newcap *= 2;
+        }
+
+        char* tmp = (char*)realloc(*pending, newcap);
+        if (NULL == tmp)
+        {
+            return 1;
+        }
+
+        *pending = tmp;
+        *pending_cap = newcap;
+    }
+
+    memcpy(*pending + *pending_size, data, size);
+    *pending_size += size;
+
+    return 0;
+}
@@ -0,0 +1,145 @@
+/**
+ * \file lib/eroc_buffer_load_lazy.c
+ *
+ * \brief Load a text file into a piece table buffer that is indexed in the
+ * background.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * \brief Attempt to load a text file with the given path into a piece table
+ * buffer, without waiting for the file to be indexed.
+ *
+ * The file is mapped into memory, and its lines are indexed by a background
+ * thread, so this returns in constant time whatever the size of the file. The
+ * pages of the file are read in as lines on them are reached. Moving to a line
+ * waits only until the indexer has passed it; counting the lines, addressing
+ * the last line, or editing waits for the whole file to be indexed.
+ *
+ * As with \ref eroc_buffer_load, the current line is the last line, but it is
+ * left pending until a command uses it, since finding it means waiting for the
+ * whole file. Files that can't be mapped, such as pipes, are loaded with
+ * \ref eroc_buffer_load instead.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the size of the file on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_lazy(
+    eroc_buffer** buffer, size_t* size, const char* path)
+{
+    int retval, release_retval;
+    eroc_buffer* tmp;
+    struct stat st;
+    void* data = NULL;
+    int fd;
+
+    /* attempt to open the file for reading. */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    retval = fstat(fd, &st);
+    if (0 != retval)
+    {
+        retval = 1;
+        goto cleanup_fd;
+    }
+
+    /* only regular files can be mapped. */
+    if (!S_ISREG(st.st_mode))
+    {
+        (void)close(fd);
+        return eroc_buffer_load(buffer, size, path);
+    }
+
+    /* map the file, unless it is empty. Nothing writes through this mapping. */
+    if (st.st_size > 0)
+    {
+        data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (MAP_FAILED == data)
+        {
+            retval = 5;
+            goto cleanup_fd;
+        }
+    }
+
+    /* create a buffer. */
+    retval = eroc_buffer_create(&tmp);
+    if (0 != retval)
+    {
+        retval = 2;
+        goto cleanup_data;
+    }
+
+    /* from here on, the buffer owns the mapping. */
+    tmp->map.data = data;
+    tmp->map.size = st.st_size;
+    tmp->map.dev = st.st_dev;
+    tmp->map.ino = st.st_ino;
+
+    retval =
+        eroc_piece_table_create_lazy(
+            &tmp->pieces, (const char*)data, st.st_size);
+    if (0 != retval)
+    {
+        retval = 4;
+        goto cleanup_tmp;
+    }
+
+    /* the first line is indexed first, so the cursor holds it until the
+     * last line is known. */
+    eroc_buffer_cursor_move_head(tmp);
+    tmp->flags |= EROC_BUFFER_FLAG_CURSOR_PENDING;
+
+    /* success. */
+    *buffer = tmp;
+    *size = st.st_size;
+    retval = 0;
+    goto cleanup_fd;
+
+cleanup_tmp:
+    release_retval = eroc_buffer_release(tmp);
+    if (0 != release_retval)
+    {
+        retval = release_retval;
+    }
+    goto cleanup_fd;
+
+cleanup_data:
+    if (NULL != data)
+    {
+        (void)munmap(data, st.st_size);
+    }
+
+cleanup_fd:
+    /* the mapping stays valid after the descriptor is closed. */
+    release_retval = close(fd);
+    if (0 != release_retval && 0 == retval)
+    {
+        eroc_buffer_release(tmp);
+        *buffer = NULL;
+        *size = 0;
+        retval = 3;
+    }
+
+done:
+    return retval;
+}
@@ -0,0 +1,196 @@
+/**
+ * \file lib/eroc_buffer_load_mapped.c
+ *
+ * \brief Load a text file into a buffer by mapping it into memory.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/linetable.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define SCAN_BLOCK_SIZE                                         (1024 * 1024)
+
+/**
+ * \brief Attempt to load a text file with the given path into a buffer by
+ * mapping it into memory.
+ *
+ * Lines borrow their strings from the mapping until they are edited, so loading
+ * costs a newline scan rather than a copy and an allocation per line string.
+ * Files that can't be mapped, such as pipes or empty files, are loaded with
+ * \ref eroc_buffer_load instead.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the number of bytes read on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_mapped(
+    eroc_buffer** buffer, size_t* size, const char* path)
+{
+    int retval, release_retval;
+    eroc_buffer* tmp;
+    eroc_line_table* table;
+    eroc_buffer_line* bufline;
+    struct stat st;
+    void* data;
+    int fd;
+
+    /* attempt to open the file for reading. */
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    retval = fstat(fd, &st);
+    if (0 != retval)
+    {
+        retval = 1;
+        goto cleanup_fd;
+    }
+
+    /* only non-empty regular files can be mapped. */
+    if (!S_ISREG(st.st_mode) || 0 == st.st_size)
+    {
+        (void)close(fd);
+        return eroc_buffer_load(buffer, size, path);
+    }
+
+    /* map the file. Lines never write through this mapping. */
+    data = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED == data)
+    {
+        retval = 5;
+        goto cleanup_fd;
+    }
+
+    /* create a buffer. */
+    retval = eroc_buffer_create(&tmp);
+    if (0 != retval)
+    {
+        retval = 2;
+        goto cleanup_data;
+    }
+
+    /* from here on, the buffer owns the mapping. */
+    tmp->map.data = data;
+    tmp->map.size = st.st_size;
+    tmp->map.dev = st.st_dev;
+    tmp->map.ino = st.st_ino;
+
+    retval = eroc_line_table_create(&table);
+    if (0 != retval)
+    {
+        retval = 4;
+        goto cleanup_tmp;
+    }
+
+    /* split the mapping into borrowed lines, a block at a time so that the
+     * line table stays small. */
+    const char* text = (const char*)data;
+    size_t start = 0U;
+    for (
+        size_t block = 0U;
+        block < (size_t)st.st_size;
+        block += SCAN_BLOCK_SIZE)
+    {
+        size_t block_size = st.st_size - block;
+        if (block_size > SCAN_BLOCK_SIZE)
+        {
+            block_size = SCAN_BLOCK_SIZE;
+        }
+
+        retval = eroc_line_table_scan(table, text + block, block_size);
+        if (0 != retval)
+        {
+            retval = 4;
+            goto cleanup_table;
+        }
+
+        for (size_t i = 0; i < table->count; ++i)
+        {
+            size_t newline = block + table->newlines[i];
+
+            retval =
+                eroc_buffer_line_create_borrowed_in(
+                    &bufline, tmp, text + start, newline - start);
+            if (0 != retval)
+            {
+                retval = 4;
+                goto cleanup_table;
+            }
+
+            eroc_list_append(tmp->lines, &bufline->hdr);
+            start = newline + 1;
+        }
+    }
+
+    /* the final line may not end with a newline. */
+    if (start < (size_t)st.st_size)
+    {
+        retval =
+            eroc_buffer_line_create_borrowed_in(
+                &bufline, tmp, text + start, st.st_size - start);
+        if (0 != retval)
+        {
+            retval = 4;
+            goto cleanup_table;
+        }
+
+        eroc_list_append(tmp->lines, &bufline->hdr);
+    }
+
+    eroc_line_table_release(table);
+
+    /* index the lines all at once. */
+    eroc_buffer_index_build(tmp);
+
+    /* move the cursor to the end of the buffer. */
+    eroc_buffer_cursor_move_tail(tmp);
+
+    /* success. */
+    *buffer = tmp;
+    *size = st.st_size;
+    retval = 0;
+    goto cleanup_fd;
+
+cleanup_table:
+    eroc_line_table_release(table);
+
+cleanup_tmp:
+    release_retval = eroc_buffer_release(tmp);
+    if (0 != release_retval)
+    {
+        retval = release_retval;
+    }
+    goto cleanup_fd;
+
+cleanup_data:
+    (void)munmap(data, st.st_size);
+
+cleanup_fd:
+    /* the mapping stays valid after the descriptor is closed. */
+    release_retval = close(fd);
+    if (0 != release_retval && 0 == retval)
+    {
+        eroc_buffer_release(tmp);
+        *buffer = NULL;
+        *size = 0;
+        retval = 3;
+    }
+
+done:
+    return retval;
+}
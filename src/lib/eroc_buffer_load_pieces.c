@@ -0,0 +1,63 @@
+/**
+ * \file lib/eroc_buffer_load_pieces.c
+ *
+ * \brief Load a text file into a piece table buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Attempt to load a text file with the given path into a piece table
+ * buffer.
+ *
+ * The file is mapped into memory and becomes the original text of the buffer's
+ * piece table, so loading costs a newline scan and a few bytes of index per
+ * line, and no line is created until it is edited. Files that can't be mapped,
+ * such as pipes, are loaded with \ref eroc_buffer_load instead.
+ *
+ * This is \ref eroc_buffer_load_lazy, followed by a wait for the file to be
+ * indexed so that the cursor can start on the last line.
+ *
+ * \note The file must not be truncated by another process while the buffer is
+ * open.
+ *
+ * \param buffer            Pointer to the buffer pointer to be set with this
+ *                          loaded file on success.
+ * \param size              Set to the number of bytes read on success.
+ * \param path              Path to the file to load.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_load_pieces(
+    eroc_buffer** buffer, size_t* size, const char* path)
+{
+    int retval;
+    eroc_buffer* tmp;
+
+    retval = eroc_buffer_load_lazy(&tmp, size, path);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    /* a file that couldn't be mapped was loaded into a list buffer. */
+    if (NULL != tmp->pieces)
+    {
+        retval = eroc_piece_table_finish(tmp->pieces);
+        if (0 != retval)
+        {
+            (void)eroc_buffer_release(tmp);
+            *size = 0;
+            return 4;
+        }
+
+        /* move the cursor to the end of the buffer. */
+        eroc_buffer_cursor_move_tail(tmp);
+    }
+
+    *buffer = tmp;
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * \file lib/eroc_buffer_mapping_detach.c
+ *
+ * \brief Copy a buffer's file mapping into private memory.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* the mapping is copied a chunk at a time; a multiple of any page size. */
+#define DETACH_CHUNK_SIZE (256 * 1024)
+
+/**
+ * \brief Copy a buffer's file mapping into private memory, so that the file it
+ * was loaded from can be overwritten in place.
+ *
+ * \param buffer            The buffer whose mapping is copied.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_buffer_mapping_detach(const eroc_buffer* buffer)
+{
+    int retval;
+    char* data = (char*)buffer->map.data;
+    char* chunk;
+    size_t length;
+
+    if (NULL == data)
+    {
+        return 0;
+    }
+
+    chunk = (char*)malloc(DETACH_CHUNK_SIZE);
+    if (NULL == chunk)
+    {
+        return 1;
+    }
+
+    /* truncating a file takes even the copied pages of a private mapping of
+     * it, so each chunk is replaced with anonymous memory at the same address,
+     * which keeps every pointer into the mapping valid. */
+    for (size_t offset = 0; offset < buffer->map.size; offset += length)
+    {
+        length = buffer->map.size - offset;
+        if (length > DETACH_CHUNK_SIZE)
+        {
+            length = DETACH_CHUNK_SIZE;
+        }
+
+        memcpy(chunk, data + offset, length);
+
+        if (MAP_FAILED
+         == mmap(
+                data + offset, length, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0))
+        {
+            retval = 2;
+            goto cleanup_chunk;
+        }
+
+        memcpy(data + offset, chunk, length);
+    }
+
+    /* nothing writes through the mapping. */
+    (void)mprotect(data, buffer->map.size, PROT_READ);
+
+    /* success. */
+    retval = 0;
+    goto cleanup_chunk;
+
+cleanup_chunk:
+    free(chunk);
+
+    return retval;
+}
@@ -0,0 +1,203 @@
+/**
+ * \file lib/eroc_buffer_mark.c
+ *
+ * \brief Mark the lines of a buffer which match a pattern.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/regex.h>
+#include <eroc/threadpool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ranges smaller than this are marked on the calling thread. */
+#define MIN_CHUNK_LINES 16384
+
+/* split the range into this many chunks per worker, to balance the load. */
+#define CHUNKS_PER_WORKER 4
+
+/**
+ * \brief Shared state for the mark tasks.
+ */
+typedef struct mark_context mark_context;
+
+struct mark_context
+{
+    eroc_buffer* buffer;
+    /* one regex per worker, since searches update the DFA cache. */
+    eroc_regex** regexes;
+    bool invert;
+    unsigned long start;
+    unsigned long end;
+    unsigned long chunk_lines;
+    /* number of lines marked by each chunk. */
+    unsigned long* chunk_marked;
+};
+
+/* forward decls. */
+static void mark_chunk(void* context, size_t worker, size_t chunk);
+
+/**
+ * \brief Mark every line in the range [start, end] which matches the given
+ * pattern, or which doesn't match it if invert is set.
+ *
+ * Lines are tested in parallel, in contiguous chunks spread across a pool of
+ * worker threads. Marks from any previous call are cleared first.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param pattern           The pattern to match.
+ * \param invert            If true, mark the lines which don't match.
+ * \param start             The first line of the range.
+ * \param end               The last line of the range.
+ * \param workers           The number of worker threads, or 0 for one per
+ *                          online CPU.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_mark(
+    eroc_buffer* buffer, const char* pattern, bool invert, unsigned long start,
+    unsigned long end, size_t workers)
+{
+    int retval;
+    mark_context ctx;
+    eroc_thread_pool* pool = NULL;
+    size_t regex_count = 0;
+    size_t chunk_count;
+    unsigned long lines;
+
+    eroc_buffer_mark_clear(buffer);
+
+    if (end < start || end >= buffer->lines->count)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    lines = end - start + 1;
+    if (0 == workers)
+    {
+        workers = eroc_thread_pool_cpu_count();
+    }
+
+    /* small ranges aren't worth the cost of starting threads. */
+    if (lines < 2 * MIN_CHUNK_LINES)
+    {
+        workers = 1;
+    }
+
+    memset(&ctx, 0, sizeof(ctx));
+    ctx.buffer = buffer;
+    ctx.invert = invert;
+    ctx.start = start;
+    ctx.end = end;
+    ctx.chunk_lines = lines / (workers * CHUNKS_PER_WORKER);
+    if (ctx.chunk_lines < MIN_CHUNK_LINES)
+    {
+        ctx.chunk_lines = MIN_CHUNK_LINES;
+    }
+    chunk_count = (lines + ctx.chunk_lines - 1) / ctx.chunk_lines;
+
+    ctx.chunk_marked =
+        (unsigned long*)calloc(chunk_count, sizeof(unsigned long));
+    ctx.regexes = (eroc_regex**)calloc(workers, sizeof(eroc_regex*));
+    if (NULL == ctx.chunk_marked || NULL == ctx.regexes)
+    {
+        retval = 2;
+        goto cleanup_ctx;
+    }
+
+    for (; regex_count < workers; ++regex_count)
+    {
+        retval = eroc_regex_create(ctx.regexes + regex_count, pattern);
+        if (0 != retval)
+        {
+            goto cleanup_ctx;
+        }
+    }
+
+    if (1 == workers || 1 == chunk_count)
+    {
+        for (size_t i = 0; i < chunk_count; ++i)
+        {
+            mark_chunk(&ctx, 0, i);
+        }
+    }
+    else
+    {
+        retval = eroc_thread_pool_create(&pool, workers);
+        if (0 != retval)
+        {
+            goto cleanup_ctx;
+        }
+
+        eroc_thread_pool_run(pool, &mark_chunk, &ctx, chunk_count);
+        eroc_thread_pool_release(pool);
+    }
+
+    for (size_t i = 0; i < chunk_count; ++i)
+    {
+        buffer->marked += ctx.chunk_marked[i];
+    }
+
+    /* success. */
+    retval = 0;
+    goto cleanup_ctx;
+
+cleanup_ctx:
+    for (size_t i = 0; i < regex_count; ++i)
+    {
+        eroc_regex_release(ctx.regexes[i]);
+    }
+    free(ctx.regexes);
+    free(ctx.chunk_marked);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Mark the matching lines of one chunk.
+ *
+ * Each chunk is a contiguous run of lines, found with one index lookup and
+ * then walked in list order. Only this task touches the flags of these lines.
+ *
+ * \param context       The mark context.
+ * \param worker        The worker running this task.
+ * \param chunk         The chunk to mark.
+ */
+static void mark_chunk(void* context, size_t worker, size_t chunk)
+{
+    mark_context* ctx = (mark_context*)context;
+    eroc_regex* regex = ctx->regexes[worker];
+    unsigned long first = ctx->start + chunk * ctx->chunk_lines;
+    unsigned long count = ctx->chunk_lines;
+    unsigned long marked = 0;
+    eroc_buffer_line* line;
+
+    if (count > ctx->end - first + 1)
+    {
+        count = ctx->end - first + 1;
+    }
+
+    if (0 != eroc_buffer_line_at(&line, ctx->buffer, first))
+    {
+        return;
+    }
+
+    for (; count > 0 && NULL != line; --count)
+    {
+        if (ctx->invert
+         != eroc_regex_search(regex, NULL, line->line, line->length))
+        {
+            line->flags |= EROC_BUFFER_LINE_FLAG_MARKED;
+            ++marked;
+        }
+
+        line = (eroc_buffer_line*)line->hdr.next;
+    }
+
+    ctx->chunk_marked[chunk] = marked;
+}
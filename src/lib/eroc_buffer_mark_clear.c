@@ -0,0 +1,31 @@
+/**
+ * \file lib/eroc_buffer_mark_clear.c
+ *
+ * \brief Clear every mark in a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Clear every mark in the buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+void eroc_buffer_mark_clear(eroc_buffer* buffer)
+{
+    eroc_list_node* node = buffer->lines->head;
+
+    for (; buffer->marked > 0 && NULL != node; node = node->next)
+    {
+        eroc_buffer_line* line = (eroc_buffer_line*)node;
+
+        if (line->flags & EROC_BUFFER_LINE_FLAG_MARKED)
+        {
+            line->flags &= ~EROC_BUFFER_LINE_FLAG_MARKED;
+            --buffer->marked;
+        }
+    }
+}
@@ -0,0 +1,177 @@
+/**
+ * \file lib/eroc_buffer_materialize.c
+ *
+ * \brief Turn a piece table buffer into a list buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <string.h>
+
+/* forward decls. */
+static int piece_materialize(
+    eroc_buffer* buffer, const eroc_piece_table* table,
+    const eroc_piece* piece);
+static void lines_discard(eroc_buffer* buffer);
+
+/**
+ * \brief Turn a piece table buffer into a list buffer, so that it supports
+ * every buffer operation.
+ *
+ * Lines of the original text borrow their strings from the buffer's file
+ * mapping, as with \ref eroc_buffer_load_mapped; added lines are copied. The
+ * cursor stays on the same line number, and the conversion isn't recorded in
+ * the journal. This does nothing to a list buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the buffer is
+ * unchanged.
+ */
+int eroc_buffer_materialize(eroc_buffer* buffer)
+{
+    int retval;
+    eroc_piece_table* table = buffer->pieces;
+    eroc_buffer_journal* journal = buffer->journal;
+    unsigned long lineno = buffer->lineno;
+
+    if (NULL == table)
+    {
+        return 0;
+    }
+
+    retval = eroc_piece_table_finish(table);
+    if (0 != retval)
+    {
+        return 1;
+    }
+
+    /* from here on, the buffer appends to its list. */
+    buffer->pieces = NULL;
+    buffer->journal = NULL;
+    buffer->cursor = NULL;
+
+    for (
+        eroc_avl_tree_node* node =
+            (NULL == table->pieces->root)
+                ? NULL
+                : eroc_avl_tree_minimum_node(
+                    table->pieces, table->pieces->root);
+        NULL != node;
+        node = eroc_avl_tree_successor_node(table->pieces, node))
+    {
+        retval = piece_materialize(buffer, table, (const eroc_piece*)node);
+        if (0 != retval)
+        {
+            lines_discard(buffer);
+            buffer->pieces = table;
+            buffer->journal = journal;
+            (void)eroc_buffer_cursor_move(buffer, lineno);
+            return 2;
+        }
+    }
+
+    /* index the lines all at once. */
+    eroc_buffer_index_build(buffer);
+
+    buffer->journal = journal;
+    eroc_piece_table_release(table);
+    memset(&buffer->view, 0, sizeof(buffer->view));
+
+    if (0 != eroc_buffer_cursor_move(buffer, lineno))
+    {
+        eroc_buffer_cursor_move_tail(buffer);
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Append the lines of a piece to the end of a buffer's list, leaving
+ * them out of the index.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param table             The table that holds the piece.
+ * \param piece             The piece to append.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int piece_materialize(
+    eroc_buffer* buffer, const eroc_piece_table* table,
+    const eroc_piece* piece)
+{
+    int retval;
+    eroc_buffer_line* line;
+
+    if (piece->added)
+    {
+        for (size_t i = piece->first; i < piece->first + piece->lines; ++i)
+        {
+            retval =
+                eroc_buffer_line_create_in(
+                    &line, buffer, table->added[i].text,
+                    table->added[i].length);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            eroc_list_append(buffer->lines, &line->hdr);
+        }
+
+        return 0;
+    }
+
+    /* every line of an original piece ends with a newline. */
+    const char* text = table->original + piece->offset;
+    const char* end = text + piece->length;
+    while (text < end)
+    {
+        const char* newline = (const char*)memchr(text, '\n', end - text);
+
+        retval =
+            eroc_buffer_line_create_borrowed_in(
+                &line, buffer, text, newline - text);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        eroc_list_append(buffer->lines, &line->hdr);
+        text = newline + 1;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Release every line in a buffer's list, after a failed conversion.
+ *
+ * \param buffer            The buffer for this operation.
+ */
+static void lines_discard(eroc_buffer* buffer)
+{
+    eroc_list_node* node = buffer->lines->head;
+
+    while (NULL != node)
+    {
+        eroc_list_node* next = node->next;
+        eroc_buffer_line* line = (eroc_buffer_line*)node;
+
+        if (0 == (line->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+        {
+            --buffer->heap_lines;
+        }
+
+        eroc_buffer_line_recycle(buffer, line);
+        node = next;
+    }
+
+    buffer->lines->head = buffer->lines->tail = NULL;
+    buffer->lines->count = 0;
+    (void)eroc_avl_tree_clear(buffer->index);
+    buffer->cursor = NULL;
+    buffer->lineno = 0;
+}
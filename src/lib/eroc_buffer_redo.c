@@ -0,0 +1,48 @@
+/**
+ * \file lib/eroc_buffer_redo.c
+ *
+ * \brief Redo the group of changes to a buffer undone most recently.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Redo the group of changes that was undone most recently.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero if there is nothing to redo.
+ */
+int eroc_buffer_redo(eroc_buffer* buffer)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* record;
+    unsigned long group;
+
+    if (NULL == journal)
+    {
+        return 1;
+    }
+
+    record =
+        (NULL != journal->current) ? journal->current->next : journal->head;
+    if (NULL == record)
+    {
+        return 1;
+    }
+
+    group = record->group;
+    while (NULL != record && record->group == group)
+    {
+        eroc_buffer_journal_record_apply(buffer, record);
+        journal->current = record;
+        record = record->next;
+    }
+
+    eroc_buffer_journal_trim(buffer);
+
+    return 0;
+}
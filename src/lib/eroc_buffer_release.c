@@ -10,6 +10,7 @@
 #include <eroc/buffer.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 
 /**
  * \brief Release a buffer.
@@ -27,8 +28,45 @@ int eroc_buffer_release(eroc_buffer* buffer)
         free(buffer->name);
     }
 
+    /* the journal's lines come from the arena, so release them first. */
+    if (NULL != buffer->journal)
+    {
+        eroc_buffer_journal_release(buffer);
+    }
+
+    /* the list owns the lines, so the index drops them in one call. */
+    (void)eroc_avl_tree_release(buffer->index);
+
+    /* only lines from outside of the arena need to be released one by one;
+     * the rest go with the arena. */
+    if (buffer->heap_lines > 0)
+    {
+        eroc_list_node* node = buffer->lines->head;
+        while (NULL != node)
+        {
+            eroc_list_node* next = node->next;
+            (void)eroc_buffer_line_release((eroc_buffer_line*)node);
+            node = next;
+        }
+    }
+
+    buffer->lines->head = buffer->lines->tail = NULL;
+    buffer->lines->count = 0;
     retval = eroc_list_release(buffer->lines);
 
+    eroc_arena_release(buffer->arena);
+
+    if (NULL != buffer->pieces)
+    {
+        eroc_piece_table_release(buffer->pieces);
+    }
+
+    /* the mapping must outlive every line that borrows from it. */
+    if (NULL != buffer->map.data)
+    {
+        (void)munmap(buffer->map.data, buffer->map.size);
+    }
+
     free(buffer);
 
     return retval;
@@ -9,19 +9,113 @@
 
 #include <eroc/buffer.h>
 
+/* forward decls. */
+static int pieces_replace(
+    eroc_buffer* buffer, eroc_buffer_line* oldline, eroc_buffer_line* newline);
+
 /**
  * \brief Replace oldline with newline.
  *
- * \note After this operation, the caller owns oldline.
+ * \note The buffer releases oldline, or moves it into its journal, unless the
+ * buffer is a piece table buffer, in which case oldline is the view, which the
+ * buffer keeps, and newline is copied and released.
  *
  * \param buffer            The buffer for this replace operation.
- * \param oldline           The line to replace, owned by caller after the
- *                          operation.
+ * \param oldline           The line to replace.
  * \param newline           The line that \p oldline is replaced with, owned by
  *                          the buffer after the operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case nothing
+ * changes. Replacing a line of a list buffer never fails.
  */
-void eroc_buffer_replace(
+int eroc_buffer_replace(
     eroc_buffer* buffer, eroc_buffer_line* oldline, eroc_buffer_line* newline)
 {
+    if (NULL != buffer->pieces)
+    {
+        return pieces_replace(buffer, oldline, newline);
+    }
+
+    /* the replaced line takes its mark with it. */
+    if (oldline->flags & EROC_BUFFER_LINE_FLAG_MARKED)
+    {
+        oldline->flags &= ~EROC_BUFFER_LINE_FLAG_MARKED;
+        --buffer->marked;
+    }
+
+    if (0 == (oldline->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        --buffer->heap_lines;
+    }
+
+    if (0 == (newline->flags & EROC_BUFFER_LINE_FLAG_ARENA))
+    {
+        ++buffer->heap_lines;
+    }
+
     eroc_list_node_splice(buffer->lines, &oldline->hdr, &newline->hdr);
+    eroc_avl_tree_replace_node(buffer->index, &oldline->index, &newline->index);
+
+    if (buffer->cursor == oldline)
+    {
+        buffer->cursor = newline;
+    }
+
+    if (NULL == buffer->journal
+     || !eroc_buffer_journal_replace(
+            buffer, oldline,
+            eroc_avl_tree_rank(buffer->index, &newline->index)))
+    {
+        eroc_buffer_line_recycle(buffer, oldline);
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Replace the cursor's line of a piece table buffer with a copy of the
+ * given line.
+ *
+ * \param buffer            The buffer for this replace operation.
+ * \param oldline           The cursor.
+ * \param newline           The new line, which is released on success.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int pieces_replace(
+    eroc_buffer* buffer, eroc_buffer_line* oldline, eroc_buffer_line* newline)
+{
+    int retval;
+    size_t lineno = buffer->lineno;
+
+    if (NULL == oldline || oldline != buffer->cursor)
+    {
+        return 1;
+    }
+
+    /* the insert uses at most two pieces, which leaves one for the delete. */
+    retval = eroc_piece_table_reserve(buffer->pieces, 3);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    retval =
+        eroc_piece_table_insert(
+            buffer->pieces, lineno, newline->line, newline->length);
+    if (0 != retval)
+    {
+        return 3;
+    }
+
+    retval = eroc_piece_table_delete(buffer->pieces, lineno + 1);
+    if (0 != retval)
+    {
+        return 4;
+    }
+
+    eroc_buffer_line_recycle(buffer, newline);
+
+    /* point the view at the new text. */
+    return eroc_buffer_cursor_move(buffer, lineno);
 }
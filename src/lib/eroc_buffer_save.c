@@ -8,51 +8,156 @@
  */
 
 #include <eroc/buffer.h>
-#include <stdio.h>
-#include <string.h>
+#include <eroc/writer.h>
+#include <errno.h>
+#include <sys/stat.h>
+
+/* forward decls. */
+static int contents_write(const eroc_buffer* buffer, size_t* size, int fd);
 
 /**
  * \brief Save the contents of the given buffer into the file at the given path.
  *
+ * The buffer is written to a temporary file next to the target, which is
+ * synced and then renamed over the target, so a failed save leaves the old
+ * file as it was. See \ref eroc_writer_file_open for how permissions, symbolic
+ * links, and special files are handled.
+ *
+ * Renaming leaves the old file alive for any lines borrowed from a mapping of
+ * it. A target that is written in place instead, such as a file with other
+ * hard links, may be the mapped file itself, which is the case if its device
+ * and inode match the mapping's. Then the mapping is first copied into private
+ * memory with \ref eroc_buffer_mapping_detach, and the file is only cut to its
+ * new length once all of it has been written.
+ *
  * \param buffer            The buffer to save.
  * \param size              The number of bytes written on success.
  * \param path              The path to which the buffer is saved.
  *
- * \returns 0 on success and non-zero on failure.
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
  */
 int eroc_buffer_save(const eroc_buffer* buffer, size_t* size, const char* path)
 {
     int retval;
-    FILE* fp;
+    eroc_writer_file* file;
+    struct stat st;
+
+    /* the pieces of a piece table are built once its text is indexed. */
+    if (NULL != buffer->pieces)
+    {
+        retval = eroc_piece_table_finish(buffer->pieces);
+        if (0 != retval)
+        {
+            errno = ENOMEM;
+            return 4;
+        }
+    }
+
+    retval = eroc_writer_file_open(&file, path);
+    if (0 != retval)
+    {
+        return 1;
+    }
+
+    /* overwriting the mapped file would pull the lines out from under us. */
+    if (NULL == file->temp && NULL != buffer->map.data)
+    {
+        if (0 != fstat(file->fd, &st))
+        {
+            eroc_writer_file_abort(file);
+            return 5;
+        }
+
+        if (st.st_dev == buffer->map.dev && st.st_ino == buffer->map.ino
+         && 0 != eroc_buffer_mapping_detach(buffer))
+        {
+            eroc_writer_file_abort(file);
+            return 6;
+        }
+    }
+
+    retval = contents_write(buffer, size, file->fd);
+    if (0 != retval)
+    {
+        eroc_writer_file_abort(file);
+        return 2;
+    }
+
+    retval = eroc_writer_file_commit(file);
+    if (0 != retval)
+    {
+        return 3;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Write the contents of a buffer to a file descriptor.
+ *
+ * \param buffer            The buffer to write.
+ * \param size              Set to the number of bytes written on success.
+ * \param fd                The file descriptor to write to.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int contents_write(const eroc_buffer* buffer, size_t* size, int fd)
+{
+    int retval, saved_errno;
+    eroc_writer* writer;
 
-    /* attempt to open the file for writing. */
-    fp = fopen(path, "w");
-    if (NULL == fp)
+    retval = eroc_writer_create(&writer, fd);
+    if (0 != retval)
     {
-        retval = 1;
-        goto done;
+        return 1;
     }
 
-    /* start with 0 bytes. */
-    *size = 0U;
+    /* a piece table writes its pieces. */
+    if (NULL != buffer->pieces)
+    {
+        retval = eroc_piece_table_write(writer, buffer->pieces);
+        if (0 != retval)
+        {
+            goto cleanup_writer;
+        }
+
+        goto flush;
+    }
 
-    /* while there are lines to write, write them. */
     for (
         eroc_buffer_line* line = (eroc_buffer_line*)buffer->lines->head;
         NULL != line;
         line = (eroc_buffer_line*)line->hdr.next)
     {
-        fprintf(fp, "%s\n", line->line);
-        *size += strlen(line->line) + 1;
+        retval = eroc_writer_add(writer, line->line, line->length);
+        if (0 != retval)
+        {
+            goto cleanup_writer;
+        }
+
+        retval = eroc_writer_add(writer, "\n", 1);
+        if (0 != retval)
+        {
+            goto cleanup_writer;
+        }
+    }
+
+flush:
+    retval = eroc_writer_flush(writer);
+    if (0 != retval)
+    {
+        goto cleanup_writer;
     }
 
-    /* success. */
+    /* the count is what reached the file, not what was asked for. */
+    *size = writer->written;
     retval = 0;
-    goto cleanup_fp;
 
-cleanup_fp:
-    retval = fclose(fp);
+cleanup_writer:
+    saved_errno = errno;
+    eroc_writer_release(writer);
+    errno = saved_errno;
 
-done:
     return retval;
 }
@@ -0,0 +1,114 @@
+/**
+ * \file lib/eroc_buffer_substitute.c
+ *
+ * \brief Apply a substitution to a range of lines.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Apply a substitution to every line in the range [start, end].
+ *
+ * Each changed line is rewritten in place when the result fits in its
+ * capacity, unless the buffer keeps a journal, in which case the line is
+ * replaced so that the journal can keep the old one. The cursor is moved to
+ * the last changed line.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param substitution      The substitution to apply.
+ * \param start             The first line of the range.
+ * \param end               The last line of the range.
+ * \param count             Set to the number of lines changed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_substitute(
+    eroc_buffer* buffer, eroc_regex_substitution* substitution,
+    unsigned long start, unsigned long end, unsigned long* count)
+{
+    int retval;
+    eroc_buffer_line *line, *next, *newline;
+    eroc_buffer_line* last = NULL;
+    unsigned long lastno = 0;
+    unsigned long changed = 0;
+    size_t replaced;
+
+    if (start > end || end >= buffer->lines->count)
+    {
+        return 1;
+    }
+
+    retval = eroc_buffer_line_at(&line, buffer, start);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    for (unsigned long i = start; i <= end; ++i)
+    {
+        retval =
+            eroc_regex_substitution_apply(
+                substitution, &replaced, line->line, line->length);
+        if (0 != retval)
+        {
+            goto done;
+        }
+
+        next = (eroc_buffer_line*)line->hdr.next;
+
+        if (replaced > 0 && NULL != buffer->journal)
+        {
+            retval =
+                eroc_buffer_line_create_in(
+                    &newline, buffer, substitution->result,
+                    substitution->result_length);
+            if (0 != retval)
+            {
+                goto done;
+            }
+
+            (void)eroc_buffer_replace(buffer, line, newline);
+            line = newline;
+        }
+        else if (replaced > 0)
+        {
+            retval =
+                eroc_buffer_line_set(
+                    buffer, line, substitution->result,
+                    substitution->result_length);
+            if (0 != retval)
+            {
+                goto done;
+            }
+        }
+
+        if (replaced > 0)
+        {
+            buffer->flags |= EROC_BUFFER_FLAG_MODIFIED;
+            last = line;
+            lastno = i;
+            ++changed;
+        }
+
+        line = next;
+    }
+
+    /* success. */
+    retval = 0;
+    goto done;
+
+done:
+    /* the lines changed before a failure stay changed. */
+    if (NULL != last)
+    {
+        buffer->cursor = last;
+        buffer->lineno = lastno;
+    }
+
+    *count = changed;
+
+    return retval;
+}
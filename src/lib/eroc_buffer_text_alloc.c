@@ -0,0 +1,62 @@
+/**
+ * \file lib/eroc_buffer_text_alloc.c
+ *
+ * \brief Allocate a line string from a buffer's arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <string.h>
+
+/* released strings smaller than this can't hold a free list link. */
+#define MIN_CLASS 3
+
+/**
+ * \brief Allocate a line string from the buffer's arena, reusing a released
+ * string if one is large enough.
+ *
+ * \param text              Pointer to be set to the string on success.
+ * \param capacity          Set to the string's capacity, not counting its NUL
+ *                          terminator, on success.
+ * \param buffer            The buffer whose arena holds this string.
+ * \param length            The least capacity needed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_buffer_text_alloc(
+    char** text, size_t* capacity, eroc_buffer* buffer, size_t length)
+{
+    size_t size = length + 1;
+    size_t k = MIN_CLASS;
+    char* tmp;
+
+    /* every released string in class k holds at least 2^k bytes, so the
+     * smallest class that can satisfy this request is the ceiling of log2. */
+    while (k < EROC_BUFFER_TEXT_CLASSES && ((size_t)1 << k) < size)
+    {
+        ++k;
+    }
+
+    if (k < EROC_BUFFER_TEXT_CLASSES && NULL != buffer->free_text[k])
+    {
+        tmp = buffer->free_text[k];
+        memcpy(&buffer->free_text[k], tmp, sizeof(char*));
+
+        *text = tmp;
+        *capacity = ((size_t)1 << k) - 1;
+        return 0;
+    }
+
+    /* strings need no alignment. */
+    tmp = (char*)eroc_arena_alloc(buffer->arena, size, 1);
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    *text = tmp;
+    *capacity = length;
+    return 0;
+}
@@ -0,0 +1,44 @@
+/**
+ * \file lib/eroc_buffer_text_free.c
+ *
+ * \brief Release a line string to a buffer's arena.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <string.h>
+
+/* released strings smaller than this can't hold a free list link. */
+#define MIN_CLASS 3
+
+/**
+ * \brief Release a line string allocated from the buffer's arena, so that it
+ * can be reused.
+ *
+ * \param buffer            The buffer whose arena holds this string.
+ * \param text              The string to release.
+ * \param capacity          The string's capacity.
+ */
+void eroc_buffer_text_free(eroc_buffer* buffer, char* text, size_t capacity)
+{
+    size_t size = capacity + 1;
+    size_t k = MIN_CLASS;
+
+    /* tiny strings stay in the arena until the buffer is released. */
+    if (size < ((size_t)1 << MIN_CLASS))
+    {
+        return;
+    }
+
+    /* file the string under the largest class that it can satisfy. */
+    while (k + 1 < EROC_BUFFER_TEXT_CLASSES && ((size_t)1 << (k + 1)) <= size)
+    {
+        ++k;
+    }
+
+    /* the string may not be aligned, so copy the link in. */
+    memcpy(text, &buffer->free_text[k], sizeof(char*));
+    buffer->free_text[k] = text;
+}
@@ -0,0 +1,47 @@
+/**
+ * \file lib/eroc_buffer_undo.c
+ *
+ * \brief Undo the most recent group of changes to a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+
+/**
+ * \brief Undo the most recent group of changes that hasn't been undone.
+ *
+ * The records of the group are applied newest first, so every record finds the
+ * buffer as it was just after its change.
+ *
+ * \param buffer            The buffer for this operation.
+ *
+ * \returns 0 on success and non-zero if there is nothing to undo.
+ */
+int eroc_buffer_undo(eroc_buffer* buffer)
+{
+    eroc_buffer_journal* journal = buffer->journal;
+    eroc_buffer_journal_record* record;
+    unsigned long group;
+
+    if (NULL == journal || NULL == journal->current)
+    {
+        return 1;
+    }
+
+    record = journal->current;
+    group = record->group;
+    while (NULL != record && record->group == group)
+    {
+        eroc_buffer_journal_record_apply(buffer, record);
+        record = record->prev;
+    }
+
+    journal->current = record;
+
+    /* undone lines may be larger than the lines that they replaced. */
+    eroc_buffer_journal_trim(buffer);
+
+    return 0;
+}
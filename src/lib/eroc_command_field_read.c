@@ -0,0 +1,66 @@
+/**
+ * \file lib/eroc_command_field_read.c
+ *
+ * \brief Read one delimited field of a command's parameters.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Read one delimited field of a command's parameters, such as the re in
+ * g/re/cmd or the re and repl in s/re/repl/.
+ *
+ * The field ends at the first unescaped delimiter, or at the end of input. An
+ * escaped delimiter is copied as a bare delimiter; any other escape is copied
+ * unchanged, so that it can be interpreted by the consumer of the field.
+ *
+ * \param field             Pointer to be set to the field, which the caller
+ *                          must free.
+ * \param input             Pointer to the input, which is advanced past the
+ *                          field and its closing delimiter, if any.
+ * \param delimiter         The delimiter.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_field_read(char** field, const char** input, char delimiter)
+{
+    const char* in = *input;
+    char* out;
+
+    *field = out = (char*)malloc(strlen(in) + 1);
+    if (NULL == out)
+    {
+        return 1;
+    }
+
+    for (; *in && delimiter != *in; ++in)
+    {
+        /* an escaped delimiter is a literal delimiter. */
+        if ('\\' == *in && delimiter == in[1])
+        {
+            ++in;
+        }
+        else if ('\\' == *in && 0 != in[1])
+        {
+            *out++ = *in++;
+        }
+
+        *out++ = *in;
+    }
+
+    *out = 0;
+
+    if (delimiter == *in)
+    {
+        ++in;
+    }
+
+    *input = in;
+
+    return 0;
+}
@@ -30,7 +30,10 @@ int eroc_command_function_advance(eroc_command* command)
 
     if (NULL != command->buffer->cursor)
     {
-        printf("%s\n", command->buffer->cursor->line);
+        fwrite(
+            command->buffer->cursor->line, 1, command->buffer->cursor->length,
+            stdout);
+        printf("\n");
     }
     else
     {
@@ -22,14 +22,23 @@
 int eroc_command_function_change(eroc_command* command)
 {
     int retval;
-    bool last_line = false;
+    unsigned long last = command->buffer->lineno;
+    bool last_line;
 
-    /* is this the last line in the buffer? */
-    if (NULL == command->buffer->cursor
-     || NULL == command->buffer->cursor->hdr.next)
+    /* find the last line of the range. */
+    if (command->end_provided)
     {
-        last_line = true;
+        last = command->end;
     }
+    else if (command->start_provided)
+    {
+        last = command->start;
+    }
+
+    /* does the range run to the end of the buffer? */
+    last_line =
+        NULL == command->buffer->cursor
+     || last + 1 >= command->buffer->lines->count;
 
     /* first, delete all lines in this range. */
     retval = eroc_command_function_delete(command);
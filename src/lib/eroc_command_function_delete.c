@@ -48,7 +48,7 @@ int eroc_command_function_delete(eroc_command* command)
     }
 
     /* move to the line indicated by start. */
-    retval = eroc_buffer_cursor_move(command->buffer, start);
+    retval = eroc_buffer_cursor_seek(command->buffer, start);
     if (0 != retval)
     {
         return retval;
@@ -34,11 +34,11 @@ int eroc_command_function_display_line_number(eroc_command* command)
     /* otherwise, use the current line number. */
     else
     {
-        lineno = command->buffer->lines->count - 1;
+        lineno = eroc_buffer_line_count(command->buffer) - 1;
     }
 
     /* it's an error if this line number is out of range. */
-    if (lineno > command->buffer->lines->count)
+    if (lineno > eroc_buffer_line_count(command->buffer))
     {
         return 1;
     }
@@ -0,0 +1,22 @@
+/**
+ * \file lib/eroc_command_function_global_invert.c
+ *
+ * \brief Run a command on every line not matching a pattern: v/re/cmd.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+
+/**
+ * \brief Run a command on every line not matching a pattern: v/re/cmd.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_global_invert(eroc_command* command)
+{
+    return eroc_command_global(command, true);
+}
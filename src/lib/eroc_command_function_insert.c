@@ -10,9 +10,9 @@
 #include <eroc/command.h>
 #include <stdlib.h>
 #include <stdio.h>
-#include <string.h>
 
-static int read_line(char** input_line);
+static int read_line(
+    char** input_line, size_t* linecap, size_t* length, FILE* input);
 
 /**
  * \brief Insert lines terminated by . to the buffer.
@@ -25,6 +25,8 @@ int eroc_command_function_insert(eroc_command* command)
 {
     int retval;
     char* input_line = NULL;
+    size_t linecap = 0;
+    size_t length;
     eroc_buffer_line* buffer_line = NULL;
     size_t insert_lines = 0;
 
@@ -32,7 +34,7 @@ int eroc_command_function_insert(eroc_command* command)
     if (command->start_provided)
     {
         /* move to this start address. */
-        retval = eroc_buffer_cursor_move(command->buffer, command->start);
+        retval = eroc_buffer_cursor_seek(command->buffer, command->start);
         if (0 != retval)
         {
             return retval;
@@ -48,15 +50,16 @@ int eroc_command_function_insert(eroc_command* command)
     for (;;)
     {
         /* read an insert line from standard input. */
-        retval = read_line(&input_line);
+        retval = read_line(&input_line, &linecap, &length, command->input);
         if (retval < 0)
         {
-            clearerr(stdin);
+            free(input_line);
+            clearerr(command->input);
             return 1;
         }
 
         /* a dot terminates this insert operation. */
-        if (!strcmp(input_line, "."))
+        if (1 == length && '.' == input_line[0])
         {
             free(input_line);
 
@@ -70,8 +73,11 @@ int eroc_command_function_insert(eroc_command* command)
             return 0;
         }
 
-        /* create a buffer line. */
-        retval = eroc_buffer_line_create(&buffer_line, input_line);
+        /* copy this line into the buffer's arena; the input line is reused
+         * for the next line. */
+        retval =
+            eroc_buffer_line_create_in(
+                &buffer_line, command->buffer, input_line, length);
         if (0 != retval)
         {
             free(input_line);
@@ -90,32 +96,35 @@ int eroc_command_function_insert(eroc_command* command)
 }
 
 /**
- * \brief Read a line from standard input.
+ * \brief Read a line from the given input.
+ *
+ * The line may hold embedded NULs, so its length is returned as well.
  *
- * \param input_line            Pointer to the character pointer to store this
- *                              line on success.
+ * \param input_line            Pointer to the line buffer, which is grown as
+ *                              needed and reused between calls.
+ * \param linecap               Pointer to the capacity of the line buffer.
+ * \param length                Pointer to the length to set to the length of
+ *                              the line, without its newline, on success.
+ * \param input                 The input from which the line is read.
  *
  * \returns 0 on success and -1 on failure.
  */
-static int read_line(char** input_line)
+static int read_line(
+    char** input_line, size_t* linecap, size_t* length, FILE* input)
 {
-    size_t linecap = 0;
-    char* line = NULL;
-
-    ssize_t read_bytes = getline(&line, &linecap, stdin);
+    ssize_t read_bytes = getline(input_line, linecap, input);
     if (read_bytes < 0)
     {
-        free(line);
         return -1;
     }
     else if (read_bytes > 0)
     {
-        if ('\n' == line[read_bytes - 1])
+        if ('\n' == (*input_line)[read_bytes - 1])
         {
-            line[read_bytes - 1] = 0;
+            (*input_line)[--read_bytes] = 0;
         }
     }
 
-    *input_line = line;
+    *length = (size_t)read_bytes;
     return 0;
 }
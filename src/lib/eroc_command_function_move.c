@@ -28,7 +28,7 @@ int eroc_command_function_move(eroc_command* command)
     }
 
     /* attempt to move to the provided address. */
-    retval = eroc_buffer_cursor_move(command->buffer, command->start);
+    retval = eroc_buffer_cursor_seek(command->buffer, command->start);
     if (0 != retval)
     {
         return retval;
@@ -37,7 +37,10 @@ int eroc_command_function_move(eroc_command* command)
     /* output the line. */
     if (NULL != command->buffer->cursor)
     {
-        printf("%s\n", command->buffer->cursor->line);
+        fwrite(
+            command->buffer->cursor->line, 1, command->buffer->cursor->length,
+            stdout);
+        printf("\n");
     }
     else
     {
@@ -10,9 +10,16 @@
 #include <eroc/command.h>
 #include <stdio.h>
 
+/* forward decls. */
+static void pieces_print(
+    eroc_buffer* buffer, unsigned long start, unsigned long count);
+
 /**
  * \brief Print command function.
  *
+ * Lines of a piece table buffer are read straight from its piece table, which
+ * waits only until the last line printed has been indexed.
+ *
  * \param command           The command instance.
  *
  * \returns 0 on success and non-zero on failure.
@@ -27,10 +34,8 @@ int eroc_command_function_print(eroc_command* command)
     if (command->start_provided)
     {
         start = command->start;
-        if (
-            0 !=
-                eroc_list_node_at(
-                    (eroc_list_node**)&line, command->buffer->lines, start))
+        if (NULL == command->buffer->pieces
+         && 0 != eroc_buffer_line_seek(&line, command->buffer, start))
         {
             return 1;
         }
@@ -46,7 +51,7 @@ int eroc_command_function_print(eroc_command* command)
         }
 
         /* end can't exceed count. */
-        if (command->end >= command->buffer->lines->count)
+        if (!eroc_buffer_line_exists(command->buffer, command->end))
         {
             return 3;
         }
@@ -55,11 +60,43 @@ int eroc_command_function_print(eroc_command* command)
         count = command->end - start + 1;
     }
 
+    if (NULL != command->buffer->pieces)
+    {
+        pieces_print(command->buffer, start, count);
+        return 0;
+    }
+
     while (count-- && NULL != line)
     {
-        printf("%s\n", line->line);
+        fwrite(line->line, 1, line->length, stdout);
+        printf("\n");
         line = (eroc_buffer_line*)line->hdr.next;
     }
 
     return 0;
 }
+
+/**
+ * \brief Print lines of a piece table buffer.
+ *
+ * \param buffer            The buffer for this operation.
+ * \param start             The first line to print.
+ * \param count             The number of lines to print.
+ */
+static void pieces_print(
+    eroc_buffer* buffer, unsigned long start, unsigned long count)
+{
+    const char* text;
+    size_t length;
+
+    for (unsigned long i = start; i < start + count; ++i)
+    {
+        if (0 != eroc_piece_table_line(&text, &length, buffer->pieces, i))
+        {
+            break;
+        }
+
+        fwrite(text, 1, length, stdout);
+        printf("\n");
+    }
+}
@@ -0,0 +1,90 @@
+/**
+ * \file lib/eroc_command_function_substitute.c
+ *
+ * \brief Substitute text matching a pattern: s/re/repl/flags.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+#include <stdio.h>
+
+/**
+ * \brief Substitute text matching a pattern: s/re/repl/flags.
+ *
+ * The first match of re on each line in the command's range (the current line
+ * by default) is replaced with repl, in which & is the match and \1 through \9
+ * are its capture groups. The flags are any of g, to replace every match, a
+ * number N, to start with the Nth match, and p, to print the last line
+ * changed. It is an error if no line changes.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success, EROC_COMMAND_SUBSTITUTE_NO_MATCH if no line changes,
+ * and another non-zero value on failure.
+ */
+int eroc_command_function_substitute(eroc_command* command)
+{
+    int retval;
+    eroc_buffer* buffer = command->buffer;
+    unsigned long start = buffer->lineno;
+    unsigned long end;
+    unsigned long count;
+    bool print = false;
+    eroc_regex_substitution* substitution;
+
+    if (0 == buffer->lines->count)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    /* the default range is the current line. */
+    if (command->start_provided)
+    {
+        start = command->start;
+    }
+    end = start;
+    if (command->end_provided)
+    {
+        end = command->end;
+    }
+
+    retval =
+        eroc_command_substitution_parse(
+            &substitution, &print, command->parameters);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    retval = eroc_buffer_substitute(buffer, substitution, start, end, &count);
+    if (0 != retval)
+    {
+        goto cleanup_substitution;
+    }
+
+    /* no match is an error. */
+    if (0 == count)
+    {
+        retval = EROC_COMMAND_SUBSTITUTE_NO_MATCH;
+        goto cleanup_substitution;
+    }
+
+    if (print)
+    {
+        fwrite(buffer->cursor->line, 1, buffer->cursor->length, stdout);
+        printf("\n");
+    }
+
+    /* success. */
+    retval = 0;
+    goto cleanup_substitution;
+
+cleanup_substitution:
+    eroc_regex_substitution_release(substitution);
+
+done:
+    return retval;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file lib/eroc_command_function_undo.c
+ *
+ * \brief Undo the most recent command that changed the buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+
+/**
+ * \brief Undo the most recent command that changed the buffer.
+ *
+ * \param command           The command instance.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_function_undo(eroc_command* command)
+{
+    /* the journal moves the cursor and marks the buffer as modified. */
+    return eroc_buffer_undo(command->buffer);
+}
@@ -60,7 +60,10 @@ int eroc_command_function_write(eroc_command* command)
     }
 
     /* output the size. */
-    printf("%zu\n", write_size);
+    if (0 == (command->buffer->flags & EROC_BUFFER_FLAG_QUIET))
+    {
+        printf("%zu\n", write_size);
+    }
 
     /* If this is the buffer name, then the buffer is no longer modified. */
     if (name == command->buffer->name)
@@ -0,0 +1,195 @@
+/**
+ * \file lib/eroc_command_global.c
+ *
+ * \brief Run a command on every line that matches, or doesn't match, a pattern.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static eroc_buffer_line* next_marked(eroc_buffer_line* line);
+static int run_on_line(
+    eroc_buffer* buffer, eroc_buffer_line* line, const char* command_list);
+
+/**
+ * \brief Run the global command described by the command's parameters, which
+ * take the form /re/cmd.
+ *
+ * Every line in the command's range (the whole buffer by default) is first
+ * tested against the pattern in parallel, and the matching lines (or the
+ * non-matching lines, if invert is set) are marked. Then cmd is run serially on
+ * each marked line in order, with that line as the current line. Lines deleted
+ * along the way are skipped. An empty cmd is p. A substitution that leaves a
+ * line alone is not an error, but it is an error if cmd is s and no line
+ * changes.
+ *
+ * \param command           The command instance.
+ * \param invert            If true, run cmd on the lines which don't match.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_global(eroc_command* command, bool invert)
+{
+    int retval;
+    eroc_buffer* buffer = command->buffer;
+    unsigned long start = 0;
+    unsigned long end;
+    char* pattern;
+    const char* command_list;
+    eroc_command_template tmpl;
+    eroc_buffer_line* line;
+    bool substitute;
+    bool ran = false;
+    bool changed = false;
+
+    if (0 == buffer->lines->count)
+    {
+        return 1;
+    }
+
+    /* the default range is the whole buffer. */
+    end = buffer->lines->count - 1;
+    if (command->start_provided)
+    {
+        start = end = command->start;
+    }
+    if (command->end_provided)
+    {
+        end = command->end;
+    }
+
+    retval =
+        eroc_command_global_parse(
+            &pattern, &command_list, command->parameters);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    /* global commands can't be nested, even behind an address. */
+    retval = eroc_command_template_parse(&tmpl, command_list);
+    if (0 != retval
+     || &eroc_command_function_global == tmpl.command_fn
+     || &eroc_command_function_global_invert == tmpl.command_fn)
+    {
+        retval = 2;
+        goto cleanup_pattern;
+    }
+
+    substitute = (&eroc_command_function_substitute == tmpl.command_fn);
+
+    /* mark phase: test every line in parallel. */
+    retval = eroc_buffer_mark(buffer, pattern, invert, start, end, 0);
+    if (0 != retval)
+    {
+        goto cleanup_pattern;
+    }
+
+    /* command phase: run the command on each marked line in order. */
+    line = next_marked((eroc_buffer_line*)buffer->lines->head);
+    while (NULL != line)
+    {
+        unsigned long marked;
+        eroc_buffer_line* next;
+
+        line->flags &= ~EROC_BUFFER_LINE_FLAG_MARKED;
+        --buffer->marked;
+
+        /* find where to resume before the command changes the buffer. */
+        next = next_marked((eroc_buffer_line*)line->hdr.next);
+        marked = buffer->marked;
+
+        retval = run_on_line(buffer, line, command_list);
+        ran = true;
+        if (0 == retval)
+        {
+            changed = true;
+        }
+        else if (!substitute || EROC_COMMAND_SUBSTITUTE_NO_MATCH != retval)
+        {
+            eroc_buffer_mark_clear(buffer);
+            goto cleanup_pattern;
+        }
+
+        /* if the command deleted a marked line, next may be gone, so search
+         * again from the top; the lines already visited are unmarked. */
+        if (marked != buffer->marked)
+        {
+            next =
+                (buffer->marked > 0)
+                    ? next_marked((eroc_buffer_line*)buffer->lines->head)
+                    : NULL;
+        }
+
+        line = next;
+    }
+
+    /* a substitution which matched none of the marked lines is an error. */
+    if (substitute && ran && !changed)
+    {
+        retval = EROC_COMMAND_SUBSTITUTE_NO_MATCH;
+        goto cleanup_pattern;
+    }
+
+    /* success. */
+    retval = 0;
+    goto cleanup_pattern;
+
+cleanup_pattern:
+    free(pattern);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Find the first marked line at or after the given line.
+ *
+ * \param line              The line at which to start, or NULL.
+ *
+ * \returns the first marked line, or NULL if there is none.
+ */
+static eroc_buffer_line* next_marked(eroc_buffer_line* line)
+{
+    while (NULL != line && !(line->flags & EROC_BUFFER_LINE_FLAG_MARKED))
+    {
+        line = (eroc_buffer_line*)line->hdr.next;
+    }
+
+    return line;
+}
+
+/**
+ * \brief Make the given line current and run the command list on it.
+ *
+ * \param buffer            The buffer.
+ * \param line              The line.
+ * \param command_list      The command to run.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int run_on_line(
+    eroc_buffer* buffer, eroc_buffer_line* line, const char* command_list)
+{
+    int retval;
+    eroc_command* command;
+
+    buffer->cursor = line;
+    buffer->lineno = eroc_avl_tree_rank(buffer->index, &line->index);
+
+    retval = eroc_command_parse(&command, buffer, command_list);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_command_run(command);
+    (void)eroc_command_release(command);
+
+    return retval;
+}
@@ -0,0 +1,56 @@
+/**
+ * \file lib/eroc_command_global_parse.c
+ *
+ * \brief Split the parameters of a global command.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <ctype.h>
+#include <eroc/command.h>
+
+/**
+ * \brief Split the parameters of a global command, /re/cmd, into the pattern
+ * and the command list.
+ *
+ * The first character is the delimiter, which may appear escaped in the
+ * pattern. A missing closing delimiter ends the pattern at the end of input.
+ * An empty command list is p.
+ *
+ * \param pattern           Pointer to be set to the pattern, which the caller
+ *                          must free.
+ * \param command_list      Pointer to be set to the command list, which points
+ *                          into \p parameters.
+ * \param parameters        The parameters to parse.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_global_parse(
+    char** pattern, const char** command_list, const char* parameters)
+{
+    char delimiter = *parameters;
+    int retval;
+
+    if (0 == delimiter || '\\' == delimiter || isspace(delimiter))
+    {
+        return 1;
+    }
+
+    ++parameters;
+    retval = eroc_command_field_read(pattern, &parameters, delimiter);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    /* skip spaces before the command; an empty command prints. */
+    while (*parameters && isspace(*parameters))
+    {
+        ++parameters;
+    }
+
+    *command_list = (0 != *parameters) ? parameters : "p";
+
+    return 0;
+}
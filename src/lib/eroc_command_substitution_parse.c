@@ -0,0 +1,137 @@
+/**
+ * \file lib/eroc_command_substitution_parse.c
+ *
+ * \brief Parse the parameters of a substitute command.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <ctype.h>
+#include <eroc/command.h>
+#include <stdlib.h>
+
+/* forward decls. */
+static int parse_flags(
+    size_t* occurrence, bool* global, bool* print, const char* flags);
+
+/**
+ * \brief Parse the parameters of a substitute command, /re/repl/flags, into a
+ * substitution.
+ *
+ * \param substitution      Pointer to be set to the substitution on success.
+ * \param print             Set to true if the p flag is given.
+ * \param parameters        The parameters to parse.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_substitution_parse(
+    eroc_regex_substitution** substitution, bool* print,
+    const char* parameters)
+{
+    int retval;
+    char delimiter = *parameters;
+    size_t occurrence = 1;
+    bool global = false;
+    char* pattern;
+    char* replacement;
+
+    *print = false;
+
+    if (0 == delimiter || '\\' == delimiter || isspace(delimiter))
+    {
+        retval = 2;
+        goto done;
+    }
+
+    ++parameters;
+    retval = eroc_command_field_read(&pattern, &parameters, delimiter);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    retval = eroc_command_field_read(&replacement, &parameters, delimiter);
+    if (0 != retval)
+    {
+        goto cleanup_pattern;
+    }
+
+    retval = parse_flags(&occurrence, &global, print, parameters);
+    if (0 != retval)
+    {
+        goto cleanup_replacement;
+    }
+
+    retval =
+        eroc_regex_substitution_create(
+            substitution, pattern, replacement, occurrence, global);
+    goto cleanup_replacement;
+
+cleanup_replacement:
+    free(replacement);
+
+cleanup_pattern:
+    free(pattern);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Parse the flags that follow s/re/repl/.
+ *
+ * \param occurrence        Set to the occurrence to start with, if given.
+ * \param global            Set to true if g is given.
+ * \param print             Set to true if p is given.
+ * \param flags             The flags to parse.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int parse_flags(
+    size_t* occurrence, bool* global, bool* print, const char* flags)
+{
+    bool number = false;
+
+    for (; *flags && !isspace(*flags); ++flags)
+    {
+        switch (*flags)
+        {
+            case 'g':
+                *global = true;
+                break;
+
+            case 'p':
+                *print = true;
+                break;
+
+            case '0': case '1': case '2': case '3': case '4':
+            case '5': case '6': case '7': case '8': case '9':
+                /* only one count may be given, and it can't be 0. */
+                if (number || '0' == *flags)
+                {
+                    return 1;
+                }
+                number = true;
+                *occurrence = 0;
+                while (isdigit(*flags))
+                {
+                    *occurrence = *occurrence * 10 + (*flags - '0');
+                    ++flags;
+                }
+                --flags;
+                break;
+
+            default:
+                return 2;
+        }
+    }
+
+    /* nothing but spaces may follow the flags. */
+    while (*flags && isspace(*flags))
+    {
+        ++flags;
+    }
+
+    return (0 == *flags) ? 0 : 3;
+}
@@ -0,0 +1,288 @@
+/**
+ * \file lib/eroc_command_template_parse.c
+ *
+ * \brief Parse a command into a template.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <ctype.h>
+#include <eroc/command.h>
+#include <limits.h>
+#include <string.h>
+
+/* numbers and sums of offsets are kept well clear of overflow. */
+#define MAX_NUMBER (LONG_MAX / 4)
+
+/* forward decls. */
+static int range_parse(eroc_command_template* tmpl, const char** input);
+static int address_parse(eroc_command_address* addr, const char** input);
+static int number_parse(long* value, const char** input);
+static eroc_command_fn command_read(const char** input);
+
+/**
+ * \brief Parse a command string into a template, without reference to any
+ * buffer.
+ *
+ * A command may be preceded by an address range. An address is a line number,
+ * . for the current line or $ for the last line, followed by any number of +N
+ * or -N offsets; offsets alone are relative to the current line. A range is one
+ * address, or two separated by , or by ;, which makes the second relative to
+ * the first. , and % alone are the whole buffer, and ; alone is the current
+ * line through the last.
+ *
+ * \param tmpl              The template to populate on success.
+ * \param input             The input string to parse, which must outlive the
+ *                          template, since the template's parameters point into
+ *                          it.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_command_template_parse(
+    eroc_command_template* tmpl, const char* input)
+{
+    int retval;
+
+    memset(tmpl, 0, sizeof(*tmpl));
+
+    /* read the optional address range. */
+    retval = range_parse(tmpl, &input);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    /* skip any space before the command. */
+    while (*input && isspace(*input))
+        ++input;
+
+    /* an address alone moves to the last line addressed. */
+    if (   0 == *input
+        && (EROC_COMMAND_ADDRESS_NONE != tmpl->first.base
+            || 0 != tmpl->separator))
+    {
+        tmpl->command_fn = &eroc_command_function_move;
+    }
+    /* no command at all advances the cursor by 1. */
+    else if (0 == *input)
+    {
+        tmpl->command_fn = &eroc_command_function_advance;
+    }
+    else
+    {
+        tmpl->command_fn = command_read(&input);
+        if (NULL == tmpl->command_fn)
+        {
+            return 2;
+        }
+    }
+
+    tmpl->parameters = input;
+
+    return 0;
+}
+
+/**
+ * \brief Parse the optional address range at the start of a command.
+ *
+ * \param tmpl              The template to populate with the range.
+ * \param input             The input stream, which is updated on read.
+ *
+ * \returns 0 on success and non-zero on error.
+ */
+static int range_parse(eroc_command_template* tmpl, const char** input)
+{
+    int retval;
+    const char* inp = *input;
+
+    retval = address_parse(&tmpl->first, &inp);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    while (*inp && isspace(*inp))
+        ++inp;
+
+    /* % is only a range on its own. */
+    if (   ',' == *inp || ';' == *inp
+        || ('%' == *inp && EROC_COMMAND_ADDRESS_NONE == tmpl->first.base))
+    {
+        tmpl->separator = (';' == *inp) ? ';' : ',';
+        ++inp;
+
+        retval = address_parse(&tmpl->second, &inp);
+        if (0 != retval)
+        {
+            return retval;
+        }
+    }
+
+    *input = inp;
+
+    return 0;
+}
+
+/**
+ * \brief Parse a single address, if there is one.
+ *
+ * \param addr              The address to populate. Its base is left as
+ *                          \ref EROC_COMMAND_ADDRESS_NONE if there is no
+ *                          address.
+ * \param input             The input stream, which is updated on read.
+ *
+ * \returns 0 on success and non-zero on error.
+ */
+static int address_parse(eroc_command_address* addr, const char** input)
+{
+    int retval;
+    const char* inp = *input;
+    long offset;
+    bool negative;
+
+    memset(addr, 0, sizeof(*addr));
+
+    while (*inp && isspace(*inp))
+        ++inp;
+
+    /* read the base. */
+    if (isdigit(*inp))
+    {
+        retval = number_parse(&addr->line, &inp);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        addr->base = EROC_COMMAND_ADDRESS_LINE;
+    }
+    else if ('.' == *inp)
+    {
+        ++inp;
+        addr->base = EROC_COMMAND_ADDRESS_CURRENT;
+    }
+    else if ('$' == *inp)
+    {
+        ++inp;
+        addr->base = EROC_COMMAND_ADDRESS_LAST;
+    }
+
+    /* read any offsets, which are relative to the current line by default. */
+    while ('+' == *inp || '-' == *inp)
+    {
+        negative = ('-' == *inp++);
+        offset = 1;
+        if (isdigit(*inp))
+        {
+            retval = number_parse(&offset, &inp);
+            if (0 != retval)
+            {
+                return retval;
+            }
+        }
+
+        addr->offset += negative ? -offset : offset;
+        if (addr->offset > MAX_NUMBER || addr->offset < -MAX_NUMBER)
+        {
+            return 3;
+        }
+
+        if (EROC_COMMAND_ADDRESS_NONE == addr->base)
+        {
+            addr->base = EROC_COMMAND_ADDRESS_CURRENT;
+        }
+    }
+
+    /* leave the input alone if there was no address. */
+    if (EROC_COMMAND_ADDRESS_NONE != addr->base)
+    {
+        *input = inp;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Parse a decimal number.
+ *
+ * \param value             Set to the number on success.
+ * \param input             The input stream, which is updated on read.
+ *
+ * \returns 0 on success and non-zero on error.
+ */
+static int number_parse(long* value, const char** input)
+{
+    const char* inp = *input;
+    long tmp = 0;
+
+    for (; isdigit(*inp); ++inp)
+    {
+        if (tmp > (MAX_NUMBER - (*inp - '0')) / 10)
+        {
+            return 4;
+        }
+
+        tmp = tmp * 10 + (*inp - '0');
+    }
+
+    *value = tmp;
+    *input = inp;
+
+    return 0;
+}
+
+/**
+ * \brief Read a command character.
+ *
+ * \param input             The input stream, which is updated on read.
+ *
+ * \returns the command function, or NULL if the command is unknown.
+ */
+static eroc_command_fn command_read(const char** input)
+{
+    switch (*(*input)++)
+    {
+        case '=':
+            return &eroc_command_function_display_line_number;
+
+        case 'a':
+            return &eroc_command_function_append;
+
+        case 'c':
+            return &eroc_command_function_change;
+
+        case 'd':
+            return &eroc_command_function_delete;
+
+        case 'g':
+            return &eroc_command_function_global;
+
+        case 'i':
+            return &eroc_command_function_insert;
+
+        case 'p':
+            return &eroc_command_function_print;
+
+        case 'q':
+            return &eroc_command_function_quit;
+
+        case 's':
+            return &eroc_command_function_substitute;
+
+        case 'u':
+            return &eroc_command_function_undo;
+
+        case 'U':
+            return &eroc_command_function_redo;
+
+        case 'v':
+            return &eroc_command_function_global_invert;
+
+        case 'w':
+            return &eroc_command_function_write;
+
+        default:
+            return NULL;
+    }
+}
@@ -0,0 +1,269 @@
+/**
+ * \file lib/eroc_command_template_resolve.c
+ *
+ * \brief Resolve a command template against a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/command.h>
+#include <stdio.h>
+#include <string.h>
+
+/* forward decls. */
+static int address_resolve(
+    unsigned long* lineno, const eroc_command_address* addr,
+    const eroc_buffer* buffer, unsigned long current);
+static bool pieces_supported(eroc_command_fn command_fn);
+static bool current_used(const eroc_command_template* tmpl);
+static int current_settle(eroc_buffer* buffer);
+
+/**
+ * \brief Resolve a command template against a buffer into a command that is
+ * ready to run.
+ *
+ * Addresses are resolved against the buffer's current line and line count. An
+ * address omitted before , is the first line, and before ; is the current
+ * line; an address omitted after either is the last line if both are omitted,
+ * or the first address otherwise.
+ *
+ * A command that only reads or writes out a piece table buffer runs on it as
+ * it is, so it waits only for the lines it addresses to be indexed. Any other
+ * command needs a list buffer, so the buffer is materialized first. A pending
+ * current line is settled on the last line only once a command uses it.
+ *
+ * \param command           The command to populate on success.
+ * \param tmpl              The template to resolve.
+ * \param buffer            The buffer on which the command is executed.
+ *
+ * \returns 0 on success and non-zero on failure, including an address outside
+ * of the buffer or a range that runs backward.
+ */
+int eroc_command_template_resolve(
+    eroc_command* command, const eroc_command_template* tmpl,
+    eroc_buffer* buffer)
+{
+    int retval;
+    unsigned long first, second;
+    bool have_first = EROC_COMMAND_ADDRESS_NONE != tmpl->first.base;
+    bool have_second = EROC_COMMAND_ADDRESS_NONE != tmpl->second.base;
+    bool materialize =
+        NULL != buffer->pieces && !pieces_supported(tmpl->command_fn);
+
+    /* materializing keeps the current line, so it must be known first. */
+    if ((buffer->flags & EROC_BUFFER_FLAG_CURSOR_PENDING)
+     && (materialize || current_used(tmpl)))
+    {
+        retval = current_settle(buffer);
+        if (0 != retval)
+        {
+            return 5;
+        }
+    }
+
+    if (materialize)
+    {
+        retval = eroc_buffer_materialize(buffer);
+        if (0 != retval)
+        {
+            return 4;
+        }
+    }
+
+    memset(command, 0, sizeof(*command));
+    command->buffer = buffer;
+    command->line = buffer->cursor;
+    command->parameters = tmpl->parameters;
+    command->command_fn = tmpl->command_fn;
+    command->input = stdin;
+
+    if (have_first)
+    {
+        retval =
+            address_resolve(&first, &tmpl->first, buffer, buffer->lineno);
+        if (0 != retval)
+        {
+            return retval;
+        }
+    }
+
+    /* a single address, or none at all. */
+    if (0 == tmpl->separator)
+    {
+        command->start = have_first ? first : 0;
+        command->start_provided = have_first;
+        return 0;
+    }
+
+    if (!have_first)
+    {
+        first = (';' == tmpl->separator) ? buffer->lineno : 0;
+    }
+
+    if (have_second)
+    {
+        retval =
+            address_resolve(
+                &second, &tmpl->second, buffer,
+                (';' == tmpl->separator) ? first : buffer->lineno);
+        if (0 != retval)
+        {
+            return retval;
+        }
+    }
+    else
+    {
+        /* an empty buffer has no last line. */
+        if (!have_first && 0 == eroc_buffer_line_count(buffer))
+        {
+            return 1;
+        }
+
+        second = have_first ? first : eroc_buffer_line_count(buffer) - 1;
+    }
+
+    /* the range can't run backward. */
+    if (second < first)
+    {
+        return 2;
+    }
+
+    command->start = first;
+    command->end = second;
+    command->start_provided = command->end_provided = true;
+
+    /* an address alone moves to the last line addressed. */
+    if (&eroc_command_function_move == command->command_fn)
+    {
+        command->start = second;
+        command->end_provided = false;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Resolve a single address.
+ *
+ * \param lineno            Set to the zero-indexed line number on success.
+ * \param addr              The address to resolve.
+ * \param buffer            The buffer to which the address refers.
+ * \param current           The zero-indexed line that . refers to.
+ *
+ * \returns 0 on success and non-zero if the address is outside of the buffer.
+ */
+static int address_resolve(
+    unsigned long* lineno, const eroc_command_address* addr,
+    const eroc_buffer* buffer, unsigned long current)
+{
+    long value;
+
+    switch (addr->base)
+    {
+        /* line numbers are one-indexed. */
+        case EROC_COMMAND_ADDRESS_LINE:
+            value = addr->line - 1;
+            break;
+
+        case EROC_COMMAND_ADDRESS_LAST:
+            value = (long)eroc_buffer_line_count(buffer) - 1;
+            break;
+
+        default:
+            value = (long)current;
+            break;
+    }
+
+    value += addr->offset;
+    if (value < 0 || !eroc_buffer_line_exists(buffer, value))
+    {
+        return 3;
+    }
+
+    *lineno = (unsigned long)value;
+
+    return 0;
+}
+
+/**
+ * \brief Check whether a command can run on a piece table buffer.
+ *
+ * \param command_fn        The command function to check.
+ *
+ * \returns true if the command runs on a piece table buffer and false if it
+ * needs a list buffer.
+ */
+static bool pieces_supported(eroc_command_fn command_fn)
+{
+    return
+        &eroc_command_function_move == command_fn
+     || &eroc_command_function_advance == command_fn
+     || &eroc_command_function_print == command_fn
+     || &eroc_command_function_display_line_number == command_fn
+     || &eroc_command_function_write == command_fn
+     || &eroc_command_function_quit == command_fn
+     || &eroc_command_function_undo == command_fn
+     || &eroc_command_function_redo == command_fn;
+}
+
+/**
+ * \brief Check whether a command uses the current line.
+ *
+ * \param tmpl              The command template to check.
+ *
+ * \returns true if an address is relative to the current line, or if the
+ * command runs on the current line by default.
+ */
+static bool current_used(const eroc_command_template* tmpl)
+{
+    eroc_command_fn command_fn = tmpl->command_fn;
+
+    if (EROC_COMMAND_ADDRESS_CURRENT == tmpl->first.base
+     || EROC_COMMAND_ADDRESS_CURRENT == tmpl->second.base)
+    {
+        return true;
+    }
+
+    /* an omitted first address before ; is the current line. */
+    if (';' == tmpl->separator
+     && EROC_COMMAND_ADDRESS_NONE == tmpl->first.base)
+    {
+        return true;
+    }
+
+    /* without an address, most commands run on the current line. */
+    return
+        EROC_COMMAND_ADDRESS_NONE == tmpl->first.base
+     && EROC_COMMAND_ADDRESS_NONE == tmpl->second.base
+     && 0 == tmpl->separator
+     && &eroc_command_function_write != command_fn
+     && &eroc_command_function_quit != command_fn
+     && &eroc_command_function_display_line_number != command_fn
+     && &eroc_command_function_undo != command_fn
+     && &eroc_command_function_redo != command_fn;
+}
+
+/**
+ * \brief Settle a pending current line on the last line, waiting for the
+ * buffer to be indexed.
+ *
+ * \param buffer            The buffer whose current line is pending.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int current_settle(eroc_buffer* buffer)
+{
+    int retval;
+
+    retval = eroc_piece_table_finish(buffer->pieces);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    eroc_buffer_cursor_move_tail(buffer);
+    buffer->flags &= ~EROC_BUFFER_FLAG_CURSOR_PENDING;
+
+    return 0;
+}
@@ -0,0 +1,39 @@
+/**
+ * \file lib/eroc_line_table_create.c
+ *
+ * \brief Create an empty line table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create an empty line table.
+ *
+ * \param table         Pointer to the line table pointer to set to the created
+ *                      table on success.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_create(eroc_line_table** table)
+{
+    eroc_line_table* tmp;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_line_table*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    /* the newline array is allocated on first scan. */
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* success. */
+    *table = tmp;
+    return 0;
+}
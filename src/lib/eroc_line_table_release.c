@@ -0,0 +1,22 @@
+/**
+ * \file lib/eroc_line_table_release.c
+ *
+ * \brief Release a line table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a line table.
+ *
+ * \param table         The table to release.
+ */
+void eroc_line_table_release(eroc_line_table* table)
+{
+    free(table->newlines);
+    free(table);
+}
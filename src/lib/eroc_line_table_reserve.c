@@ -0,0 +1,53 @@
+/**
+ * \file lib/eroc_line_table_reserve.c
+ *
+ * \brief Grow a line table to a minimum capacity.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <stdlib.h>
+
+#define LINE_TABLE_MINIMUM_CAPACITY                                     1024
+
+/**
+ * \brief Make sure that the table can hold at least the given number of
+ * newlines without growing.
+ *
+ * \param table         The table for this operation.
+ * \param capacity      The minimum capacity.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_reserve(eroc_line_table* table, size_t capacity)
+{
+    size_t newcap;
+    size_t* tmp;
+
+    /* nothing to do if the table is already big enough. */
+    if (capacity <= table->capacity)
+    {
+        return 0;
+    }
+
+    /* grow geometrically so that scanning stays amortized O(n). */
+    newcap =
+        table->capacity > 0 ? table->capacity : LINE_TABLE_MINIMUM_CAPACITY;
+    while (newcap < capacity)
+    {
+        newcap *= 2;
+    }
+
+    tmp = (size_t*)realloc(table->newlines, newcap * sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    table->newlines = tmp;
+    table->capacity = newcap;
+
+    return 0;
+}
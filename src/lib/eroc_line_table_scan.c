@@ -0,0 +1,206 @@
+/**
+ * \file lib/eroc_line_table_scan.c
+ *
+ * \brief Scan a block of data for newlines using the widest vector unit
+ * available.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <stdint.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# define EROC_LINE_TABLE_X86
+# include <immintrin.h>
+#endif
+
+#ifdef EROC_LINE_TABLE_X86
+static int scan_avx2(eroc_line_table* table, const char* data, size_t size);
+static int scan_sse2(eroc_line_table* table, const char* data, size_t size);
+#endif
+static int scan_tail(
+    eroc_line_table* table, const char* data, size_t offset, size_t size);
+
+/**
+ * \brief Record each newline in a comparison mask.
+ *
+ * \param table         The table for this operation, which must have room for
+ *                      every bit in the mask.
+ * \param data          The start of the block.
+ * \param offset        The offset of the first byte covered by this mask.
+ * \param mask          The mask, with one bit set per newline.
+ */
+static inline void record_mask(
+    eroc_line_table* table, const char* data, size_t offset, uint32_t mask)
+{
+    while (0 != mask)
+    {
+        size_t newline = offset + __builtin_ctz(mask);
+
+        table->newlines[table->count++] = newline;
+        if (newline > 0 && '\r' == data[newline - 1])
+        {
+            ++table->crlf_count;
+        }
+
+        /* clear the lowest set bit. */
+        mask &= mask - 1;
+    }
+}
+
+/**
+ * \brief Scan a block of data for newlines, replacing the contents of the table
+ * with the offset of each newline found.
+ *
+ * The scan uses AVX2 or SSE2 when the CPU supports them, and a scalar loop
+ * otherwise.
+ *
+ * \note A carriage return at the very start of the block can't be attributed
+ * to a CRLF pair in this block, so a CRLF split across two blocks is not
+ * counted in \ref eroc_line_table.crlf_count.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_scan(
+    eroc_line_table* table, const char* data, size_t size)
+{
+    table->count = 0;
+    table->crlf_count = 0;
+
+#ifdef EROC_LINE_TABLE_X86
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return scan_avx2(table, data, size);
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return scan_sse2(table, data, size);
+    }
+#endif
+
+    return scan_tail(table, data, 0, size);
+}
+
+#ifdef EROC_LINE_TABLE_X86
+/**
+ * \brief Scan 32 bytes at a time with AVX2.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+__attribute__((target("avx2")))
+static int scan_avx2(eroc_line_table* table, const char* data, size_t size)
+{
+    const __m256i newline = _mm256_set1_epi8('\n');
+    size_t i = 0;
+
+    for (; i + 32 <= size; i += 32)
+    {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        uint32_t mask =
+            (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, newline));
+
+        if (0 == mask)
+        {
+            continue;
+        }
+
+        /* make room for every newline in this chunk. */
+        if (table->count + 32 > table->capacity
+         && 0 != eroc_line_table_reserve(table, table->count + 32))
+        {
+            return 1;
+        }
+
+        record_mask(table, data, i, mask);
+    }
+
+    return scan_tail(table, data, i, size);
+}
+
+/**
+ * \brief Scan 16 bytes at a time with SSE2.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+__attribute__((target("sse2")))
+static int scan_sse2(eroc_line_table* table, const char* data, size_t size)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t i = 0;
+
+    for (; i + 16 <= size; i += 16)
+    {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        uint32_t mask =
+            (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline));
+
+        if (0 == mask)
+        {
+            continue;
+        }
+
+        /* make room for every newline in this chunk. */
+        if (table->count + 16 > table->capacity
+         && 0 != eroc_line_table_reserve(table, table->count + 16))
+        {
+            return 1;
+        }
+
+        record_mask(table, data, i, mask);
+    }
+
+    return scan_tail(table, data, i, size);
+}
+#endif
+
+/**
+ * \brief Scan the bytes from offset to size one at a time.
+ *
+ * \param table         The table to populate.
+ * \param data          The start of the block.
+ * \param offset        The offset at which to start scanning.
+ * \param size          The size of the block in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int scan_tail(
+    eroc_line_table* table, const char* data, size_t offset, size_t size)
+{
+    for (size_t i = offset; i < size; ++i)
+    {
+        if ('\n' != data[i])
+        {
+            continue;
+        }
+
+        /* make room for this newline. */
+        if (table->count == table->capacity
+         && 0 != eroc_line_table_reserve(table, table->count + 1))
+        {
+            return 1;
+        }
+
+        table->newlines[table->count++] = i;
+        if (i > 0 && '\r' == data[i - 1])
+        {
+            ++table->crlf_count;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,52 @@
+/**
+ * \file lib/eroc_line_table_scan_scalar.c
+ *
+ * \brief Scan a block of data for newlines one byte at a time.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+
+/**
+ * \brief Scan a block of data for newlines one byte at a time.
+ *
+ * This is the portable fallback for \ref eroc_line_table_scan, and produces an
+ * identical table.
+ *
+ * \param table         The table to populate.
+ * \param data          The data to scan.
+ * \param size          The size of the data in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_line_table_scan_scalar(
+    eroc_line_table* table, const char* data, size_t size)
+{
+    table->count = 0;
+    table->crlf_count = 0;
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        if ('\n' != data[i])
+        {
+            continue;
+        }
+
+        /* make room for this newline. */
+        if (table->count == table->capacity
+         && 0 != eroc_line_table_reserve(table, table->count + 1))
+        {
+            return 1;
+        }
+
+        table->newlines[table->count++] = i;
+        if (i > 0 && '\r' == data[i - 1])
+        {
+            ++table->crlf_count;
+        }
+    }
+
+    return 0;
+}
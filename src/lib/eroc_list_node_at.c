@@ -12,6 +12,8 @@
 /**
  * \brief Attempt to get the node at the given 0-based index.
  *
+ * The list is walked from the head or the tail, whichever is nearer.
+ *
  * \param node          Pointer to the node pointer to be updated on success.
  * \param list          The list for this operation.
  * \param index         The index to find.
@@ -21,19 +23,5 @@
 int eroc_list_node_at(
     eroc_list_node** node, eroc_list* list, unsigned long index)
 {
-    eroc_list_node* tmp = list->head;
-
-    /* index out of bounds. */
-    if (index >= list->count)
-    {
-        return 1;
-    }
-
-    /* Scan to the requested line. */
-    while (index--)
-        tmp = tmp->next;
-
-    /* Success. Return the node. */
-    *node = tmp;
-    return 0;
+    return eroc_list_node_seek(node, list, NULL, 0, index);
 }
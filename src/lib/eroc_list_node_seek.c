@@ -0,0 +1,76 @@
+/**
+ * \file lib/eroc_list_node_seek.c
+ *
+ * \brief Get the node at a given index, walking from the nearest known node.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/list.h>
+#include <stdbool.h>
+
+/**
+ * \brief Attempt to get the node at the given 0-based index, walking from the
+ * nearest of the head, the tail, and a node whose index is known.
+ *
+ * \param node          Pointer to the node pointer to be updated on success.
+ * \param list          The list for this operation.
+ * \param from          A node of this list, or NULL.
+ * \param from_index    The index of \p from, if it is set.
+ * \param index         The index to find.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_list_node_seek(
+    eroc_list_node** node, eroc_list* list, eroc_list_node* from,
+    unsigned long from_index, unsigned long index)
+{
+    eroc_list_node* tmp = list->head;
+    unsigned long distance = index;
+    bool forward = true;
+
+    /* index out of bounds. */
+    if (index >= list->count)
+    {
+        return 1;
+    }
+
+    /* the tail is nearer than the head. */
+    if (list->count - 1 - index < distance)
+    {
+        tmp = list->tail;
+        distance = list->count - 1 - index;
+        forward = false;
+    }
+
+    /* the known node is nearer still. */
+    if (NULL != from)
+    {
+        unsigned long from_distance =
+            (index >= from_index) ? index - from_index : from_index - index;
+
+        if (from_distance < distance)
+        {
+            tmp = from;
+            distance = from_distance;
+            forward = index >= from_index;
+        }
+    }
+
+    /* Scan to the requested node. */
+    if (forward)
+    {
+        while (distance--)
+            tmp = tmp->next;
+    }
+    else
+    {
+        while (distance--)
+            tmp = tmp->prev;
+    }
+
+    /* Success. Return the node. */
+    *node = tmp;
+    return 0;
+}
@@ -0,0 +1,58 @@
+/**
+ * \file lib/eroc_piece_table_create.c
+ *
+ * \brief Create a piece table over an original text.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/**
+ * \brief Create a piece table over the given original text.
+ *
+ * Every line of the original text ends with a newline, except possibly the
+ * last, which is copied into the add buffer.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          created table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_create(
+    eroc_piece_table** table, const char* original, size_t size)
+{
+    int retval;
+    eroc_piece_table* tmp;
+
+    retval = eroc_piece_table_init(&tmp, original, size);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    retval = eroc_piece_table_index(tmp);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    retval = eroc_piece_table_finish(tmp);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    *table = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_piece_table_release(tmp);
+
+done:
+    return retval;
+}
@@ -0,0 +1,83 @@
+/**
+ * \file lib/eroc_piece_table_create_lazy.c
+ *
+ * \brief Create a piece table that indexes its original text in the
+ * background.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/* forward decls. */
+static void* indexer(void* context);
+
+/**
+ * \brief Create a piece table over the given original text, indexing the text
+ * in a background thread.
+ *
+ * The table can be read as soon as it is created: reading a line waits only
+ * until the indexer has passed that line. Edits wait for the whole text to be
+ * indexed, and the line count of the table is only valid once it has been; see
+ * \ref eroc_piece_table_finish. If the thread can't be started, the text is
+ * indexed before this returns.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          created table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_create_lazy(
+    eroc_piece_table** table, const char* original, size_t size)
+{
+    int retval;
+    eroc_piece_table* tmp;
+
+    retval = eroc_piece_table_init(&tmp, original, size);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    /* the indexer owns the index fields until it is joined. */
+    tmp->indexing = true;
+    retval = pthread_create(&tmp->indexer, NULL, &indexer, tmp);
+    if (0 != retval)
+    {
+        tmp->indexing = false;
+
+        /* without a thread, index the text now. */
+        retval = eroc_piece_table_index(tmp);
+        if (0 != retval)
+        {
+            goto cleanup_tmp;
+        }
+    }
+
+    *table = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_piece_table_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Index a piece table in the background.
+ *
+ * \param context           The table to index.
+ *
+ * \returns NULL; the result is kept in the table's index status.
+ */
+static void* indexer(void* context)
+{
+    (void)eroc_piece_table_index((eroc_piece_table*)context);
+
+    return NULL;
+}
@@ -0,0 +1,124 @@
+/**
+ * \file lib/eroc_piece_table_delete.c
+ *
+ * \brief Delete a line of a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <string.h>
+
+/**
+ * \brief Delete a line of a piece table.
+ *
+ * Neither source changes; the piece holding the line is trimmed, split, or
+ * removed.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line to delete.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the table is
+ * unchanged.
+ */
+int eroc_piece_table_delete(eroc_piece_table* table, size_t lineno)
+{
+    int retval;
+    eroc_piece *piece, *next, *tail;
+    size_t first, split, offset;
+
+    /* edits need the whole text indexed. */
+    retval = eroc_piece_table_finish(table);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_piece_table_find(&piece, &first, table, lineno);
+    if (0 != retval)
+    {
+        return 1;
+    }
+
+    /* a split needs a new piece. */
+    retval = eroc_piece_table_reserve(table, 1);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    split = lineno - first;
+    if (1 == piece->lines)
+    {
+        /* the next piece moves up to take this piece's place. */
+        next =
+            (eroc_piece*)
+                eroc_avl_tree_successor_node(table->pieces, &piece->node);
+        eroc_avl_tree_remove_node(table->pieces, &piece->node);
+
+        piece->node.right = (eroc_avl_tree_node*)table->free_pieces;
+        table->free_pieces = piece;
+
+        table->recent = next;
+    }
+    else if (0 == split)
+    {
+        if (!piece->added)
+        {
+            offset =
+                eroc_piece_table_original_offset(
+                    table, piece, piece->first + 1);
+            piece->length -= offset - piece->offset;
+            piece->offset = offset;
+        }
+
+        ++piece->first;
+        --piece->lines;
+        eroc_avl_tree_rebalance(table->pieces, &piece->node);
+    }
+    else if (piece->lines - 1 == split)
+    {
+        if (!piece->added)
+        {
+            offset =
+                eroc_piece_table_original_offset(
+                    table, piece, piece->first + split);
+            piece->length = offset - piece->offset;
+        }
+
+        --piece->lines;
+        eroc_avl_tree_rebalance(table->pieces, &piece->node);
+    }
+    else
+    {
+        /* the lines after the deleted line become a new piece. */
+        tail = table->free_pieces;
+        table->free_pieces = (eroc_piece*)tail->node.right;
+        memset(tail, 0, sizeof(*tail));
+
+        tail->first = piece->first + split + 1;
+        tail->lines = piece->lines - split - 1;
+        tail->added = piece->added;
+        if (!piece->added)
+        {
+            offset =
+                eroc_piece_table_original_offset(
+                    table, piece, piece->first + split);
+            tail->offset =
+                eroc_piece_table_original_offset(table, piece, tail->first);
+            tail->length = piece->offset + piece->length - tail->offset;
+            piece->length = offset - piece->offset;
+        }
+
+        /* the tail goes below the piece, so inserting it updates the
+         * piece's line total. */
+        piece->lines = split;
+        eroc_avl_tree_insert_after(table->pieces, &piece->node, &tail->node);
+    }
+
+    /* every piece before the found piece keeps its first line number. */
+    table->recent_first = first;
+    --table->lines;
+    return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * \file lib/eroc_piece_table_find.c
+ *
+ * \brief Find the piece holding a line of a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/* forward decls. */
+static size_t subtree_lines(const eroc_avl_tree_node* node);
+
+/**
+ * \brief Find the piece holding a line of a piece table.
+ *
+ * A lookup that lands in the piece found by the previous lookup, or in the
+ * piece after it, takes O(1), so walking the lines in order visits each piece
+ * once. Any other lookup descends the tree by the line totals of the pieces,
+ * in O(log p) for p pieces.
+ *
+ * \param piece             Set to the piece holding the line on success.
+ * \param first             Set to the number of the first line of this piece
+ *                          on success.
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line to find.
+ *
+ * \returns 0 on success and non-zero if there is no such line.
+ */
+int eroc_piece_table_find(
+    eroc_piece** piece, size_t* first, eroc_piece_table* table, size_t lineno)
+{
+    eroc_piece* tmp = NULL;
+    size_t tmp_first = 0U;
+
+    if (lineno >= table->lines)
+    {
+        return 1;
+    }
+
+    /* try the previous piece and the one after it. */
+    if (NULL != table->recent && lineno >= table->recent_first)
+    {
+        tmp = table->recent;
+        tmp_first = table->recent_first;
+
+        if (lineno >= tmp_first + tmp->lines)
+        {
+            tmp_first += tmp->lines;
+            tmp =
+                (eroc_piece*)
+                    eroc_avl_tree_successor_node(table->pieces, &tmp->node);
+        }
+
+        if (NULL != tmp && lineno >= tmp_first + tmp->lines)
+        {
+            tmp = NULL;
+        }
+    }
+
+    /* otherwise, skip whole subtrees of lines on the way down. */
+    if (NULL == tmp)
+    {
+        tmp = (eroc_piece*)table->pieces->root;
+        tmp_first = 0U;
+
+        for (;;)
+        {
+            size_t left_lines = subtree_lines(tmp->node.left);
+
+            if (lineno < tmp_first + left_lines)
+            {
+                tmp = (eroc_piece*)tmp->node.left;
+            }
+            else if (lineno < tmp_first + left_lines + tmp->lines)
+            {
+                tmp_first += left_lines;
+                break;
+            }
+            else
+            {
+                tmp_first += left_lines + tmp->lines;
+                tmp = (eroc_piece*)tmp->node.right;
+            }
+        }
+    }
+
+    table->recent = tmp;
+    table->recent_first = tmp_first;
+
+    *piece = tmp;
+    *first = tmp_first;
+    return 0;
+}
+
+/**
+ * \brief Get the number of lines in a subtree of pieces.
+ *
+ * \param node              The root of the subtree, or NULL.
+ *
+ * \returns the number of lines in the subtree.
+ */
+static size_t subtree_lines(const eroc_avl_tree_node* node)
+{
+    return (NULL != node) ? ((const eroc_piece*)node)->subtree_lines : 0U;
+}
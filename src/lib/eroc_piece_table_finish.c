@@ -0,0 +1,83 @@
+/**
+ * \file lib/eroc_piece_table_finish.c
+ *
+ * \brief Finish indexing a piece table and build its pieces.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/**
+ * \brief Wait for the whole original text to be indexed, and build the pieces
+ * that describe it.
+ *
+ * This does nothing for a table that has already been finished.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero if indexing failed.
+ */
+int eroc_piece_table_finish(eroc_piece_table* table)
+{
+    int retval;
+    eroc_piece* piece;
+
+    if (table->indexed)
+    {
+        return table->index_status;
+    }
+
+    if (table->indexing)
+    {
+        (void)pthread_join(table->indexer, NULL);
+        table->indexing = false;
+    }
+
+    /* the indexer has stopped, so its fields need no lock. */
+    if (0 != table->index_status)
+    {
+        return table->index_status;
+    }
+
+    /* the lines that end with a newline make up the first piece. */
+    if (table->index_lines > 0)
+    {
+        retval = eroc_piece_table_reserve(table, 1);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        piece = table->free_pieces;
+        table->free_pieces = (eroc_piece*)piece->node.right;
+
+        piece->first = 0;
+        piece->lines = table->index_lines;
+        piece->offset = 0;
+        piece->length = table->index_end;
+        piece->added = false;
+        eroc_avl_tree_insert_after(table->pieces, NULL, &piece->node);
+        table->lines = table->index_lines;
+    }
+
+    table->indexed = true;
+
+    /* an unterminated final line can't be a piece of the original text. */
+    if (table->index_end < table->original_size)
+    {
+        retval =
+            eroc_piece_table_insert(
+                table, table->lines, table->original + table->index_end,
+                table->original_size - table->index_end);
+        if (0 != retval)
+        {
+            /* the table is missing its last line, so it stays failed. */
+            table->index_status = retval;
+            return retval;
+        }
+    }
+
+    return 0;
+}
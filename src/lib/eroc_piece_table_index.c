@@ -0,0 +1,117 @@
+/**
+ * \file lib/eroc_piece_table_index.c
+ *
+ * \brief Index the original text of a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <eroc/piecetable.h>
+
+#define SCAN_BLOCK_SIZE                                         (1024 * 1024)
+
+/* forward decls. */
+static void publish(
+    eroc_piece_table* table, size_t lines, size_t end, bool done, int status);
+
+/**
+ * \brief Index the original text of a piece table, recording checkpoints and
+ * publishing progress to readers as each block is scanned.
+ *
+ * The start of every line whose number is a multiple of the stride is recorded
+ * before the block that holds it is published, so a reader that has seen a
+ * line counted can also find its checkpoint.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero on failure or cancellation.
+ */
+int eroc_piece_table_index(eroc_piece_table* table)
+{
+    int retval;
+    eroc_line_table* scan;
+    size_t count = 0U, end = 0U;
+    bool cancel;
+
+    retval = eroc_line_table_create(&scan);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    for (
+        size_t block = 0U;
+        block < table->original_size;
+        block += SCAN_BLOCK_SIZE)
+    {
+        size_t block_size = table->original_size - block;
+        if (block_size > SCAN_BLOCK_SIZE)
+        {
+            block_size = SCAN_BLOCK_SIZE;
+        }
+
+        retval =
+            eroc_line_table_scan(scan, table->original + block, block_size);
+        if (0 != retval)
+        {
+            goto cleanup_scan;
+        }
+
+        for (size_t i = 0; i < scan->count; ++i)
+        {
+            end = block + scan->newlines[i] + 1;
+            ++count;
+
+            /* the line after this newline may start a new stride. */
+            if (0 == count % EROC_PIECE_TABLE_STRIDE)
+            {
+                table->checkpoints[table->checkpoint_count++] = end;
+            }
+        }
+
+        /* a released table stops its indexer between blocks. */
+        pthread_mutex_lock(&table->index_lock);
+        cancel = table->index_cancel;
+        pthread_mutex_unlock(&table->index_lock);
+        if (cancel)
+        {
+            retval = 1;
+            goto cleanup_scan;
+        }
+
+        publish(table, count, end, false, 0);
+    }
+
+    retval = 0;
+
+cleanup_scan:
+    eroc_line_table_release(scan);
+
+done:
+    publish(table, count, end, true, retval);
+
+    return retval;
+}
+
+/**
+ * \brief Publish indexing progress, and wake any reader waiting on it.
+ *
+ * \param table             The table for this operation.
+ * \param lines             The number of newlines indexed.
+ * \param end               The offset just past the last newline indexed.
+ * \param done              True if indexing has ended.
+ * \param status            The result of indexing, if it has ended.
+ */
+static void publish(
+    eroc_piece_table* table, size_t lines, size_t end, bool done, int status)
+{
+    pthread_mutex_lock(&table->index_lock);
+    table->index_lines = lines;
+    table->index_end = end;
+    table->index_done = done;
+    table->index_status = status;
+    pthread_cond_broadcast(&table->index_cond);
+    pthread_mutex_unlock(&table->index_lock);
+}
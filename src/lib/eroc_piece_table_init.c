@@ -0,0 +1,178 @@
+/**
+ * \file lib/eroc_piece_table_init.c
+ *
+ * \brief Allocate an empty piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+/* forward decls. */
+static int piece_release(void* context, eroc_avl_tree_node* node);
+static int pieces_bulk_release(void* context, eroc_avl_tree_node* root);
+static void piece_update(void* context, eroc_avl_tree_node* node);
+
+/**
+ * \brief Allocate a piece table with no pieces and an empty index.
+ *
+ * The checkpoint array is reserved for the case in which every byte of the
+ * original text is a newline. The reservation is address space only; pages are
+ * committed as the indexer reaches them.
+ *
+ * \param table             Pointer to the piece table pointer to set to the
+ *                          allocated table on success.
+ * \param original          The original text, which must outlive the table.
+ * \param size              The size of the original text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_init(
+    eroc_piece_table** table, const char* original, size_t size)
+{
+    int retval;
+    eroc_piece_table* tmp;
+    void* checkpoints;
+
+    tmp = (eroc_piece_table*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->original = original;
+    tmp->original_size = size;
+
+    /* pieces are ordered by position, so the tree needs no key functions. */
+    retval =
+        eroc_avl_tree_create(&tmp->pieces, NULL, NULL, &piece_release, NULL);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* the pieces go with the arena, so the tree needn't visit them. */
+    eroc_avl_tree_bulk_release_set(tmp->pieces, &pieces_bulk_release);
+
+    /* line totals let a lookup descend straight to the piece of a line. */
+    eroc_avl_tree_update_set(tmp->pieces, &piece_update);
+
+    retval = eroc_arena_create(&tmp->arena, 0);
+    if (0 != retval)
+    {
+        goto cleanup_pieces;
+    }
+
+    /* line 0 always starts at offset 0. */
+    tmp->checkpoint_capacity = size / EROC_PIECE_TABLE_STRIDE + 1;
+    checkpoints =
+        mmap(
+            NULL, tmp->checkpoint_capacity * sizeof(size_t),
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE,
+            -1, 0);
+    if (MAP_FAILED == checkpoints)
+    {
+        retval = 2;
+        goto cleanup_arena;
+    }
+
+    tmp->checkpoints = (size_t*)checkpoints;
+    tmp->checkpoints[0] = 0;
+    tmp->checkpoint_count = 1;
+
+    retval = pthread_mutex_init(&tmp->index_lock, NULL);
+    if (0 != retval)
+    {
+        goto cleanup_checkpoints;
+    }
+
+    retval = pthread_cond_init(&tmp->index_cond, NULL);
+    if (0 != retval)
+    {
+        goto cleanup_lock;
+    }
+
+    *table = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_lock:
+    pthread_mutex_destroy(&tmp->index_lock);
+
+cleanup_checkpoints:
+    (void)munmap(tmp->checkpoints, tmp->checkpoint_capacity * sizeof(size_t));
+
+cleanup_arena:
+    eroc_arena_release(tmp->arena);
+
+cleanup_pieces:
+    (void)eroc_avl_tree_release(tmp->pieces);
+
+cleanup_tmp:
+    free(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Pieces live in the table's arena, so the tree doesn't release them.
+ *
+ * \param context           Unused.
+ * \param node              Unused.
+ *
+ * \returns 0.
+ */
+static int piece_release(void* context, eroc_avl_tree_node* node)
+{
+    (void)context;
+    (void)node;
+
+    return 0;
+}
+
+/**
+ * \brief Pieces live in the table's arena, so the tree drops them all at once.
+ *
+ * \param context           Unused.
+ * \param root              Unused.
+ *
+ * \returns 0.
+ */
+static int pieces_bulk_release(void* context, eroc_avl_tree_node* root)
+{
+    (void)context;
+    (void)root;
+
+    return 0;
+}
+
+/**
+ * \brief Total the lines of a piece and of the pieces below it.
+ *
+ * \param context           Unused.
+ * \param node              The piece to update.
+ */
+static void piece_update(void* context, eroc_avl_tree_node* node)
+{
+    eroc_piece* piece = (eroc_piece*)node;
+
+    (void)context;
+
+    piece->subtree_lines = piece->lines;
+    if (NULL != node->left)
+    {
+        piece->subtree_lines += ((eroc_piece*)node->left)->subtree_lines;
+    }
+
+    if (NULL != node->right)
+    {
+        piece->subtree_lines += ((eroc_piece*)node->right)->subtree_lines;
+    }
+}
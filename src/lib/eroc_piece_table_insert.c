@@ -0,0 +1,218 @@
+/**
+ * \file lib/eroc_piece_table_insert.c
+ *
+ * \brief Insert a line into a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static int added_reserve(eroc_piece_table* table);
+static eroc_piece* piece_take(eroc_piece_table* table);
+
+/**
+ * \brief Insert a copy of the given line before a line of a piece table.
+ *
+ * A line added right after the previously added line extends that line's piece,
+ * so appending or inserting a run of lines creates one piece, not one per line.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The number of the line before which the new line is
+ *                          inserted, or the number of lines in the table to add
+ *                          the new line at the end.
+ * \param text              The text of the line, without a newline.
+ * \param length            The length of the line.
+ *
+ * \returns 0 on success and non-zero on failure, in which case the table is
+ * unchanged.
+ */
+int eroc_piece_table_insert(
+    eroc_piece_table* table, size_t lineno, const char* text, size_t length)
+{
+    int retval;
+    eroc_piece *piece = NULL, *prev, *tail, *line;
+    size_t first = 0U, split, index;
+    char* copy;
+
+    /* edits need the whole text indexed. */
+    retval = eroc_piece_table_finish(table);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    if (lineno > table->lines)
+    {
+        return 1;
+    }
+
+    /* find the piece holding the line that the new line goes before. */
+    if (lineno < table->lines)
+    {
+        retval = eroc_piece_table_find(&piece, &first, table, lineno);
+        if (0 != retval)
+        {
+            return 1;
+        }
+    }
+
+    /* make every allocation before changing anything. */
+    retval = eroc_piece_table_reserve(table, 2);
+    if (0 != retval)
+    {
+        return 2;
+    }
+
+    retval = added_reserve(table);
+    if (0 != retval)
+    {
+        return 3;
+    }
+
+    copy = (char*)eroc_arena_alloc(table->arena, length + 1, 1);
+    if (NULL == copy)
+    {
+        return 4;
+    }
+
+    memcpy(copy, text, length);
+    copy[length] = 0;
+
+    index = table->added_count++;
+    table->added[index].text = copy;
+    table->added[index].length = length;
+
+    /* adding at the end leaves the number of every existing line alone. */
+    if (NULL == piece)
+    {
+        prev =
+            (NULL == table->pieces->root)
+                ? NULL
+                : (eroc_piece*)
+                    eroc_avl_tree_maximum_node(
+                        table->pieces, table->pieces->root);
+        if (NULL != prev && prev->added && prev->first + prev->lines == index)
+        {
+            ++prev->lines;
+            eroc_avl_tree_rebalance(table->pieces, &prev->node);
+        }
+        else
+        {
+            line = piece_take(table);
+            line->first = index;
+            line->lines = 1;
+            line->added = true;
+            eroc_avl_tree_insert_after(table->pieces, NULL, &line->node);
+        }
+
+        ++table->lines;
+        return 0;
+    }
+
+    split = lineno - first;
+    if (0 == split)
+    {
+        prev =
+            (eroc_piece*)
+                eroc_avl_tree_predecessor_node(table->pieces, &piece->node);
+        if (NULL != prev && prev->added && prev->first + prev->lines == index)
+        {
+            ++prev->lines;
+            eroc_avl_tree_rebalance(table->pieces, &prev->node);
+        }
+        else
+        {
+            line = piece_take(table);
+            line->first = index;
+            line->lines = 1;
+            line->added = true;
+            eroc_avl_tree_insert_before(
+                table->pieces, &piece->node, &line->node);
+        }
+
+        /* the found piece moved down by one line. */
+        table->recent_first = first + 1;
+        ++table->lines;
+        return 0;
+    }
+
+    /* split the piece around the new line. */
+    tail = piece_take(table);
+    tail->first = piece->first + split;
+    tail->lines = piece->lines - split;
+    tail->added = piece->added;
+    if (!piece->added)
+    {
+        tail->offset =
+            eroc_piece_table_original_offset(table, piece, tail->first);
+        tail->length = piece->offset + piece->length - tail->offset;
+        piece->length = tail->offset - piece->offset;
+    }
+
+    /* the tail goes below the piece, so inserting it updates the piece's line
+     * total. */
+    piece->lines = split;
+    eroc_avl_tree_insert_after(table->pieces, &piece->node, &tail->node);
+
+    line = piece_take(table);
+    line->first = index;
+    line->lines = 1;
+    line->added = true;
+    eroc_avl_tree_insert_after(table->pieces, &piece->node, &line->node);
+
+    ++table->lines;
+    return 0;
+}
+
+/**
+ * \brief Make room for one more line in the add buffer.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int added_reserve(eroc_piece_table* table)
+{
+    size_t capacity;
+    eroc_piece_line* tmp;
+
+    if (table->added_count < table->added_capacity)
+    {
+        return 0;
+    }
+
+    capacity = (0 == table->added_capacity) ? 64 : 2 * table->added_capacity;
+    tmp =
+        (eroc_piece_line*)
+            realloc(table->added, capacity * sizeof(eroc_piece_line));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    table->added = tmp;
+    table->added_capacity = capacity;
+    return 0;
+}
+
+/**
+ * \brief Take a piece reserved by \ref eroc_piece_table_reserve.
+ *
+ * \param table             The table for this operation.
+ *
+ * \returns the piece.
+ */
+static eroc_piece* piece_take(eroc_piece_table* table)
+{
+    eroc_piece* piece = table->free_pieces;
+
+    table->free_pieces = (eroc_piece*)piece->node.right;
+    memset(piece, 0, sizeof(*piece));
+
+    return piece;
+}
@@ -0,0 +1,112 @@
+/**
+ * \file lib/eroc_piece_table_line.c
+ *
+ * \brief Get a line of a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <string.h>
+
+/* forward decls. */
+static int original_line(
+    const char** text, size_t* length, const eroc_piece_table* table,
+    size_t lineno);
+
+/**
+ * \brief Get a line of a piece table.
+ *
+ * Before the table is finished, this waits only until the line is indexed.
+ *
+ * \param text              Set to the start of the line on success. The line
+ *                          is not NUL terminated.
+ * \param length            Set to the length of the line, without its newline,
+ *                          on success.
+ * \param table             The table for this operation.
+ * \param lineno            The zero-based number of the line.
+ *
+ * \returns 0 on success and non-zero if there is no such line.
+ */
+int eroc_piece_table_line(
+    const char** text, size_t* length, eroc_piece_table* table,
+    size_t lineno)
+{
+    int retval;
+    eroc_piece* piece;
+    size_t first, index, start;
+    const char* newline;
+
+    /* until the table is finished, it is the original text. */
+    if (!table->indexed)
+    {
+        retval = eroc_piece_table_wait(table, lineno);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        if (!table->indexed)
+        {
+            return original_line(text, length, table, lineno);
+        }
+    }
+
+    retval = eroc_piece_table_find(&piece, &first, table, lineno);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    index = piece->first + (lineno - first);
+    if (piece->added)
+    {
+        *text = table->added[index].text;
+        *length = table->added[index].length;
+        return 0;
+    }
+
+    /* every line of an original piece ends with a newline. */
+    start = eroc_piece_table_original_offset(table, piece, index);
+    newline =
+        (const char*)
+            memchr(
+                table->original + start, '\n',
+                piece->offset + piece->length - start);
+
+    *text = table->original + start;
+    *length = newline - *text;
+    return 0;
+}
+
+/**
+ * \brief Get a line of the original text, which has been indexed at least as
+ * far as the end of this line.
+ *
+ * \param text              Set to the start of the line.
+ * \param length            Set to the length of the line, without its newline.
+ * \param table             The table for this operation.
+ * \param lineno            The zero-based number of the line.
+ *
+ * \returns 0.
+ */
+static int original_line(
+    const char** text, size_t* length, const eroc_piece_table* table,
+    size_t lineno)
+{
+    /* the whole original text, as a single piece. */
+    eroc_piece whole = { .first = 0U, .offset = 0U };
+    size_t start;
+    const char* newline;
+
+    start = eroc_piece_table_original_offset(table, &whole, lineno);
+    newline =
+        (const char*)
+            memchr(
+                table->original + start, '\n', table->original_size - start);
+
+    *text = table->original + start;
+    *length = newline - *text;
+    return 0;
+}
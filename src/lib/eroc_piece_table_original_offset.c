@@ -0,0 +1,56 @@
+/**
+ * \file lib/eroc_piece_table_original_offset.c
+ *
+ * \brief Get the offset of a line of the original text.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <string.h>
+
+/**
+ * \brief Get the offset of a line of the original text.
+ *
+ * The scan starts from the nearest checkpoint at or before the line, or from
+ * the start of the piece if that is closer, so it passes over fewer than
+ * \ref EROC_PIECE_TABLE_STRIDE lines.
+ *
+ * \param table             The table for this operation.
+ * \param piece             An original piece holding this line.
+ * \param index             The number of the line in the original text, which
+ *                          may be one past the last line of the piece.
+ *
+ * \returns the offset of the start of the line.
+ */
+size_t eroc_piece_table_original_offset(
+    const eroc_piece_table* table, const eroc_piece* piece, size_t index)
+{
+    size_t checkpoint = index / EROC_PIECE_TABLE_STRIDE;
+    size_t offset, skip;
+
+    if (checkpoint * EROC_PIECE_TABLE_STRIDE >= piece->first)
+    {
+        offset = table->checkpoints[checkpoint];
+        skip = index - checkpoint * EROC_PIECE_TABLE_STRIDE;
+    }
+    else
+    {
+        offset = piece->offset;
+        skip = index - piece->first;
+    }
+
+    while (skip--)
+    {
+        const char* newline =
+            (const char*)
+                memchr(
+                    table->original + offset, '\n',
+                    table->original_size - offset);
+
+        offset = newline - table->original + 1;
+    }
+
+    return offset;
+}
@@ -0,0 +1,45 @@
+/**
+ * \file lib/eroc_piece_table_release.c
+ *
+ * \brief Release a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+
+/**
+ * \brief Release a piece table.
+ *
+ * The original text belongs to the caller and is left alone. A running indexer
+ * is stopped first.
+ *
+ * \param table             The table to release.
+ */
+void eroc_piece_table_release(eroc_piece_table* table)
+{
+    /* the indexer checks for cancellation between blocks. */
+    if (table->indexing)
+    {
+        pthread_mutex_lock(&table->index_lock);
+        table->index_cancel = true;
+        pthread_mutex_unlock(&table->index_lock);
+
+        (void)pthread_join(table->indexer, NULL);
+    }
+
+    /* the pieces live in the arena. */
+    (void)eroc_avl_tree_release(table->pieces);
+    eroc_arena_release(table->arena);
+
+    pthread_cond_destroy(&table->index_cond);
+    pthread_mutex_destroy(&table->index_lock);
+
+    free(table->added);
+    (void)munmap(
+        table->checkpoints, table->checkpoint_capacity * sizeof(size_t));
+    free(table);
+}
@@ -0,0 +1,52 @@
+/**
+ * \file lib/eroc_piece_table_reserve.c
+ *
+ * \brief Reserve free pieces for an edit.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+#include <stdalign.h>
+
+/**
+ * \brief Make sure that the table has at least the given number of free pieces,
+ * so that an edit can't fail halfway through.
+ *
+ * Free pieces are linked through their right child pointers.
+ *
+ * \param table             The table for this operation.
+ * \param count             The number of free pieces needed.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_piece_table_reserve(eroc_piece_table* table, size_t count)
+{
+    size_t have = 0U;
+
+    for (
+        eroc_piece* piece = table->free_pieces;
+        NULL != piece && have < count;
+        piece = (eroc_piece*)piece->node.right)
+    {
+        ++have;
+    }
+
+    for (; have < count; ++have)
+    {
+        eroc_piece* piece =
+            (eroc_piece*)
+                eroc_arena_alloc(
+                    table->arena, sizeof(eroc_piece), alignof(eroc_piece));
+        if (NULL == piece)
+        {
+            return 1;
+        }
+
+        piece->node.right = (eroc_avl_tree_node*)table->free_pieces;
+        table->free_pieces = piece;
+    }
+
+    return 0;
+}
@@ -0,0 +1,56 @@
+/**
+ * \file lib/eroc_piece_table_wait.c
+ *
+ * \brief Wait until a line of a piece table has been indexed.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/**
+ * \brief Wait until a line of the original text has been indexed.
+ *
+ * This blocks only until the indexer passes the line, or until indexing ends
+ * if there is no such line, so it is cheap for lines near the start of a huge
+ * text. Once indexing has ended, the table is finished, and this just checks
+ * the line count.
+ *
+ * \param table             The table for this operation.
+ * \param lineno            The zero-based number of the line.
+ *
+ * \returns 0 if the line exists and non-zero if it doesn't, or if indexing
+ * failed.
+ */
+int eroc_piece_table_wait(eroc_piece_table* table, size_t lineno)
+{
+    int retval;
+    bool done;
+
+    if (table->indexing)
+    {
+        pthread_mutex_lock(&table->index_lock);
+        while (!table->index_done && table->index_lines <= lineno)
+        {
+            pthread_cond_wait(&table->index_cond, &table->index_lock);
+        }
+
+        done = table->index_done;
+        pthread_mutex_unlock(&table->index_lock);
+
+        /* the line has been indexed, and the indexer is still going. */
+        if (!done)
+        {
+            return 0;
+        }
+    }
+
+    retval = eroc_piece_table_finish(table);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    return (lineno < table->lines) ? 0 : 1;
+}
@@ -0,0 +1,72 @@
+/**
+ * \file lib/eroc_piece_table_write.c
+ *
+ * \brief Write the text of a piece table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/piecetable.h>
+
+/**
+ * \brief Write the text of a piece table.
+ *
+ * Original pieces are written as single spans, straight from the original
+ * text; added lines are written one at a time, each followed by a newline.
+ *
+ * \param writer            The writer to add the text to. The caller flushes
+ *                          the writer.
+ * \param table             The table for this operation.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_piece_table_write(eroc_writer* writer, const eroc_piece_table* table)
+{
+    int retval;
+
+    for (
+        eroc_avl_tree_node* node =
+            (NULL == table->pieces->root)
+                ? NULL
+                : eroc_avl_tree_minimum_node(
+                    table->pieces, table->pieces->root);
+        NULL != node;
+        node = eroc_avl_tree_successor_node(table->pieces, node))
+    {
+        const eroc_piece* piece = (const eroc_piece*)node;
+
+        if (!piece->added)
+        {
+            retval =
+                eroc_writer_add(
+                    writer, table->original + piece->offset, piece->length);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            continue;
+        }
+
+        for (size_t i = piece->first; i < piece->first + piece->lines; ++i)
+        {
+            retval =
+                eroc_writer_add(
+                    writer, table->added[i].text, table->added[i].length);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            retval = eroc_writer_add(writer, "\n", 1);
+            if (0 != retval)
+            {
+                return retval;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -38,6 +38,8 @@ static int add_member_char_class_instruction(
 static int add_range_char_class_instruction(eroc_regex_compiler_instance* inst);
 static int invert_char_class_instruction(eroc_regex_compiler_instance* inst);
 static int reduce_instructions(eroc_regex_compiler_instance* inst);
+static bool is_postfix(int ch);
+static bool ends_alternate(int ch);
 static int reduce_concat(eroc_regex_compiler_instance* inst);
 static int reduce_alternate(eroc_regex_compiler_instance* inst);
 static int reduce_capture(eroc_regex_compiler_instance* inst);
@@ -544,6 +546,9 @@ static int shift_start_capture_pseudoinstruction(
     /* override the type to make it a start capture pseudoinstruction. */
     ast->type = EROC_REGEX_AST_PSEUDOINSTRUCTION_START_CAPTURE;
 
+    /* groups are numbered in order of their opening parenthesis. */
+    ast->data.capture.group_index = (inst->captures)++;
+
     /* shift this node onto the stack. */
     ast->next = inst->head;
     inst->head = ast;
@@ -880,6 +885,11 @@ static int reduce_char_class_range(eroc_regex_compiler_instance* inst)
 /**
  * \brief Reduce instructions by combining them according to stack ordering.
  *
+ * The next input character is used as lookahead to respect precedence: an
+ * instruction followed by a postfix operator is not reduced until the operator
+ * has been applied to it, and an alternate is not reduced until its right-hand
+ * side is complete.
+ *
  * \param inst          The compiler instance for this operation.
  *
  * \returns 0 on success and non-zero on failure.
@@ -887,6 +897,7 @@ static int reduce_char_class_range(eroc_regex_compiler_instance* inst)
 static int reduce_instructions(eroc_regex_compiler_instance* inst)
 {
     int retval;
+    int lookahead = inst->input[inst->offset];
     eroc_regex_ast_node* right = inst->head;
     eroc_regex_ast_node* left;
 
@@ -931,14 +942,24 @@ static int reduce_instructions(eroc_regex_compiler_instance* inst)
                 goto next;
         }
 
+        /* a postfix operator binds to the right-hand instruction first. */
+        if (is_postfix(lookahead))
+        {
+            return 0;
+        }
+
         switch (left->type)
         {
             /* we can't reduce this any further until we get the end capture. */
             case EROC_REGEX_AST_PSEUDOINSTRUCTION_START_CAPTURE:
                 return 0;
 
-            /* handle alternate case. */
+            /* handle alternate case, once the right-hand side is complete. */
             case EROC_REGEX_AST_PSEUDOINSTRUCTION_ALTERNATE:
+                if (!ends_alternate(lookahead))
+                {
+                    return 0;
+                }
                 retval = reduce_alternate(inst);
                 break;
 
@@ -964,6 +985,49 @@ static int reduce_instructions(eroc_regex_compiler_instance* inst)
     return 0;
 }
 
+/**
+ * \brief Check to see if the given character is a postfix operator.
+ *
+ * \param ch            The character to check.
+ *
+ * \returns true if this character is a postfix operator and false otherwise.
+ */
+static bool is_postfix(int ch)
+{
+    switch (ch)
+    {
+        case '*':
+        case '+':
+        case '?':
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+/**
+ * \brief Check to see if the given character ends the right-hand side of an
+ * alternate.
+ *
+ * \param ch            The character to check.
+ *
+ * \returns true if this character ends an alternate and false otherwise.
+ */
+static bool ends_alternate(int ch)
+{
+    switch (ch)
+    {
+        case 0:
+        case '|':
+        case ')':
+            return true;
+
+        default:
+            return false;
+    }
+}
+
 /**
  * \brief Reduce the top two instructions on the stack into a concat.
  *
@@ -1069,7 +1133,9 @@ static int reduce_capture(eroc_regex_compiler_instance* inst)
     }
 
     /* create a capture node to hold the instruction. */
-    retval = eroc_regex_ast_node_capture_create(&ast, in, (inst->captures)++);
+    retval =
+        eroc_regex_ast_node_capture_create(
+            &ast, in, start->data.capture.group_index);
     if (0 != retval)
     {
         return retval;
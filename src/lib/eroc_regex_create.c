@@ -0,0 +1,77 @@
+/**
+ * \file lib/eroc_regex_create.c
+ *
+ * \brief Compile a pattern for searching.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Compile a pattern for searching.
+ *
+ * \param regex         Pointer to the regex pointer to be populated with the
+ *                      compiled regex on success.
+ * \param pattern       The pattern to compile.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_create(eroc_regex** regex, const char* pattern)
+{
+    int retval;
+    eroc_regex* tmp;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_regex*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    retval = eroc_regex_compiler_parse(&tmp->ast, pattern);
+    if (0 != retval)
+    {
+        tmp->ast = NULL;
+        goto cleanup_tmp;
+    }
+
+    retval = eroc_regex_program_compile(&tmp->program, tmp->ast);
+    if (0 != retval)
+    {
+        tmp->program = NULL;
+        goto cleanup_tmp;
+    }
+
+    retval =
+        eroc_regex_dfa_create(
+            &tmp->dfa, tmp->program, EROC_REGEX_DFA_DEFAULT_CACHE_SIZE);
+    if (0 != retval)
+    {
+        tmp->dfa = NULL;
+        goto cleanup_tmp;
+    }
+
+    retval = eroc_regex_prefilter_extract(&tmp->prefilter, tmp->ast);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *regex = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_regex_release(tmp);
+
+done:
+    return retval;
+}
@@ -0,0 +1,184 @@
+/**
+ * \file lib/eroc_regex_dfa_create.c
+ *
+ * \brief Create a lazy DFA for a compiled NFA program.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static void compute_byte_classes(eroc_regex_dfa* dfa);
+static bool class_member(const uint32_t* members, unsigned int ch);
+
+/**
+ * \brief Create a lazy DFA for the given program.
+ *
+ * \note The program remains owned by the caller, and must outlive the DFA.
+ *
+ * \param dfa           Pointer to the DFA pointer to be populated with the DFA
+ *                      on success.
+ * \param program       The program for this DFA.
+ * \param cache_size    The size of the state cache, in bytes.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_dfa_create(
+    eroc_regex_dfa** dfa, const eroc_regex_program* program,
+    size_t cache_size)
+{
+    int retval;
+    eroc_regex_dfa* tmp;
+    size_t count = program->count;
+    size_t per_state;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_regex_dfa*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->program = program;
+    tmp->start = -1;
+
+    compute_byte_classes(tmp);
+
+    /* size the cache for the worst case set size of every state. */
+    per_state =
+        sizeof(eroc_regex_dfa_state) + tmp->class_count * sizeof(int32_t)
+      + count * sizeof(uint32_t) + 2 * sizeof(uint32_t);
+    tmp->max_states = cache_size / per_state;
+    if (tmp->max_states < 2)
+    {
+        tmp->max_states = 2;
+    }
+
+    /* keep the hash table at most half full. */
+    tmp->table_size = 1;
+    while (tmp->table_size < 2 * tmp->max_states)
+    {
+        tmp->table_size *= 2;
+    }
+
+    tmp->states =
+        (eroc_regex_dfa_state*)
+            malloc(tmp->max_states * sizeof(eroc_regex_dfa_state));
+    tmp->transitions =
+        (int32_t*)
+            malloc(tmp->max_states * tmp->class_count * sizeof(int32_t));
+    tmp->sets = (uint32_t*)malloc(tmp->max_states * count * sizeof(uint32_t));
+    tmp->table = (uint32_t*)calloc(tmp->table_size, sizeof(uint32_t));
+    if (
+        NULL == tmp->states || NULL == tmp->transitions || NULL == tmp->sets
+     || NULL == tmp->table)
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    tmp->scratch = (uint32_t*)malloc(count * sizeof(uint32_t));
+    tmp->stack = (uint32_t*)malloc(count * sizeof(uint32_t));
+    tmp->marks = (unsigned int*)calloc(count, sizeof(unsigned int));
+    if (NULL == tmp->scratch || NULL == tmp->stack || NULL == tmp->marks)
+    {
+        retval = 3;
+        goto cleanup_tmp;
+    }
+
+    /* captures are extracted with the NFA. */
+    retval = eroc_regex_vm_create(&tmp->vm, program);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *dfa = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_regex_dfa_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Partition the byte values into classes which no instruction in the
+ * program can tell apart.
+ *
+ * A class boundary falls at every byte where a BYTE instruction starts or
+ * stops matching, or where a char class bitmap changes membership.
+ *
+ * \param dfa           The DFA for which byte classes are computed.
+ */
+static void compute_byte_classes(eroc_regex_dfa* dfa)
+{
+    const eroc_regex_program* program = dfa->program;
+    bool boundary[256];
+
+    memset(boundary, 0, sizeof(boundary));
+
+    for (size_t i = 0; i < program->count; ++i)
+    {
+        const eroc_regex_instruction* inst = program->instructions + i;
+
+        if (EROC_REGEX_OP_BYTE == inst->opcode)
+        {
+            boundary[inst->byte] = true;
+            if (inst->byte < 255)
+            {
+                boundary[inst->byte + 1] = true;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < program->class_count; ++i)
+    {
+        for (unsigned int ch = 1; ch < 256; ++ch)
+        {
+            if (
+                class_member(program->classes[i], ch)
+             != class_member(program->classes[i], ch - 1))
+            {
+                boundary[ch] = true;
+            }
+        }
+    }
+
+    /* number the classes in byte order. */
+    size_t current = 0;
+    dfa->class_bytes[0] = 0;
+    for (unsigned int ch = 0; ch < 256; ++ch)
+    {
+        if (ch > 0 && boundary[ch])
+        {
+            dfa->class_bytes[++current] = (uint8_t)ch;
+        }
+
+        dfa->byte_classes[ch] = (uint8_t)current;
+    }
+
+    dfa->class_count = current + 1;
+}
+
+/**
+ * \brief Check a char class bitmap for membership.
+ *
+ * \param members       The bitmap.
+ * \param ch            The byte to check.
+ *
+ * \returns true if ch is a member and false otherwise.
+ */
+static bool class_member(const uint32_t* members, unsigned int ch)
+{
+    return 0 != (members[ch / 32] & ((uint32_t)1 << (ch % 32)));
+}
@@ -0,0 +1,33 @@
+/**
+ * \file lib/eroc_regex_dfa_release.c
+ *
+ * \brief Release a lazy DFA.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a lazy DFA.
+ *
+ * \param dfa           The DFA to release.
+ */
+void eroc_regex_dfa_release(eroc_regex_dfa* dfa)
+{
+    if (NULL != dfa->vm)
+    {
+        eroc_regex_vm_release(dfa->vm);
+    }
+
+    free(dfa->states);
+    free(dfa->transitions);
+    free(dfa->sets);
+    free(dfa->table);
+    free(dfa->scratch);
+    free(dfa->stack);
+    free(dfa->marks);
+    free(dfa);
+}
@@ -0,0 +1,346 @@
+/**
+ * \file lib/eroc_regex_dfa_search.c
+ *
+ * \brief Search text using a lazy DFA.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <string.h>
+
+/* forward decls. */
+static int32_t start_state(eroc_regex_dfa* dfa);
+static int32_t compute_transition(
+    eroc_regex_dfa* dfa, int32_t from, size_t byte_class);
+static void next_generation(eroc_regex_dfa* dfa);
+static void add_closure(eroc_regex_dfa* dfa, uint32_t pc);
+static int32_t add_state(eroc_regex_dfa* dfa, bool* flushed);
+static void flush(eroc_regex_dfa* dfa);
+
+/**
+ * \brief Search the given text for a match of the DFA's program.
+ *
+ * \param dfa           The DFA for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the leftmost match on success, or NULL
+ *                      if only a yes or no answer is needed. Captures are
+ *                      extracted with the NFA, and only when the DFA has found
+ *                      a match.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_dfa_search(
+    eroc_regex_dfa* dfa, size_t* captures, const char* text, size_t length)
+{
+    const unsigned char* in = (const unsigned char*)text;
+    size_t class_count = dfa->class_count;
+    int32_t state = start_state(dfa);
+
+    /* the search is unanchored, so every state includes the start state, and
+     * the first state containing a MATCH decides the answer. */
+    for (size_t i = 0; i < length && !dfa->states[state].match; ++i)
+    {
+        size_t byte_class = dfa->byte_classes[in[i]];
+        int32_t next = dfa->transitions[state * class_count + byte_class];
+
+        if (next >= 0)
+        {
+            ++dfa->hits;
+            state = next;
+        }
+        else
+        {
+            ++dfa->misses;
+            state = compute_transition(dfa, state, byte_class);
+        }
+    }
+
+    if (!dfa->states[state].match)
+    {
+        return false;
+    }
+
+    /* fall back to the NFA to find the leftmost match and its captures. */
+    if (NULL != captures)
+    {
+        return eroc_regex_vm_search(dfa->vm, captures, text, length);
+    }
+
+    return true;
+}
+
+/**
+ * \brief Get the start state, computing it if it isn't cached.
+ *
+ * \param dfa           The DFA.
+ *
+ * \returns the index of the start state.
+ */
+static int32_t start_state(eroc_regex_dfa* dfa)
+{
+    bool flushed;
+
+    if (dfa->start < 0)
+    {
+        next_generation(dfa);
+        add_closure(dfa, 0);
+        dfa->start = add_state(dfa, &flushed);
+    }
+
+    return dfa->start;
+}
+
+/**
+ * \brief Compute and cache the transition from the given state on the given
+ * byte class.
+ *
+ * \param dfa           The DFA.
+ * \param from          The state to transition from.
+ * \param byte_class    The byte class to transition on.
+ *
+ * \returns the index of the target state.
+ */
+static int32_t compute_transition(
+    eroc_regex_dfa* dfa, int32_t from, size_t byte_class)
+{
+    const eroc_regex_program* program = dfa->program;
+    const eroc_regex_dfa_state* state = dfa->states + from;
+    const uint32_t* set = dfa->sets + state->set;
+    unsigned int ch = dfa->class_bytes[byte_class];
+    bool flushed;
+
+    next_generation(dfa);
+
+    /* step every consuming instruction which accepts this class. */
+    for (uint32_t i = 0; i < state->length; ++i)
+    {
+        const eroc_regex_instruction* inst = program->instructions + set[i];
+        bool step;
+
+        switch (inst->opcode)
+        {
+            case EROC_REGEX_OP_BYTE:
+                step = (ch == inst->byte);
+                break;
+
+            case EROC_REGEX_OP_ANY:
+                step = true;
+                break;
+
+            case EROC_REGEX_OP_CLASS:
+                step =
+                    0 != (program->classes[inst->x][ch / 32]
+                            & ((uint32_t)1 << (ch % 32)));
+                break;
+
+            default:
+                step = false;
+                break;
+        }
+
+        if (step)
+        {
+            add_closure(dfa, set[i] + 1);
+        }
+    }
+
+    /* a match may start at the next position. */
+    add_closure(dfa, 0);
+
+    int32_t to = add_state(dfa, &flushed);
+
+    /* a flush invalidates the from state, so its transition is not kept. */
+    if (!flushed)
+    {
+        dfa->transitions[from * dfa->class_count + byte_class] = to;
+    }
+
+    return to;
+}
+
+/**
+ * \brief Start a new, empty pc set.
+ *
+ * \param dfa           The DFA.
+ */
+static void next_generation(eroc_regex_dfa* dfa)
+{
+    if (0 == ++dfa->generation)
+    {
+        memset(dfa->marks, 0, dfa->program->count * sizeof(unsigned int));
+        dfa->generation = 1;
+    }
+}
+
+/**
+ * \brief Add every instruction reachable from pc by empty transitions to the
+ * current pc set.
+ *
+ * \param dfa           The DFA.
+ * \param pc            The starting program counter.
+ */
+static void add_closure(eroc_regex_dfa* dfa, uint32_t pc)
+{
+    const eroc_regex_program* program = dfa->program;
+    uint32_t* stack = dfa->stack;
+    size_t top = 0;
+
+    if (dfa->marks[pc] == dfa->generation)
+    {
+        return;
+    }
+
+    /* pcs are marked as they are pushed, so each is pushed at most once. */
+    dfa->marks[pc] = dfa->generation;
+    stack[top++] = pc;
+
+    while (top > 0)
+    {
+        uint32_t current = stack[--top];
+        const eroc_regex_instruction* inst = program->instructions + current;
+        uint32_t targets[2];
+        int target_count = 0;
+
+        switch (inst->opcode)
+        {
+            case EROC_REGEX_OP_SPLIT:
+                targets[target_count++] = inst->x;
+                targets[target_count++] = inst->y;
+                break;
+
+            case EROC_REGEX_OP_JUMP:
+                targets[target_count++] = inst->x;
+                break;
+
+            case EROC_REGEX_OP_SAVE:
+                targets[target_count++] = current + 1;
+                break;
+
+            default:
+                break;
+        }
+
+        for (int i = 0; i < target_count; ++i)
+        {
+            if (dfa->marks[targets[i]] != dfa->generation)
+            {
+                dfa->marks[targets[i]] = dfa->generation;
+                stack[top++] = targets[i];
+            }
+        }
+    }
+}
+
+/**
+ * \brief Find or add the state for the current pc set.
+ *
+ * Only consuming and MATCH instructions distinguish states, so the set is
+ * built from those in pc order, which makes it canonical.
+ *
+ * \param dfa           The DFA.
+ * \param flushed       Set to true if the cache was flushed to make room.
+ *
+ * \returns the index of the state.
+ */
+static int32_t add_state(eroc_regex_dfa* dfa, bool* flushed)
+{
+    const eroc_regex_program* program = dfa->program;
+    uint32_t length = 0;
+    uint32_t hash = 2166136261U;
+    bool match = false;
+
+    *flushed = false;
+
+    for (uint32_t pc = 0; pc < program->count; ++pc)
+    {
+        if (dfa->marks[pc] != dfa->generation)
+        {
+            continue;
+        }
+
+        switch (program->instructions[pc].opcode)
+        {
+            case EROC_REGEX_OP_MATCH:
+                match = true;
+                /* fall-through. */
+
+            case EROC_REGEX_OP_BYTE:
+            case EROC_REGEX_OP_ANY:
+            case EROC_REGEX_OP_CLASS:
+                dfa->scratch[length++] = pc;
+                hash = (hash ^ pc) * 16777619U;
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* look for an existing state with this set. */
+    size_t mask = dfa->table_size - 1;
+    size_t slot = hash & mask;
+    for (; 0 != dfa->table[slot]; slot = (slot + 1) & mask)
+    {
+        const eroc_regex_dfa_state* state =
+            dfa->states + dfa->table[slot] - 1;
+
+        if (
+            state->hash == hash && state->length == length
+         && 0 == memcmp(
+                    dfa->sets + state->set, dfa->scratch,
+                    length * sizeof(uint32_t)))
+        {
+            return dfa->table[slot] - 1;
+        }
+    }
+
+    /* make room if the cache is full. */
+    if (dfa->state_count == dfa->max_states)
+    {
+        flush(dfa);
+        *flushed = true;
+
+        slot = hash & mask;
+        while (0 != dfa->table[slot])
+        {
+            slot = (slot + 1) & mask;
+        }
+    }
+
+    /* add the new state. */
+    int32_t index = (int32_t)dfa->state_count++;
+    eroc_regex_dfa_state* state = dfa->states + index;
+    state->set = (uint32_t)dfa->sets_used;
+    state->length = length;
+    state->hash = hash;
+    state->match = match;
+    memcpy(dfa->sets + state->set, dfa->scratch, length * sizeof(uint32_t));
+    dfa->sets_used += length;
+
+    for (size_t i = 0; i < dfa->class_count; ++i)
+    {
+        dfa->transitions[index * dfa->class_count + i] = -1;
+    }
+
+    dfa->table[slot] = (uint32_t)index + 1;
+
+    return index;
+}
+
+/**
+ * \brief Discard every cached state.
+ *
+ * \param dfa           The DFA.
+ */
+static void flush(eroc_regex_dfa* dfa)
+{
+    ++dfa->flushes;
+    dfa->state_count = 0;
+    dfa->sets_used = 0;
+    dfa->start = -1;
+    memset(dfa->table, 0, dfa->table_size * sizeof(uint32_t));
+}
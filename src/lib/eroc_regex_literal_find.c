@@ -0,0 +1,207 @@
+/**
+ * \file lib/eroc_regex_literal_find.c
+ *
+ * \brief Find a literal in text using the widest vector unit available.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+# define EROC_REGEX_X86
+# include <immintrin.h>
+#endif
+
+#ifdef EROC_REGEX_X86
+static const char* find_avx2(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length);
+static const char* find_sse2(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length);
+#endif
+static const char* find_tail(
+    const char* text, size_t offset, size_t length, const char* literal,
+    size_t literal_length);
+
+/**
+ * \brief Find the first occurrence of a literal in text.
+ *
+ * Candidate positions are found by comparing both the first and the last byte
+ * of the literal against a whole vector of text at once, which rejects most
+ * positions without looking at the middle of the literal.
+ *
+ * \param text          The text to search.
+ * \param length        The length of the text.
+ * \param literal       The literal to find.
+ * \param literal_length    The length of the literal, which must be at least
+ *                          one.
+ *
+ * \returns a pointer to the first occurrence, or NULL if not found.
+ */
+const char* eroc_regex_literal_find(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length)
+{
+    if (literal_length > length)
+    {
+        return NULL;
+    }
+
+    if (1 == literal_length)
+    {
+        return (const char*)memchr(text, literal[0], length);
+    }
+
+#ifdef EROC_REGEX_X86
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return find_avx2(text, length, literal, literal_length);
+    }
+
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return find_sse2(text, length, literal, literal_length);
+    }
+#endif
+
+    return find_tail(text, 0, length, literal, literal_length);
+}
+
+#ifdef EROC_REGEX_X86
+/**
+ * \brief Check 32 candidate positions at a time with AVX2.
+ *
+ * \param text          The text to search.
+ * \param length        The length of the text.
+ * \param literal       The literal to find.
+ * \param literal_length    The length of the literal, which is at least two.
+ *
+ * \returns a pointer to the first occurrence, or NULL if not found.
+ */
+__attribute__((target("avx2")))
+static const char* find_avx2(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length)
+{
+    const __m256i first = _mm256_set1_epi8(literal[0]);
+    const __m256i last = _mm256_set1_epi8(literal[literal_length - 1]);
+    size_t i = 0;
+
+    for (; i + literal_length - 1 + 32 <= length; i += 32)
+    {
+        __m256i head = _mm256_loadu_si256((const __m256i*)(text + i));
+        __m256i tail =
+            _mm256_loadu_si256(
+                (const __m256i*)(text + i + literal_length - 1));
+        uint32_t mask =
+            (uint32_t)_mm256_movemask_epi8(
+                _mm256_and_si256(
+                    _mm256_cmpeq_epi8(head, first),
+                    _mm256_cmpeq_epi8(tail, last)));
+
+        while (0 != mask)
+        {
+            size_t candidate = i + __builtin_ctz(mask);
+
+            if (0 == memcmp(
+                        text + candidate + 1, literal + 1,
+                        literal_length - 2))
+            {
+                return text + candidate;
+            }
+
+            /* clear the lowest set bit. */
+            mask &= mask - 1;
+        }
+    }
+
+    return find_tail(text, i, length, literal, literal_length);
+}
+
+/**
+ * \brief Check 16 candidate positions at a time with SSE2.
+ *
+ * \param text          The text to search.
+ * \param length        The length of the text.
+ * \param literal       The literal to find.
+ * \param literal_length    The length of the literal, which is at least two.
+ *
+ * \returns a pointer to the first occurrence, or NULL if not found.
+ */
+__attribute__((target("sse2")))
+static const char* find_sse2(
+    const char* text, size_t length, const char* literal,
+    size_t literal_length)
+{
+    const __m128i first = _mm_set1_epi8(literal[0]);
+    const __m128i last = _mm_set1_epi8(literal[literal_length - 1]);
+    size_t i = 0;
+
+    for (; i + literal_length - 1 + 16 <= length; i += 16)
+    {
+        __m128i head = _mm_loadu_si128((const __m128i*)(text + i));
+        __m128i tail =
+            _mm_loadu_si128((const __m128i*)(text + i + literal_length - 1));
+        uint32_t mask =
+            (uint32_t)_mm_movemask_epi8(
+                _mm_and_si128(
+                    _mm_cmpeq_epi8(head, first), _mm_cmpeq_epi8(tail, last)));
+
+        while (0 != mask)
+        {
+            size_t candidate = i + __builtin_ctz(mask);
+
+            if (0 == memcmp(
+                        text + candidate + 1, literal + 1,
+                        literal_length - 2))
+            {
+                return text + candidate;
+            }
+
+            /* clear the lowest set bit. */
+            mask &= mask - 1;
+        }
+    }
+
+    return find_tail(text, i, length, literal, literal_length);
+}
+#endif
+
+/**
+ * \brief Check the candidate positions from offset onward one at a time.
+ *
+ * \param text          The text to search.
+ * \param offset        The first candidate position.
+ * \param length        The length of the text.
+ * \param literal       The literal to find.
+ * \param literal_length    The length of the literal, which is at least two.
+ *
+ * \returns a pointer to the first occurrence, or NULL if not found.
+ */
+static const char* find_tail(
+    const char* text, size_t offset, size_t length, const char* literal,
+    size_t literal_length)
+{
+    for (size_t i = offset; i + literal_length <= length; ++i)
+    {
+        const char* candidate =
+            (const char*)memchr(
+                text + i, literal[0], length - literal_length + 1 - i);
+        if (NULL == candidate)
+        {
+            return NULL;
+        }
+
+        i = candidate - text;
+        if (0 == memcmp(candidate + 1, literal + 1, literal_length - 1))
+        {
+            return candidate;
+        }
+    }
+
+    return NULL;
+}
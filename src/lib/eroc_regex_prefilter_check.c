@@ -0,0 +1,41 @@
+/**
+ * \file lib/eroc_regex_prefilter_check.c
+ *
+ * \brief Check text against a prefilter.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+
+/**
+ * \brief Check whether the given text could match the pattern from which this
+ * prefilter was extracted.
+ *
+ * \param prefilter     The prefilter.
+ * \param text          The text to check, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns false if the text can't match, and true otherwise.
+ */
+bool eroc_regex_prefilter_check(
+    const eroc_regex_prefilter* prefilter, const char* text, size_t length)
+{
+    if (EROC_REGEX_PREFILTER_NONE == prefilter->kind)
+    {
+        return true;
+    }
+
+    for (size_t i = 0; i < prefilter->count; ++i)
+    {
+        if (NULL != eroc_regex_literal_find(
+                        text, length, prefilter->literals[i],
+                        prefilter->lengths[i]))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
@@ -0,0 +1,633 @@
+/**
+ * \file lib/eroc_regex_prefilter_extract.c
+ *
+ * \brief Extract the literals required by a regular expression.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_LITERALS EROC_REGEX_PREFILTER_MAX_LITERALS
+#define MAX_LENGTH EROC_REGEX_PREFILTER_MAX_LENGTH
+
+/* char classes with at most this many members become literal sets. */
+#define MAX_CLASS_LITERALS 4
+
+/**
+ * \brief A set of literals, or an unknown set if known is false.
+ */
+typedef struct literal_set literal_set;
+
+struct literal_set
+{
+    bool known;
+    size_t count;
+    size_t lengths[MAX_LITERALS];
+    char literals[MAX_LITERALS][MAX_LENGTH];
+};
+
+/**
+ * \brief The literals known about the text matched by an AST node.
+ */
+typedef struct literal_info literal_info;
+
+struct literal_info
+{
+    /* the node matches exactly one of these. */
+    literal_set exact;
+    /* every match starts with one of these. */
+    literal_set prefix;
+    /* every match ends with one of these. */
+    literal_set suffix;
+    /* every match contains one of these. */
+    literal_set inner;
+};
+
+/**
+ * \brief How a cross product handles literals which are too long.
+ */
+enum cross_mode
+{
+    /* give up on the whole set. */
+    CROSS_EXACT,
+    /* keep the start of each literal. */
+    CROSS_KEEP_START,
+    /* keep the end of each literal. */
+    CROSS_KEEP_END,
+};
+
+/* forward decls. */
+static int analyze(literal_info** info, const eroc_regex_ast_node* ast);
+static void analyze_char_class(
+    literal_info* info, const eroc_regex_ast_node* ast);
+static void analyze_concat(
+    literal_info* info, const literal_info* left, const literal_info* right);
+static void analyze_alternate(
+    literal_info* info, const literal_info* left, const literal_info* right);
+static const literal_set* exact_or(
+    const literal_info* info, const literal_set* set);
+static void set_single(literal_set* set, const char* literal, size_t length);
+static bool set_add(
+    literal_set* set, const char* literal, size_t length, int mode);
+static void set_cross(
+    literal_set* out, const literal_set* left, const literal_set* right,
+    int mode);
+static void set_union(
+    literal_set* out, const literal_set* left, const literal_set* right);
+static bool set_usable(const literal_set* set);
+static const literal_set* set_better(
+    const literal_set* left, const literal_set* right);
+static void choose_inner(literal_info* info);
+
+/**
+ * \brief Extract the literals required by the given AST into a prefilter.
+ *
+ * Required prefix, suffix and inner literals are collected for every node,
+ * including small literal sets from alternations and char classes, and the
+ * most selective set found for the whole pattern is kept.
+ *
+ * \param prefilter     The prefilter to populate. Its kind is set to
+ *                      \ref EROC_REGEX_PREFILTER_NONE if the pattern has no
+ *                      useful required literals.
+ * \param ast           The AST to analyze.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_prefilter_extract(
+    eroc_regex_prefilter* prefilter, const eroc_regex_ast_node* ast)
+{
+    int retval;
+    literal_info* info;
+    const literal_set* best = NULL;
+
+    memset(prefilter, 0, sizeof(*prefilter));
+    prefilter->kind = EROC_REGEX_PREFILTER_NONE;
+
+    retval = analyze(&info, ast);
+    if (0 != retval)
+    {
+        goto done;
+    }
+
+    /* prefer the more specific kinds when they are as selective. */
+    const literal_set* candidates[] = {
+        &info->exact, &info->prefix, &info->suffix, &info->inner };
+    const int kinds[] = {
+        EROC_REGEX_PREFILTER_EXACT, EROC_REGEX_PREFILTER_PREFIX,
+        EROC_REGEX_PREFILTER_SUFFIX, EROC_REGEX_PREFILTER_INNER };
+
+    for (size_t i = 0; i < sizeof(kinds) / sizeof(kinds[0]); ++i)
+    {
+        if (set_usable(candidates[i]) && candidates[i] != best
+         && set_better(best, candidates[i]) == candidates[i])
+        {
+            best = candidates[i];
+            prefilter->kind = kinds[i];
+        }
+    }
+
+    if (NULL != best)
+    {
+        prefilter->count = best->count;
+        memcpy(prefilter->lengths, best->lengths, sizeof(best->lengths));
+        memcpy(prefilter->literals, best->literals, sizeof(best->literals));
+    }
+
+    free(info);
+    retval = 0;
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Compute the literals known about the given AST node.
+ *
+ * \param info          Pointer to be set to the computed info on success, which
+ *                      the caller must free.
+ * \param ast           The AST node to analyze.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int analyze(literal_info** info, const eroc_regex_ast_node* ast)
+{
+    int retval;
+    literal_info* tmp;
+    literal_info* left = NULL;
+    literal_info* right = NULL;
+
+    tmp = (literal_info*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    switch (ast->type)
+    {
+        case EROC_REGEX_AST_EMPTY:
+            set_single(&tmp->exact, "", 0);
+            break;
+
+        case EROC_REGEX_AST_LITERAL:
+            set_single(&tmp->exact, &ast->data.literal, 1);
+            break;
+
+        case EROC_REGEX_AST_CHAR_CLASS:
+            analyze_char_class(tmp, ast);
+            break;
+
+        case EROC_REGEX_AST_CONCAT:
+        case EROC_REGEX_AST_ALTERNATE:
+            retval = analyze(&left, ast->data.binary.left);
+            if (0 != retval)
+            {
+                goto cleanup_tmp;
+            }
+
+            retval = analyze(&right, ast->data.binary.right);
+            if (0 != retval)
+            {
+                goto cleanup_left;
+            }
+
+            if (EROC_REGEX_AST_CONCAT == ast->type)
+            {
+                analyze_concat(tmp, left, right);
+            }
+            else
+            {
+                analyze_alternate(tmp, left, right);
+            }
+
+            free(right);
+            free(left);
+            break;
+
+        /* at least one repetition, but the whole is not a known literal. */
+        case EROC_REGEX_AST_PLUS:
+            retval = analyze(&left, ast->data.unary.child);
+            if (0 != retval)
+            {
+                goto cleanup_tmp;
+            }
+
+            tmp->prefix = *exact_or(left, &left->prefix);
+            tmp->suffix = *exact_or(left, &left->suffix);
+            tmp->inner = left->inner;
+            free(left);
+            break;
+
+        /* either the child or the empty string. */
+        case EROC_REGEX_AST_OPTIONAL:
+            retval = analyze(&left, ast->data.unary.child);
+            if (0 != retval)
+            {
+                goto cleanup_tmp;
+            }
+
+            if (left->exact.known)
+            {
+                literal_set empty;
+                set_single(&empty, "", 0);
+                set_union(&tmp->exact, &left->exact, &empty);
+            }
+            free(left);
+            break;
+
+        case EROC_REGEX_AST_CAPTURE:
+            retval = analyze(&left, ast->data.capture.child);
+            if (0 != retval)
+            {
+                goto cleanup_tmp;
+            }
+
+            *tmp = *left;
+            free(left);
+            break;
+
+        /* nothing is known about any and star. */
+        default:
+            break;
+    }
+
+    choose_inner(tmp);
+
+    /* success. */
+    *info = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_left:
+    free(left);
+
+cleanup_tmp:
+    free(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Small char classes match exactly one of their members.
+ *
+ * \param info          The info to populate.
+ * \param ast           The char class AST node.
+ */
+static void analyze_char_class(
+    literal_info* info, const eroc_regex_ast_node* ast)
+{
+    literal_set* set = &info->exact;
+
+    set->known = true;
+    for (unsigned int ch = 0; ch < 256; ++ch)
+    {
+        bool member =
+            0 != (ast->data.char_class.members[ch / 32]
+                    & ((uint32_t)1 << (ch % 32)));
+        if (member == ast->data.char_class.inverse)
+        {
+            continue;
+        }
+
+        char literal = (char)ch;
+        if (set->count == MAX_CLASS_LITERALS
+         || !set_add(set, &literal, 1, CROSS_EXACT))
+        {
+            set->known = false;
+            set->count = 0;
+            return;
+        }
+    }
+}
+
+/**
+ * \brief A concatenation matches a left match followed by a right match.
+ *
+ * \param info          The info to populate.
+ * \param left          The info for the left-hand side.
+ * \param right         The info for the right-hand side.
+ */
+static void analyze_concat(
+    literal_info* info, const literal_info* left, const literal_info* right)
+{
+    literal_set cross;
+
+    set_cross(&info->exact, &left->exact, &right->exact, CROSS_EXACT);
+
+    /* an exact left side extends into the prefix of the right side. */
+    if (left->exact.known)
+    {
+        set_cross(
+            &info->prefix, &left->exact, exact_or(right, &right->prefix),
+            CROSS_KEEP_START);
+        if (!info->prefix.known)
+        {
+            info->prefix = left->exact;
+        }
+    }
+    else
+    {
+        info->prefix = left->prefix;
+    }
+
+    /* likewise, an exact right side extends into the suffix of the left. */
+    if (right->exact.known)
+    {
+        set_cross(
+            &info->suffix, exact_or(left, &left->suffix), &right->exact,
+            CROSS_KEEP_END);
+        if (!info->suffix.known)
+        {
+            info->suffix = right->exact;
+        }
+    }
+    else
+    {
+        info->suffix = right->suffix;
+    }
+
+    /* the join of the two sides is an inner literal. */
+    set_cross(
+        &cross, exact_or(left, &left->suffix), exact_or(right, &right->prefix),
+        CROSS_KEEP_START);
+
+    info->inner =
+        *set_better(set_better(&left->inner, &right->inner), &cross);
+}
+
+/**
+ * \brief An alternation matches either side, so every set is the union of the
+ * two sides.
+ *
+ * \param info          The info to populate.
+ * \param left          The info for the left-hand side.
+ * \param right         The info for the right-hand side.
+ */
+static void analyze_alternate(
+    literal_info* info, const literal_info* left, const literal_info* right)
+{
+    set_union(&info->exact, &left->exact, &right->exact);
+    set_union(
+        &info->prefix, exact_or(left, &left->prefix),
+        exact_or(right, &right->prefix));
+    set_union(
+        &info->suffix, exact_or(left, &left->suffix),
+        exact_or(right, &right->suffix));
+    set_union(&info->inner, &left->inner, &right->inner);
+}
+
+/**
+ * \brief An exact set is also a prefix, suffix and inner set.
+ *
+ * \param info          The info.
+ * \param set           The set to use if the exact set is unknown.
+ *
+ * \returns the exact set if known, and set otherwise.
+ */
+static const literal_set* exact_or(
+    const literal_info* info, const literal_set* set)
+{
+    return info->exact.known ? &info->exact : set;
+}
+
+/**
+ * \brief Make a set holding a single literal.
+ *
+ * \param set           The set to populate.
+ * \param literal       The literal.
+ * \param length        The length of the literal.
+ */
+static void set_single(literal_set* set, const char* literal, size_t length)
+{
+    set->known = true;
+    set->count = 0;
+    (void)set_add(set, literal, length, CROSS_EXACT);
+}
+
+/**
+ * \brief Add a literal to a set, skipping duplicates.
+ *
+ * \param set           The set.
+ * \param literal       The literal.
+ * \param length        The length of the literal.
+ * \param mode          How to handle a literal which is too long.
+ *
+ * \returns true on success and false if the literal doesn't fit.
+ */
+static bool set_add(
+    literal_set* set, const char* literal, size_t length, int mode)
+{
+    if (length > MAX_LENGTH)
+    {
+        switch (mode)
+        {
+            case CROSS_KEEP_START:
+                length = MAX_LENGTH;
+                break;
+
+            case CROSS_KEEP_END:
+                literal += length - MAX_LENGTH;
+                length = MAX_LENGTH;
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    for (size_t i = 0; i < set->count; ++i)
+    {
+        if (set->lengths[i] == length
+         && 0 == memcmp(set->literals[i], literal, length))
+        {
+            return true;
+        }
+    }
+
+    if (MAX_LITERALS == set->count)
+    {
+        return false;
+    }
+
+    memcpy(set->literals[set->count], literal, length);
+    set->lengths[set->count++] = length;
+
+    return true;
+}
+
+/**
+ * \brief Compute every concatenation of a left literal and a right literal.
+ *
+ * \param out           The set to populate, which is unknown if either input
+ *                      is unknown or the product doesn't fit.
+ * \param left          The left-hand set.
+ * \param right         The right-hand set.
+ * \param mode          How to handle a literal which is too long.
+ */
+static void set_cross(
+    literal_set* out, const literal_set* left, const literal_set* right,
+    int mode)
+{
+    char buffer[2 * MAX_LENGTH];
+
+    out->known = false;
+    out->count = 0;
+
+    if (!left->known || !right->known)
+    {
+        return;
+    }
+
+    out->known = true;
+    for (size_t i = 0; i < left->count; ++i)
+    {
+        for (size_t j = 0; j < right->count; ++j)
+        {
+            memcpy(buffer, left->literals[i], left->lengths[i]);
+            memcpy(
+                buffer + left->lengths[i], right->literals[j],
+                right->lengths[j]);
+            if (!set_add(
+                    out, buffer, left->lengths[i] + right->lengths[j], mode))
+            {
+                out->known = false;
+                out->count = 0;
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Compute the union of two sets.
+ *
+ * \param out           The set to populate, which is unknown if either input
+ *                      is unknown or the union doesn't fit.
+ * \param left          The left-hand set.
+ * \param right         The right-hand set.
+ */
+static void set_union(
+    literal_set* out, const literal_set* left, const literal_set* right)
+{
+    literal_set tmp;
+
+    out->known = false;
+    out->count = 0;
+
+    if (!left->known || !right->known)
+    {
+        return;
+    }
+
+    tmp = *left;
+    for (size_t i = 0; i < right->count; ++i)
+    {
+        if (!set_add(
+                &tmp, right->literals[i], right->lengths[i], CROSS_EXACT))
+        {
+            return;
+        }
+    }
+
+    *out = tmp;
+}
+
+/**
+ * \brief A set can filter text if it is known and has no empty literal.
+ *
+ * \param set           The set to check.
+ *
+ * \returns true if this set is usable as a filter.
+ */
+static bool set_usable(const literal_set* set)
+{
+    if (!set->known || 0 == set->count)
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < set->count; ++i)
+    {
+        if (0 == set->lengths[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * \brief Pick the more selective of two sets: the one whose shortest literal is
+ * longer, then the one with fewer literals. Unusable sets lose.
+ *
+ * \param left          The left-hand set, which wins ties, or NULL.
+ * \param right         The right-hand set.
+ *
+ * \returns the more selective set.
+ */
+static const literal_set* set_better(
+    const literal_set* left, const literal_set* right)
+{
+    size_t left_min = SIZE_MAX, right_min = SIZE_MAX;
+
+    if (NULL == left || !set_usable(left))
+    {
+        return right;
+    }
+
+    if (!set_usable(right))
+    {
+        return left;
+    }
+
+    for (size_t i = 0; i < left->count; ++i)
+    {
+        if (left->lengths[i] < left_min)
+            left_min = left->lengths[i];
+    }
+
+    for (size_t i = 0; i < right->count; ++i)
+    {
+        if (right->lengths[i] < right_min)
+            right_min = right->lengths[i];
+    }
+
+    if (right_min > left_min)
+    {
+        return right;
+    }
+
+    if (right_min == left_min && right->count < left->count)
+    {
+        return right;
+    }
+
+    return left;
+}
+
+/**
+ * \brief The inner set of a node is the most selective set known about it.
+ *
+ * \param info          The info to update.
+ */
+static void choose_inner(literal_info* info)
+{
+    const literal_set* best = &info->inner;
+
+    best = set_better(best, &info->exact);
+    best = set_better(best, &info->prefix);
+    best = set_better(best, &info->suffix);
+
+    if (best != &info->inner)
+    {
+        info->inner = *best;
+    }
+}
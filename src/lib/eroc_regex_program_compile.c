@@ -0,0 +1,349 @@
+/**
+ * \file lib/eroc_regex_program_compile.c
+ *
+ * \brief Compile a regular expression AST into an NFA program.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static int compile_node(
+    eroc_regex_program* program, size_t* capacity,
+    const eroc_regex_ast_node* ast);
+static int emit(
+    eroc_regex_program* program, size_t* capacity, int opcode, uint32_t x,
+    uint32_t y);
+static int add_class(
+    eroc_regex_program* program, uint32_t* index,
+    const eroc_regex_ast_node* ast);
+
+/**
+ * \brief Compile an AST into an NFA program.
+ *
+ * \note The AST remains owned by the caller.
+ *
+ * \param program       Pointer to the program pointer to be populated with the
+ *                      compiled program on success.
+ * \param ast           The AST to compile.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_program_compile(
+    eroc_regex_program** program, const eroc_regex_ast_node* ast)
+{
+    int retval;
+    size_t capacity = 0U;
+    eroc_regex_program* tmp;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_regex_program*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* the whole match is captured in slots 0 and 1. */
+    retval = emit(tmp, &capacity, EROC_REGEX_OP_SAVE, 0, 0);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    retval = compile_node(tmp, &capacity, ast);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    retval = emit(tmp, &capacity, EROC_REGEX_OP_SAVE, 1, 0);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    retval = emit(tmp, &capacity, EROC_REGEX_OP_MATCH, 0, 0);
+    if (0 != retval)
+    {
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *program = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_regex_program_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Compile an AST node, appending its instructions to the program.
+ *
+ * \param program       The program under construction.
+ * \param capacity      Pointer to the instruction capacity of the program.
+ * \param ast           The AST node to compile.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int compile_node(
+    eroc_regex_program* program, size_t* capacity,
+    const eroc_regex_ast_node* ast)
+{
+    int retval;
+    size_t split, jump, loop;
+    uint32_t index;
+
+    switch (ast->type)
+    {
+        case EROC_REGEX_AST_EMPTY:
+            return 0;
+
+        case EROC_REGEX_AST_ANY:
+            return emit(program, capacity, EROC_REGEX_OP_ANY, 0, 0);
+
+        case EROC_REGEX_AST_LITERAL:
+            retval = emit(program, capacity, EROC_REGEX_OP_BYTE, 0, 0);
+            if (0 == retval)
+            {
+                program->instructions[program->count - 1].byte =
+                    (uint8_t)ast->data.literal;
+            }
+            return retval;
+
+        case EROC_REGEX_AST_CHAR_CLASS:
+            retval = add_class(program, &index, ast);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            return emit(program, capacity, EROC_REGEX_OP_CLASS, index, 0);
+
+        case EROC_REGEX_AST_CONCAT:
+            retval = compile_node(program, capacity, ast->data.binary.left);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            return compile_node(program, capacity, ast->data.binary.right);
+
+        /*   SPLIT L1, L2
+         * L1: left
+         *     JUMP L3
+         * L2: right
+         * L3:
+         */
+        case EROC_REGEX_AST_ALTERNATE:
+            split = program->count;
+            retval = emit(program, capacity, EROC_REGEX_OP_SPLIT, 0, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = compile_node(program, capacity, ast->data.binary.left);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            jump = program->count;
+            retval = emit(program, capacity, EROC_REGEX_OP_JUMP, 0, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = compile_node(program, capacity, ast->data.binary.right);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            program->instructions[split].x = split + 1;
+            program->instructions[split].y = jump + 1;
+            program->instructions[jump].x = program->count;
+            return 0;
+
+        /* L1: SPLIT L2, L3
+         * L2: child
+         *     JUMP L1
+         * L3:
+         */
+        case EROC_REGEX_AST_STAR:
+            split = program->count;
+            retval = emit(program, capacity, EROC_REGEX_OP_SPLIT, 0, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = compile_node(program, capacity, ast->data.unary.child);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = emit(program, capacity, EROC_REGEX_OP_JUMP, split, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            program->instructions[split].x = split + 1;
+            program->instructions[split].y = program->count;
+            return 0;
+
+        /* L1: child
+         *     SPLIT L1, L3
+         * L3:
+         */
+        case EROC_REGEX_AST_PLUS:
+            loop = program->count;
+            retval = compile_node(program, capacity, ast->data.unary.child);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            return
+                emit(
+                    program, capacity, EROC_REGEX_OP_SPLIT, loop,
+                    program->count + 1);
+
+        /*   SPLIT L1, L2
+         * L1: child
+         * L2:
+         */
+        case EROC_REGEX_AST_OPTIONAL:
+            split = program->count;
+            retval = emit(program, capacity, EROC_REGEX_OP_SPLIT, 0, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = compile_node(program, capacity, ast->data.unary.child);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            program->instructions[split].x = split + 1;
+            program->instructions[split].y = program->count;
+            return 0;
+
+        /*   SAVE 2g + 2
+         *   child
+         *   SAVE 2g + 3
+         */
+        case EROC_REGEX_AST_CAPTURE:
+            if (ast->data.capture.group_index < 0)
+            {
+                return 2;
+            }
+            if (ast->data.capture.group_index >= program->captures)
+            {
+                program->captures = ast->data.capture.group_index + 1;
+            }
+            retval =
+                emit(
+                    program, capacity, EROC_REGEX_OP_SAVE,
+                    2 * ast->data.capture.group_index + 2, 0);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            retval = compile_node(program, capacity, ast->data.capture.child);
+            if (0 != retval)
+            {
+                return retval;
+            }
+            return
+                emit(
+                    program, capacity, EROC_REGEX_OP_SAVE,
+                    2 * ast->data.capture.group_index + 3, 0);
+
+        /* pseudoinstructions never survive a successful parse. */
+        default:
+            return 3;
+    }
+}
+
+/**
+ * \brief Append an instruction to the program, growing it as needed.
+ *
+ * \param program       The program under construction.
+ * \param capacity      Pointer to the instruction capacity of the program.
+ * \param opcode        The opcode of this instruction.
+ * \param x             The first operand.
+ * \param y             The second operand.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int emit(
+    eroc_regex_program* program, size_t* capacity, int opcode, uint32_t x,
+    uint32_t y)
+{
+    if (program->count == *capacity)
+    {
+        size_t newcap = *capacity > 0 ? *capacity * 2 : 16;
+        eroc_regex_instruction* tmp =
+            (eroc_regex_instruction*)
+                realloc(program->instructions, newcap * sizeof(*tmp));
+        if (NULL == tmp)
+        {
+            return 1;
+        }
+
+        program->instructions = tmp;
+        *capacity = newcap;
+    }
+
+    eroc_regex_instruction* instruction =
+        program->instructions + program->count++;
+    instruction->opcode = (uint8_t)opcode;
+    instruction->byte = 0;
+    instruction->x = x;
+    instruction->y = y;
+
+    return 0;
+}
+
+/**
+ * \brief Add the membership bitmap of a char class to the program, resolving
+ * inversion up front.
+ *
+ * \param program       The program under construction.
+ * \param index         Set to the index of the class on success.
+ * \param ast           The char class AST node.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int add_class(
+    eroc_regex_program* program, uint32_t* index,
+    const eroc_regex_ast_node* ast)
+{
+    uint32_t (*tmp)[8] =
+        (uint32_t (*)[8])
+            realloc(
+                program->classes,
+                (program->class_count + 1) * sizeof(*program->classes));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    program->classes = tmp;
+    for (int i = 0; i < 8; ++i)
+    {
+        tmp[program->class_count][i] =
+            ast->data.char_class.inverse
+                ? ~ast->data.char_class.members[i]
+                : ast->data.char_class.members[i];
+    }
+
+    *index = program->class_count++;
+
+    return 0;
+}
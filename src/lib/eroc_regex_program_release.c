@@ -0,0 +1,23 @@
+/**
+ * \file lib/eroc_regex_program_release.c
+ *
+ * \brief Release a compiled NFA program.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a compiled NFA program.
+ *
+ * \param program       The program to release.
+ */
+void eroc_regex_program_release(eroc_regex_program* program)
+{
+    free(program->instructions);
+    free(program->classes);
+    free(program);
+}
@@ -0,0 +1,36 @@
+/**
+ * \file lib/eroc_regex_release.c
+ *
+ * \brief Release a compiled regex.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a compiled regex.
+ *
+ * \param regex         The regex to release.
+ */
+void eroc_regex_release(eroc_regex* regex)
+{
+    if (NULL != regex->dfa)
+    {
+        eroc_regex_dfa_release(regex->dfa);
+    }
+
+    if (NULL != regex->program)
+    {
+        eroc_regex_program_release(regex->program);
+    }
+
+    if (NULL != regex->ast)
+    {
+        eroc_regex_ast_node_release(regex->ast);
+    }
+
+    free(regex);
+}
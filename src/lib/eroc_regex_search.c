@@ -0,0 +1,63 @@
+/**
+ * \file lib/eroc_regex_search.c
+ *
+ * \brief Search text using a compiled regex.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+
+/**
+ * \brief Search the given text for a match of a compiled regex.
+ *
+ * \param regex         The regex for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the leftmost match on success, or NULL.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_search(
+    eroc_regex* regex, size_t* captures, const char* text, size_t length)
+{
+    const eroc_regex_prefilter* prefilter = &regex->prefilter;
+    const char* found;
+
+    ++regex->searches;
+
+    /* a pattern which only matches one literal, and has no groups to fill */
+    /* in, is found by the literal search alone. */
+    if (   EROC_REGEX_PREFILTER_EXACT == prefilter->kind
+        && 1 == prefilter->count
+        && 0 == regex->program->captures)
+    {
+        found =
+            eroc_regex_literal_find(
+                text, length, prefilter->literals[0], prefilter->lengths[0]);
+        if (NULL == found)
+        {
+            ++regex->skipped;
+            return false;
+        }
+
+        if (NULL != captures)
+        {
+            captures[0] = found - text;
+            captures[1] = captures[0] + prefilter->lengths[0];
+        }
+
+        return true;
+    }
+
+    /* reject text without a required literal before running the engine. */
+    if (!eroc_regex_prefilter_check(&regex->prefilter, text, length))
+    {
+        ++regex->skipped;
+        return false;
+    }
+
+    return eroc_regex_dfa_search(regex->dfa, captures, text, length);
+}
@@ -0,0 +1,276 @@
+/**
+ * \file lib/eroc_regex_substitution_apply.c
+ *
+ * \brief Apply a substitution to text.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MIN_RESULT_CAPACITY 64
+
+/* forward decls. */
+static int append(
+    eroc_regex_substitution* substitution, const char* data, size_t length);
+static int expand(
+    eroc_regex_substitution* substitution, const char* text, size_t offset);
+
+/**
+ * \brief Apply a substitution to the given text.
+ *
+ * On success, the substituted text is in the substitution's result buffer,
+ * which is valid until the next call. If no replacement was made, the contents
+ * of the result buffer are unspecified.
+ *
+ * \param substitution  The substitution to apply.
+ * \param count         Set to the number of replacements made.
+ * \param text          The text to substitute, which need not be NUL
+ *                      terminated.
+ * \param length        The length of the text.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_substitution_apply(
+    eroc_regex_substitution* substitution, size_t* count, const char* text,
+    size_t length)
+{
+    int retval;
+    size_t* captures = substitution->captures;
+    size_t pos = 0;
+    size_t matches = 0;
+    size_t replaced = 0;
+    size_t last_end = SIZE_MAX;
+    size_t start, end;
+
+    substitution->result_length = 0;
+
+    while (pos <= length)
+    {
+        if (!eroc_regex_search(
+                substitution->regex, captures, text + pos, length - pos))
+        {
+            break;
+        }
+
+        start = pos + captures[0];
+        end = pos + captures[1];
+
+        /* an empty match directly after the previous match doesn't count, */
+        /* so that globally replacing x* with - turns xab into -a-b-. */
+        if (start == end && start == last_end)
+        {
+            if (start == length)
+            {
+                break;
+            }
+
+            retval = append(substitution, text + pos, start + 1 - pos);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            pos = start + 1;
+            continue;
+        }
+
+        ++matches;
+        if (matches >= substitution->occurrence)
+        {
+            retval = append(substitution, text + pos, start - pos);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            retval = expand(substitution, text, pos);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            ++replaced;
+        }
+        else
+        {
+            retval = append(substitution, text + pos, end - pos);
+            if (0 != retval)
+            {
+                return retval;
+            }
+        }
+
+        last_end = pos = end;
+
+        if (replaced > 0 && !substitution->global)
+        {
+            break;
+        }
+
+        /* step over the character after an empty match. */
+        if (start == end)
+        {
+            if (end == length)
+            {
+                break;
+            }
+
+            retval = append(substitution, text + end, 1);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            pos = end + 1;
+        }
+    }
+
+    *count = replaced;
+    if (0 == replaced)
+    {
+        return 0;
+    }
+
+    /* copy the text after the last match. */
+    return append(substitution, text + pos, length - pos);
+}
+
+/**
+ * \brief Append data to the result buffer, growing it as needed.
+ *
+ * \param substitution  The substitution.
+ * \param data          The data to append.
+ * \param length        The length of the data.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int append(
+    eroc_regex_substitution* substitution, const char* data, size_t length)
+{
+    size_t needed = substitution->result_length + length;
+    size_t capacity = substitution->result_capacity;
+    char* tmp;
+
+    if (needed > capacity)
+    {
+        if (capacity < MIN_RESULT_CAPACITY)
+        {
+            capacity = MIN_RESULT_CAPACITY;
+        }
+
+        while (capacity < needed)
+        {
+            capacity *= 2;
+        }
+
+        tmp = (char*)realloc(substitution->result, capacity);
+        if (NULL == tmp)
+        {
+            return 1;
+        }
+
+        substitution->result = tmp;
+        substitution->result_capacity = capacity;
+    }
+
+    if (length > 0)
+    {
+        memcpy(
+            substitution->result + substitution->result_length, data, length);
+        substitution->result_length += length;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Append the replacement for the current match to the result buffer.
+ *
+ * \param substitution  The substitution.
+ * \param text          The text being substituted.
+ * \param offset        The offset at which the current match's search began,
+ *                      which the capture slots are relative to.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int expand(
+    eroc_regex_substitution* substitution, const char* text, size_t offset)
+{
+    int retval;
+    const size_t* captures = substitution->captures;
+    const char* in = substitution->replacement;
+    const char* literal;
+    size_t group;
+
+    while (*in)
+    {
+        /* copy a run of literal characters. */
+        literal = in;
+        while (*in && '&' != *in && '\\' != *in)
+        {
+            ++in;
+        }
+
+        retval = append(substitution, literal, in - literal);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        if (0 == *in)
+        {
+            break;
+        }
+
+        /* & is the whole match, and \0 through \9 are capture groups. */
+        if ('&' == *in)
+        {
+            group = 0;
+        }
+        else if (in[1] >= '0' && in[1] <= '9')
+        {
+            group = *++in - '0';
+        }
+        /* any other escaped character is literal; a trailing backslash is */
+        /* itself. */
+        else
+        {
+            if (0 != in[1])
+            {
+                ++in;
+            }
+
+            retval = append(substitution, in++, 1);
+            if (0 != retval)
+            {
+                return retval;
+            }
+
+            continue;
+        }
+
+        ++in;
+
+        /* a group that didn't participate in the match is empty. */
+        if (EROC_REGEX_UNSET == captures[2 * group])
+        {
+            continue;
+        }
+
+        retval =
+            append(
+                substitution, text + offset + captures[2 * group],
+                captures[2 * group + 1] - captures[2 * group]);
+        if (0 != retval)
+        {
+            return retval;
+        }
+    }
+
+    return 0;
+}
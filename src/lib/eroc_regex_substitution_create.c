@@ -0,0 +1,120 @@
+/**
+ * \file lib/eroc_regex_substitution_create.c
+ *
+ * \brief Compile a substitution.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static bool replacement_valid(const char* replacement, int captures);
+
+/**
+ * \brief Compile a substitution.
+ *
+ * \param substitution  Pointer to the substitution pointer to be populated
+ *                      with the substitution on success.
+ * \param pattern       The pattern to match.
+ * \param replacement   The replacement for each match.
+ * \param occurrence    The 1-based index of the first match to replace, or 0
+ *                      for the first match.
+ * \param global        If true, replace every match from the given occurrence
+ *                      onward; otherwise, replace only that occurrence.
+ *
+ * \returns 0 on success and non-zero on failure, including a replacement
+ * which refers to a capture group that the pattern lacks.
+ */
+int eroc_regex_substitution_create(
+    eroc_regex_substitution** substitution, const char* pattern,
+    const char* replacement, size_t occurrence, bool global)
+{
+    int retval;
+    eroc_regex_substitution* tmp;
+    size_t slots;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_regex_substitution*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->occurrence = (0 == occurrence) ? 1 : occurrence;
+    tmp->global = global;
+
+    retval = eroc_regex_create(&tmp->regex, pattern);
+    if (0 != retval)
+    {
+        tmp->regex = NULL;
+        goto cleanup_tmp;
+    }
+
+    /* back references must name groups that exist. */
+    if (!replacement_valid(replacement, tmp->regex->program->captures))
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    tmp->replacement = strdup(replacement);
+    if (NULL == tmp->replacement)
+    {
+        retval = 3;
+        goto cleanup_tmp;
+    }
+
+    slots = 2 * ((size_t)tmp->regex->program->captures + 1);
+    tmp->captures = (size_t*)malloc(slots * sizeof(size_t));
+    if (NULL == tmp->captures)
+    {
+        retval = 4;
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *substitution = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_regex_substitution_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Check that every back reference in a replacement names a capture
+ * group of the pattern.
+ *
+ * \param replacement   The replacement to check.
+ * \param captures      The number of capture groups in the pattern.
+ *
+ * \returns true if the replacement is valid and false otherwise.
+ */
+static bool replacement_valid(const char* replacement, int captures)
+{
+    for (; *replacement; ++replacement)
+    {
+        if ('\\' != *replacement || 0 == replacement[1])
+        {
+            continue;
+        }
+
+        ++replacement;
+        if (   *replacement >= '1' && *replacement <= '9'
+            && *replacement - '0' > captures)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
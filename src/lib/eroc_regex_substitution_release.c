@@ -0,0 +1,29 @@
+/**
+ * \file lib/eroc_regex_substitution_release.c
+ *
+ * \brief Release a substitution.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a substitution.
+ *
+ * \param substitution  The substitution to release.
+ */
+void eroc_regex_substitution_release(eroc_regex_substitution* substitution)
+{
+    if (NULL != substitution->regex)
+    {
+        eroc_regex_release(substitution->regex);
+    }
+
+    free(substitution->replacement);
+    free(substitution->captures);
+    free(substitution->result);
+    free(substitution);
+}
@@ -0,0 +1,84 @@
+/**
+ * \file lib/eroc_regex_vm_create.c
+ *
+ * \brief Create a Pike VM for a compiled NFA program.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create a Pike VM for running the given program.
+ *
+ * \note The program remains owned by the caller, and must outlive the VM.
+ *
+ * \param vm            Pointer to the VM pointer to be populated with the VM on
+ *                      success.
+ * \param program       The program that this VM runs.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_regex_vm_create(eroc_regex_vm** vm, const eroc_regex_program* program)
+{
+    int retval;
+    eroc_regex_vm* tmp;
+    size_t count = program->count;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_regex_vm*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->program = program;
+    tmp->slot_count = 2 * ((size_t)program->captures + 1);
+
+    /* each list holds at most one thread per instruction. */
+    for (int i = 0; i < 2; ++i)
+    {
+        tmp->pcs[i] = (uint32_t*)malloc(count * sizeof(uint32_t));
+        tmp->slots[i] =
+            (size_t*)malloc(count * tmp->slot_count * sizeof(size_t));
+        if (NULL == tmp->pcs[i] || NULL == tmp->slots[i])
+        {
+            retval = 2;
+            goto cleanup_tmp;
+        }
+    }
+
+    tmp->marks = (unsigned int*)calloc(count, sizeof(unsigned int));
+    if (NULL == tmp->marks)
+    {
+        retval = 3;
+        goto cleanup_tmp;
+    }
+
+    /* each instruction is followed once per step, pushing at most two frames
+     * of two words each. */
+    tmp->stack = (size_t*)malloc(2 * (2 * count + 1) * sizeof(size_t));
+    tmp->scratch = (size_t*)malloc(tmp->slot_count * sizeof(size_t));
+    tmp->best = (size_t*)malloc(tmp->slot_count * sizeof(size_t));
+    if (NULL == tmp->stack || NULL == tmp->scratch || NULL == tmp->best)
+    {
+        retval = 4;
+        goto cleanup_tmp;
+    }
+
+    /* success. */
+    *vm = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_regex_vm_release(tmp);
+
+done:
+    return retval;
+}
@@ -0,0 +1,31 @@
+/**
+ * \file lib/eroc_regex_vm_release.c
+ *
+ * \brief Release a Pike VM.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a Pike VM.
+ *
+ * \param vm            The VM to release.
+ */
+void eroc_regex_vm_release(eroc_regex_vm* vm)
+{
+    for (int i = 0; i < 2; ++i)
+    {
+        free(vm->pcs[i]);
+        free(vm->slots[i]);
+    }
+
+    free(vm->marks);
+    free(vm->stack);
+    free(vm->scratch);
+    free(vm->best);
+    free(vm);
+}
@@ -0,0 +1,229 @@
+/**
+ * \file lib/eroc_regex_vm_search.c
+ *
+ * \brief Search text using a Pike VM.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <string.h>
+
+/* stack frames which restore a capture slot are tagged with the high bit. */
+#define RESTORE_FRAME (~((size_t)-1 >> 1))
+
+/* forward decls. */
+static void add_thread(
+    eroc_regex_vm* vm, int list, uint32_t pc, size_t offset);
+static void next_generation(eroc_regex_vm* vm);
+
+/**
+ * \brief Search the given text for the leftmost match of the VM's program.
+ *
+ * Among matches starting at the leftmost position, the one preferred by the
+ * pattern wins: alternation prefers its left side, and repetition is greedy.
+ *
+ * \param vm            The VM for this search.
+ * \param captures      Array of 2 * (captures + 1) offsets which is set to the
+ *                      capture slots of the match on success, or NULL. Groups
+ *                      which did not participate are set to
+ *                      \ref EROC_REGEX_UNSET.
+ * \param text          The text to search, which need not be NUL terminated.
+ * \param length        The length of the text.
+ *
+ * \returns true if the text matches and false otherwise.
+ */
+bool eroc_regex_vm_search(
+    eroc_regex_vm* vm, size_t* captures, const char* text, size_t length)
+{
+    const eroc_regex_program* program = vm->program;
+    size_t slot_count = vm->slot_count;
+    bool matched = false;
+    int current = 0;
+
+    vm->thread_count[current] = 0;
+    next_generation(vm);
+
+    for (size_t offset = 0; ; ++offset)
+    {
+        /* until a match is found, start a new, lowest priority thread here. */
+        if (!matched)
+        {
+            for (size_t i = 0; i < slot_count; ++i)
+            {
+                vm->scratch[i] = EROC_REGEX_UNSET;
+            }
+
+            add_thread(vm, current, 0, offset);
+        }
+
+        if (0 == vm->thread_count[current])
+        {
+            break;
+        }
+
+        int next = 1 - current;
+        vm->thread_count[next] = 0;
+        next_generation(vm);
+
+        /* step each thread in priority order. */
+        for (size_t t = 0; t < vm->thread_count[current]; ++t)
+        {
+            const eroc_regex_instruction* inst =
+                program->instructions + vm->pcs[current][t];
+            size_t* slots = vm->slots[current] + t * slot_count;
+            bool step = false;
+
+            if (EROC_REGEX_OP_MATCH == inst->opcode)
+            {
+                /* lower priority threads can no longer win. */
+                memcpy(vm->best, slots, slot_count * sizeof(size_t));
+                matched = true;
+                break;
+            }
+
+            if (offset < length)
+            {
+                unsigned int ch = (unsigned char)text[offset];
+
+                switch (inst->opcode)
+                {
+                    case EROC_REGEX_OP_BYTE:
+                        step = (ch == inst->byte);
+                        break;
+
+                    case EROC_REGEX_OP_ANY:
+                        step = true;
+                        break;
+
+                    case EROC_REGEX_OP_CLASS:
+                        step =
+                            0 != (program->classes[inst->x][ch / 32]
+                                    & ((uint32_t)1 << (ch % 32)));
+                        break;
+
+                    default:
+                        break;
+                }
+            }
+
+            if (step)
+            {
+                memcpy(vm->scratch, slots, slot_count * sizeof(size_t));
+                add_thread(vm, next, vm->pcs[current][t] + 1, offset + 1);
+            }
+        }
+
+        current = next;
+
+        if (offset >= length)
+        {
+            /* threads surviving past the end can only be matches, which were
+             * handled above. */
+            break;
+        }
+    }
+
+    if (matched && NULL != captures)
+    {
+        memcpy(captures, vm->best, slot_count * sizeof(size_t));
+    }
+
+    return matched;
+}
+
+/**
+ * \brief Follow the empty transitions from the given pc, adding every
+ * consuming or matching instruction reached to the given thread list in
+ * priority order.
+ *
+ * The capture slots of the thread being added are taken from vm->scratch,
+ * which is restored to its original contents on return.
+ *
+ * \param vm            The VM.
+ * \param list          The thread list to add to.
+ * \param pc            The starting program counter.
+ * \param offset        The current offset in the text.
+ */
+static void add_thread(
+    eroc_regex_vm* vm, int list, uint32_t pc, size_t offset)
+{
+    const eroc_regex_program* program = vm->program;
+    size_t slot_count = vm->slot_count;
+    size_t* stack = vm->stack;
+    size_t top = 0;
+
+    stack[top++] = pc;
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        size_t value = stack[--top];
+        size_t frame = stack[--top];
+
+        /* undo a SAVE once every thread below it has been added. */
+        if (frame & RESTORE_FRAME)
+        {
+            vm->scratch[frame & ~RESTORE_FRAME] = value;
+            continue;
+        }
+
+        if (vm->marks[frame] == vm->generation)
+        {
+            continue;
+        }
+
+        vm->marks[frame] = vm->generation;
+
+        const eroc_regex_instruction* inst = program->instructions + frame;
+        switch (inst->opcode)
+        {
+            case EROC_REGEX_OP_JUMP:
+                stack[top++] = inst->x;
+                stack[top++] = 0;
+                break;
+
+            case EROC_REGEX_OP_SPLIT:
+                /* push the lower priority branch first. */
+                stack[top++] = inst->y;
+                stack[top++] = 0;
+                stack[top++] = inst->x;
+                stack[top++] = 0;
+                break;
+
+            case EROC_REGEX_OP_SAVE:
+                stack[top++] = inst->x | RESTORE_FRAME;
+                stack[top++] = vm->scratch[inst->x];
+                vm->scratch[inst->x] = offset;
+                stack[top++] = frame + 1;
+                stack[top++] = 0;
+                break;
+
+            default:
+            {
+                size_t t = vm->thread_count[list]++;
+                vm->pcs[list][t] = (uint32_t)frame;
+                memcpy(
+                    vm->slots[list] + t * slot_count, vm->scratch,
+                    slot_count * sizeof(size_t));
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * \brief Start a new generation of marks, so that every pc may be added to the
+ * next thread list once.
+ *
+ * \param vm            The VM.
+ */
+static void next_generation(eroc_regex_vm* vm)
+{
+    if (0 == ++vm->generation)
+    {
+        memset(vm->marks, 0, vm->program->count * sizeof(unsigned int));
+        vm->generation = 1;
+    }
+}
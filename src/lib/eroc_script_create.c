@@ -0,0 +1,157 @@
+/**
+ * \file lib/eroc_script_create.c
+ *
+ * \brief Parse a script.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/script.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static bool takes_text(eroc_command_fn command_fn);
+
+/**
+ * \brief Parse a script.
+ *
+ * Each line of the script is a command. The lines following an a, c or i
+ * command, through a line holding a single ., are the text for that command
+ * rather than commands.
+ *
+ * \param script            Pointer to the script pointer to be set to the
+ *                          parsed script on success.
+ * \param text              The script text, which is copied.
+ * \param length            The length of the script text.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that fails to parse, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_create(
+    eroc_script** script, const char* text, size_t length,
+    size_t* error_line)
+{
+    int retval;
+    eroc_script* tmp;
+    char* pos;
+    char* end;
+    char* eol;
+    size_t lines = 0;
+    size_t lineno = 0;
+
+    *error_line = 0;
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_script*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* keep a NUL terminated copy of the text for the commands to point into. */
+    tmp->text = (char*)malloc(length + 1);
+    if (NULL == tmp->text)
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    memcpy(tmp->text, text, length);
+    tmp->text[length] = 0;
+    end = tmp->text + length;
+
+    /* there is at most one command per line. */
+    for (pos = tmp->text; pos < end; ++pos)
+    {
+        lines += ('\n' == *pos);
+    }
+
+    tmp->commands =
+        (eroc_script_command*)calloc(lines + 1, sizeof(eroc_script_command));
+    if (NULL == tmp->commands)
+    {
+        retval = 3;
+        goto cleanup_tmp;
+    }
+
+    for (pos = tmp->text; pos < end; pos = eol + 1)
+    {
+        eroc_script_command* command = &tmp->commands[tmp->count];
+
+        eol = (char*)memchr(pos, '\n', end - pos);
+        if (NULL == eol)
+        {
+            eol = end;
+        }
+
+        *eol = 0;
+        ++lineno;
+
+        retval = eroc_command_template_parse(&command->tmpl, pos);
+        if (0 != retval)
+        {
+            *error_line = lineno;
+            goto cleanup_tmp;
+        }
+
+        command->line = lineno;
+        ++tmp->count;
+
+        if (!takes_text(command->tmpl.command_fn))
+        {
+            continue;
+        }
+
+        /* the text runs through the terminating . line, newlines intact. */
+        command->text = (eol < end) ? eol + 1 : end;
+        while (eol < end)
+        {
+            pos = eol + 1;
+            eol = (char*)memchr(pos, '\n', end - pos);
+            if (NULL == eol)
+            {
+                eol = end;
+            }
+
+            ++lineno;
+            if (1 == eol - pos && '.' == *pos)
+            {
+                break;
+            }
+        }
+
+        command->text_length = ((eol < end) ? eol + 1 : end) - command->text;
+    }
+
+    /* success. */
+    *script = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_script_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Check whether a command reads text following it.
+ *
+ * \param command_fn        The command function.
+ *
+ * \returns true if the command reads text and false otherwise.
+ */
+static bool takes_text(eroc_command_fn command_fn)
+{
+    return
+        &eroc_command_function_append == command_fn
+     || &eroc_command_function_change == command_fn
+     || &eroc_command_function_insert == command_fn;
+}
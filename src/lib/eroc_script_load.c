@@ -0,0 +1,84 @@
+/**
+ * \file lib/eroc_script_load.c
+ *
+ * \brief Read and parse a script.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/script.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+/* the script is read in blocks of this size. */
+#define READ_BLOCK_SIZE 4096
+
+/**
+ * \brief Read and parse the script at the given path.
+ *
+ * \param script            Pointer to the script pointer to be set to the
+ *                          parsed script on success.
+ * \param path              The path of the script.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that fails to parse, or 0 if the script could not be
+ *                          read, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_load(
+    eroc_script** script, const char* path, size_t* error_line)
+{
+    int retval;
+    FILE* fp;
+    char* text = NULL;
+    char* tmp;
+    size_t length = 0;
+    size_t capacity = 0;
+    size_t read_size;
+
+    *error_line = 0;
+
+    fp = fopen(path, "r");
+    if (NULL == fp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    /* read the whole script; it may be a pipe, so its size isn't known. */
+    do
+    {
+        if (capacity - length < READ_BLOCK_SIZE)
+        {
+            capacity = 2 * capacity + READ_BLOCK_SIZE;
+            tmp = (char*)realloc(text, capacity);
+            if (NULL == tmp)
+            {
+                retval = 2;
+                goto cleanup_text;
+            }
+
+            text = tmp;
+        }
+
+        read_size = fread(text + length, 1, capacity - length, fp);
+        length += read_size;
+    } while (read_size > 0);
+
+    if (ferror(fp))
+    {
+        retval = 3;
+        goto cleanup_text;
+    }
+
+    retval = eroc_script_create(script, text, length, error_line);
+    goto cleanup_text;
+
+cleanup_text:
+    free(text);
+    fclose(fp);
+
+done:
+    return retval;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file lib/eroc_script_release.c
+ *
+ * \brief Release a script.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/script.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a script.
+ *
+ * \param script            The script to release.
+ */
+void eroc_script_release(eroc_script* script)
+{
+    free(script->commands);
+    free(script->text);
+    free(script);
+}
@@ -0,0 +1,81 @@
+/**
+ * \file lib/eroc_script_run.c
+ *
+ * \brief Run a script against a buffer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/script.h>
+#include <stdio.h>
+
+/**
+ * \brief Run a script against a buffer.
+ *
+ * Commands run in order until one fails, or until one requests a quit. No
+ * commands are allocated or parsed while the script runs.
+ *
+ * \param script            The script to run.
+ * \param buffer            The buffer to run it against.
+ * \param error_line        Set to the one-indexed line of the command that
+ *                          failed, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_script_run(
+    const eroc_script* script, eroc_buffer* buffer, size_t* error_line)
+{
+    int retval;
+    eroc_command command;
+
+    for (size_t i = 0; i < script->count; ++i)
+    {
+        const eroc_script_command* step = &script->commands[i];
+
+        *error_line = step->line;
+
+        retval = eroc_command_template_resolve(&command, &step->tmpl, buffer);
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        /* text commands read the lines that follow them in the script. */
+        if (NULL != step->text)
+        {
+            if (0 == step->text_length)
+            {
+                return 1;
+            }
+
+            command.input =
+                fmemopen((void*)step->text, step->text_length, "r");
+            if (NULL == command.input)
+            {
+                return 2;
+            }
+        }
+
+        retval = eroc_command_run(&command);
+
+        if (NULL != step->text)
+        {
+            fclose(command.input);
+        }
+
+        if (0 != retval)
+        {
+            return retval;
+        }
+
+        if (buffer->flags & EROC_BUFFER_FLAG_QUIT_REQUESTED)
+        {
+            break;
+        }
+    }
+
+    *error_line = 0;
+
+    return 0;
+}
@@ -0,0 +1,357 @@
+/**
+ * \file lib/eroc_stream_create.c
+ *
+ * \brief Build a stream from a script.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <ctype.h>
+#include <eroc/stream.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static int stage_build(
+    eroc_stream_stage* stage, const eroc_script_command* step);
+static int global_build(
+    eroc_stream_stage* stage, const char* parameters, bool invert);
+static int substitution_build(
+    eroc_stream_stage* stage, const char* parameters);
+static bool whole_file(const eroc_command_template* tmpl);
+static bool no_address(const eroc_command_template* tmpl);
+
+/**
+ * \brief Build a stream from a script.
+ *
+ * Only scripts that can run forward-only are accepted. A command may be
+ * s/re/repl/, p, or d over the whole file; g/re/cmd or v/re/cmd, where cmd is
+ * one of s, p, or d without an address; w; or a final q. At most one command
+ * may print, and at most one may write, since their output would otherwise be
+ * interleaved differently than when the script runs over a buffer. Anything
+ * else, such as a command on a particular line, or one that adds lines, needs
+ * random access.
+ *
+ * \param stream            Pointer to the stream pointer to be set to the
+ *                          created stream on success.
+ * \param script            The script, which must outlive the stream.
+ * \param error_line        Set to the one-indexed line of the first command
+ *                          that can't be streamed, or to 0 if the stream could
+ *                          not be created, on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_stream_create(
+    eroc_stream** stream, const eroc_script* script, size_t* error_line)
+{
+    int retval;
+    eroc_stream* tmp;
+    size_t prints = 0, writes = 0, substitutions = 0;
+
+    *error_line = 0;
+
+    tmp = (eroc_stream*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    /* a q command makes no stage, so there is at most one stage per command.
+     */
+    tmp->stages =
+        (eroc_stream_stage*)calloc(script->count + 1, sizeof(*tmp->stages));
+    if (NULL == tmp->stages)
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    tmp->chunk = (char*)malloc(EROC_STREAM_CHUNK_SIZE);
+    if (NULL == tmp->chunk)
+    {
+        retval = 3;
+        goto cleanup_tmp;
+    }
+
+    tmp->chunk_size = EROC_STREAM_CHUNK_SIZE;
+
+    for (size_t i = 0; i < script->count; ++i)
+    {
+        const eroc_script_command* step = &script->commands[i];
+        eroc_stream_stage* stage = &tmp->stages[tmp->count];
+
+        /* the end of the input is the only place to quit. */
+        if (&eroc_command_function_quit == step->tmpl.command_fn
+         && NULL == step->text)
+        {
+            if (i + 1 != script->count)
+            {
+                *error_line = step->line;
+                retval = 4;
+                goto cleanup_tmp;
+            }
+
+            continue;
+        }
+
+        retval = stage_build(stage, step);
+        if (0 != retval)
+        {
+            *error_line = step->line;
+            goto cleanup_tmp;
+        }
+
+        stage->line = step->line;
+        ++tmp->count;
+
+        /* output from two stages would be interleaved line by line. */
+        if ((EROC_STREAM_STAGE_PRINT == stage->kind && ++prints > 1)
+         || (EROC_STREAM_STAGE_WRITE == stage->kind && ++writes > 1))
+        {
+            *error_line = step->line;
+            retval = 5;
+            goto cleanup_tmp;
+        }
+
+        /* a substitution only fails at the end, so later prints must wait. */
+        if (EROC_STREAM_STAGE_SUBSTITUTE == stage->kind)
+        {
+            ++substitutions;
+        }
+        else if (EROC_STREAM_STAGE_PRINT == stage->kind && substitutions > 0)
+        {
+            tmp->spool = true;
+        }
+    }
+
+    /* success. */
+    *stream = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_tmp:
+    eroc_stream_release(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Build the stage for a script command.
+ *
+ * \param stage             The stage to populate on success.
+ * \param step              The script command.
+ *
+ * \returns 0 on success and non-zero if the command can't be streamed.
+ */
+static int stage_build(
+    eroc_stream_stage* stage, const eroc_script_command* step)
+{
+    const eroc_command_template* tmpl = &step->tmpl;
+    eroc_command_fn fn = tmpl->command_fn;
+    const char* path;
+
+    /* commands that add lines have to find where to put them. */
+    if (NULL != step->text)
+    {
+        return 1;
+    }
+
+    if (&eroc_command_function_substitute == fn && whole_file(tmpl))
+    {
+        return substitution_build(stage, tmpl->parameters);
+    }
+    else if (&eroc_command_function_print == fn && whole_file(tmpl))
+    {
+        stage->kind = EROC_STREAM_STAGE_PRINT;
+        return 0;
+    }
+    else if (&eroc_command_function_delete == fn && whole_file(tmpl))
+    {
+        stage->kind = EROC_STREAM_STAGE_DELETE;
+        return 0;
+    }
+    else if (
+        (&eroc_command_function_global == fn
+      || &eroc_command_function_global_invert == fn)
+     && (no_address(tmpl) || whole_file(tmpl)))
+    {
+        return
+            global_build(
+                stage, tmpl->parameters,
+                &eroc_command_function_global_invert == fn);
+    }
+    else if (
+        &eroc_command_function_write == fn
+     && (no_address(tmpl) || whole_file(tmpl)))
+    {
+        path = tmpl->parameters;
+        while (*path && isspace(*path))
+            ++path;
+
+        stage->kind = EROC_STREAM_STAGE_WRITE;
+        stage->path = (0 != *path) ? path : NULL;
+        return 0;
+    }
+
+    return 2;
+}
+
+/**
+ * \brief Build the stage for a g/re/cmd or v/re/cmd command.
+ *
+ * \param stage             The stage to populate on success.
+ * \param parameters        The parameters of the command, /re/cmd.
+ * \param invert            True for v, which runs cmd on the lines that don't
+ *                          match.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int global_build(
+    eroc_stream_stage* stage, const char* parameters, bool invert)
+{
+    int retval;
+    char* pattern;
+    const char* command_list;
+    eroc_command_template inner;
+
+    retval = eroc_command_global_parse(&pattern, &command_list, parameters);
+    if (0 != retval)
+    {
+        return 1;
+    }
+
+    retval = eroc_command_template_parse(&inner, command_list);
+    if (0 != retval || !no_address(&inner))
+    {
+        retval = 2;
+        goto cleanup_pattern;
+    }
+
+    if (&eroc_command_function_substitute == inner.command_fn)
+    {
+        retval = substitution_build(stage, inner.parameters);
+        if (0 != retval)
+        {
+            goto cleanup_pattern;
+        }
+    }
+    else if (&eroc_command_function_print == inner.command_fn)
+    {
+        stage->kind = EROC_STREAM_STAGE_PRINT;
+    }
+    else if (&eroc_command_function_delete == inner.command_fn)
+    {
+        stage->kind = EROC_STREAM_STAGE_DELETE;
+    }
+    else
+    {
+        retval = 3;
+        goto cleanup_pattern;
+    }
+
+    retval = eroc_regex_create(&stage->pattern, pattern);
+    if (0 != retval)
+    {
+        retval = 4;
+        goto cleanup_substitution;
+    }
+
+    stage->invert = invert;
+
+    /* success. */
+    retval = 0;
+    goto cleanup_pattern;
+
+cleanup_substitution:
+    if (NULL != stage->substitution)
+    {
+        eroc_regex_substitution_release(stage->substitution);
+        stage->substitution = NULL;
+    }
+
+cleanup_pattern:
+    free(pattern);
+
+    return retval;
+}
+
+/**
+ * \brief Build a substitution stage.
+ *
+ * \param stage             The stage to populate on success.
+ * \param parameters        The parameters of the command, /re/repl/flags.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int substitution_build(
+    eroc_stream_stage* stage, const char* parameters)
+{
+    int retval;
+    bool print;
+
+    retval =
+        eroc_command_substitution_parse(
+            &stage->substitution, &print, parameters);
+    if (0 != retval)
+    {
+        return 1;
+    }
+
+    /* printing the last line changed would mean waiting for the end. */
+    if (print)
+    {
+        eroc_regex_substitution_release(stage->substitution);
+        stage->substitution = NULL;
+        return 2;
+    }
+
+    stage->kind = EROC_STREAM_STAGE_SUBSTITUTE;
+    return 0;
+}
+
+/**
+ * \brief Check whether a command's range is the whole file: , or % or 1,$.
+ *
+ * \param tmpl              The command template.
+ *
+ * \returns true if the range is the whole file.
+ */
+static bool whole_file(const eroc_command_template* tmpl)
+{
+    if (',' != tmpl->separator)
+    {
+        return false;
+    }
+
+    if (EROC_COMMAND_ADDRESS_NONE == tmpl->first.base
+     && EROC_COMMAND_ADDRESS_NONE == tmpl->second.base)
+    {
+        return true;
+    }
+
+    return
+        EROC_COMMAND_ADDRESS_LINE == tmpl->first.base
+     && 1 == tmpl->first.line
+     && 0 == tmpl->first.offset
+     && EROC_COMMAND_ADDRESS_LAST == tmpl->second.base
+     && 0 == tmpl->second.offset;
+}
+
+/**
+ * \brief Check whether a command has no address at all.
+ *
+ * \param tmpl              The command template.
+ *
+ * \returns true if the command has no address.
+ */
+static bool no_address(const eroc_command_template* tmpl)
+{
+    return
+        EROC_COMMAND_ADDRESS_NONE == tmpl->first.base
+     && 0 == tmpl->separator;
+}
@@ -0,0 +1,36 @@
+/**
+ * \file lib/eroc_stream_release.c
+ *
+ * \brief Release a stream.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/stream.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a stream.
+ *
+ * \param stream            The stream to release.
+ */
+void eroc_stream_release(eroc_stream* stream)
+{
+    for (size_t i = 0; NULL != stream->stages && i < stream->count; ++i)
+    {
+        if (NULL != stream->stages[i].pattern)
+        {
+            eroc_regex_release(stream->stages[i].pattern);
+        }
+
+        if (NULL != stream->stages[i].substitution)
+        {
+            eroc_regex_substitution_release(stream->stages[i].substitution);
+        }
+    }
+
+    free(stream->stages);
+    free(stream->chunk);
+    free(stream);
+}
@@ -0,0 +1,499 @@
+/**
+ * \file lib/eroc_stream_run.c
+ *
+ * \brief Run a stream over an input.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <errno.h>
+#include <eroc/stream.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* forward decls. */
+static int line_process(
+    eroc_stream* stream, eroc_writer* writer, FILE* out, const char* text,
+    size_t length, size_t* error_line);
+static int chunk_grow(eroc_stream* stream);
+static int spool_copy(eroc_stream* stream, FILE* spool);
+static bool same_file(int fd1, int fd2);
+static size_t first_failure(const eroc_stream* stream);
+static size_t stage_find(const eroc_stream* stream, int kind);
+
+/**
+ * \brief Run a stream over the input read from a file descriptor.
+ *
+ * Printed lines go to standard output as they are produced, unless a
+ * substitution comes before the print, in which case they are held back until
+ * the whole input has been processed. Lines written by w go to a temporary
+ * file, which replaces the target once the whole input has been processed. As
+ * when the script runs over a buffer, a command that fails stops the script
+ * there, so held back lines are printed, and the target is replaced, only if
+ * the print, or the w, comes before the first command that failed. A target
+ * that would have to be written in place, such as one with other hard links,
+ * can't be the input.
+ *
+ * \param stream            The stream to run.
+ * \param fd                The file descriptor to read from.
+ * \param name              The name of the input, which is the file that w
+ *                          writes to by default, or NULL.
+ * \param error_line        Set to the one-indexed line of the command that
+ *                          failed, or to 0 if reading or writing failed, on
+ *                          failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_stream_run(
+    eroc_stream* stream, int fd, const char* name, size_t* error_line)
+{
+    int retval;
+    eroc_writer_file* file = NULL;
+    eroc_writer* writer = NULL;
+    FILE* spool = NULL;
+    FILE* out = stdout;
+    const char* path = NULL;
+    size_t used = 0U, start, scan, failed;
+    ssize_t size;
+    char* newline;
+
+    *error_line = 0;
+
+    for (size_t i = 0; i < stream->count; ++i)
+    {
+        stream->stages[i].reached = 0;
+        stream->stages[i].matched = 0;
+        stream->stages[i].changed = 0;
+
+        if (EROC_STREAM_STAGE_WRITE == stream->stages[i].kind)
+        {
+            path =
+                (NULL != stream->stages[i].path)
+                    ? stream->stages[i].path : name;
+            if (NULL == path)
+            {
+                *error_line = stream->stages[i].line;
+                retval = 1;
+                goto done;
+            }
+        }
+    }
+
+    if (NULL != path)
+    {
+        retval = eroc_writer_file_open(&file, path);
+        if (0 != retval)
+        {
+            retval = 2;
+            goto done;
+        }
+
+        /* writing the input in place would overwrite lines not yet read. */
+        if (NULL == file->temp && same_file(file->fd, fd))
+        {
+            retval = 11;
+            goto cleanup_file;
+        }
+
+        retval = eroc_writer_create(&writer, file->fd);
+        if (0 != retval)
+        {
+            retval = 3;
+            goto cleanup_file;
+        }
+    }
+
+    if (stream->spool)
+    {
+        spool = tmpfile();
+        if (NULL == spool)
+        {
+            retval = 9;
+            goto cleanup_writer;
+        }
+
+        out = spool;
+    }
+
+    for (;;)
+    {
+        /* a line longer than the chunk grows the chunk. */
+        if (used == stream->chunk_size)
+        {
+            retval = chunk_grow(stream);
+            if (0 != retval)
+            {
+                goto cleanup_spool;
+            }
+        }
+
+        size = read(fd, stream->chunk + used, stream->chunk_size - used);
+        if (size < 0 && EINTR == errno)
+        {
+            continue;
+        }
+        else if (size < 0)
+        {
+            retval = 4;
+            goto cleanup_spool;
+        }
+        else if (0 == size)
+        {
+            break;
+        }
+
+        /* the carried over part of a line holds no newline. */
+        start = 0U;
+        scan = used;
+        used += size;
+
+        while (
+            NULL
+         != (newline = (char*)memchr(stream->chunk + scan, '\n', used - scan)))
+        {
+            scan = newline - stream->chunk;
+
+            retval =
+                line_process(
+                    stream, writer, out, stream->chunk + start, scan - start,
+                    error_line);
+            if (0 != retval)
+            {
+                goto cleanup_spool;
+            }
+
+            start = ++scan;
+        }
+
+        /* carry the start of the next line over to the next read. */
+        memmove(stream->chunk, stream->chunk + start, used - start);
+        used -= start;
+    }
+
+    /* the last line may lack a newline. */
+    if (used > 0)
+    {
+        retval =
+            line_process(
+                stream, writer, out, stream->chunk, used, error_line);
+        if (0 != retval)
+        {
+            goto cleanup_spool;
+        }
+    }
+
+    /* as over a buffer, the script stops at the first command that fails, so
+     * output from the commands before it stands. */
+    failed = first_failure(stream);
+    if (failed < stream->count)
+    {
+        *error_line = stream->stages[failed].line;
+    }
+
+    /* the held back lines were printed if the print came first. */
+    if (NULL != spool)
+    {
+        if (stage_find(stream, EROC_STREAM_STAGE_PRINT) < failed)
+        {
+            retval = spool_copy(stream, spool);
+            if (0 != retval)
+            {
+                retval = 10;
+                goto cleanup_spool;
+            }
+        }
+
+        fclose(spool);
+        spool = NULL;
+    }
+
+    /* a failed write to standard output may have happened before this flush.
+     */
+    if (0 != fflush(stdout) || ferror(stdout))
+    {
+        retval = 6;
+        goto cleanup_writer;
+    }
+
+    /* likewise, the file was written if the w came first. */
+    if (NULL != writer)
+    {
+        if (stage_find(stream, EROC_STREAM_STAGE_WRITE) > failed)
+        {
+            retval = 5;
+            goto cleanup_writer;
+        }
+
+        retval = eroc_writer_flush(writer);
+        if (0 != retval)
+        {
+            retval = 7;
+            goto cleanup_writer;
+        }
+
+        eroc_writer_release(writer);
+
+        retval = eroc_writer_file_commit(file);
+        if (0 != retval)
+        {
+            retval = 8;
+            goto done;
+        }
+    }
+
+    if (failed < stream->count)
+    {
+        retval = 5;
+        goto done;
+    }
+
+    /* success. */
+    retval = 0;
+    goto done;
+
+cleanup_spool:
+    if (NULL != spool)
+    {
+        fclose(spool);
+    }
+
+cleanup_writer:
+    if (NULL != writer)
+    {
+        eroc_writer_release(writer);
+    }
+
+cleanup_file:
+    if (NULL != file)
+    {
+        eroc_writer_file_abort(file);
+    }
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Pass a line through every stage of the stream.
+ *
+ * \param stream            The stream.
+ * \param writer            The writer for w, or NULL if there is no w.
+ * \param out               The file to which p prints.
+ * \param text              The line, without its newline.
+ * \param length            The length of the line.
+ * \param error_line        Set to the line of the failing command on failure.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int line_process(
+    eroc_stream* stream, eroc_writer* writer, FILE* out, const char* text,
+    size_t length, size_t* error_line)
+{
+    int retval;
+    size_t count;
+
+    for (size_t i = 0; i < stream->count; ++i)
+    {
+        eroc_stream_stage* stage = &stream->stages[i];
+
+        ++stage->reached;
+
+        if (NULL != stage->pattern
+         && stage->invert
+                == eroc_regex_search(stage->pattern, NULL, text, length))
+        {
+            continue;
+        }
+
+        switch (stage->kind)
+        {
+            case EROC_STREAM_STAGE_DELETE:
+                return 0;
+
+            case EROC_STREAM_STAGE_SUBSTITUTE:
+                retval =
+                    eroc_regex_substitution_apply(
+                        stage->substitution, &count, text, length);
+                if (0 != retval)
+                {
+                    *error_line = stage->line;
+                    return 1;
+                }
+
+                ++stage->matched;
+                if (count > 0)
+                {
+                    text = stage->substitution->result;
+                    length = stage->substitution->result_length;
+                    ++stage->changed;
+                }
+                break;
+
+            case EROC_STREAM_STAGE_PRINT:
+                fwrite(text, 1, length, out);
+                fputc('\n', out);
+                break;
+
+            case EROC_STREAM_STAGE_WRITE:
+                retval = eroc_writer_add(writer, text, length);
+                if (0 == retval)
+                {
+                    retval = eroc_writer_add(writer, "\n", 1);
+                }
+
+                /* a long line is borrowed, and its text won't last until the
+                 * next flush. */
+                if (0 == retval && length >= EROC_WRITER_COPY_LIMIT)
+                {
+                    retval = eroc_writer_flush(writer);
+                }
+
+                if (0 != retval)
+                {
+                    return 2;
+                }
+                break;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Double the size of the stream's chunk.
+ *
+ * \param stream            The stream.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int chunk_grow(eroc_stream* stream)
+{
+    char* chunk = (char*)realloc(stream->chunk, 2 * stream->chunk_size);
+
+    if (NULL == chunk)
+    {
+        return 1;
+    }
+
+    stream->chunk = chunk;
+    stream->chunk_size *= 2;
+
+    return 0;
+}
+
+/**
+ * \brief Copy the lines held back in a spool file to standard output.
+ *
+ * \param stream            The stream, whose chunk is free to use as a buffer.
+ * \param spool             The spool file.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+static int spool_copy(eroc_stream* stream, FILE* spool)
+{
+    size_t size;
+
+    if (0 != fflush(spool) || ferror(spool))
+    {
+        return 1;
+    }
+
+    rewind(spool);
+
+    while (0 < (size = fread(stream->chunk, 1, stream->chunk_size, spool)))
+    {
+        if (size != fwrite(stream->chunk, 1, size, stdout))
+        {
+            return 2;
+        }
+    }
+
+    if (ferror(spool))
+    {
+        return 3;
+    }
+
+    return 0;
+}
+
+/**
+ * \brief Check whether two file descriptors refer to the same file.
+ *
+ * \param fd1               The first file descriptor.
+ * \param fd2               The second file descriptor.
+ *
+ * \returns true if both are the same file, and false if they differ or either
+ * can't be checked.
+ */
+static bool same_file(int fd1, int fd2)
+{
+    struct stat st1, st2;
+
+    return
+        0 == fstat(fd1, &st1) && 0 == fstat(fd2, &st2)
+     && st1.st_dev == st2.st_dev && st1.st_ino == st2.st_ino;
+}
+
+/**
+ * \brief Find the first stage whose command would have failed over a buffer,
+ * once the whole input has been seen.
+ *
+ * A command fails if it runs on an empty buffer, which is when no line reaches
+ * its stage, except for w, which writes an empty file. A substitution also
+ * fails if it changes nothing, though under g only if it ran on a line.
+ *
+ * \param stream            The stream.
+ *
+ * \returns the index of the failing stage, or the stage count if none fails.
+ */
+static size_t first_failure(const eroc_stream* stream)
+{
+    size_t i;
+
+    for (i = 0; i < stream->count; ++i)
+    {
+        const eroc_stream_stage* stage = &stream->stages[i];
+
+        if (0 == stage->reached && EROC_STREAM_STAGE_WRITE != stage->kind)
+        {
+            break;
+        }
+
+        if (EROC_STREAM_STAGE_SUBSTITUTE == stage->kind
+         && 0 == stage->changed
+         && (NULL == stage->pattern || stage->matched > 0))
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/**
+ * \brief Find the stage of the given kind.
+ *
+ * \param stream            The stream.
+ * \param kind              The kind of stage to find.
+ *
+ * \returns the index of the first such stage, or the stage count if there is
+ * none.
+ */
+static size_t stage_find(const eroc_stream* stream, int kind)
+{
+    size_t i;
+
+    for (i = 0; i < stream->count; ++i)
+    {
+        if (kind == stream->stages[i].kind)
+        {
+            break;
+        }
+    }
+
+    return i;
+}
@@ -0,0 +1,23 @@
+/**
+ * \file lib/eroc_thread_pool_cpu_count.c
+ *
+ * \brief Get the number of online CPUs.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/threadpool.h>
+#include <unistd.h>
+
+/**
+ * \brief Get the number of online CPUs.
+ *
+ * \returns the number of online CPUs, which is at least one.
+ */
+size_t eroc_thread_pool_cpu_count(void)
+{
+    long count = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return count > 0 ? (size_t)count : 1;
+}
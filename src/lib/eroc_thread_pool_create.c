@@ -0,0 +1,178 @@
+/**
+ * \file lib/eroc_thread_pool_create.c
+ *
+ * \brief Create a thread pool.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/threadpool.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* forward decls. */
+static void* worker_main(void* arg);
+
+/**
+ * \brief Each worker learns its index from one of these.
+ */
+typedef struct worker_start worker_start;
+
+struct worker_start
+{
+    eroc_thread_pool* pool;
+    size_t worker;
+};
+
+/**
+ * \brief Create a thread pool.
+ *
+ * \param pool          Pointer to the pool pointer to be set to the created
+ *                      pool on success.
+ * \param workers       The number of worker threads, or 0 for one per online
+ *                      CPU.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_thread_pool_create(eroc_thread_pool** pool, size_t workers)
+{
+    int retval;
+    eroc_thread_pool* tmp;
+
+    if (0 == workers)
+    {
+        workers = eroc_thread_pool_cpu_count();
+    }
+
+    /* allocate memory for this instance. */
+    tmp = (eroc_thread_pool*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+
+    tmp->threads = (pthread_t*)malloc(workers * sizeof(pthread_t));
+    if (NULL == tmp->threads)
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    if (0 != pthread_mutex_init(&tmp->lock, NULL))
+    {
+        retval = 3;
+        goto cleanup_threads;
+    }
+
+    if (0 != pthread_cond_init(&tmp->work, NULL))
+    {
+        retval = 4;
+        goto cleanup_lock;
+    }
+
+    if (0 != pthread_cond_init(&tmp->done, NULL))
+    {
+        retval = 5;
+        goto cleanup_work;
+    }
+
+    /* start the workers; a pool with fewer than requested is still useful. */
+    for (size_t i = 0; i < workers; ++i)
+    {
+        worker_start* start = (worker_start*)malloc(sizeof(*start));
+        if (NULL == start)
+        {
+            break;
+        }
+
+        start->pool = tmp;
+        start->worker = i;
+        if (0 != pthread_create(
+                    tmp->threads + tmp->thread_count, NULL, &worker_main,
+                    start))
+        {
+            free(start);
+            break;
+        }
+
+        ++tmp->thread_count;
+    }
+
+    if (0 == tmp->thread_count)
+    {
+        retval = 6;
+        goto cleanup_done;
+    }
+
+    /* success. */
+    *pool = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_done:
+    pthread_cond_destroy(&tmp->done);
+
+cleanup_work:
+    pthread_cond_destroy(&tmp->work);
+
+cleanup_lock:
+    pthread_mutex_destroy(&tmp->lock);
+
+cleanup_threads:
+    free(tmp->threads);
+
+cleanup_tmp:
+    free(tmp);
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Worker loop: wait for a batch, then run tasks from it until there are
+ * none left.
+ *
+ * \param arg           The worker_start for this worker, which it frees.
+ *
+ * \returns NULL.
+ */
+static void* worker_main(void* arg)
+{
+    worker_start* start = (worker_start*)arg;
+    eroc_thread_pool* pool = start->pool;
+    size_t worker = start->worker;
+
+    free(start);
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;)
+    {
+        while (!pool->shutdown && pool->next_task >= pool->task_count)
+        {
+            pthread_cond_wait(&pool->work, &pool->lock);
+        }
+
+        if (pool->shutdown)
+        {
+            break;
+        }
+
+        size_t task = pool->next_task++;
+        pthread_mutex_unlock(&pool->lock);
+
+        pool->fn(pool->context, worker, task);
+
+        pthread_mutex_lock(&pool->lock);
+        if (++pool->finished == pool->task_count)
+        {
+            pthread_cond_signal(&pool->done);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+
+    return NULL;
+}
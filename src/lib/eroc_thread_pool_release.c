@@ -0,0 +1,35 @@
+/**
+ * \file lib/eroc_thread_pool_release.c
+ *
+ * \brief Stop the workers and release a thread pool.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/threadpool.h>
+#include <stdlib.h>
+
+/**
+ * \brief Stop the workers and release a thread pool.
+ *
+ * \param pool          The pool to release.
+ */
+void eroc_thread_pool_release(eroc_thread_pool* pool)
+{
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (size_t i = 0; i < pool->thread_count; ++i)
+    {
+        pthread_join(pool->threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
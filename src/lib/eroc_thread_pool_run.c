@@ -0,0 +1,50 @@
+/**
+ * \file lib/eroc_thread_pool_run.c
+ *
+ * \brief Run a batch of tasks on a thread pool.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/threadpool.h>
+
+/**
+ * \brief Run a batch of tasks on the pool, returning once all have finished.
+ *
+ * \param pool          The pool.
+ * \param fn            The task function, which is called once for each task
+ *                      index in [0, task_count) along with the index of the
+ *                      worker running it.
+ * \param context       The context passed to each call.
+ * \param task_count    The number of tasks.
+ */
+void eroc_thread_pool_run(
+    eroc_thread_pool* pool, eroc_thread_pool_task_fn fn, void* context,
+    size_t task_count)
+{
+    if (0 == task_count)
+    {
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+
+    pool->fn = fn;
+    pool->context = context;
+    pool->finished = 0;
+    pool->next_task = 0;
+    pool->task_count = task_count;
+    pthread_cond_broadcast(&pool->work);
+
+    while (pool->finished < pool->task_count)
+    {
+        pthread_cond_wait(&pool->done, &pool->lock);
+    }
+
+    /* leave the workers idle until the next batch. */
+    pool->task_count = 0;
+    pool->next_task = 0;
+
+    pthread_mutex_unlock(&pool->lock);
+}
@@ -0,0 +1,78 @@
+/**
+ * \file lib/eroc_writer_add.c
+ *
+ * \brief Add a span to a writer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <string.h>
+
+/**
+ * \brief Add a span to a writer.
+ *
+ * A short span is copied to the end of the staging buffer, extending the last
+ * gathered span when that span already ends there.
+ *
+ * \param writer            The writer for this operation.
+ * \param data              The span to write.
+ * \param length            The length of the span.
+ *
+ * \returns 0 on success and non-zero if a write failed, in which case errno
+ * describes the failure.
+ */
+int eroc_writer_add(eroc_writer* writer, const void* data, size_t length)
+{
+    int retval;
+    struct iovec* last;
+
+    if (0 == length)
+    {
+        return 0;
+    }
+
+    /* make room for the span. */
+    if (EROC_WRITER_IOV_MAX == writer->iov_count
+     || (length < EROC_WRITER_COPY_LIMIT
+      && writer->staged + length > EROC_WRITER_STAGE_SIZE))
+    {
+        retval = eroc_writer_flush(writer);
+        if (0 != retval)
+        {
+            return retval;
+        }
+    }
+
+    last =
+        (writer->iov_count > 0) ? &writer->iov[writer->iov_count - 1] : NULL;
+
+    if (length >= EROC_WRITER_COPY_LIMIT)
+    {
+        writer->iov[writer->iov_count].iov_base = (void*)data;
+        writer->iov[writer->iov_count].iov_len = length;
+        ++writer->iov_count;
+    }
+    else
+    {
+        char* dest = writer->stage + writer->staged;
+
+        memcpy(dest, data, length);
+        writer->staged += length;
+
+        if (NULL != last && (char*)last->iov_base + last->iov_len == dest)
+        {
+            last->iov_len += length;
+        }
+        else
+        {
+            writer->iov[writer->iov_count].iov_base = dest;
+            writer->iov[writer->iov_count].iov_len = length;
+            ++writer->iov_count;
+        }
+    }
+
+    writer->pending += length;
+    return 0;
+}
@@ -0,0 +1,46 @@
+/**
+ * \file lib/eroc_writer_create.c
+ *
+ * \brief Create a writer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * \brief Create a writer for the given file descriptor.
+ *
+ * \param writer            Pointer to the writer pointer to be set to the
+ *                          created writer on success.
+ * \param fd                The file descriptor to write to, which the writer
+ *                          does not own.
+ *
+ * \returns 0 on success and non-zero on failure.
+ */
+int eroc_writer_create(eroc_writer** writer, int fd)
+{
+    eroc_writer* tmp;
+
+    tmp = (eroc_writer*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        return 1;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->fd = fd;
+
+    tmp->stage = (char*)malloc(EROC_WRITER_STAGE_SIZE);
+    if (NULL == tmp->stage)
+    {
+        free(tmp);
+        return 2;
+    }
+
+    *writer = tmp;
+    return 0;
+}
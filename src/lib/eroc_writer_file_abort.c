@@ -0,0 +1,39 @@
+/**
+ * \file lib/eroc_writer_file_abort.c
+ *
+ * \brief Discard a file written to replace a target.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/**
+ * \brief Discard a file, leaving its target unchanged, and release it.
+ *
+ * A target written in place has been changed by anything written to it, and
+ * is only closed.
+ *
+ * \param file              The file to discard.
+ */
+void eroc_writer_file_abort(eroc_writer_file* file)
+{
+    int saved_errno = errno;
+
+    (void)close(file->fd);
+
+    if (NULL != file->temp)
+    {
+        (void)unlink(file->temp);
+        free(file->temp);
+    }
+
+    free(file->path);
+    free(file);
+
+    errno = saved_errno;
+}
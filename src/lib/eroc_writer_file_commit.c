@@ -0,0 +1,127 @@
+/**
+ * \file lib/eroc_writer_file_commit.c
+ *
+ * \brief Move a file written to replace a target into place.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <libgen.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* forward decls. */
+static void directory_sync(const char* path);
+
+/**
+ * \brief Sync a file and move it into place, then release it.
+ *
+ * A regular file written in place is cut to the length written.
+ *
+ * \param file              The file to commit, which is released whether or
+ *                          not the commit succeeds.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure and the target is unchanged.
+ */
+int eroc_writer_file_commit(eroc_writer_file* file)
+{
+    int retval, saved_errno;
+    struct stat st;
+    off_t end;
+
+    /* a file written in place only needs to lose what is left of its old
+     * contents, then be closed. */
+    if (NULL == file->temp)
+    {
+        end = lseek(file->fd, 0, SEEK_CUR);
+        if (0 == fstat(file->fd, &st) && S_ISREG(st.st_mode)
+         && (end < 0 || 0 != ftruncate(file->fd, end)))
+        {
+            saved_errno = errno;
+            (void)close(file->fd);
+            errno = saved_errno;
+            retval = 4;
+            goto cleanup_file;
+        }
+
+        retval = (0 == close(file->fd)) ? 0 : 1;
+        goto cleanup_file;
+    }
+
+    /* the data must be on disk before the rename makes it the file. */
+    if (0 != fsync(file->fd))
+    {
+        saved_errno = errno;
+        (void)close(file->fd);
+        errno = saved_errno;
+        retval = 2;
+        goto cleanup_temp;
+    }
+
+    if (0 != close(file->fd))
+    {
+        retval = 1;
+        goto cleanup_temp;
+    }
+
+    if (0 != rename(file->temp, file->path))
+    {
+        retval = 3;
+        goto cleanup_temp;
+    }
+
+    directory_sync(file->path);
+
+    /* success. */
+    retval = 0;
+    goto cleanup_file;
+
+cleanup_temp:
+    saved_errno = errno;
+    (void)unlink(file->temp);
+    errno = saved_errno;
+
+cleanup_file:
+    saved_errno = errno;
+    free(file->temp);
+    free(file->path);
+    free(file);
+    errno = saved_errno;
+
+    return retval;
+}
+
+/**
+ * \brief Sync the directory holding a file, so that a rename survives a crash.
+ *
+ * The file is already in place, so this is best effort.
+ *
+ * \param path              The path of the file.
+ */
+static void directory_sync(const char* path)
+{
+    char* copy = strdup(path);
+    int fd;
+
+    if (NULL == copy)
+    {
+        return;
+    }
+
+    fd = open(dirname(copy), O_RDONLY | O_DIRECTORY);
+    if (fd >= 0)
+    {
+        (void)fsync(fd);
+        (void)close(fd);
+    }
+
+    free(copy);
+}
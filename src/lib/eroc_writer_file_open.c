@@ -0,0 +1,280 @@
+/**
+ * \file lib/eroc_writer_file_open.c
+ *
+ * \brief Open a file to replace a target atomically.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* the most symbolic links followed by hand before giving up. */
+#define LINK_HOPS_MAX 40
+
+/* forward decls. */
+static char* link_resolve(const char* path);
+static char* link_read(const char* path);
+
+/**
+ * \brief Open a file to replace the file at the given path.
+ *
+ * The new file keeps the permissions and the owner of the file that it
+ * replaces. A symbolic link is followed, even if the file it names doesn't
+ * exist yet. A file with other hard links, or whose owner can't be given to a
+ * new file, is written in place instead, so that the links and the owner
+ * survive, at the cost of the atomic replace. A file written in place is only
+ * cut to its new length when it is committed, so a caller whose data comes
+ * from the file can check \c fd against it before writing anything.
+ *
+ * \param file              Pointer to the file pointer to be set to the opened
+ *                          file on success.
+ * \param path              The path of the file to replace or create.
+ *
+ * \returns 0 on success and non-zero on failure, in which case errno describes
+ * the failure.
+ */
+int eroc_writer_file_open(eroc_writer_file** file, const char* path)
+{
+    int retval, saved_errno;
+    eroc_writer_file* tmp;
+    bool exists = false;
+    struct stat st;
+    mode_t mask;
+
+    tmp = (eroc_writer_file*)malloc(sizeof(*tmp));
+    if (NULL == tmp)
+    {
+        retval = 1;
+        goto done;
+    }
+
+    memset(tmp, 0, sizeof(*tmp));
+    tmp->fd = -1;
+
+    /* write through a symbolic link to the file that it names. */
+    if (0 == lstat(path, &st) && S_ISLNK(st.st_mode))
+    {
+        tmp->path = link_resolve(path);
+    }
+    else
+    {
+        tmp->path = strdup(path);
+    }
+
+    if (NULL == tmp->path)
+    {
+        retval = 2;
+        goto cleanup_tmp;
+    }
+
+    if (0 == stat(tmp->path, &st))
+    {
+        exists = true;
+    }
+    else if (ENOENT != errno)
+    {
+        retval = 3;
+        goto cleanup_path;
+    }
+
+    /* only a regular file can be replaced, and replacing one with other hard
+     * links would split it from them. */
+    if (exists && (!S_ISREG(st.st_mode) || st.st_nlink > 1))
+    {
+        goto in_place;
+    }
+
+    /* the temporary file lives in the same directory, so it can be renamed. */
+    tmp->temp = (char*)malloc(strlen(tmp->path) + sizeof(".XXXXXX"));
+    if (NULL == tmp->temp)
+    {
+        retval = 5;
+        goto cleanup_path;
+    }
+
+    strcpy(tmp->temp, tmp->path);
+    strcat(tmp->temp, ".XXXXXX");
+
+    tmp->fd = mkstemp(tmp->temp);
+    if (tmp->fd < 0)
+    {
+        retval = 4;
+        goto cleanup_temp;
+    }
+
+    /* mkstemp creates the file private; give it the target's permissions. */
+    if (exists)
+    {
+        /* a file that would lose its owner is kept and written in place. */
+        if (0 != fchown(tmp->fd, st.st_uid, st.st_gid))
+        {
+            (void)close(tmp->fd);
+            (void)unlink(tmp->temp);
+            free(tmp->temp);
+            tmp->temp = NULL;
+            goto in_place;
+        }
+
+        retval = fchmod(tmp->fd, st.st_mode & 07777);
+    }
+    else
+    {
+        mask = umask(0);
+        (void)umask(mask);
+        retval = fchmod(tmp->fd, 0666 & ~mask);
+    }
+
+    if (0 != retval)
+    {
+        saved_errno = errno;
+        (void)close(tmp->fd);
+        (void)unlink(tmp->temp);
+        errno = saved_errno;
+        retval = 6;
+        goto cleanup_temp;
+    }
+
+    goto success;
+
+in_place:
+    tmp->fd = open(tmp->path, O_WRONLY);
+    if (tmp->fd < 0)
+    {
+        retval = 4;
+        goto cleanup_path;
+    }
+
+success:
+    *file = tmp;
+    retval = 0;
+    goto done;
+
+cleanup_temp:
+    free(tmp->temp);
+
+cleanup_path:
+    free(tmp->path);
+
+cleanup_tmp:
+    saved_errno = errno;
+    free(tmp);
+    errno = saved_errno;
+
+done:
+    return retval;
+}
+
+/**
+ * \brief Resolve a symbolic link to the file that it names.
+ *
+ * A link whose target doesn't exist names the file that writing through it
+ * creates, so it is followed by hand where realpath gives up.
+ *
+ * \param path              The path of the link.
+ *
+ * \returns the resolved path, which the caller must free, or NULL on failure,
+ * in which case errno describes the failure.
+ */
+static char* link_resolve(const char* path)
+{
+    struct stat st;
+    char* current;
+    char* next;
+
+    current = realpath(path, NULL);
+    if (NULL != current || ENOENT != errno)
+    {
+        return current;
+    }
+
+    current = strdup(path);
+    for (int hops = 0; NULL != current && hops < LINK_HOPS_MAX; ++hops)
+    {
+        /* stop at the first path that isn't a link. */
+        if (0 != lstat(current, &st) || !S_ISLNK(st.st_mode))
+        {
+            return current;
+        }
+
+        next = link_read(current);
+        free(current);
+        current = next;
+    }
+
+    if (NULL != current)
+    {
+        free(current);
+        errno = ELOOP;
+    }
+
+    return NULL;
+}
+
+/**
+ * \brief Read the target of a symbolic link, relative to the link's directory.
+ *
+ * \param path              The path of the link.
+ *
+ * \returns the path of the target, which the caller must free, or NULL on
+ * failure, in which case errno describes the failure.
+ */
+static char* link_read(const char* path)
+{
+    const char* slash = strrchr(path, '/');
+    size_t dir_length = (NULL != slash) ? (size_t)(slash - path) + 1 : 0;
+    size_t size = 64;
+    ssize_t length;
+    char* target;
+    char* result;
+
+    /* grow the buffer until the whole target fits. */
+    for (;;)
+    {
+        target = (char*)malloc(size);
+        if (NULL == target)
+        {
+            return NULL;
+        }
+
+        length = readlink(path, target, size);
+        if (length < 0)
+        {
+            int saved_errno = errno;
+            free(target);
+            errno = saved_errno;
+            return NULL;
+        }
+        else if ((size_t)length < size)
+        {
+            break;
+        }
+
+        free(target);
+        size *= 2;
+    }
+
+    /* an absolute target stands alone. */
+    if ('/' == target[0])
+    {
+        dir_length = 0;
+    }
+
+    result = (char*)malloc(dir_length + length + 1);
+    if (NULL != result)
+    {
+        memcpy(result, path, dir_length);
+        memcpy(result + dir_length, target, length);
+        result[dir_length + length] = 0;
+    }
+
+    free(target);
+    return result;
+}
@@ -0,0 +1,69 @@
+/**
+ * \file lib/eroc_writer_flush.c
+ *
+ * \brief Write everything that a writer has gathered.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <errno.h>
+#include <eroc/writer.h>
+#include <unistd.h>
+
+/**
+ * \brief Write everything that the writer has gathered.
+ *
+ * Short writes are resumed, and interrupted writes are retried.
+ *
+ * \param writer            The writer for this operation.
+ *
+ * \returns 0 on success and non-zero if a write failed, in which case errno
+ * describes the failure.
+ */
+int eroc_writer_flush(eroc_writer* writer)
+{
+    struct iovec* iov = writer->iov;
+    int count = writer->iov_count;
+
+    while (count > 0)
+    {
+        ssize_t result = writev(writer->fd, iov, count);
+        if (result < 0)
+        {
+            if (EINTR == errno)
+            {
+                continue;
+            }
+
+            return 1;
+        }
+        else if (0 == result)
+        {
+            errno = EIO;
+            return 2;
+        }
+
+        writer->written += result;
+        writer->pending -= result;
+
+        /* skip the spans that were written in full. */
+        while (count > 0 && (size_t)result >= iov->iov_len)
+        {
+            result -= iov->iov_len;
+            ++iov;
+            --count;
+        }
+
+        /* resume a span that was written in part. */
+        if (count > 0)
+        {
+            iov->iov_base = (char*)iov->iov_base + result;
+            iov->iov_len -= result;
+        }
+    }
+
+    writer->iov_count = 0;
+    writer->staged = 0;
+    return 0;
+}
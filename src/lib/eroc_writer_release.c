@@ -0,0 +1,22 @@
+/**
+ * \file lib/eroc_writer_release.c
+ *
+ * \brief Release a writer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/writer.h>
+#include <stdlib.h>
+
+/**
+ * \brief Release a writer, discarding anything that hasn't been flushed.
+ *
+ * \param writer            The writer to release.
+ */
+void eroc_writer_release(eroc_writer* writer)
+{
+    free(writer->stage);
+    free(writer);
+}
@@ -0,0 +1,155 @@
+/**
+ * \file test/lib/test_eroc_arena.cpp
+ *
+ * \brief Unit tests for the arena and buffer line recycling.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <eroc/arena.h>
+#include <eroc/buffer.h>
+#include <minunit/minunit.h>
+#include <string>
+
+TEST_SUITE(eroc_arena);
+
+/**
+ * \brief Allocations honor their alignment and don't overlap.
+ */
+TEST(alloc_alignment)
+{
+    eroc_arena* arena;
+
+    TEST_ASSERT(0 == eroc_arena_create(&arena, 4096));
+
+    char* a = (char*)eroc_arena_alloc(arena, 3, 1);
+    void* b = eroc_arena_alloc(arena, 8, 8);
+    void* c = eroc_arena_alloc(arena, 16, 64);
+    TEST_ASSERT(nullptr != a);
+    TEST_ASSERT(nullptr != b);
+    TEST_ASSERT(nullptr != c);
+
+    TEST_EXPECT(0 == (uintptr_t)b % 8);
+    TEST_EXPECT(0 == (uintptr_t)c % 64);
+    TEST_EXPECT((char*)b >= a + 3);
+    TEST_EXPECT((char*)c >= (char*)b + 8);
+
+    /* all three allocations share the first block. */
+    TEST_EXPECT(nullptr == arena->blocks->next);
+
+    eroc_arena_release(arena);
+}
+
+/**
+ * \brief A full block is replaced by a new one, and a large request gets a
+ * block of its own without retiring the block being filled.
+ */
+TEST(alloc_blocks)
+{
+    eroc_arena* arena;
+
+    TEST_ASSERT(0 == eroc_arena_create(&arena, 1024));
+
+    /* fill most of the first block. */
+    char* first = (char*)eroc_arena_alloc(arena, 200, 1);
+    for (int i = 0; i < 3; ++i)
+    {
+        TEST_ASSERT(nullptr != eroc_arena_alloc(arena, 200, 1));
+    }
+    eroc_arena_block* block = arena->blocks;
+
+    /* a large request goes behind the current block. */
+    char* large = (char*)eroc_arena_alloc(arena, 4000, 1);
+    TEST_ASSERT(nullptr != large);
+    memset(large, 0xAA, 4000);
+    TEST_EXPECT(block == arena->blocks);
+    TEST_EXPECT(4000 <= arena->blocks->next->size);
+
+    /* the current block keeps filling. */
+    char* next = (char*)eroc_arena_alloc(arena, 100, 1);
+    TEST_EXPECT(next == first + 800);
+
+    /* a request that doesn't fit starts a new block. */
+    TEST_ASSERT(nullptr != eroc_arena_alloc(arena, 200, 1));
+    TEST_EXPECT(block != arena->blocks);
+    TEST_EXPECT(block == arena->blocks->next);
+
+    eroc_arena_release(arena);
+}
+
+/**
+ * \brief Deleted arena lines are recycled for lines created later.
+ */
+TEST(buffer_line_recycle)
+{
+    eroc_buffer* buffer;
+    eroc_buffer_line* line;
+
+    TEST_ASSERT(0 == eroc_buffer_create(&buffer));
+
+    std::string text(100, 'x');
+    TEST_ASSERT(
+        0 == eroc_buffer_line_create_in(
+                &line, buffer, text.data(), text.size()));
+    TEST_EXPECT(0 != (line->flags & EROC_BUFFER_LINE_FLAG_ARENA));
+    TEST_EXPECT(100 == line->length);
+    TEST_EXPECT(0 == line->line[100]);
+    eroc_buffer_append(buffer, nullptr, line);
+    TEST_EXPECT(0 == buffer->heap_lines);
+
+    eroc_buffer_line* old_line = line;
+    char* old_text = line->line;
+    eroc_buffer_line_delete(buffer, line);
+
+    /* a shorter line of the same size class reuses both the header and the
+     * string. */
+    std::string shorter(50, 'y');
+    TEST_ASSERT(
+        0 == eroc_buffer_line_create_in(
+                &line, buffer, shorter.data(), shorter.size()));
+    TEST_EXPECT(old_line == line);
+    TEST_EXPECT(old_text == line->line);
+    TEST_EXPECT(63 == line->capacity);
+    TEST_EXPECT(shorter == line->line);
+    eroc_buffer_append(buffer, nullptr, line);
+
+    /* heap lines can be mixed with arena lines. */
+    TEST_ASSERT(0 == eroc_buffer_line_create_copy(&line, "def", 3));
+    eroc_buffer_append(buffer, nullptr, line);
+    TEST_EXPECT(1 == buffer->heap_lines);
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Setting an arena line grows its string from the arena and recycles
+ * the old one.
+ */
+TEST(buffer_line_set)
+{
+    eroc_buffer* buffer;
+    eroc_buffer_line* line;
+
+    TEST_ASSERT(0 == eroc_buffer_create(&buffer));
+    TEST_ASSERT(0 == eroc_buffer_line_create_in(&line, buffer, "abcdefgh", 8));
+    eroc_buffer_append(buffer, nullptr, line);
+
+    std::string longer(40, 'y');
+    TEST_ASSERT(
+        0 == eroc_buffer_line_set(
+                buffer, line, longer.data(), longer.size()));
+    TEST_EXPECT(longer == std::string(line->line, line->length));
+    TEST_EXPECT(line->capacity >= 40);
+    TEST_EXPECT(nullptr != buffer->free_text[3]);
+
+    /* a shorter string is copied in place. */
+    char* text = line->line;
+    TEST_ASSERT(0 == eroc_buffer_line_set(buffer, line, "z", 1));
+    TEST_EXPECT(text == line->line);
+    TEST_EXPECT(0 == strcmp("z", line->line));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
@@ -12,6 +12,7 @@
 #include <minunit/minunit.h>
 #include <stdlib.h>
 #include <string.h>
+#include <vector>
 
 using namespace std;
 
@@ -28,6 +29,9 @@ struct test_node
     eroc_avl_tree_node hdr;
     int key;
     char* value;
+    /* the aggregate kept by test_node_update. */
+    long weight;
+    long sum;
 };
 
 static int test_compare(
@@ -66,6 +70,46 @@ static test_node* test_node_create(int key, const char* value)
     return retval;
 }
 
+/**
+ * Verify the parent links, heights, subtree counts, and balance factors of a
+ * subtree, returning the number of nodes in the subtree, or -1 on error.
+ */
+static long verify_subtree(
+    const eroc_avl_tree_node* node, const eroc_avl_tree_node* parent)
+{
+    if (NULL == node)
+    {
+        return 0;
+    }
+
+    if (parent != node->parent)
+    {
+        return -1;
+    }
+
+    long left_count = verify_subtree(node->left, node);
+    long right_count = verify_subtree(node->right, node);
+    if (left_count < 0 || right_count < 0)
+    {
+        return -1;
+    }
+
+    int left_height = node->left ? node->left->height : 0;
+    int right_height = node->right ? node->right->height : 0;
+    int bf = left_height - right_height;
+    if (max(left_height, right_height) + 1 != node->height || bf < -1 || bf > 1)
+    {
+        return -1;
+    }
+
+    if ((size_t)(left_count + right_count + 1) != node->count)
+    {
+        return -1;
+    }
+
+    return left_count + right_count + 1;
+}
+
 /**
  * Test that we can create and release an eroc_avl_tree instance.
  */
@@ -907,3 +951,898 @@ TEST(height_five_tree)
         TEST_ASSERT(0 == eroc_avl_tree_release(tree));
     }
 }
+
+/**
+ * Deleting a node whose left child is its predecessor keeps the left child's
+ * own left subtree.
+ */
+TEST(delete_with_left_predecessor)
+{
+    eroc_avl_tree* tree;
+    int keys[] = { 5, 3, 8, 2, 9 };
+
+    /* create the avl_tree. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                    (eroc_avl_tree_key_fn)&test_key,
+                    (eroc_avl_tree_release_fn)&test_node_release, NULL));
+
+    /* insert each element. */
+    for (int i = 0; i < 5; ++i)
+    {
+        eroc_avl_tree_insert(tree, &test_node_create(keys[i], "x")->hdr);
+    }
+
+    /* delete the root; its predecessor is its left child. */
+    TEST_ASSERT(0 == eroc_avl_tree_delete(NULL, tree, keys + 0));
+
+    /* the remaining elements are all reachable. */
+    TEST_ASSERT(4 == tree->count);
+    TEST_ASSERT(4 == verify_subtree(tree->root, NULL));
+    for (int i = 1; i < 5; ++i)
+    {
+        eroc_avl_tree_node* node = NULL;
+        TEST_ASSERT(eroc_avl_tree_find(&node, tree, keys + i));
+    }
+
+    /* clean up. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * Random keyed inserts and deletes maintain the tree invariants, and select
+ * and rank agree with the key order.
+ */
+TEST(random_insert_delete_select_rank)
+{
+    eroc_avl_tree* tree;
+
+    /* create the avl_tree. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                    (eroc_avl_tree_key_fn)&test_key,
+                    (eroc_avl_tree_release_fn)&test_node_release, NULL));
+
+    srand(12345);
+    for (int i = 0; i < 5000; ++i)
+    {
+        int key = rand() % 200;
+        eroc_avl_tree_node* node = NULL;
+
+        if (rand() % 2)
+        {
+            if (!eroc_avl_tree_find(&node, tree, &key))
+            {
+                eroc_avl_tree_insert(tree, &test_node_create(key, "x")->hdr);
+            }
+        }
+        else
+        {
+            TEST_ASSERT(0 == eroc_avl_tree_delete(NULL, tree, &key));
+        }
+
+        TEST_ASSERT((long)tree->count == verify_subtree(tree->root, NULL));
+    }
+
+    /* select walks the tree in key order, and rank inverts select. */
+    int prev_key = -1;
+    for (size_t i = 0; i < tree->count; ++i)
+    {
+        test_node* node = (test_node*)eroc_avl_tree_select(tree, i);
+        TEST_ASSERT(NULL != node);
+        TEST_EXPECT(prev_key < node->key);
+        TEST_EXPECT(i == eroc_avl_tree_rank(tree, &node->hdr));
+        prev_key = node->key;
+    }
+
+    /* selecting past the end fails. */
+    TEST_EXPECT(NULL == eroc_avl_tree_select(tree, tree->count));
+
+    /* clean up. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * Positional insertion places nodes relative to other nodes, regardless of
+ * keys.
+ */
+TEST(positional_insert)
+{
+    eroc_avl_tree* tree;
+    test_node* nodes[100];
+
+    /* create a tree with no key functions. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, NULL, NULL,
+                    (eroc_avl_tree_release_fn)&test_node_release, NULL));
+
+    /* append the even nodes in order. */
+    for (int i = 0; i < 100; i += 2)
+    {
+        nodes[i] = test_node_create(i, "x");
+        eroc_avl_tree_insert_after(tree, NULL, &nodes[i]->hdr);
+    }
+
+    /* insert the odd nodes before or after their even neighbors. */
+    for (int i = 1; i < 100; i += 2)
+    {
+        nodes[i] = test_node_create(i, "x");
+        if (i % 4 == 1)
+        {
+            eroc_avl_tree_insert_after(
+                tree, &nodes[i - 1]->hdr, &nodes[i]->hdr);
+        }
+        else if (i < 99)
+        {
+            eroc_avl_tree_insert_before(
+                tree, &nodes[i + 1]->hdr, &nodes[i]->hdr);
+        }
+        else
+        {
+            eroc_avl_tree_insert_after(tree, NULL, &nodes[i]->hdr);
+        }
+    }
+
+    TEST_ASSERT(100 == tree->count);
+    TEST_ASSERT(100 == verify_subtree(tree->root, NULL));
+
+    /* the nodes are in positional order. */
+    for (int i = 0; i < 100; ++i)
+    {
+        TEST_EXPECT(&nodes[i]->hdr == eroc_avl_tree_select(tree, i));
+        TEST_EXPECT((size_t)i == eroc_avl_tree_rank(tree, &nodes[i]->hdr));
+    }
+
+    /* inserting before NULL places a node at the beginning. */
+    test_node* first = test_node_create(-1, "x");
+    eroc_avl_tree_insert_before(tree, NULL, &first->hdr);
+    TEST_EXPECT(&first->hdr == eroc_avl_tree_select(tree, 0));
+    TEST_EXPECT(101 == verify_subtree(tree->root, NULL));
+
+    /* clean up. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * A node can be replaced in place.
+ */
+TEST(replace_node)
+{
+    eroc_avl_tree* tree;
+    test_node* nodes[7];
+
+    /* create the avl_tree. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                    (eroc_avl_tree_key_fn)&test_key,
+                    (eroc_avl_tree_release_fn)&test_node_release, NULL));
+
+    for (int i = 0; i < 7; ++i)
+    {
+        nodes[i] = test_node_create(i, "x");
+        eroc_avl_tree_insert(tree, &nodes[i]->hdr);
+    }
+
+    /* replace the root and a leaf. */
+    test_node* new_root = test_node_create(nodes[3]->key, "root");
+    test_node* new_leaf = test_node_create(nodes[6]->key, "leaf");
+    TEST_ASSERT(&nodes[3]->hdr == tree->root);
+    eroc_avl_tree_replace_node(tree, &nodes[3]->hdr, &new_root->hdr);
+    eroc_avl_tree_replace_node(tree, &nodes[6]->hdr, &new_leaf->hdr);
+
+    /* the new nodes are in place. */
+    TEST_EXPECT(&new_root->hdr == tree->root);
+    TEST_EXPECT(&new_root->hdr == eroc_avl_tree_select(tree, 3));
+    TEST_EXPECT(&new_leaf->hdr == eroc_avl_tree_select(tree, 6));
+    TEST_EXPECT(7 == verify_subtree(tree->root, NULL));
+
+    /* the old nodes are orphans. */
+    TEST_EXPECT(NULL == nodes[3]->hdr.parent);
+    TEST_EXPECT(NULL == nodes[3]->hdr.left);
+    TEST_EXPECT(NULL == nodes[3]->hdr.right);
+
+    /* clean up. */
+    test_node_release(NULL, nodes[3]);
+    test_node_release(NULL, nodes[6]);
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * Count the nodes released, checking that they are released in order.
+ */
+struct release_counter
+{
+    int next_key;
+    int bulk_calls;
+};
+
+static int counting_release(release_counter* counter, test_node* node)
+{
+    int retval = (counter->next_key == node->key) ? 0 : 1;
+
+    ++counter->next_key;
+    test_node_release(NULL, node);
+
+    return retval;
+}
+
+static int counting_bulk_release(
+    release_counter* counter, eroc_avl_tree_node* root)
+{
+    (void)root;
+    ++counter->bulk_calls;
+
+    return 0;
+}
+
+/**
+ * Test that deleting nodes needs no stack, even for a subtree far deeper than
+ * an AVL tree can be, and releases the nodes in order.
+ */
+TEST(delete_nodes_deep)
+{
+    const int COUNT = 1000000;
+    eroc_avl_tree* tree;
+    release_counter counter = {0, 0};
+
+    /* create the avl_tree. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                    (eroc_avl_tree_key_fn)&test_key,
+                    (eroc_avl_tree_release_fn)&counting_release, &counter));
+
+    /* build a zigzag chain by hand, which would overflow a recursive walk. */
+    eroc_avl_tree_node* root = NULL;
+    for (int i = 0; i < COUNT; ++i)
+    {
+        int key = (i % 2) ? COUNT / 2 + i / 2 : COUNT / 2 - 1 - i / 2;
+        test_node* node = test_node_create(key, "x");
+        TEST_ASSERT(NULL != node);
+
+        node->hdr.left = (i % 2) ? root : NULL;
+        node->hdr.right = (i % 2) ? NULL : root;
+        root = &node->hdr;
+    }
+
+    TEST_EXPECT(0 == eroc_avl_tree_delete_nodes(tree, root));
+    TEST_EXPECT(COUNT == counter.next_key);
+
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * Test that clearing a tree with a bulk release function calls it once instead
+ * of releasing each node.
+ */
+TEST(bulk_release)
+{
+    eroc_avl_tree* tree;
+    release_counter counter = {0, 0};
+    test_node* nodes[100];
+
+    /* create the avl_tree. */
+    TEST_ASSERT(
+        0
+            == eroc_avl_tree_create(
+                    &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                    (eroc_avl_tree_key_fn)&test_key,
+                    (eroc_avl_tree_release_fn)&counting_release, &counter));
+    eroc_avl_tree_bulk_release_set(
+        tree, (eroc_avl_tree_bulk_release_fn)&counting_bulk_release);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        nodes[i] = test_node_create(i, "x");
+        eroc_avl_tree_insert(tree, &nodes[i]->hdr);
+    }
+
+    /* clearing calls the bulk release function, and nothing else. */
+    TEST_EXPECT(0 == eroc_avl_tree_clear(tree));
+    TEST_EXPECT(1 == counter.bulk_calls);
+    TEST_EXPECT(0 == counter.next_key);
+    TEST_EXPECT(NULL == tree->root);
+    TEST_EXPECT(0 == tree->count);
+
+    /* an empty tree has nothing to release. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+    TEST_EXPECT(1 == counter.bulk_calls);
+
+    /* the nodes still belong to the test. */
+    for (int i = 0; i < 100; ++i)
+    {
+        test_node_release(NULL, nodes[i]);
+    }
+}
+
+/**
+ * Test that building from sorted nodes gives a valid, perfectly balanced tree
+ * for every size, with the nodes in order.
+ */
+TEST(build_sorted)
+{
+    for (int count = 0; count <= 130; ++count)
+    {
+        eroc_avl_tree* tree;
+        test_node* nodes[130];
+        eroc_avl_tree_node* hdrs[130];
+
+        /* create the avl_tree. */
+        TEST_ASSERT(
+            0
+                == eroc_avl_tree_create(
+                        &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                        (eroc_avl_tree_key_fn)&test_key,
+                        (eroc_avl_tree_release_fn)&test_node_release, NULL));
+
+        for (int i = 0; i < count; ++i)
+        {
+            nodes[i] = test_node_create(i * 2, "x");
+            hdrs[i] = &nodes[i]->hdr;
+        }
+
+        TEST_ASSERT(0 == eroc_avl_tree_build_sorted(tree, hdrs, count));
+        TEST_ASSERT(count == verify_subtree(tree->root, NULL));
+        TEST_EXPECT((size_t)count == tree->count);
+
+        /* the height is the least possible for this many nodes. */
+        int height = 0;
+        while ((1 << height) - 1 < count)
+        {
+            ++height;
+        }
+        TEST_EXPECT(height == (tree->root ? tree->root->height : 0));
+
+        /* the nodes are in order, and can be found by key. */
+        for (int i = 0; i < count; ++i)
+        {
+            eroc_avl_tree_node* found;
+            int key = i * 2;
+            TEST_EXPECT(hdrs[i] == eroc_avl_tree_select(tree, i));
+            TEST_EXPECT(eroc_avl_tree_find(&found, tree, &key));
+            TEST_EXPECT(hdrs[i] == found);
+        }
+
+        /* a tree that isn't empty can't be built over. */
+        if (count > 0)
+        {
+            TEST_EXPECT(0 != eroc_avl_tree_build_sorted(tree, hdrs, 1));
+        }
+
+        /* the tree still supports inserts and deletes. */
+        eroc_avl_tree_insert(tree, &test_node_create(1, "y")->hdr);
+        int key = 1;
+        TEST_ASSERT(0 == eroc_avl_tree_delete(NULL, tree, &key));
+        TEST_ASSERT(count == verify_subtree(tree->root, NULL));
+
+        /* clean up. */
+        TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+    }
+}
+
+/**
+ * Test that merging random trees gives a valid tree holding every node of
+ * both, in key order, and leaves the other tree empty.
+ */
+TEST(merge)
+{
+    srand(54321);
+    for (int round = 0; round < 50; ++round)
+    {
+        eroc_avl_tree* trees[2];
+        vector<int> keys;
+
+        for (auto& tree : trees)
+        {
+            TEST_ASSERT(
+                0
+                    == eroc_avl_tree_create(
+                            &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                            (eroc_avl_tree_key_fn)&test_key,
+                            (eroc_avl_tree_release_fn)&test_node_release,
+                            NULL));
+
+            /* keys may repeat within and across the trees. */
+            int count = rand() % 100;
+            for (int i = 0; i < count; ++i)
+            {
+                int key = rand() % 150;
+                eroc_avl_tree_insert(tree, &test_node_create(key, "x")->hdr);
+                keys.push_back(key);
+            }
+        }
+
+        eroc_avl_tree_merge(trees[0], trees[1]);
+        sort(keys.begin(), keys.end());
+
+        TEST_ASSERT((long)keys.size() == verify_subtree(trees[0]->root, NULL));
+        TEST_EXPECT(keys.size() == trees[0]->count);
+        TEST_EXPECT(NULL == trees[1]->root);
+        TEST_EXPECT(0 == trees[1]->count);
+
+        for (size_t i = 0; i < keys.size(); ++i)
+        {
+            test_node* node = (test_node*)eroc_avl_tree_select(trees[0], i);
+            TEST_ASSERT(NULL != node);
+            TEST_EXPECT(keys[i] == node->key);
+        }
+
+        /* clean up. */
+        TEST_ASSERT(0 == eroc_avl_tree_release(trees[0]));
+        TEST_ASSERT(0 == eroc_avl_tree_release(trees[1]));
+    }
+}
+
+/**
+ * Create an empty tree of test nodes.
+ */
+static eroc_avl_tree* test_tree_create()
+{
+    eroc_avl_tree* tree;
+
+    if (0
+        != eroc_avl_tree_create(
+                &tree, (eroc_avl_tree_compare_fn)&test_compare,
+                (eroc_avl_tree_key_fn)&test_key,
+                (eroc_avl_tree_release_fn)&test_node_release, NULL))
+    {
+        return NULL;
+    }
+
+    return tree;
+}
+
+/**
+ * Return the nodes of a tree in order.
+ */
+static vector<eroc_avl_tree_node*> tree_nodes(eroc_avl_tree* tree)
+{
+    vector<eroc_avl_tree_node*> nodes;
+
+    for (size_t i = 0; i < tree->count; ++i)
+    {
+        nodes.push_back(eroc_avl_tree_select(tree, i));
+    }
+
+    return nodes;
+}
+
+/**
+ * Test that joining trees of every pair of sizes around a node gives a valid
+ * tree with the nodes in order, and leaves the other tree empty.
+ */
+TEST(join)
+{
+    /* sizes that differ by a lot differ in height by a lot. */
+    for (int left_count : { 0, 1, 2, 3, 5, 8, 13, 40, 100, 300 })
+    {
+        for (int right_count : { 0, 1, 2, 3, 5, 8, 13, 40, 100, 300 })
+        {
+            eroc_avl_tree* trees[2] = {
+                test_tree_create(), test_tree_create() };
+            vector<eroc_avl_tree_node*> expected;
+
+            TEST_ASSERT(NULL != trees[0] && NULL != trees[1]);
+
+            for (int i = 0; i < left_count; ++i)
+            {
+                expected.push_back(&test_node_create(i, "l")->hdr);
+                eroc_avl_tree_insert(trees[0], expected.back());
+            }
+
+            test_node* middle = test_node_create(left_count, "m");
+            expected.push_back(&middle->hdr);
+
+            for (int i = 0; i < right_count; ++i)
+            {
+                expected.push_back(
+                    &test_node_create(left_count + 1 + i, "r")->hdr);
+                eroc_avl_tree_insert(trees[1], expected.back());
+            }
+
+            eroc_avl_tree_join(trees[0], &middle->hdr, trees[1]);
+
+            TEST_ASSERT(
+                (long)expected.size() == verify_subtree(trees[0]->root, NULL));
+            TEST_EXPECT(expected.size() == trees[0]->count);
+            TEST_EXPECT(expected == tree_nodes(trees[0]));
+            TEST_EXPECT(NULL == trees[1]->root);
+            TEST_EXPECT(0 == trees[1]->count);
+
+            /* clean up. */
+            TEST_ASSERT(0 == eroc_avl_tree_release(trees[0]));
+            TEST_ASSERT(0 == eroc_avl_tree_release(trees[1]));
+        }
+    }
+}
+
+/**
+ * Test that splitting a random tree at random positions and concatenating the
+ * pieces back gives valid trees with the nodes in order every time.
+ */
+TEST(split_concat)
+{
+    srand(2468);
+    for (int round = 0; round < 200; ++round)
+    {
+        eroc_avl_tree* tree = test_tree_create();
+        eroc_avl_tree* right = test_tree_create();
+        size_t count = rand() % 500;
+
+        TEST_ASSERT(NULL != tree && NULL != right);
+
+        /* random deletes leave the tree in a shape builds don't. */
+        for (size_t i = 0; i < count + count / 2; ++i)
+        {
+            eroc_avl_tree_insert(
+                tree, &test_node_create(rand() % 1000, "x")->hdr);
+        }
+        for (size_t i = 0; i < count / 2; ++i)
+        {
+            eroc_avl_tree_node* node =
+                eroc_avl_tree_select(tree, rand() % tree->count);
+            eroc_avl_tree_remove_node(tree, node);
+            test_node_release(NULL, (test_node*)node);
+        }
+
+        vector<eroc_avl_tree_node*> expected = tree_nodes(tree);
+        size_t index = rand() % (count + 2);
+        size_t split = min(index, count);
+
+        TEST_ASSERT(0 == eroc_avl_tree_split_at(tree, right, index));
+        TEST_ASSERT((long)split == verify_subtree(tree->root, NULL));
+        TEST_ASSERT((long)(count - split) == verify_subtree(right->root, NULL));
+        TEST_EXPECT(split == tree->count);
+        TEST_EXPECT(count - split == right->count);
+        TEST_EXPECT(
+            vector<eroc_avl_tree_node*>(
+                expected.begin(), expected.begin() + split)
+                == tree_nodes(tree));
+        TEST_EXPECT(
+            vector<eroc_avl_tree_node*>(
+                expected.begin() + split, expected.end())
+                == tree_nodes(right));
+
+        /* a split can't go into a tree that isn't empty. */
+        if (NULL != right->root)
+        {
+            TEST_EXPECT(0 != eroc_avl_tree_split_at(right, right, 0));
+        }
+
+        eroc_avl_tree_concat(tree, right);
+        TEST_ASSERT((long)count == verify_subtree(tree->root, NULL));
+        TEST_EXPECT(count == tree->count);
+        TEST_EXPECT(expected == tree_nodes(tree));
+        TEST_EXPECT(NULL == right->root);
+        TEST_EXPECT(0 == right->count);
+
+        /* clean up. */
+        TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+        TEST_ASSERT(0 == eroc_avl_tree_release(right));
+    }
+}
+
+/**
+ * Test that splitting by key puts every node with a lesser key on the left and
+ * every other node on the right, including duplicates of the split key.
+ */
+TEST(split_key)
+{
+    srand(1357);
+    for (int round = 0; round < 100; ++round)
+    {
+        eroc_avl_tree* tree = test_tree_create();
+        eroc_avl_tree* right = test_tree_create();
+        int count = rand() % 300;
+        int key = rand() % 60 - 5;
+
+        TEST_ASSERT(NULL != tree && NULL != right);
+
+        for (int i = 0; i < count; ++i)
+        {
+            eroc_avl_tree_insert(
+                tree, &test_node_create(rand() % 50, "x")->hdr);
+        }
+
+        vector<eroc_avl_tree_node*> expected = tree_nodes(tree);
+
+        TEST_ASSERT(0 == eroc_avl_tree_split(tree, right, &key));
+        TEST_ASSERT((long)tree->count == verify_subtree(tree->root, NULL));
+        TEST_ASSERT((long)right->count == verify_subtree(right->root, NULL));
+        TEST_EXPECT((size_t)count == tree->count + right->count);
+
+        for (auto* node : tree_nodes(tree))
+        {
+            TEST_EXPECT(((test_node*)node)->key < key);
+        }
+        for (auto* node : tree_nodes(right))
+        {
+            TEST_EXPECT(((test_node*)node)->key >= key);
+        }
+
+        /* the order of equal keys survives the split. */
+        vector<eroc_avl_tree_node*> joined = tree_nodes(tree);
+        vector<eroc_avl_tree_node*> rest = tree_nodes(right);
+        joined.insert(joined.end(), rest.begin(), rest.end());
+        TEST_EXPECT(expected == joined);
+
+        /* clean up. */
+        TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+        TEST_ASSERT(0 == eroc_avl_tree_release(right));
+    }
+}
+
+/**
+ * Test that ranking by key counts the lesser keys, with duplicate keys, as the
+ * tree changes by inserts and by removals at random positions.
+ */
+TEST(rank_key)
+{
+    eroc_avl_tree* tree = test_tree_create();
+    vector<int> keys;
+
+    TEST_ASSERT(NULL != tree);
+
+    /* an empty tree has nothing before any key. */
+    int key = 0;
+    TEST_EXPECT(0 == eroc_avl_tree_rank_key(tree, &key));
+
+    srand(97531);
+    for (int round = 0; round < 40; ++round)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            key = rand() % 100;
+            eroc_avl_tree_insert(tree, &test_node_create(key, "x")->hdr);
+            keys.insert(upper_bound(keys.begin(), keys.end(), key), key);
+        }
+
+        for (int i = 0; i < 50; ++i)
+        {
+            size_t index = rand() % keys.size();
+            eroc_avl_tree_node* node = eroc_avl_tree_select(tree, index);
+
+            TEST_ASSERT(NULL != node);
+            TEST_EXPECT(keys[index] == ((test_node*)node)->key);
+            eroc_avl_tree_remove_node(tree, node);
+            test_node_release(NULL, (test_node*)node);
+            keys.erase(keys.begin() + index);
+        }
+
+        TEST_ASSERT((long)keys.size() == verify_subtree(tree->root, NULL));
+
+        /* probe every key, including those past either end. */
+        for (key = -1; key <= 100; ++key)
+        {
+            size_t expected =
+                lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+            size_t rank = eroc_avl_tree_rank_key(tree, &key);
+
+            TEST_EXPECT(expected == rank);
+            if (rank < tree->count)
+            {
+                test_node* node = (test_node*)eroc_avl_tree_select(tree, rank);
+                TEST_EXPECT(node->key >= key);
+                TEST_EXPECT(rank == eroc_avl_tree_rank(tree, &node->hdr));
+            }
+        }
+    }
+
+    /* clean up. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+}
+
+/**
+ * Keep the sum of the weights of each subtree.
+ */
+static void test_node_update(test_context* context, test_node* node)
+{
+    (void)context;
+
+    node->sum = node->weight;
+    if (NULL != node->hdr.left)
+    {
+        node->sum += ((test_node*)node->hdr.left)->sum;
+    }
+    if (NULL != node->hdr.right)
+    {
+        node->sum += ((test_node*)node->hdr.right)->sum;
+    }
+}
+
+/**
+ * Verify the weight sums of a subtree, returning the sum of the subtree, or -1
+ * on error.
+ */
+static long verify_sums(const eroc_avl_tree_node* node)
+{
+    if (NULL == node)
+    {
+        return 0;
+    }
+
+    long left_sum = verify_sums(node->left);
+    long right_sum = verify_sums(node->right);
+    if (left_sum < 0 || right_sum < 0)
+    {
+        return -1;
+    }
+
+    const test_node* tnode = (const test_node*)node;
+    long sum = left_sum + right_sum + tnode->weight;
+
+    return (sum == tnode->sum) ? sum : -1;
+}
+
+/**
+ * Create a test node with the given key and weight.
+ */
+static test_node* weighted_node_create(int key, long weight)
+{
+    test_node* node = test_node_create(key, "w");
+    node->weight = weight;
+
+    return node;
+}
+
+/**
+ * Test that the update function keeps the weight sums current through every
+ * operation that changes the shape of the tree or the contents of a node.
+ */
+TEST(update_fn)
+{
+    eroc_avl_tree* tree = test_tree_create();
+    eroc_avl_tree* right = test_tree_create();
+    long total = 0;
+
+    TEST_ASSERT(NULL != tree && NULL != right);
+
+    /* setting the function on a tree with nodes updates all of them. */
+    srand(8642);
+    for (int i = 0; i < 300; ++i)
+    {
+        long weight = 1 + rand() % 1000;
+        eroc_avl_tree_insert(
+            tree, &weighted_node_create(rand() % 500, weight)->hdr);
+        total += weight;
+    }
+
+    eroc_avl_tree_update_set(
+        tree, (eroc_avl_tree_update_fn)&test_node_update);
+    eroc_avl_tree_update_set(
+        right, (eroc_avl_tree_update_fn)&test_node_update);
+    TEST_ASSERT(total == verify_sums(tree->root));
+
+    for (int i = 0; i < 3000; ++i)
+    {
+        long weight = 1 + rand() % 1000;
+        int key = rand() % 500;
+        test_node* node =
+            (test_node*)eroc_avl_tree_select(
+                tree, rand() % (tree->count ? tree->count : 1));
+
+        switch (rand() % 9)
+        {
+            /* keyed insert and delete. */
+            case 0:
+                eroc_avl_tree_insert(
+                    tree, &weighted_node_create(key, weight)->hdr);
+                total += weight;
+                break;
+
+            case 1:
+                if (eroc_avl_tree_find((eroc_avl_tree_node**)&node, tree, &key))
+                {
+                    total -= node->weight;
+                    TEST_ASSERT(0 == eroc_avl_tree_delete(NULL, tree, &key));
+                }
+                break;
+
+            /* positional inserts next to a node with the same key. */
+            case 2:
+            case 3:
+                if (NULL != node)
+                {
+                    test_node* added = weighted_node_create(node->key, weight);
+                    if (i % 2)
+                    {
+                        eroc_avl_tree_insert_after(
+                            tree, &node->hdr, &added->hdr);
+                    }
+                    else
+                    {
+                        eroc_avl_tree_insert_before(
+                            tree, &node->hdr, &added->hdr);
+                    }
+                    total += weight;
+                }
+                break;
+
+            /* positional removal. */
+            case 4:
+                if (NULL != node)
+                {
+                    eroc_avl_tree_remove_node(tree, &node->hdr);
+                    TEST_EXPECT(node->weight == node->sum);
+                    total -= node->weight;
+                    test_node_release(NULL, node);
+                }
+                break;
+
+            /* replacement by a node of another weight. */
+            case 5:
+                if (NULL != node)
+                {
+                    test_node* added = weighted_node_create(node->key, weight);
+                    eroc_avl_tree_replace_node(tree, &node->hdr, &added->hdr);
+                    total += weight - node->weight;
+                    test_node_release(NULL, node);
+                }
+                break;
+
+            /* a weight changed in place. */
+            case 6:
+                if (NULL != node)
+                {
+                    total += weight - node->weight;
+                    node->weight = weight;
+                    eroc_avl_tree_rebalance(tree, &node->hdr);
+                }
+                break;
+
+            /* split and put back together by concatenation. */
+            case 7:
+                TEST_ASSERT(
+                    0 == eroc_avl_tree_split_at(
+                            tree, right, rand() % (tree->count + 1)));
+                TEST_ASSERT(
+                    total
+                        == verify_sums(tree->root) + verify_sums(right->root));
+                eroc_avl_tree_concat(tree, right);
+                break;
+
+            /* split and put back together around a new node. */
+            default:
+                TEST_ASSERT(0 == eroc_avl_tree_split(tree, right, &key));
+                eroc_avl_tree_join(
+                    tree, &weighted_node_create(key, weight)->hdr, right);
+                total += weight;
+                break;
+        }
+
+        TEST_ASSERT((long)tree->count == verify_subtree(tree->root, NULL));
+        TEST_ASSERT(total == verify_sums(tree->root));
+    }
+
+    /* merging rebuilds the tree, and bulk building builds it. */
+    for (int i = 0; i < 200; ++i)
+    {
+        long weight = 1 + rand() % 1000;
+        eroc_avl_tree_insert(
+            right, &weighted_node_create(rand() % 500, weight)->hdr);
+        total += weight;
+    }
+
+    eroc_avl_tree_merge(tree, right);
+    TEST_ASSERT(total == verify_sums(tree->root));
+
+    vector<eroc_avl_tree_node*> nodes = tree_nodes(tree);
+    tree->root = NULL;
+    tree->count = 0;
+    TEST_ASSERT(
+        0 == eroc_avl_tree_build_sorted(tree, nodes.data(), nodes.size()));
+    TEST_ASSERT(total == verify_sums(tree->root));
+
+    /* clean up. */
+    TEST_ASSERT(0 == eroc_avl_tree_release(tree));
+    TEST_ASSERT(0 == eroc_avl_tree_release(right));
+}
@@ -0,0 +1,426 @@
+/**
+ * \file test/lib/test_eroc_buffer_journal.cpp
+ *
+ * \brief Unit tests for the buffer journal, undo, and redo.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <minunit/minunit.h>
+#include <random>
+#include <string>
+#include <vector>
+
+TEST_SUITE(eroc_buffer_journal);
+
+namespace {
+
+/**
+ * \brief Create an arena line holding the given text.
+ */
+eroc_buffer_line* make_line(eroc_buffer* buffer, const std::string& text)
+{
+    eroc_buffer_line* line;
+
+    if (0 != eroc_buffer_line_create_in(
+                &line, buffer, text.data(), text.size()))
+    {
+        return nullptr;
+    }
+
+    return line;
+}
+
+/**
+ * \brief Create a journaled buffer holding the given number of lines.
+ */
+eroc_buffer* make_buffer(unsigned long count, size_t limit = 1024 * 1024)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (unsigned long i = 0; i < count; ++i)
+    {
+        eroc_buffer_append(
+            buffer, nullptr, make_line(buffer, "line " + std::to_string(i)));
+    }
+
+    if (0 != eroc_buffer_journal_create(buffer, limit))
+    {
+        eroc_buffer_release(buffer);
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+/**
+ * \brief Get the contents of a buffer, checking that the index agrees with the
+ * list.
+ */
+std::vector<std::string> contents(eroc_buffer* buffer)
+{
+    std::vector<std::string> lines;
+    unsigned long i = 0;
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (eroc_buffer_line*)node;
+        eroc_buffer_line* indexed;
+
+        if (0 != eroc_buffer_line_at(&indexed, buffer, i++) || indexed != line)
+        {
+            lines.emplace_back("<index mismatch>");
+            break;
+        }
+
+        lines.emplace_back(line->line, line->length);
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Parse and run a command.
+ */
+int run(eroc_buffer* buffer, const char* input)
+{
+    eroc_command* command;
+
+    int retval = eroc_command_parse(&command, buffer, input);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_command_run(command);
+    (void)eroc_command_release(command);
+
+    return retval;
+}
+
+/**
+ * \brief Count the records in a buffer's journal.
+ */
+size_t record_count(const eroc_buffer* buffer)
+{
+    size_t count = 0;
+
+    for (auto record = buffer->journal->head; nullptr != record;
+         record = record->next)
+    {
+        ++count;
+    }
+
+    return count;
+}
+
+} /* namespace */
+
+/**
+ * \brief Deleting a range makes one record, whose lines move back on undo.
+ */
+TEST(delete_range)
+{
+    eroc_buffer* buffer = make_buffer(10);
+    TEST_ASSERT(nullptr != buffer);
+
+    auto before = contents(buffer);
+    eroc_buffer_line* third;
+    TEST_ASSERT(0 == eroc_buffer_line_at(&third, buffer, 2));
+
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "2,5d"));
+    TEST_EXPECT(6 == buffer->lines->count);
+    TEST_EXPECT(1 == record_count(buffer));
+    TEST_EXPECT(4 == buffer->journal->head->removed_count);
+
+    TEST_ASSERT(0 == run(buffer, "u"));
+    TEST_EXPECT(before == contents(buffer));
+    TEST_EXPECT(4 == buffer->lineno);
+
+    /* the lines themselves were moved back, not copied. */
+    eroc_buffer_line* line;
+    TEST_ASSERT(0 == eroc_buffer_line_at(&line, buffer, 2));
+    TEST_EXPECT(third == line);
+    TEST_ASSERT(0 == eroc_buffer_line_at(&line, buffer, 4));
+    TEST_EXPECT(buffer->cursor == line);
+
+    TEST_ASSERT(0 == run(buffer, "U"));
+    TEST_EXPECT(6 == buffer->lines->count);
+    TEST_EXPECT("line 6" == contents(buffer)[2]);
+
+    /* nothing is left to redo. */
+    TEST_EXPECT(0 != eroc_buffer_redo(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Deleting backwards from the end of the buffer also makes one record.
+ */
+TEST(delete_backwards)
+{
+    eroc_buffer* buffer = make_buffer(5);
+    TEST_ASSERT(nullptr != buffer);
+
+    auto before = contents(buffer);
+
+    eroc_buffer_journal_checkpoint(buffer);
+    for (int i = 0; i < 3; ++i)
+    {
+        eroc_buffer_line_delete(buffer, (eroc_buffer_line*)buffer->lines->tail);
+    }
+
+    TEST_EXPECT(1 == record_count(buffer));
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT(before == contents(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Each group of changes is undone and redone as a whole.
+ */
+TEST(groups)
+{
+    eroc_buffer* buffer = make_buffer(3);
+    TEST_ASSERT(nullptr != buffer);
+
+    auto v0 = contents(buffer);
+
+    /* append two lines at the end. */
+    eroc_buffer_journal_checkpoint(buffer);
+    eroc_buffer_append(buffer, nullptr, make_line(buffer, "a"));
+    eroc_buffer_append(buffer, nullptr, make_line(buffer, "b"));
+    auto v1 = contents(buffer);
+
+    /* insert a line at the start and replace the second line. */
+    eroc_buffer_journal_checkpoint(buffer);
+    eroc_buffer_insert(
+        buffer, (eroc_buffer_line*)buffer->lines->head, make_line(buffer, "c"));
+    eroc_buffer_replace(
+        buffer, (eroc_buffer_line*)buffer->lines->head->next,
+        make_line(buffer, "d"));
+    auto v2 = contents(buffer);
+    TEST_EXPECT("c" == v2[0]);
+    TEST_EXPECT("d" == v2[1]);
+
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT(v1 == contents(buffer));
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT(v0 == contents(buffer));
+    TEST_EXPECT(0 != eroc_buffer_undo(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_redo(buffer));
+    TEST_EXPECT(v1 == contents(buffer));
+    TEST_ASSERT(0 == eroc_buffer_redo(buffer));
+    TEST_EXPECT(v2 == contents(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief A substitution over a range is undone as one record, even when the
+ * results fit in the old lines.
+ */
+TEST(substitute)
+{
+    eroc_buffer* buffer = make_buffer(6);
+    TEST_ASSERT(nullptr != buffer);
+
+    auto before = contents(buffer);
+
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "2,5s/line/L/"));
+    TEST_EXPECT("L 1" == contents(buffer)[1]);
+    TEST_EXPECT("L 4" == contents(buffer)[4]);
+    TEST_EXPECT(1 == record_count(buffer));
+    TEST_EXPECT(4 == buffer->journal->head->count);
+
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT(before == contents(buffer));
+    TEST_EXPECT(4 == buffer->lineno);
+
+    TEST_ASSERT(0 == eroc_buffer_redo(buffer));
+    TEST_EXPECT("L 3" == contents(buffer)[3]);
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief A new change forgets the changes that could have been redone.
+ */
+TEST(redo_dropped)
+{
+    eroc_buffer* buffer = make_buffer(4);
+    TEST_ASSERT(nullptr != buffer);
+
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "1d"));
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "1d"));
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "3d"));
+    TEST_EXPECT(1 == record_count(buffer));
+    TEST_EXPECT(0 != eroc_buffer_redo(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT(4 == buffer->lines->count);
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief The oldest groups are forgotten to stay under the limit, and a group
+ * that doesn't fit on its own turns recording off until the next checkpoint.
+ */
+TEST(limit)
+{
+    size_t line_size = sizeof(eroc_buffer_line) + 16;
+    size_t limit = sizeof(eroc_buffer_journal_record) * 3 + line_size * 10;
+    eroc_buffer* buffer = make_buffer(100, limit);
+    TEST_ASSERT(nullptr != buffer);
+
+    /* each delete holds one line. */
+    for (int i = 0; i < 20; ++i)
+    {
+        eroc_buffer_journal_checkpoint(buffer);
+        TEST_ASSERT(0 == run(buffer, "1d"));
+        TEST_EXPECT(buffer->journal->size <= limit);
+    }
+
+    TEST_EXPECT(record_count(buffer) < 20);
+    TEST_EXPECT(record_count(buffer) > 0);
+
+    /* the newest changes are the ones that are kept. */
+    TEST_ASSERT(0 == eroc_buffer_undo(buffer));
+    TEST_EXPECT("line 19" == contents(buffer)[0]);
+
+    /* a group too big to keep empties the journal. */
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "1,50d"));
+    TEST_EXPECT(nullptr == buffer->journal->head);
+    TEST_EXPECT(0 == buffer->journal->size);
+    TEST_EXPECT(buffer->journal->paused);
+    TEST_EXPECT(0 != eroc_buffer_undo(buffer));
+
+    /* recording resumes with the next group. */
+    eroc_buffer_journal_checkpoint(buffer);
+    TEST_ASSERT(0 == run(buffer, "1d"));
+    TEST_EXPECT(1 == record_count(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Random edits, undos, and redos agree with a model that keeps a copy
+ * of the buffer after every group.
+ */
+TEST(random_model)
+{
+    eroc_buffer* buffer = make_buffer(20);
+    TEST_ASSERT(nullptr != buffer);
+
+    std::mt19937 rng(13);
+    std::vector<std::vector<std::string>> history{contents(buffer)};
+    size_t position = 0;
+    bool ok = true;
+
+    for (int step = 0; step < 2000 && ok; ++step)
+    {
+        unsigned action = rng() % 10;
+
+        if (action < 2)
+        {
+            if (0 == eroc_buffer_undo(buffer))
+            {
+                ok = ok && position > 0;
+                --position;
+            }
+            else
+            {
+                ok = ok && 0 == position;
+            }
+
+            ok = ok && history[position] == contents(buffer);
+            continue;
+        }
+        else if (action < 3)
+        {
+            if (0 == eroc_buffer_redo(buffer))
+            {
+                ++position;
+                ok = ok && position < history.size();
+            }
+            else
+            {
+                ok = ok && position + 1 == history.size();
+            }
+
+            ok = ok && position < history.size()
+                 && history[position] == contents(buffer);
+            continue;
+        }
+
+        /* a group of one to three edits. */
+        eroc_buffer_journal_checkpoint(buffer);
+        unsigned edits = 1 + rng() % 3;
+        for (unsigned i = 0; i < edits; ++i)
+        {
+            unsigned long count = buffer->lines->count;
+            unsigned long lineno = (count > 0) ? rng() % count : 0;
+            eroc_buffer_line* line = nullptr;
+            std::string text = "s" + std::to_string(step) + "." +
+                               std::to_string(i);
+
+            if (count > 0)
+            {
+                (void)eroc_buffer_line_at(&line, buffer, lineno);
+            }
+
+            switch ((count > 0) ? rng() % 4 : 0)
+            {
+                case 0:
+                    eroc_buffer_append(buffer, line, make_line(buffer, text));
+                    break;
+
+                case 1:
+                    eroc_buffer_insert(buffer, line, make_line(buffer, text));
+                    break;
+
+                case 2:
+                    eroc_buffer_replace(buffer, line, make_line(buffer, text));
+                    break;
+
+                case 3:
+                    eroc_buffer_line_delete(buffer, line);
+                    break;
+            }
+        }
+
+        history.resize(position + 1);
+        history.push_back(contents(buffer));
+        ++position;
+    }
+
+    TEST_EXPECT(ok);
+
+    /* everything can be undone back to the start. */
+    while (0 == eroc_buffer_undo(buffer))
+    {
+    }
+    TEST_EXPECT(history[0] == contents(buffer));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
@@ -0,0 +1,276 @@
+/**
+ * \file test/lib/test_eroc_buffer_mark.cpp
+ *
+ * \brief Unit tests for marking lines and the global commands.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <vector>
+
+TEST_SUITE(eroc_buffer_mark);
+
+namespace {
+
+/**
+ * \brief Create a buffer holding the given lines.
+ */
+eroc_buffer* make_buffer(const std::vector<std::string>& lines)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (const auto& text : lines)
+    {
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text.data(), text.size()))
+        {
+            eroc_buffer_release(buffer);
+            return nullptr;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+    }
+
+    return buffer;
+}
+
+/**
+ * \brief Get the contents of a buffer.
+ */
+std::vector<std::string> contents(const eroc_buffer* buffer)
+{
+    std::vector<std::string> lines;
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (const eroc_buffer_line*)node;
+        lines.emplace_back(line->line, line->length);
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Get the indices of the marked lines in a buffer.
+ */
+std::vector<size_t> marked(const eroc_buffer* buffer)
+{
+    std::vector<size_t> result;
+    size_t index = 0;
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (const eroc_buffer_line*)node;
+        if (line->flags & EROC_BUFFER_LINE_FLAG_MARKED)
+        {
+            result.push_back(index);
+        }
+        ++index;
+    }
+
+    return result;
+}
+
+/**
+ * \brief Parse and run a command.
+ */
+int run(eroc_buffer* buffer, const char* input)
+{
+    eroc_command* command;
+
+    int retval = eroc_command_parse(&command, buffer, input);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_command_run(command);
+    (void)eroc_command_release(command);
+
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief Matching lines in a range are marked, and inverting marks the rest.
+ */
+TEST(mark_range)
+{
+    eroc_buffer* buffer =
+        make_buffer({"alpha", "beta", "gamma", "delta", "epsilon"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == eroc_buffer_mark(buffer, "l", false, 0, 4, 0));
+    TEST_EXPECT(3 == buffer->marked);
+    TEST_EXPECT((std::vector<size_t>{0, 3, 4}) == marked(buffer));
+
+    /* marking again replaces the previous marks. */
+    TEST_ASSERT(0 == eroc_buffer_mark(buffer, "l", true, 1, 3, 0));
+    TEST_EXPECT(2 == buffer->marked);
+    TEST_EXPECT((std::vector<size_t>{1, 2}) == marked(buffer));
+
+    /* out of range and invalid patterns fail. */
+    TEST_EXPECT(0 != eroc_buffer_mark(buffer, "l", false, 3, 5, 0));
+    TEST_EXPECT(0 != eroc_buffer_mark(buffer, "(l", false, 0, 4, 0));
+    TEST_EXPECT(0 == buffer->marked);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Marking across several workers gives the same marks as one worker.
+ */
+TEST(mark_parallel)
+{
+    std::vector<std::string> lines;
+    std::vector<size_t> expected;
+
+    for (size_t i = 0; i < 200000; ++i)
+    {
+        lines.push_back("line " + std::to_string(i * 7919 % 100003));
+        if (std::string::npos != lines.back().find("42"))
+        {
+            expected.push_back(i);
+        }
+    }
+
+    eroc_buffer* buffer = make_buffer(lines);
+    TEST_ASSERT(nullptr != buffer);
+
+    for (size_t workers : {1, 2, 4, 7})
+    {
+        TEST_ASSERT(
+            0 == eroc_buffer_mark(
+                    buffer, "42", false, 0, lines.size() - 1, workers));
+        TEST_EXPECT(expected.size() == buffer->marked);
+        TEST_EXPECT(expected == marked(buffer));
+    }
+
+    eroc_buffer_mark_clear(buffer);
+    TEST_EXPECT(0 == buffer->marked);
+    TEST_EXPECT(marked(buffer).empty());
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief g/re/d deletes the matching lines, and v/re/d the others.
+ */
+TEST(global_delete)
+{
+    eroc_buffer* buffer =
+        make_buffer({"keep 1", "drop 1", "keep 2", "drop 2", "drop 3"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == run(buffer, "g/drop/d"));
+    TEST_EXPECT(
+        (std::vector<std::string>{"keep 1", "keep 2"}) == contents(buffer));
+    TEST_EXPECT(0 == buffer->marked);
+    TEST_EXPECT(buffer->flags & EROC_BUFFER_FLAG_MODIFIED);
+
+    TEST_ASSERT(0 == run(buffer, "v|1|d"));
+    TEST_EXPECT((std::vector<std::string>{"keep 1"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief An escaped delimiter is part of the pattern.
+ */
+TEST(global_escaped_delimiter)
+{
+    eroc_buffer* buffer = make_buffer({"a/b", "ab", "a/c"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == run(buffer, "g/a\\/b/d"));
+    TEST_EXPECT((std::vector<std::string>{"ab", "a/c"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A substitution skips the marked lines it doesn't change, and fails
+ * only if it changes none of them.
+ */
+TEST(global_substitute)
+{
+    eroc_buffer* buffer = make_buffer({"foo bar", "foo", "foo bar", "baz"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == run(buffer, "g/foo/s/bar/BAZ/"));
+    TEST_EXPECT(
+        (std::vector<std::string>{"foo BAZ", "foo", "foo BAZ", "baz"})
+            == contents(buffer));
+    TEST_EXPECT(0 == buffer->marked);
+
+    TEST_EXPECT(
+        EROC_COMMAND_SUBSTITUTE_NO_MATCH == run(buffer, "g/foo/s/bar/BAZ/"));
+    TEST_EXPECT(
+        (std::vector<std::string>{"foo BAZ", "foo", "foo BAZ", "baz"})
+            == contents(buffer));
+    TEST_EXPECT(0 == buffer->marked);
+
+    /* no marked lines is not an error. */
+    TEST_EXPECT(0 == run(buffer, "g/qux/s/bar/BAZ/"));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Malformed global commands fail without leaving marks.
+ */
+TEST(global_errors)
+{
+    eroc_buffer* buffer = make_buffer({"one", "two"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    /* no delimiter. */
+    TEST_EXPECT(0 != run(buffer, "g"));
+    /* empty pattern. */
+    TEST_EXPECT(0 != run(buffer, "g//d"));
+    /* nested global. */
+    TEST_EXPECT(0 != run(buffer, "g/o/g/o/d"));
+    /* unknown command. */
+    TEST_EXPECT(0 != run(buffer, "g/o/Z"));
+    TEST_EXPECT(0 == buffer->marked);
+    TEST_EXPECT(
+        (std::vector<std::string>{"one", "two"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A nested global is refused even when it has an address.
+ */
+TEST(global_nested_address)
+{
+    eroc_buffer* buffer = make_buffer({"ax", "ay", "bx", "ax2"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_EXPECT(0 != run(buffer, "g/a/.g/x/d"));
+    TEST_EXPECT(0 != run(buffer, "g/a/1g/x/d"));
+    TEST_EXPECT(0 != run(buffer, "g/a/1,$v/x/d"));
+    TEST_EXPECT(0 == buffer->marked);
+    TEST_EXPECT(
+        (std::vector<std::string>{"ax", "ay", "bx", "ax2"})
+            == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
@@ -0,0 +1,393 @@
+/**
+ * \file test/lib/test_eroc_buffer_save.cpp
+ *
+ * \brief Unit tests for saving buffers.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <dirent.h>
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+
+TEST_SUITE(eroc_buffer_save);
+
+namespace {
+
+/**
+ * \brief Create a buffer holding the given lines.
+ */
+eroc_buffer* make_buffer(std::initializer_list<std::string> lines)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (const auto& text : lines)
+    {
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_in(
+                    &line, buffer, text.data(), text.size()))
+        {
+            eroc_buffer_release(buffer);
+            return nullptr;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+    }
+
+    return buffer;
+}
+
+/**
+ * \brief Read a whole file.
+ */
+std::string slurp(const std::string& path)
+{
+    std::string result;
+    FILE* fp = fopen(path.c_str(), "r");
+    char data[4096];
+    size_t size;
+
+    if (nullptr == fp)
+    {
+        return "<missing>";
+    }
+
+    while (0 < (size = fread(data, 1, sizeof(data), fp)))
+    {
+        result.append(data, size);
+    }
+
+    fclose(fp);
+    return result;
+}
+
+/**
+ * \brief Count the entries of a directory, not counting . and ..
+ */
+int entry_count(const std::string& path)
+{
+    DIR* dir = opendir(path.c_str());
+    int count = 0;
+
+    if (nullptr == dir)
+    {
+        return -1;
+    }
+
+    while (struct dirent* entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if ("." != name && ".." != name)
+        {
+            ++count;
+        }
+    }
+
+    closedir(dir);
+    return count;
+}
+
+/**
+ * \brief Make a scratch directory.
+ */
+std::string scratch_dir()
+{
+    char templ[] = "/tmp/eroc_save_XXXXXX";
+
+    return (nullptr != mkdtemp(templ)) ? templ : "";
+}
+
+/**
+ * \brief Parse and run a command, reading any text that it takes from the
+ * given input.
+ */
+int run(eroc_buffer* buffer, const char* text, const std::string& input)
+{
+    eroc_command* command;
+    FILE* fp = fmemopen((void*)input.data(), input.size(), "r");
+
+    if (nullptr == fp)
+    {
+        return -1;
+    }
+
+    int retval = eroc_command_parse(&command, buffer, text);
+    if (0 == retval)
+    {
+        command->input = fp;
+        retval = eroc_command_run(command);
+        (void)eroc_command_release(command);
+    }
+
+    fclose(fp);
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief Saving replaces the file, keeps its permissions, and leaves no
+ * temporary file behind.
+ */
+TEST(replace)
+{
+    std::string dir = scratch_dir();
+    std::string path = dir + "/file.txt";
+    eroc_buffer* buffer = make_buffer({"one", "", "three"});
+    size_t size = 0;
+    struct stat st;
+
+    TEST_ASSERT(!dir.empty());
+    TEST_ASSERT(nullptr != buffer);
+
+    FILE* fp = fopen(path.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fputs("old contents\n", fp);
+    fclose(fp);
+    TEST_ASSERT(0 == chmod(path.c_str(), 0640));
+
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT(11 == size);
+    TEST_EXPECT("one\n\nthree\n" == slurp(path));
+    TEST_ASSERT(0 == stat(path.c_str(), &st));
+    TEST_EXPECT(0640 == (st.st_mode & 07777));
+    TEST_EXPECT(1 == entry_count(dir));
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Saving through a symbolic link replaces the file that it names, not
+ * the link.
+ */
+TEST(symlink)
+{
+    std::string dir = scratch_dir();
+    std::string target = dir + "/target.txt";
+    std::string link = dir + "/link.txt";
+    eroc_buffer* buffer = make_buffer({"new"});
+    size_t size = 0;
+    struct stat st;
+
+    TEST_ASSERT(!dir.empty());
+    TEST_ASSERT(nullptr != buffer);
+
+    FILE* fp = fopen(target.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fclose(fp);
+    TEST_ASSERT(0 == ::symlink("target.txt", link.c_str()));
+
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, link.c_str()));
+    TEST_EXPECT("new\n" == slurp(target));
+    TEST_ASSERT(0 == lstat(link.c_str(), &st));
+    TEST_EXPECT(S_ISLNK(st.st_mode));
+
+    unlink(link.c_str());
+    unlink(target.c_str());
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Saving through a symbolic link whose target doesn't exist yet creates
+ * the target.
+ */
+TEST(dangling_symlink)
+{
+    std::string dir = scratch_dir();
+    std::string target = dir + "/target.txt";
+    std::string link = dir + "/link.txt";
+    eroc_buffer* buffer = make_buffer({"new"});
+    size_t size = 0;
+    struct stat st;
+
+    TEST_ASSERT(!dir.empty());
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == ::symlink("target.txt", link.c_str()));
+
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, link.c_str()));
+    TEST_EXPECT("new\n" == slurp(target));
+    TEST_ASSERT(0 == lstat(link.c_str(), &st));
+    TEST_EXPECT(S_ISLNK(st.st_mode));
+    TEST_EXPECT(2 == entry_count(dir));
+
+    unlink(link.c_str());
+    unlink(target.c_str());
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Saving a file with another hard link writes it in place, so that the
+ * links still share the new contents.
+ */
+TEST(hard_link)
+{
+    std::string dir = scratch_dir();
+    std::string path = dir + "/file.txt";
+    std::string other = dir + "/other.txt";
+    eroc_buffer* buffer = make_buffer({"new"});
+    size_t size = 0;
+    struct stat before, after;
+
+    TEST_ASSERT(!dir.empty());
+    TEST_ASSERT(nullptr != buffer);
+
+    FILE* fp = fopen(path.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fputs("old contents\n", fp);
+    fclose(fp);
+    TEST_ASSERT(0 == ::link(path.c_str(), other.c_str()));
+    TEST_ASSERT(0 == stat(path.c_str(), &before));
+
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT("new\n" == slurp(path));
+    TEST_EXPECT("new\n" == slurp(other));
+    TEST_ASSERT(0 == stat(path.c_str(), &after));
+    TEST_EXPECT(before.st_ino == after.st_ino);
+    TEST_EXPECT(2 == after.st_nlink);
+    TEST_EXPECT(2 == entry_count(dir));
+
+    unlink(other.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Saving a mapped file with another hard link over itself, in place,
+ * keeps the lines that were borrowed from it, whether it shrinks or grows.
+ */
+TEST(hard_link_mapped)
+{
+    std::string dir = scratch_dir();
+    std::string path = dir + "/file.txt";
+    std::string other = dir + "/other.txt";
+    std::string text, tail;
+    eroc_buffer* buffer;
+    size_t size = 0;
+
+    TEST_ASSERT(!dir.empty());
+
+    /* enough lines that the saved file ends pages before the mapping. */
+    for (int i = 0; i < 3000; ++i)
+    {
+        std::string line = "line " + std::to_string(i) + " x\n";
+        text += line;
+        if (i >= 2000)
+        {
+            tail += line;
+        }
+    }
+
+    FILE* fp = fopen(path.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fputs(text.c_str(), fp);
+    fclose(fp);
+    TEST_ASSERT(0 == ::link(path.c_str(), other.c_str()));
+
+    /* shrink the file under the borrowed lines. */
+    TEST_ASSERT(0 == eroc_buffer_load_mapped(&buffer, &size, path.c_str()));
+    TEST_ASSERT(nullptr != buffer->map.data);
+    TEST_ASSERT(0 == run(buffer, "1,2000d", ""));
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT(tail == slurp(other));
+    TEST_ASSERT(0 == run(buffer, "$s/x/y/", ""));
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT(
+        tail.substr(0, tail.size() - 2) + "y\n" == slurp(other));
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* grow it, which overwrites lines not yet written. */
+    fp = fopen(path.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fputs(text.c_str(), fp);
+    fclose(fp);
+    TEST_ASSERT(0 == eroc_buffer_load_mapped(&buffer, &size, path.c_str()));
+    TEST_ASSERT(0 == run(buffer, "1i", "head\n.\n"));
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT("head\n" + text == slurp(other));
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* a lazily loaded buffer writes its pieces over their own text. */
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT("head\n" + text == slurp(other));
+    TEST_ASSERT(0 == run(buffer, "1p", ""));
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    unlink(other.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief A save that can't be done reports failure and changes nothing.
+ */
+TEST(failure)
+{
+    std::string dir = scratch_dir();
+    eroc_buffer* buffer = make_buffer({"x"});
+    size_t size = 0;
+
+    TEST_ASSERT(!dir.empty());
+    TEST_ASSERT(nullptr != buffer);
+
+    std::string missing = dir + "/no/such/dir/file.txt";
+    TEST_EXPECT(0 != eroc_buffer_save(buffer, &size, missing.c_str()));
+    TEST_EXPECT(0 == size);
+    TEST_EXPECT(0 == entry_count(dir));
+
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Lines keep embedded NULs from load, through typed input and
+ * substitution, to save.
+ */
+TEST(embedded_nul)
+{
+    std::string dir = scratch_dir();
+    std::string path = dir + "/file.txt";
+    const std::string original("a\0b\nc\n", 6);
+    eroc_buffer* buffer;
+    size_t size = 0;
+
+    TEST_ASSERT(!dir.empty());
+
+    FILE* fp = fopen(path.c_str(), "w");
+    TEST_ASSERT(nullptr != fp);
+    fwrite(original.data(), 1, original.size(), fp);
+    fclose(fp);
+
+    TEST_ASSERT(0 == eroc_buffer_load_mapped(&buffer, &size, path.c_str()));
+    TEST_EXPECT(6 == size);
+
+    TEST_ASSERT(0 == run(buffer, "1a", std::string("x\0y\n.\n", 6)));
+    TEST_ASSERT(0 == run(buffer, "1s/b/B/", ""));
+    TEST_ASSERT(0 == run(buffer, "2i", std::string("\0\n.\n", 4)));
+
+    TEST_ASSERT(0 == eroc_buffer_save(buffer, &size, path.c_str()));
+    TEST_EXPECT(std::string("a\0B\n\0\nx\0y\nc\n", 12) == slurp(path));
+    TEST_EXPECT(12 == size);
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
@@ -0,0 +1,262 @@
+/**
+ * \file test/lib/test_eroc_command_parse.cpp
+ *
+ * \brief Unit tests for command parsing.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <vector>
+
+TEST_SUITE(eroc_command_parse);
+
+namespace {
+
+/**
+ * \brief Create a buffer of the given number of lines, with the cursor on the
+ * given zero-indexed line.
+ */
+eroc_buffer* make_buffer(size_t count, unsigned long lineno)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string text = std::to_string(i + 1);
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text.data(), text.size()))
+        {
+            eroc_buffer_release(buffer);
+            return nullptr;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+    }
+
+    if (count > 0 && 0 != eroc_buffer_cursor_move(buffer, lineno))
+    {
+        eroc_buffer_release(buffer);
+        return nullptr;
+    }
+
+    return buffer;
+}
+
+/**
+ * \brief The range that a command parsed to.
+ */
+struct range
+{
+    int retval;
+    bool start_provided;
+    bool end_provided;
+    unsigned long start;
+    unsigned long end;
+    eroc_command_fn command_fn;
+
+    bool operator==(const range&) const = default;
+};
+
+/**
+ * \brief Parse a command and return its range.
+ */
+range parse(eroc_buffer* buffer, const char* input)
+{
+    eroc_command* command;
+    range result = {};
+
+    result.retval = eroc_command_parse(&command, buffer, input);
+    if (0 != result.retval)
+    {
+        return result;
+    }
+
+    result.start_provided = command->start_provided;
+    result.end_provided = command->end_provided;
+    result.start = command->start_provided ? command->start : 0;
+    result.end = command->end_provided ? command->end : 0;
+    result.command_fn = command->command_fn;
+    (void)eroc_command_release(command);
+
+    return result;
+}
+
+/**
+ * \brief A print command with a single zero-indexed line.
+ */
+range print_line(unsigned long start)
+{
+    return range{0, true, false, start, 0, &eroc_command_function_print};
+}
+
+/**
+ * \brief A print command with a zero-indexed range.
+ */
+range print_range(unsigned long start, unsigned long end)
+{
+    return range{0, true, true, start, end, &eroc_command_function_print};
+}
+
+} /* namespace */
+
+/**
+ * \brief Single addresses are line numbers, . or $, with offsets.
+ */
+TEST(single_addresses)
+{
+    eroc_buffer* buffer = make_buffer(10, 4);
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_EXPECT(print_line(2) == parse(buffer, "3p"));
+    TEST_EXPECT(print_line(4) == parse(buffer, ".p"));
+    TEST_EXPECT(print_line(9) == parse(buffer, "$p"));
+    TEST_EXPECT(print_line(8) == parse(buffer, "$-1p"));
+    TEST_EXPECT(print_line(6) == parse(buffer, "+2p"));
+    TEST_EXPECT(print_line(3) == parse(buffer, "-p"));
+    TEST_EXPECT(print_line(6) == parse(buffer, ".++p"));
+    TEST_EXPECT(print_line(4) == parse(buffer, "3+3-1p"));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Ranges are two addresses separated by , or ;, either of which may be
+ * omitted.
+ */
+TEST(ranges)
+{
+    eroc_buffer* buffer = make_buffer(10, 4);
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_EXPECT(print_range(1, 3) == parse(buffer, "2,4p"));
+    TEST_EXPECT(print_range(0, 9) == parse(buffer, ",p"));
+    TEST_EXPECT(print_range(0, 9) == parse(buffer, "%p"));
+    TEST_EXPECT(print_range(4, 9) == parse(buffer, ";p"));
+    TEST_EXPECT(print_range(0, 2) == parse(buffer, ",3p"));
+    TEST_EXPECT(print_range(2, 2) == parse(buffer, "3,p"));
+    TEST_EXPECT(print_range(4, 6) == parse(buffer, ".,+2p"));
+    TEST_EXPECT(print_range(4, 7) == parse(buffer, " -0 , $-2 p"));
+
+    /* with ;, the second address is relative to the first. */
+    TEST_EXPECT(print_range(1, 3) == parse(buffer, "2;+2p"));
+    TEST_EXPECT(print_range(1, 6) == parse(buffer, "2,+2p"));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Addresses outside of the buffer, and backward ranges, are errors.
+ */
+TEST(errors)
+{
+    eroc_buffer* buffer = make_buffer(10, 4);
+    eroc_buffer* empty = make_buffer(0, 0);
+
+    TEST_ASSERT(nullptr != buffer);
+    TEST_ASSERT(nullptr != empty);
+
+    TEST_EXPECT(0 != parse(buffer, "0p").retval);
+    TEST_EXPECT(0 != parse(buffer, "11p").retval);
+    TEST_EXPECT(0 != parse(buffer, "$+1p").retval);
+    TEST_EXPECT(0 != parse(buffer, "-5p").retval);
+    TEST_EXPECT(0 != parse(buffer, "4,2p").retval);
+    TEST_EXPECT(0 != parse(buffer, "99999999999999999999999p").retval);
+    TEST_EXPECT(0 != parse(buffer, "2%p").retval);
+    TEST_EXPECT(0 != parse(empty, ",p").retval);
+    TEST_EXPECT(0 != parse(empty, "$p").retval);
+
+    eroc_buffer_release(empty);
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief An address alone moves to the last line addressed, and no address at
+ * all advances.
+ */
+TEST(address_alone)
+{
+    eroc_buffer* buffer = make_buffer(10, 4);
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_EXPECT(
+        (range{0, true, false, 6, 0, &eroc_command_function_move})
+            == parse(buffer, "7"));
+    TEST_EXPECT(
+        (range{0, true, false, 5, 0, &eroc_command_function_move})
+            == parse(buffer, "2,6"));
+    TEST_EXPECT(
+        (range{0, false, false, 0, 0, &eroc_command_function_advance})
+            == parse(buffer, ""));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A ranged delete removes the whole range in one command.
+ */
+TEST(ranged_delete)
+{
+    eroc_buffer* buffer = make_buffer(10, 0);
+    eroc_command* command;
+    std::vector<std::string> lines;
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == eroc_command_parse(&command, buffer, "2,9d"));
+    TEST_ASSERT(0 == eroc_command_run(command));
+    (void)eroc_command_release(command);
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (const eroc_buffer_line*)node;
+        lines.emplace_back(line->line, line->length);
+    }
+
+    TEST_EXPECT((std::vector<std::string>{"1", "10"}) == lines);
+    TEST_EXPECT(2 == buffer->index->count);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Relative moves walk from the cursor, the head, or the tail, and land
+ * on the same line that the index finds.
+ */
+TEST(relative_moves)
+{
+    eroc_buffer* buffer = make_buffer(1000, 500);
+    eroc_command* command;
+
+    TEST_ASSERT(nullptr != buffer);
+
+    const char* moves[] = {
+        "+5", "-3", "$", "-1", "1", "+2", "500", "+100", "-64", "-65", ".",
+    };
+    for (const char* move : moves)
+    {
+        TEST_ASSERT(0 == eroc_command_parse(&command, buffer, move));
+        TEST_ASSERT(0 == eroc_command_run(command));
+        (void)eroc_command_release(command);
+
+        eroc_buffer_line* line;
+        TEST_ASSERT(0 == eroc_buffer_line_at(&line, buffer, buffer->lineno));
+        TEST_EXPECT(line == buffer->cursor);
+    }
+
+    TEST_EXPECT(470 == buffer->lineno);
+
+    eroc_buffer_release(buffer);
+}
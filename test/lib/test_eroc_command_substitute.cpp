@@ -0,0 +1,234 @@
+/**
+ * \file test/lib/test_eroc_command_substitute.cpp
+ *
+ * \brief Unit tests for the substitute command.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <vector>
+
+TEST_SUITE(eroc_command_substitute);
+
+namespace {
+
+/**
+ * \brief Create a buffer holding the given lines.
+ */
+eroc_buffer* make_buffer(const std::vector<std::string>& lines)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (const auto& text : lines)
+    {
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text.data(), text.size()))
+        {
+            eroc_buffer_release(buffer);
+            return nullptr;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+    }
+
+    return buffer;
+}
+
+/**
+ * \brief Get the contents of a buffer.
+ */
+std::vector<std::string> contents(const eroc_buffer* buffer)
+{
+    std::vector<std::string> lines;
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (const eroc_buffer_line*)node;
+        lines.emplace_back(line->line, line->length);
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Parse and run a command.
+ */
+int run(eroc_buffer* buffer, const char* input)
+{
+    eroc_command* command;
+
+    int retval = eroc_command_parse(&command, buffer, input);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_command_run(command);
+    (void)eroc_command_release(command);
+
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief s substitutes on the current line only.
+ */
+TEST(current_line)
+{
+    eroc_buffer* buffer = make_buffer({"foo foo", "foo foo"});
+
+    TEST_ASSERT(nullptr != buffer);
+    buffer->cursor = (eroc_buffer_line*)buffer->lines->head;
+    buffer->lineno = 0;
+
+    TEST_ASSERT(0 == run(buffer, "s/foo/bar/"));
+    TEST_EXPECT(
+        (std::vector<std::string>{"bar foo", "foo foo"}) == contents(buffer));
+    TEST_EXPECT(buffer->flags & EROC_BUFFER_FLAG_MODIFIED);
+
+    TEST_ASSERT(0 == run(buffer, "s,foo,b\\,z,g"));
+    TEST_EXPECT(
+        (std::vector<std::string>{"bar b,z", "foo foo"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A range substitutes on every line, leaving the cursor on the last
+ * line changed.
+ */
+TEST(range)
+{
+    eroc_buffer* buffer = make_buffer({"a1", "b2", "a3", "b4"});
+    eroc_command command = {};
+    char parameters[] = "/a(.)/<\\1>/";
+
+    TEST_ASSERT(nullptr != buffer);
+
+    command.buffer = buffer;
+    command.start = 0;
+    command.end = 3;
+    command.start_provided = command.end_provided = true;
+    command.parameters = parameters;
+
+    TEST_ASSERT(0 == eroc_command_function_substitute(&command));
+    TEST_EXPECT(
+        (std::vector<std::string>{"<1>", "b2", "<3>", "b4"})
+            == contents(buffer));
+    TEST_EXPECT(2 == buffer->lineno);
+    TEST_EXPECT(
+        buffer->cursor == (eroc_buffer_line*)buffer->lines->head->next->next);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief It is an error if nothing matches, or the command is malformed.
+ */
+TEST(errors)
+{
+    eroc_buffer* buffer = make_buffer({"abc"});
+
+    TEST_ASSERT(nullptr != buffer);
+    buffer->cursor = (eroc_buffer_line*)buffer->lines->head;
+    buffer->lineno = 0;
+
+    TEST_EXPECT(0 != run(buffer, "s/x/y/"));
+    TEST_EXPECT(0 != run(buffer, "s/a/y/q"));
+    TEST_EXPECT(0 != run(buffer, "s/a/y/0"));
+    TEST_EXPECT(0 != run(buffer, "s a y "));
+    TEST_EXPECT(0 != run(buffer, "s/(a/y/"));
+    TEST_EXPECT((std::vector<std::string>{"abc"}) == contents(buffer));
+    TEST_EXPECT(!(buffer->flags & EROC_BUFFER_FLAG_MODIFIED));
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A result which fits the line's capacity is written in place, and a
+ * longer one grows the line.
+ */
+TEST(in_place)
+{
+    eroc_buffer* buffer = make_buffer({"hello world"});
+    eroc_buffer_line* line;
+
+    TEST_ASSERT(nullptr != buffer);
+    line = (eroc_buffer_line*)buffer->lines->head;
+    buffer->cursor = line;
+    buffer->lineno = 0;
+
+    const char* text = line->line;
+    TEST_ASSERT(0 == run(buffer, "s/world/all/"));
+    TEST_EXPECT(text == line->line);
+    TEST_EXPECT(std::string("hello all") == line->line);
+    TEST_EXPECT(9 == line->length);
+    TEST_EXPECT(11 == line->capacity);
+
+    TEST_ASSERT(0 == run(buffer, "s/all/everyone/"));
+    TEST_EXPECT(std::string("hello everyone") == line->line);
+    TEST_EXPECT(14 == line->length);
+    TEST_EXPECT(line->capacity >= 14);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief Substituting on a borrowed line gives it its own copy.
+ */
+TEST(borrowed)
+{
+    const char text[] = "abcabc";
+    eroc_buffer* buffer;
+    eroc_buffer_line* line;
+
+    TEST_ASSERT(0 == eroc_buffer_create(&buffer));
+    TEST_ASSERT(0 == eroc_buffer_line_create_borrowed(&line, text, 6));
+    TEST_EXPECT(0 == line->capacity);
+    eroc_buffer_append(buffer, nullptr, line);
+    buffer->cursor = line;
+    buffer->lineno = 0;
+
+    TEST_ASSERT(0 == run(buffer, "s/b/B/g"));
+    TEST_EXPECT(!(line->flags & EROC_BUFFER_LINE_FLAG_BORROWED));
+    TEST_EXPECT(std::string("aBcaBc") == line->line);
+    TEST_EXPECT(std::string("abcabc") == text);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A substitution that empties a line works with and without undo, and
+ * can be undone.
+ */
+TEST(empty_result)
+{
+    eroc_buffer* buffer = make_buffer({"ab", "ab"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == run(buffer, "1s/ab//"));
+    TEST_EXPECT((std::vector<std::string>{"", "ab"}) == contents(buffer));
+
+    TEST_ASSERT(
+        0 == eroc_buffer_journal_create(
+                buffer, EROC_BUFFER_JOURNAL_DEFAULT_LIMIT));
+    TEST_ASSERT(0 == run(buffer, "2s/ab//"));
+    TEST_EXPECT((std::vector<std::string>{"", ""}) == contents(buffer));
+
+    TEST_ASSERT(0 == run(buffer, "u"));
+    TEST_EXPECT((std::vector<std::string>{"", "ab"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+}
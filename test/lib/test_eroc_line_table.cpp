@@ -0,0 +1,134 @@
+/**
+ * \file test/lib/test_eroc_line_table.cpp
+ *
+ * \brief Unit tests for eroc_line_table.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/linetable.h>
+#include <minunit/minunit.h>
+#include <stdlib.h>
+#include <string.h>
+
+TEST_SUITE(eroc_line_table);
+
+/**
+ * \brief We should be able to create and release a line table.
+ */
+TEST(create_release)
+{
+    eroc_line_table* table;
+
+    /* we can create the table. */
+    TEST_ASSERT(0 == eroc_line_table_create(&table));
+
+    /* the table starts empty. */
+    TEST_EXPECT(0 == table->count);
+    TEST_EXPECT(0 == table->crlf_count);
+
+    /* we can release the table. */
+    eroc_line_table_release(table);
+}
+
+/**
+ * \brief Scanning data with no newlines produces an empty table.
+ */
+TEST(scan_no_newlines)
+{
+    eroc_line_table* table;
+    const char* INPUT = "no newlines in this line, which is longer than 32.";
+
+    TEST_ASSERT(0 == eroc_line_table_create(&table));
+
+    TEST_ASSERT(0 == eroc_line_table_scan(table, INPUT, strlen(INPUT)));
+    TEST_EXPECT(0 == table->count);
+
+    /* an empty block is also fine. */
+    TEST_ASSERT(0 == eroc_line_table_scan(table, INPUT, 0));
+    TEST_EXPECT(0 == table->count);
+
+    eroc_line_table_release(table);
+}
+
+/**
+ * \brief Scanning finds every newline, including newlines on either side of a
+ * vector boundary, and counts CRLF pairs.
+ */
+TEST(scan_newlines_and_crlf)
+{
+    eroc_line_table* table;
+    char input[100];
+
+    /* newlines at 0, 15, 16, 31, 32, 63, and 99; CR before 31 and 63. */
+    memset(input, 'x', sizeof(input));
+    input[0] = input[15] = input[16] = input[31] = input[32] = '\n';
+    input[63] = input[99] = '\n';
+    input[30] = input[62] = '\r';
+
+    TEST_ASSERT(0 == eroc_line_table_create(&table));
+    TEST_ASSERT(0 == eroc_line_table_scan(table, input, sizeof(input)));
+
+    size_t EXPECTED[] = { 0, 15, 16, 31, 32, 63, 99 };
+    TEST_ASSERT(7 == table->count);
+    for (size_t i = 0; i < 7; ++i)
+    {
+        TEST_EXPECT(EXPECTED[i] == table->newlines[i]);
+    }
+
+    TEST_EXPECT(2 == table->crlf_count);
+
+    /* a rescan replaces the previous contents. */
+    TEST_ASSERT(0 == eroc_line_table_scan(table, input + 1, 15));
+    TEST_EXPECT(1 == table->count);
+    TEST_EXPECT(14 == table->newlines[0]);
+    TEST_EXPECT(0 == table->crlf_count);
+
+    eroc_line_table_release(table);
+}
+
+/**
+ * \brief The vectorized scan matches the scalar scan on random data, across
+ * many sizes and alignments, growing the table as needed.
+ */
+TEST(scan_matches_scalar)
+{
+    eroc_line_table* table;
+    eroc_line_table* scalar;
+    const size_t SIZE = 64 * 1024;
+    char* input = (char*)malloc(SIZE);
+
+    TEST_ASSERT(NULL != input);
+    TEST_ASSERT(0 == eroc_line_table_create(&table));
+    TEST_ASSERT(0 == eroc_line_table_create(&scalar));
+
+    /* roughly one newline in eight, and one CR in sixteen. */
+    srand(42);
+    for (size_t i = 0; i < SIZE; ++i)
+    {
+        int r = rand() % 16;
+        input[i] = (r < 2) ? '\n' : (r == 2) ? '\r' : 'a' + r;
+    }
+
+    for (size_t offset = 0; offset < 33; ++offset)
+    {
+        size_t size = SIZE - offset - (rand() % 64);
+
+        TEST_ASSERT(0 == eroc_line_table_scan(table, input + offset, size));
+        TEST_ASSERT(
+            0 == eroc_line_table_scan_scalar(scalar, input + offset, size));
+
+        TEST_ASSERT(scalar->count == table->count);
+        TEST_EXPECT(scalar->crlf_count == table->crlf_count);
+        TEST_EXPECT(
+            0
+                == memcmp(
+                        scalar->newlines, table->newlines,
+                        table->count * sizeof(size_t)));
+    }
+
+    eroc_line_table_release(table);
+    eroc_line_table_release(scalar);
+    free(input);
+}
@@ -1020,3 +1020,52 @@ TEST(abc_delete_beginnings)
     /* we can release the list. */
     TEST_ASSERT(0 == eroc_list_release(list));
 }
+
+/**
+ * \brief Seeking finds every node from every starting node, and node_at finds
+ * every node from the head or the tail.
+ */
+TEST(node_seek)
+{
+    eroc_list* list;
+    eroc_list_node* nodes[9];
+    eroc_list_node* node;
+
+    /* we can create the list. */
+    TEST_ASSERT(0 == eroc_list_create(&list, &test_node_release));
+
+    /* we can append nine nodes. */
+    for (int i = 0; i < 9; ++i)
+    {
+        TEST_ASSERT(0 == test_node_create(&nodes[i]));
+        eroc_list_append(list, nodes[i]);
+    }
+
+    for (unsigned long i = 0; i < 9; ++i)
+    {
+        /* node_at finds the node. */
+        node = NULL;
+        TEST_ASSERT(0 == eroc_list_node_at(&node, list, i));
+        TEST_EXPECT(nodes[i] == node);
+
+        /* seeking without a starting node finds the node. */
+        node = NULL;
+        TEST_ASSERT(0 == eroc_list_node_seek(&node, list, NULL, 0, i));
+        TEST_EXPECT(nodes[i] == node);
+
+        /* seeking from any node finds the node. */
+        for (unsigned long j = 0; j < 9; ++j)
+        {
+            node = NULL;
+            TEST_ASSERT(0 == eroc_list_node_seek(&node, list, nodes[j], j, i));
+            TEST_EXPECT(nodes[i] == node);
+        }
+    }
+
+    /* indices past the end fail. */
+    TEST_EXPECT(0 != eroc_list_node_at(&node, list, 9));
+    TEST_EXPECT(0 != eroc_list_node_seek(&node, list, nodes[8], 8, 9));
+
+    /* we can release the list. */
+    TEST_ASSERT(0 == eroc_list_release(list));
+}
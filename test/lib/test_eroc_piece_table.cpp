@@ -0,0 +1,651 @@
+/**
+ * \file test/lib/test_eroc_piece_table.cpp
+ *
+ * \brief Unit tests for the piece table and piece table buffers.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <eroc/buffer.h>
+#include <eroc/command.h>
+#include <eroc/piecetable.h>
+#include <eroc/writer.h>
+#include <minunit/minunit.h>
+#include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+TEST_SUITE(eroc_piece_table);
+
+namespace {
+
+/**
+ * \brief Get every line of a piece table.
+ */
+std::vector<std::string> contents(eroc_piece_table* table)
+{
+    std::vector<std::string> lines;
+
+    for (size_t i = 0; i < table->lines; ++i)
+    {
+        const char* text;
+        size_t length;
+
+        if (0 != eroc_piece_table_line(&text, &length, table, i))
+        {
+            break;
+        }
+
+        lines.emplace_back(text, length);
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Write a piece table to a string.
+ */
+std::string written(const eroc_piece_table* table)
+{
+    FILE* fp = tmpfile();
+    eroc_writer* writer;
+    std::string result;
+    char data[4096];
+    size_t read_size;
+
+    if (nullptr == fp)
+    {
+        return "";
+    }
+
+    if (0 != eroc_writer_create(&writer, fileno(fp)))
+    {
+        fclose(fp);
+        return "";
+    }
+
+    int retval = eroc_piece_table_write(writer, table);
+    if (0 == retval)
+    {
+        retval = eroc_writer_flush(writer);
+    }
+
+    size_t size = writer->written;
+    eroc_writer_release(writer);
+
+    rewind(fp);
+    while (0 < (read_size = fread(data, 1, sizeof(data), fp)))
+    {
+        result.append(data, read_size);
+    }
+    fclose(fp);
+
+    return (0 == retval && size == result.size()) ? result : "<error>";
+}
+
+/**
+ * \brief Join lines with newlines.
+ */
+std::string joined(const std::vector<std::string>& lines)
+{
+    std::string text;
+
+    for (const auto& line : lines)
+    {
+        text += line;
+        text += '\n';
+    }
+
+    return text;
+}
+
+/**
+ * \brief Create a piece table buffer over the given text, which must outlive
+ * the buffer.
+ */
+eroc_buffer* make_buffer(const std::string& text)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    if (0 != eroc_piece_table_create(
+                &buffer->pieces, text.data(), text.size()))
+    {
+        eroc_buffer_release(buffer);
+        return nullptr;
+    }
+
+    eroc_buffer_cursor_move_tail(buffer);
+
+    return buffer;
+}
+
+/**
+ * \brief Make a heap line holding the given text.
+ */
+eroc_buffer_line* make_line(const std::string& text)
+{
+    eroc_buffer_line* line;
+
+    if (0 != eroc_buffer_line_create_copy(&line, text.data(), text.size()))
+    {
+        return nullptr;
+    }
+
+    return line;
+}
+
+/**
+ * \brief Check the line totals of a subtree of pieces, returning the number of
+ * lines in the subtree, or SIZE_MAX if a total is wrong.
+ */
+size_t checked_lines(const eroc_avl_tree_node* node)
+{
+    if (nullptr == node)
+    {
+        return 0;
+    }
+
+    size_t left = checked_lines(node->left);
+    size_t right = checked_lines(node->right);
+    if (SIZE_MAX == left || SIZE_MAX == right)
+    {
+        return SIZE_MAX;
+    }
+
+    const eroc_piece* piece = (const eroc_piece*)node;
+    size_t total = left + right + piece->lines;
+
+    return (total == piece->subtree_lines) ? total : SIZE_MAX;
+}
+
+/**
+ * \brief Generate the given number of numbered lines.
+ */
+std::vector<std::string> numbered(size_t count)
+{
+    std::vector<std::string> lines;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        lines.push_back("line " + std::to_string(i));
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Write the given text to a new temporary file, returning its path.
+ */
+std::string scratch_file(const std::string& text)
+{
+    char templ[] = "/tmp/eroc_pieces_XXXXXX";
+    int fd = mkstemp(templ);
+
+    if (fd < 0)
+    {
+        return "";
+    }
+
+    bool ok = (ssize_t)text.size() == write(fd, text.data(), text.size());
+    close(fd);
+
+    return ok ? templ : "";
+}
+
+/**
+ * \brief Parse and run a command.
+ */
+int run(eroc_buffer* buffer, const char* input)
+{
+    eroc_command* command;
+
+    int retval = eroc_command_parse(&command, buffer, input);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    retval = eroc_command_run(command);
+    (void)eroc_command_release(command);
+
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief The original text is split into lines, and an unterminated last line
+ * goes to the add buffer.
+ */
+TEST(create)
+{
+    std::string text = "one\ntwo\n\nfour";
+    eroc_piece_table* table;
+
+    TEST_ASSERT(0 == eroc_piece_table_create(&table, text.data(), text.size()));
+
+    TEST_EXPECT(4 == table->lines);
+    TEST_EXPECT(
+        (std::vector<std::string>{"one", "two", "", "four"})
+            == contents(table));
+    TEST_EXPECT(1 == table->added_count);
+    TEST_EXPECT(text + "\n" == written(table));
+
+    const char* line;
+    size_t length;
+    TEST_EXPECT(0 != eroc_piece_table_line(&line, &length, table, 4));
+
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief An empty text has no lines.
+ */
+TEST(create_empty)
+{
+    eroc_piece_table* table;
+
+    TEST_ASSERT(0 == eroc_piece_table_create(&table, nullptr, 0));
+    TEST_EXPECT(0 == table->lines);
+    TEST_EXPECT("" == written(table));
+
+    TEST_ASSERT(0 == eroc_piece_table_insert(table, 0, "x", 1));
+    TEST_EXPECT("x\n" == written(table));
+
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief Lines are found through the checkpoints, on either side of a stride
+ * boundary.
+ */
+TEST(line_lookup)
+{
+    std::vector<std::string> lines = numbered(5 * EROC_PIECE_TABLE_STRIDE + 3);
+    std::string text = joined(lines);
+    eroc_piece_table* table;
+
+    TEST_ASSERT(0 == eroc_piece_table_create(&table, text.data(), text.size()));
+    TEST_EXPECT(6 == table->checkpoint_count);
+    TEST_EXPECT(lines == contents(table));
+
+    /* out of order lookups start from the previous lookup. */
+    const char* line;
+    size_t length;
+    TEST_ASSERT(0 == eroc_piece_table_line(&line, &length, table, 200));
+    TEST_EXPECT("line 200" == std::string(line, length));
+    TEST_ASSERT(0 == eroc_piece_table_line(&line, &length, table, 63));
+    TEST_EXPECT("line 63" == std::string(line, length));
+
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief Inserts and deletes split and trim pieces without touching the
+ * original text.
+ */
+TEST(edit)
+{
+    std::string text = "a\nb\nc\nd\ne\n";
+    std::string saved = text;
+    eroc_piece_table* table;
+
+    TEST_ASSERT(0 == eroc_piece_table_create(&table, text.data(), text.size()));
+
+    /* insert into the middle of the only piece. */
+    TEST_ASSERT(0 == eroc_piece_table_insert(table, 2, "x", 1));
+    TEST_EXPECT(3 == table->pieces->count);
+
+    /* a line inserted after the last added line extends its piece. */
+    TEST_ASSERT(0 == eroc_piece_table_insert(table, 3, "y", 1));
+    TEST_EXPECT(3 == table->pieces->count);
+
+    TEST_ASSERT(0 == eroc_piece_table_delete(table, 0));
+    TEST_ASSERT(0 == eroc_piece_table_delete(table, table->lines - 1));
+    TEST_ASSERT(0 == eroc_piece_table_delete(table, 4));
+    TEST_EXPECT(
+        (std::vector<std::string>{"b", "x", "y", "c"}) == contents(table));
+    TEST_EXPECT("b\nx\ny\nc\n" == written(table));
+    TEST_EXPECT(saved == text);
+
+    /* deleting a whole piece removes it. */
+    TEST_ASSERT(0 == eroc_piece_table_delete(table, 0));
+    TEST_EXPECT(2 == table->pieces->count);
+    TEST_EXPECT(0 != eroc_piece_table_delete(table, 3));
+    TEST_EXPECT(0 != eroc_piece_table_insert(table, 4, "z", 1));
+
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief The buffer API edits a piece table buffer through its cursor.
+ */
+TEST(buffer_api)
+{
+    std::string text = "one\ntwo\nthree\n";
+    eroc_buffer* buffer = make_buffer(text);
+
+    TEST_ASSERT(nullptr != buffer);
+    TEST_EXPECT(3 == eroc_buffer_line_count(buffer));
+    TEST_EXPECT(0 == buffer->lines->count);
+
+    /* the cursor is the view of the last line. */
+    TEST_ASSERT(&buffer->view == buffer->cursor);
+    TEST_EXPECT(2 == buffer->lineno);
+    TEST_EXPECT(
+        "three" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    /* appending after the cursor leaves the cursor on its line. */
+    TEST_ASSERT(
+        0 == eroc_buffer_append(buffer, buffer->cursor, make_line("four")));
+    TEST_EXPECT(2 == buffer->lineno);
+
+    /* inserting before the cursor moves the cursor's line down. */
+    TEST_ASSERT(0 == eroc_buffer_cursor_move(buffer, 1));
+    TEST_ASSERT(
+        0 == eroc_buffer_insert(buffer, buffer->cursor, make_line("1.5")));
+    TEST_EXPECT(2 == buffer->lineno);
+    TEST_EXPECT(
+        "two" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    TEST_ASSERT(
+        0 == eroc_buffer_replace(buffer, buffer->cursor, make_line("TWO")));
+    TEST_EXPECT(
+        "TWO" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    TEST_ASSERT(0 == eroc_buffer_insert(buffer, nullptr, make_line("zero")));
+    TEST_ASSERT(0 == eroc_buffer_append(buffer, nullptr, make_line("five")));
+    TEST_EXPECT(3 == buffer->lineno);
+
+    /* deleting the cursor moves it to the next line. */
+    TEST_ASSERT(0 == eroc_buffer_line_delete(buffer, buffer->cursor));
+    TEST_EXPECT(3 == buffer->lineno);
+    TEST_EXPECT(
+        "three" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    /* only the cursor can be named. */
+    eroc_buffer_line* other = make_line("other");
+    TEST_EXPECT(0 != eroc_buffer_append(buffer, other, other));
+    TEST_EXPECT(0 != eroc_buffer_line_delete(buffer, other));
+    eroc_buffer_line_release(other);
+
+    eroc_buffer_line* line;
+    TEST_EXPECT(0 != eroc_buffer_line_at(&line, buffer, 0));
+
+    eroc_buffer_cursor_move_head(buffer);
+    std::vector<std::string> lines;
+    do
+    {
+        lines.emplace_back(buffer->cursor->line, buffer->cursor->length);
+    } while (0 == eroc_buffer_cursor_advance(buffer));
+
+    TEST_EXPECT(
+        (std::vector<std::string>{"zero", "one", "1.5", "three", "four",
+            "five"}) == lines);
+    TEST_EXPECT(
+        "zero\none\n1.5\nthree\nfour\nfive\n" == written(buffer->pieces));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Deleting every line empties the cursor.
+ */
+TEST(buffer_delete_all)
+{
+    std::string text = "a\nb\n";
+    eroc_buffer* buffer = make_buffer(text);
+
+    TEST_ASSERT(nullptr != buffer);
+    TEST_ASSERT(0 == eroc_buffer_line_delete(buffer, buffer->cursor));
+    TEST_EXPECT(0 == buffer->lineno);
+    TEST_EXPECT(
+        "a" == std::string(buffer->cursor->line, buffer->cursor->length));
+    TEST_ASSERT(0 == eroc_buffer_line_delete(buffer, buffer->cursor));
+    TEST_EXPECT(nullptr == buffer->cursor);
+    TEST_EXPECT(0 == eroc_buffer_line_count(buffer));
+
+    /* appending to an empty buffer moves the cursor to the new line. */
+    TEST_ASSERT(0 == eroc_buffer_append(buffer, nullptr, make_line("c")));
+    TEST_ASSERT(nullptr != buffer->cursor);
+    TEST_EXPECT(
+        "c" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief Random edits of a piece table buffer agree with the same edits of a
+ * vector of lines.
+ */
+TEST(buffer_random_edits)
+{
+    std::vector<std::string> model;
+    for (size_t i = 0; i < 3 * EROC_PIECE_TABLE_STRIDE; ++i)
+    {
+        model.push_back(std::to_string(i * 7919));
+    }
+
+    std::string text = joined(model);
+    eroc_buffer* buffer = make_buffer(text);
+    TEST_ASSERT(nullptr != buffer);
+
+    std::mt19937 rng(12345);
+    bool ok = true;
+    for (int step = 0; step < 2000 && ok; ++step)
+    {
+        std::string line = "edit " + std::to_string(step);
+        size_t lineno = model.empty() ? 0 : rng() % model.size();
+
+        if (!model.empty())
+        {
+            ok = ok && 0 == eroc_buffer_cursor_move(buffer, lineno);
+        }
+
+        switch (model.empty() ? 0 : rng() % 4)
+        {
+            case 0:
+                ok = ok && 0 == eroc_buffer_append(
+                    buffer, buffer->cursor, make_line(line));
+                model.insert(
+                    model.begin() + (model.empty() ? 0 : lineno + 1), line);
+                break;
+
+            case 1:
+                ok = ok && 0 == eroc_buffer_insert(
+                    buffer, buffer->cursor, make_line(line));
+                model.insert(model.begin() + lineno, line);
+                break;
+
+            case 2:
+                ok = ok && 0 == eroc_buffer_replace(
+                    buffer, buffer->cursor, make_line(line));
+                model[lineno] = line;
+                break;
+
+            case 3:
+                ok = ok && 0 == eroc_buffer_line_delete(buffer, buffer->cursor);
+                model.erase(model.begin() + lineno);
+                break;
+        }
+
+        ok = ok && model.size() == eroc_buffer_line_count(buffer);
+        ok = ok && model.size() == checked_lines(buffer->pieces->pieces->root);
+    }
+
+    TEST_EXPECT(ok);
+    TEST_EXPECT(model == contents(buffer->pieces));
+    TEST_EXPECT(joined(model) == written(buffer->pieces));
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+}
+
+/**
+ * \brief A lazy table can be read while it is being indexed, and is the same
+ * as an eagerly created table once it is finished.
+ */
+TEST(lazy_create)
+{
+    std::vector<std::string> lines = numbered(200000);
+    std::string text = joined(lines) + "tail";
+    eroc_piece_table* table;
+    const char* line;
+    size_t length;
+
+    TEST_ASSERT(
+        0 == eroc_piece_table_create_lazy(&table, text.data(), text.size()));
+
+    TEST_ASSERT(0 == eroc_piece_table_line(&line, &length, table, 0));
+    TEST_EXPECT("line 0" == std::string(line, length));
+    TEST_ASSERT(0 == eroc_piece_table_line(&line, &length, table, 150000));
+    TEST_EXPECT("line 150000" == std::string(line, length));
+    TEST_EXPECT(0 == eroc_piece_table_wait(table, 199999));
+
+    /* the unterminated last line is found once indexing ends. */
+    TEST_EXPECT(0 == eroc_piece_table_wait(table, 200000));
+    TEST_EXPECT(0 != eroc_piece_table_wait(table, 200001));
+    TEST_EXPECT(table->indexed);
+    TEST_EXPECT(200001 == table->lines);
+
+    lines.push_back("tail");
+    TEST_EXPECT(lines == contents(table));
+    TEST_EXPECT(text + "\n" == written(table));
+
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief An edit waits for indexing to finish, and releasing a table stops its
+ * indexer.
+ */
+TEST(lazy_edit)
+{
+    std::vector<std::string> lines = numbered(500000);
+    std::string text = joined(lines);
+    eroc_piece_table* table;
+
+    TEST_ASSERT(
+        0 == eroc_piece_table_create_lazy(&table, text.data(), text.size()));
+    TEST_ASSERT(0 == eroc_piece_table_insert(table, 1, "x", 1));
+    TEST_ASSERT(0 == eroc_piece_table_delete(table, 499999));
+
+    lines.insert(lines.begin() + 1, "x");
+    lines.erase(lines.begin() + 499999);
+    TEST_EXPECT(lines == contents(table));
+    TEST_EXPECT(joined(lines) == written(table));
+
+    eroc_piece_table_release(table);
+
+    /* this table is most likely still being indexed. */
+    TEST_ASSERT(
+        0 == eroc_piece_table_create_lazy(&table, text.data(), text.size()));
+    eroc_piece_table_release(table);
+}
+
+/**
+ * \brief A lazily loaded buffer's current line is its last line, found only
+ * when a command uses it.
+ */
+TEST(buffer_lazy_current)
+{
+    std::string path = scratch_file("one\ntwo\nthree\nfour");
+    eroc_buffer* buffer;
+    size_t size;
+
+    TEST_ASSERT(!path.empty());
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(buffer->flags & EROC_BUFFER_FLAG_CURSOR_PENDING);
+
+    /* a relative address counts from the last line. */
+    TEST_EXPECT(0 == run(buffer, "-1"));
+    TEST_EXPECT(!(buffer->flags & EROC_BUFFER_FLAG_CURSOR_PENDING));
+    TEST_EXPECT(2 == buffer->lineno);
+    TEST_EXPECT(
+        "three" == std::string(buffer->cursor->line, buffer->cursor->length));
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* so does a command without an address. */
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(0 == run(buffer, "p"));
+    TEST_EXPECT(3 == buffer->lineno);
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* a command that doesn't use it leaves it pending. */
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(0 == run(buffer, "="));
+    TEST_EXPECT(buffer->flags & EROC_BUFFER_FLAG_CURSOR_PENDING);
+    TEST_EXPECT(0 == run(buffer, "-2"));
+    TEST_EXPECT(1 == buffer->lineno);
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* an edit keeps it once the buffer is materialized. */
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(0 == run(buffer, "$s/four/FOUR/"));
+    TEST_ASSERT(nullptr == buffer->pieces);
+    TEST_EXPECT(0 == run(buffer, "-3"));
+    TEST_EXPECT(
+        "one" == std::string(buffer->cursor->line, buffer->cursor->length));
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    /* an address that doesn't use it replaces it. */
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(0 == run(buffer, "2"));
+    TEST_EXPECT(0 == run(buffer, "+1"));
+    TEST_EXPECT(2 == buffer->lineno);
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+
+    unlink(path.c_str());
+}
+
+/**
+ * \brief A lazily loaded buffer prints without being materialized; an edit
+ * materializes it.
+ */
+TEST(buffer_lazy)
+{
+    std::string path = scratch_file("one\ntwo\nthree\nfour");
+    eroc_buffer* buffer;
+    size_t size;
+
+    TEST_ASSERT(!path.empty());
+    TEST_ASSERT(0 == eroc_buffer_load_lazy(&buffer, &size, path.c_str()));
+    TEST_EXPECT(18 == size);
+    TEST_ASSERT(nullptr != buffer->pieces);
+    TEST_EXPECT(eroc_buffer_line_exists(buffer, 3));
+    TEST_EXPECT(!eroc_buffer_line_exists(buffer, 4));
+
+    TEST_EXPECT(0 == run(buffer, "2,3p"));
+    TEST_EXPECT(0 == run(buffer, "3"));
+    TEST_EXPECT(nullptr != buffer->pieces);
+    TEST_EXPECT(0 != run(buffer, "5p"));
+
+    /* the delete runs on the materialized lines. */
+    TEST_EXPECT(0 == run(buffer, "1d"));
+    TEST_ASSERT(nullptr == buffer->pieces);
+    TEST_EXPECT(3 == buffer->lines->count);
+    TEST_EXPECT(0 == buffer->lineno);
+    TEST_EXPECT(
+        "two" == std::string(buffer->cursor->line, buffer->cursor->length));
+
+    std::vector<std::string> lines;
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (eroc_buffer_line*)node;
+        lines.emplace_back(line->line, line->length);
+    }
+
+    TEST_EXPECT((std::vector<std::string>{"two", "three", "four"}) == lines);
+
+    TEST_ASSERT(0 == eroc_buffer_release(buffer));
+    unlink(path.c_str());
+}
@@ -1184,3 +1184,61 @@ TEST(parse_naked_optional_alternative_failure)
 
     TEST_ASSERT(0 != eroc_regex_compiler_parse(&ast, INPUT));
 }
+
+/**
+ * \brief A postfix operator binds tighter than concatenation.
+ */
+TEST(parse_postfix_precedence)
+{
+    eroc_regex_ast_node* ast;
+    const char* INPUT = "ab*";
+
+    TEST_ASSERT(0 == eroc_regex_compiler_parse(&ast, INPUT));
+
+    /* ast is a concat. */
+    TEST_ASSERT(nullptr != ast);
+    TEST_ASSERT(EROC_REGEX_AST_CONCAT == ast->type);
+
+    /* left is the literal a. */
+    auto left = ast->data.binary.left;
+    TEST_ASSERT(nullptr != left);
+    TEST_EXPECT(EROC_REGEX_AST_LITERAL == left->type);
+    TEST_EXPECT('a' == left->data.literal);
+
+    /* right is a star over the literal b. */
+    auto right = ast->data.binary.right;
+    TEST_ASSERT(nullptr != right);
+    TEST_ASSERT(EROC_REGEX_AST_STAR == right->type);
+    TEST_ASSERT(nullptr != right->data.unary.child);
+    TEST_EXPECT(EROC_REGEX_AST_LITERAL == right->data.unary.child->type);
+    TEST_EXPECT('b' == right->data.unary.child->data.literal);
+
+    /* clean up. */
+    eroc_regex_ast_node_release(ast);
+}
+
+/**
+ * \brief Concatenation binds tighter than alternation.
+ */
+TEST(parse_alternate_precedence)
+{
+    eroc_regex_ast_node* ast;
+    const char* INPUT = "ab|cd";
+
+    TEST_ASSERT(0 == eroc_regex_compiler_parse(&ast, INPUT));
+
+    /* ast is an alternate. */
+    TEST_ASSERT(nullptr != ast);
+    TEST_ASSERT(EROC_REGEX_AST_ALTERNATE == ast->type);
+
+    /* both sides are concats. */
+    auto left = ast->data.binary.left;
+    TEST_ASSERT(nullptr != left);
+    TEST_EXPECT(EROC_REGEX_AST_CONCAT == left->type);
+    auto right = ast->data.binary.right;
+    TEST_ASSERT(nullptr != right);
+    TEST_EXPECT(EROC_REGEX_AST_CONCAT == right->type);
+
+    /* clean up. */
+    eroc_regex_ast_node_release(ast);
+}
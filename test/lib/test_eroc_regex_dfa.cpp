@@ -0,0 +1,228 @@
+/**
+ * \file test/lib/test_eroc_regex_dfa.cpp
+ *
+ * \brief Unit tests for the lazy DFA.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <minunit/minunit.h>
+#include <random>
+#include <string.h>
+#include <string>
+
+TEST_SUITE(eroc_regex_dfa);
+
+namespace {
+
+/**
+ * \brief A compiled pattern with both a DFA and a VM.
+ */
+struct compiled
+{
+    eroc_regex_ast_node* ast = nullptr;
+    eroc_regex_program* program = nullptr;
+    eroc_regex_dfa* dfa = nullptr;
+    eroc_regex_vm* vm = nullptr;
+
+    compiled(
+        const char* pattern,
+        size_t cache_size = EROC_REGEX_DFA_DEFAULT_CACHE_SIZE)
+    {
+        if (0 != eroc_regex_compiler_parse(&ast, pattern))
+        {
+            ast = nullptr;
+            return;
+        }
+        if (0 != eroc_regex_program_compile(&program, ast))
+        {
+            program = nullptr;
+            return;
+        }
+        if (0 != eroc_regex_dfa_create(&dfa, program, cache_size))
+        {
+            dfa = nullptr;
+        }
+        if (0 != eroc_regex_vm_create(&vm, program))
+        {
+            vm = nullptr;
+        }
+    }
+
+    ~compiled()
+    {
+        if (nullptr != vm)
+            eroc_regex_vm_release(vm);
+        if (nullptr != dfa)
+            eroc_regex_dfa_release(dfa);
+        if (nullptr != program)
+            eroc_regex_program_release(program);
+        if (nullptr != ast)
+            eroc_regex_ast_node_release(ast);
+    }
+
+    bool ok() const
+    {
+        return nullptr != dfa && nullptr != vm;
+    }
+
+    bool dfa_match(const std::string& text)
+    {
+        return eroc_regex_dfa_search(dfa, nullptr, text.data(), text.size());
+    }
+
+    bool vm_match(const std::string& text)
+    {
+        return eroc_regex_vm_search(vm, nullptr, text.data(), text.size());
+    }
+};
+
+} /* namespace */
+
+/**
+ * \brief The DFA agrees with the VM on simple patterns.
+ */
+TEST(simple_matches)
+{
+    compiled re("ab|cd+");
+
+    TEST_ASSERT(re.ok());
+    TEST_EXPECT(re.dfa_match("xxabxx"));
+    TEST_EXPECT(re.dfa_match("cdddd"));
+    TEST_EXPECT(re.dfa_match("zzzc d cd"));
+    TEST_EXPECT(!re.dfa_match("acbdc"));
+    TEST_EXPECT(!re.dfa_match(""));
+}
+
+/**
+ * \brief A pattern which matches the empty string matches any text.
+ */
+TEST(empty_match)
+{
+    compiled re("a*");
+
+    TEST_ASSERT(re.ok());
+    TEST_EXPECT(re.dfa_match(""));
+    TEST_EXPECT(re.dfa_match("bbb"));
+}
+
+/**
+ * \brief Byte classes merge bytes which the pattern can't tell apart.
+ */
+TEST(byte_classes)
+{
+    compiled re("[a-z]+x");
+
+    TEST_ASSERT(re.ok());
+
+    /* [0, a), [a, x), x, (x, z], (z, 255]. */
+    TEST_EXPECT(5 == re.dfa->class_count);
+    TEST_EXPECT(re.dfa->byte_classes['b'] == re.dfa->byte_classes['w']);
+    TEST_EXPECT(re.dfa->byte_classes['y'] == re.dfa->byte_classes['z']);
+    TEST_EXPECT(re.dfa->byte_classes['x'] != re.dfa->byte_classes['w']);
+    TEST_EXPECT(re.dfa->byte_classes['0'] == re.dfa->byte_classes['\0']);
+    TEST_EXPECT(re.dfa->byte_classes['{'] == re.dfa->byte_classes[0xff]);
+}
+
+/**
+ * \brief Captures are extracted with the NFA when the DFA finds a match.
+ */
+TEST(captures)
+{
+    compiled re("([0-9]+)-([0-9]+)");
+    size_t caps[6];
+    const char* TEXT = "call 555-1234 now";
+
+    TEST_ASSERT(re.ok());
+    TEST_ASSERT(eroc_regex_dfa_search(re.dfa, caps, TEXT, strlen(TEXT)));
+    TEST_EXPECT(5 == caps[0]);
+    TEST_EXPECT(13 == caps[1]);
+    TEST_EXPECT(5 == caps[2]);
+    TEST_EXPECT(8 == caps[3]);
+    TEST_EXPECT(9 == caps[4]);
+    TEST_EXPECT(13 == caps[5]);
+
+    TEST_EXPECT(!eroc_regex_dfa_search(re.dfa, caps, "555-", 4));
+}
+
+/**
+ * \brief Repeated searches are served from the cache.
+ */
+TEST(cache_counters)
+{
+    compiled re("needle");
+    std::string text = "a haystack without the thing we are looking for";
+
+    TEST_ASSERT(re.ok());
+    TEST_EXPECT(!re.dfa_match(text));
+    TEST_EXPECT(0 < re.dfa->misses);
+
+    uint64_t misses = re.dfa->misses;
+    uint64_t hits = re.dfa->hits;
+    TEST_EXPECT(!re.dfa_match(text));
+    TEST_EXPECT(misses == re.dfa->misses);
+    TEST_EXPECT(hits + text.size() == re.dfa->hits);
+    TEST_EXPECT(0 == re.dfa->flushes);
+}
+
+/**
+ * \brief A tiny cache is flushed as needed and still gives correct answers.
+ */
+TEST(cache_flush)
+{
+    compiled re("a.........b", 1);
+    std::string text(4096, 'a');
+
+    TEST_ASSERT(re.ok());
+    TEST_EXPECT(2 == re.dfa->max_states);
+
+    /* an a every few bytes needs many distinct states. */
+    for (size_t i = 0; i < text.size(); i += 3)
+    {
+        text[i] = 'x';
+    }
+
+    TEST_EXPECT(!re.dfa_match(text));
+    TEST_EXPECT(0 < re.dfa->flushes);
+
+    text.back() = 'b';
+    TEST_EXPECT(re.dfa_match(text));
+}
+
+/**
+ * \brief The DFA agrees with the VM on random patterns and texts.
+ */
+TEST(random_agreement)
+{
+    const char* PATTERNS[] = {
+        "a(b|c)*d", "[ab]+c?", "(a|ab)(c|bcd)", "a.?b.?c", "x*y+z*",
+        "[^a]b", "(ab|a)*b", "\\d+\\.\\d+", "((a)|b)+c", "a?a?a?aaa"
+    };
+    std::mt19937 rng(1234);
+
+    for (const char* pattern : PATTERNS)
+    {
+        /* a small cache exercises flushes as well. */
+        compiled big(pattern);
+        compiled small(pattern, 256);
+
+        TEST_ASSERT(big.ok());
+        TEST_ASSERT(small.ok());
+
+        for (int i = 0; i < 300; ++i)
+        {
+            std::string text;
+            size_t length = rng() % 12;
+            for (size_t j = 0; j < length; ++j)
+            {
+                text += "abcdxyz.1"[rng() % 9];
+            }
+
+            bool expected = big.vm_match(text);
+            TEST_EXPECT(expected == big.dfa_match(text));
+            TEST_EXPECT(expected == small.dfa_match(text));
+        }
+    }
+}
@@ -0,0 +1,290 @@
+/**
+ * \file test/lib/test_eroc_regex_prefilter.cpp
+ *
+ * \brief Unit tests for literal prefilter extraction and regex search.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <minunit/minunit.h>
+#include <random>
+#include <set>
+#include <string.h>
+#include <string>
+
+TEST_SUITE(eroc_regex_prefilter);
+
+namespace {
+
+/**
+ * \brief Extract the prefilter for a pattern.
+ */
+bool extract(eroc_regex_prefilter* prefilter, const char* pattern)
+{
+    eroc_regex_ast_node* ast;
+
+    if (0 != eroc_regex_compiler_parse(&ast, pattern))
+    {
+        return false;
+    }
+
+    int retval = eroc_regex_prefilter_extract(prefilter, ast);
+    eroc_regex_ast_node_release(ast);
+
+    return 0 == retval;
+}
+
+/**
+ * \brief Get the literals of a prefilter as a set of strings.
+ */
+std::set<std::string> literals(const eroc_regex_prefilter& prefilter)
+{
+    std::set<std::string> result;
+
+    for (size_t i = 0; i < prefilter.count; ++i)
+    {
+        result.emplace(prefilter.literals[i], prefilter.lengths[i]);
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+/**
+ * \brief A plain literal pattern is exact.
+ */
+TEST(exact_literal)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "needle"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_EXACT == prefilter.kind);
+    TEST_EXPECT(literals(prefilter) == std::set<std::string>{"needle"});
+}
+
+/**
+ * \brief Alternations and small char classes produce literal sets.
+ */
+TEST(literal_sets)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "foo(bar|baz)"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_EXACT == prefilter.kind);
+    TEST_EXPECT(
+        literals(prefilter)
+            == (std::set<std::string>{"foobar", "foobaz"}));
+
+    TEST_ASSERT(extract(&prefilter, "[ab]cd"));
+    TEST_EXPECT(
+        literals(prefilter) == (std::set<std::string>{"acd", "bcd"}));
+}
+
+/**
+ * \brief A required literal before a wildcard is a prefix.
+ */
+TEST(prefix)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "panic: .*"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_PREFIX == prefilter.kind);
+    TEST_EXPECT(literals(prefilter) == std::set<std::string>{"panic: "});
+}
+
+/**
+ * \brief A required literal after a wildcard is a suffix.
+ */
+TEST(suffix)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "[0-9]+ms"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_SUFFIX == prefilter.kind);
+    TEST_EXPECT(literals(prefilter) == std::set<std::string>{"ms"});
+}
+
+/**
+ * \brief The most selective literal is chosen among several.
+ */
+TEST(inner)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "ERROR.*timeout"));
+    TEST_EXPECT(literals(prefilter) == std::set<std::string>{"timeout"});
+
+    TEST_ASSERT(extract(&prefilter, "x*(abc|abd)[0-9]+y?"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_INNER == prefilter.kind);
+    TEST_EXPECT(
+        literals(prefilter) == (std::set<std::string>{"abc", "abd"}));
+}
+
+/**
+ * \brief Patterns without required literals have no prefilter.
+ */
+TEST(none)
+{
+    eroc_regex_prefilter prefilter;
+
+    TEST_ASSERT(extract(&prefilter, "(ab)*"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_NONE == prefilter.kind);
+    TEST_EXPECT(eroc_regex_prefilter_check(&prefilter, "zzz", 3));
+
+    TEST_ASSERT(extract(&prefilter, "a?b?"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_NONE == prefilter.kind);
+
+    TEST_ASSERT(extract(&prefilter, "[a-z]+"));
+    TEST_EXPECT(EROC_REGEX_PREFILTER_NONE == prefilter.kind);
+}
+
+/**
+ * \brief Long literals are truncated, and remain required.
+ */
+TEST(long_literal)
+{
+    eroc_regex_prefilter prefilter;
+    std::string pattern(EROC_REGEX_PREFILTER_MAX_LENGTH + 8, 'q');
+
+    pattern += ".*";
+    TEST_ASSERT(extract(&prefilter, pattern.c_str()));
+    TEST_ASSERT(1 == prefilter.count);
+    TEST_EXPECT(EROC_REGEX_PREFILTER_MAX_LENGTH == prefilter.lengths[0]);
+}
+
+/**
+ * \brief The literal scanner finds literals at every offset and across vector
+ * boundaries.
+ */
+TEST(literal_find)
+{
+    std::string text(200, '.');
+
+    for (size_t length = 1; length <= 40; length += 3)
+    {
+        std::string literal;
+        for (size_t i = 0; i < length; ++i)
+        {
+            literal += (char)('a' + i % 26);
+        }
+
+        for (size_t at = 0; at + length <= text.size(); ++at)
+        {
+            std::string haystack = text;
+            haystack.replace(at, length, literal);
+
+            const char* found =
+                eroc_regex_literal_find(
+                    haystack.data(), haystack.size(), literal.data(),
+                    literal.size());
+            TEST_ASSERT(found == haystack.data() + at);
+
+            /* a near miss is not found. */
+            haystack[at + length - 1] = '.';
+            if (length > 1)
+            {
+                TEST_ASSERT(
+                    nullptr
+                        == eroc_regex_literal_find(
+                            haystack.data(), haystack.size(), literal.data(),
+                            literal.size()));
+            }
+        }
+    }
+}
+
+/**
+ * \brief A prefilter never rejects text which matches.
+ */
+TEST(sound)
+{
+    const char* PATTERNS[] = {
+        "ab(c|d)*e", "x+yz", "(foo|bar)baz?", "[ab]c[de]", "q.?r.?s",
+        "(ab|cd)+", "a?bcd?", "(a|b)(c|d)(e|f)", "de+f", "c*d*e"
+    };
+    std::mt19937 rng(4321);
+    size_t checked = 0;
+
+    for (const char* pattern : PATTERNS)
+    {
+        eroc_regex_prefilter prefilter;
+        eroc_regex_ast_node* ast;
+        eroc_regex_program* program;
+        eroc_regex_vm* vm;
+
+        TEST_ASSERT(0 == eroc_regex_compiler_parse(&ast, pattern));
+        TEST_ASSERT(0 == eroc_regex_prefilter_extract(&prefilter, ast));
+        TEST_ASSERT(0 == eroc_regex_program_compile(&program, ast));
+        TEST_ASSERT(0 == eroc_regex_vm_create(&vm, program));
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            std::string text;
+            size_t length = rng() % 10;
+            for (size_t j = 0; j < length; ++j)
+            {
+                text += "abcdefqrsxyz"[rng() % 12];
+            }
+
+            if (eroc_regex_vm_search(vm, nullptr, text.data(), text.size()))
+            {
+                ++checked;
+                TEST_EXPECT(
+                    eroc_regex_prefilter_check(
+                        &prefilter, text.data(), text.size()));
+            }
+        }
+
+        eroc_regex_vm_release(vm);
+        eroc_regex_program_release(program);
+        eroc_regex_ast_node_release(ast);
+    }
+
+    TEST_EXPECT(0 < checked);
+}
+
+/**
+ * \brief A compiled regex skips lines without the required literal and finds
+ * captures in lines that match.
+ */
+TEST(regex_search)
+{
+    eroc_regex* regex;
+    size_t caps[4];
+    const char* LINES[] = {
+        "INFO request completed in 12ms",
+        "ERROR disk full",
+        "ERROR request timeout after 30s",
+    };
+
+    TEST_ASSERT(0 == eroc_regex_create(&regex, "ERROR(.*)timeout"));
+
+    TEST_EXPECT(
+        !eroc_regex_search(regex, caps, LINES[0], strlen(LINES[0])));
+    TEST_EXPECT(
+        !eroc_regex_search(regex, caps, LINES[1], strlen(LINES[1])));
+    TEST_EXPECT(eroc_regex_search(regex, caps, LINES[2], strlen(LINES[2])));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(21 == caps[1]);
+    TEST_EXPECT(5 == caps[2]);
+    TEST_EXPECT(14 == caps[3]);
+
+    /* the lines without "timeout" never reached the engine. */
+    TEST_EXPECT(3 == regex->searches);
+    TEST_EXPECT(2 == regex->skipped);
+
+    eroc_regex_release(regex);
+}
+
+/**
+ * \brief An invalid pattern fails to compile.
+ */
+TEST(regex_create_failure)
+{
+    eroc_regex* regex;
+
+    TEST_EXPECT(0 != eroc_regex_create(&regex, "(ab"));
+}
@@ -0,0 +1,130 @@
+/**
+ * \file test/lib/test_eroc_regex_substitution.cpp
+ *
+ * \brief Unit tests for regex substitution.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <minunit/minunit.h>
+#include <string>
+
+TEST_SUITE(eroc_regex_substitution);
+
+namespace {
+
+/**
+ * \brief Substitute, returning the result, or the text unchanged if nothing
+ * was replaced, and "<error>" on failure.
+ */
+std::string substitute(
+    const char* pattern, const char* replacement, const std::string& text,
+    size_t occurrence = 0, bool global = false, size_t* count = nullptr)
+{
+    eroc_regex_substitution* substitution;
+    size_t replaced;
+    std::string result = text;
+
+    if (0 != eroc_regex_substitution_create(
+                &substitution, pattern, replacement, occurrence, global))
+    {
+        return "<error>";
+    }
+
+    if (0 != eroc_regex_substitution_apply(
+                substitution, &replaced, text.data(), text.size()))
+    {
+        result = "<error>";
+    }
+    else if (replaced > 0)
+    {
+        result.assign(substitution->result, substitution->result_length);
+    }
+
+    if (nullptr != count)
+    {
+        *count = replaced;
+    }
+
+    eroc_regex_substitution_release(substitution);
+
+    return result;
+}
+
+} /* namespace */
+
+/**
+ * \brief Only the first match is replaced by default, and g replaces them all.
+ */
+TEST(first_and_global)
+{
+    size_t count;
+
+    TEST_EXPECT("bar foo foo" == substitute("foo", "bar", "foo foo foo"));
+    TEST_EXPECT(
+        "bar bar bar"
+            == substitute("foo", "bar", "foo foo foo", 0, true, &count));
+    TEST_EXPECT(3 == count);
+}
+
+/**
+ * \brief An occurrence selects the Nth match, and every later one with g.
+ */
+TEST(occurrence)
+{
+    TEST_EXPECT("a a X a" == substitute("a", "X", "a a a a", 3));
+    TEST_EXPECT("a X X X" == substitute("a", "X", "a a a a", 2, true));
+    TEST_EXPECT("a a" == substitute("a", "X", "a a", 3));
+}
+
+/**
+ * \brief & is the whole match and \N is a capture group, numbered by its
+ * opening parenthesis.
+ */
+TEST(back_references)
+{
+    TEST_EXPECT("[abc]" == substitute("abc", "[&]", "abc"));
+    TEST_EXPECT("cd-ab" == substitute("(ab)(cd)", "\\2-\\1", "abcd"));
+    TEST_EXPECT("ab/a" == substitute("((a)b)", "\\1/\\2", "ab"));
+    TEST_EXPECT("<error>" == substitute("((a)b)", "\\3", "ab"));
+    TEST_EXPECT("& and \\" == substitute("x", "\\& and \\\\", "x"));
+}
+
+/**
+ * \brief A group which doesn't take part in the match expands to nothing.
+ */
+TEST(unset_group)
+{
+    TEST_EXPECT("x[]y" == substitute("(a)|b", "[\\1]", "xby"));
+}
+
+/**
+ * \brief Empty matches step over a character, and don't count directly after a
+ * previous match.
+ */
+TEST(empty_matches)
+{
+    TEST_EXPECT("-a-b-c-" == substitute("x*", "-", "abc", 0, true));
+    TEST_EXPECT("-a-b-" == substitute("x*", "-", "xab", 0, true));
+    TEST_EXPECT("-" == substitute("x*", "-", "", 0, true));
+}
+
+/**
+ * \brief The result grows past its initial capacity, and text without a match
+ * is left alone.
+ */
+TEST(long_result)
+{
+    std::string text(1000, 'a');
+    size_t count;
+
+    TEST_EXPECT(
+        std::string(3000, 'b')
+            == substitute("a", "bbb", text, 0, true, &count));
+    TEST_EXPECT(1000 == count);
+
+    TEST_EXPECT(text == substitute("z", "y", text, 0, true, &count));
+    TEST_EXPECT(0 == count);
+}
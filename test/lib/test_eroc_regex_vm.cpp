@@ -0,0 +1,261 @@
+/**
+ * \file test/lib/test_eroc_regex_vm.cpp
+ *
+ * \brief Unit tests for the NFA compiler and Pike VM.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/regex.h>
+#include <minunit/minunit.h>
+#include <string.h>
+#include <string>
+
+TEST_SUITE(eroc_regex_vm);
+
+namespace {
+
+/**
+ * \brief Parse, compile, and search in one step.
+ *
+ * \returns 1 on match, 0 on no match, and -1 on failure.
+ */
+int search(const char* pattern, const char* text, size_t* captures)
+{
+    eroc_regex_ast_node* ast;
+    eroc_regex_program* program;
+    eroc_regex_vm* vm;
+    int retval = -1;
+
+    if (0 != eroc_regex_compiler_parse(&ast, pattern))
+    {
+        return -1;
+    }
+
+    if (0 == eroc_regex_program_compile(&program, ast))
+    {
+        if (0 == eroc_regex_vm_create(&vm, program))
+        {
+            retval =
+                eroc_regex_vm_search(vm, captures, text, strlen(text)) ? 1 : 0;
+            eroc_regex_vm_release(vm);
+        }
+
+        eroc_regex_program_release(program);
+    }
+
+    eroc_regex_ast_node_release(ast);
+
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief A literal matches its own span.
+ */
+TEST(literal_span)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("abc", "xxabcxx", caps));
+    TEST_EXPECT(2 == caps[0]);
+    TEST_EXPECT(5 == caps[1]);
+}
+
+/**
+ * \brief A pattern that does not occur does not match.
+ */
+TEST(no_match)
+{
+    TEST_EXPECT(0 == search("abd", "abcabc", nullptr));
+    TEST_EXPECT(0 == search("a", "", nullptr));
+}
+
+/**
+ * \brief The leftmost match wins, even if a later match is longer.
+ */
+TEST(leftmost_match)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("a+", "baxaaaa", caps));
+    TEST_EXPECT(1 == caps[0]);
+    TEST_EXPECT(2 == caps[1]);
+}
+
+/**
+ * \brief Alternation prefers its left side at the same start position.
+ */
+TEST(alternation_preference)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("a|ab", "ab", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(1 == caps[1]);
+
+    TEST_ASSERT(1 == search("ab|a", "ab", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(2 == caps[1]);
+}
+
+/**
+ * \brief Repetition is greedy.
+ */
+TEST(greedy_repetition)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("a*", "aaab", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(3 == caps[1]);
+
+    TEST_ASSERT(1 == search("ba+", "xbaaa", caps));
+    TEST_EXPECT(1 == caps[0]);
+    TEST_EXPECT(5 == caps[1]);
+
+    TEST_ASSERT(1 == search("ab?", "abb", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(2 == caps[1]);
+
+    /* star may match the empty string at the start. */
+    TEST_ASSERT(1 == search("x*", "abc", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(0 == caps[1]);
+}
+
+/**
+ * \brief Any matches any byte.
+ */
+TEST(any)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("a.c", "xa\x01" "cz", caps));
+    TEST_EXPECT(1 == caps[0]);
+    TEST_EXPECT(4 == caps[1]);
+}
+
+/**
+ * \brief Char classes and inverse char classes match their members.
+ */
+TEST(char_class)
+{
+    size_t caps[2];
+
+    TEST_ASSERT(1 == search("[0-9]+", "abc123def", caps));
+    TEST_EXPECT(3 == caps[0]);
+    TEST_EXPECT(6 == caps[1]);
+
+    TEST_ASSERT(1 == search("[^a-z]+", "abc123def", caps));
+    TEST_EXPECT(3 == caps[0]);
+    TEST_EXPECT(6 == caps[1]);
+
+    TEST_EXPECT(0 == search("[^a-z]", "abcdef", nullptr));
+}
+
+/**
+ * \brief Capture groups record the spans of their last iteration, numbered by
+ * their group index.
+ */
+TEST(captures)
+{
+    size_t caps[6];
+
+    TEST_ASSERT(1 == search("(a+)(b+)", "xaabbby", caps));
+    TEST_EXPECT(1 == caps[0]);
+    TEST_EXPECT(6 == caps[1]);
+    TEST_EXPECT(1 == caps[2]);
+    TEST_EXPECT(3 == caps[3]);
+    TEST_EXPECT(3 == caps[4]);
+    TEST_EXPECT(6 == caps[5]);
+
+    /* a repeated group holds its last iteration. */
+    TEST_ASSERT(1 == search("(ab)+", "ababab", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(6 == caps[1]);
+    TEST_EXPECT(4 == caps[2]);
+    TEST_EXPECT(6 == caps[3]);
+}
+
+/**
+ * \brief Groups which do not participate in the match are unset.
+ */
+TEST(unset_captures)
+{
+    size_t caps[6];
+
+    TEST_ASSERT(1 == search("(a)|(b)", "b", caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(1 == caps[1]);
+    TEST_EXPECT(EROC_REGEX_UNSET == caps[2]);
+    TEST_EXPECT(EROC_REGEX_UNSET == caps[3]);
+    TEST_EXPECT(0 == caps[4]);
+    TEST_EXPECT(1 == caps[5]);
+}
+
+/**
+ * \brief Nested groups are numbered in the order that they open.
+ */
+TEST(nested_captures)
+{
+    size_t caps[6];
+
+    TEST_ASSERT(1 == search("((a)b)", "ab", caps));
+    /* the outer group opens first. */
+    TEST_EXPECT(0 == caps[2]);
+    TEST_EXPECT(2 == caps[3]);
+    TEST_EXPECT(0 == caps[4]);
+    TEST_EXPECT(1 == caps[5]);
+}
+
+/**
+ * \brief A pattern which takes exponential time to backtrack completes in
+ * linear time.
+ */
+TEST(pathological_pattern)
+{
+    const size_t N = 64;
+    std::string pattern, text(N, 'a');
+    size_t caps[2];
+
+    for (size_t i = 0; i < N; ++i)
+    {
+        pattern += "a?";
+    }
+    pattern += text;
+
+    TEST_ASSERT(1 == search(pattern.c_str(), text.c_str(), caps));
+    TEST_EXPECT(0 == caps[0]);
+    TEST_EXPECT(N == caps[1]);
+}
+
+/**
+ * \brief A VM can be reused across searches.
+ */
+TEST(vm_reuse)
+{
+    eroc_regex_ast_node* ast;
+    eroc_regex_program* program;
+    eroc_regex_vm* vm;
+    size_t caps[4];
+
+    TEST_ASSERT(0 == eroc_regex_compiler_parse(&ast, "x(y+)"));
+    TEST_ASSERT(0 == eroc_regex_program_compile(&program, ast));
+    TEST_ASSERT(0 == eroc_regex_vm_create(&vm, program));
+
+    TEST_EXPECT(eroc_regex_vm_search(vm, caps, "axyyb", 5));
+    TEST_EXPECT(2 == caps[2]);
+    TEST_EXPECT(4 == caps[3]);
+    TEST_EXPECT(!eroc_regex_vm_search(vm, caps, "axb", 3));
+    TEST_EXPECT(eroc_regex_vm_search(vm, caps, "xy", 2));
+    TEST_EXPECT(1 == caps[2]);
+    TEST_EXPECT(2 == caps[3]);
+
+    /* clean up. */
+    eroc_regex_vm_release(vm);
+    eroc_regex_program_release(program);
+    eroc_regex_ast_node_release(ast);
+}
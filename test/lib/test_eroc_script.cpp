@@ -0,0 +1,187 @@
+/**
+ * \file test/lib/test_eroc_script.cpp
+ *
+ * \brief Unit tests for scripts.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/script.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <vector>
+
+TEST_SUITE(eroc_script);
+
+namespace {
+
+/**
+ * \brief Create a buffer holding the given lines, with the cursor on the last.
+ */
+eroc_buffer* make_buffer(const std::vector<std::string>& lines)
+{
+    eroc_buffer* buffer;
+
+    if (0 != eroc_buffer_create(&buffer))
+    {
+        return nullptr;
+    }
+
+    for (const auto& text : lines)
+    {
+        eroc_buffer_line* line;
+        if (0 != eroc_buffer_line_create_copy(&line, text.data(), text.size()))
+        {
+            eroc_buffer_release(buffer);
+            return nullptr;
+        }
+
+        eroc_buffer_append(buffer, nullptr, line);
+    }
+
+    eroc_buffer_cursor_move_tail(buffer);
+
+    return buffer;
+}
+
+/**
+ * \brief Get the contents of a buffer.
+ */
+std::vector<std::string> contents(const eroc_buffer* buffer)
+{
+    std::vector<std::string> lines;
+
+    for (auto node = buffer->lines->head; nullptr != node; node = node->next)
+    {
+        auto line = (const eroc_buffer_line*)node;
+        lines.emplace_back(line->line, line->length);
+    }
+
+    return lines;
+}
+
+/**
+ * \brief Parse a script from a string.
+ */
+eroc_script* make_script(const std::string& text, size_t* error_line)
+{
+    eroc_script* script;
+
+    if (0 != eroc_script_create(
+                &script, text.data(), text.size(), error_line))
+    {
+        return nullptr;
+    }
+
+    return script;
+}
+
+} /* namespace */
+
+/**
+ * \brief Text following a, c and i belongs to the command, not the script.
+ */
+TEST(text_blocks)
+{
+    size_t error_line;
+    eroc_script* script =
+        make_script("1d\n$a\nx\n.\n1i\ny\nz\n.\n,s/a/b/\n", &error_line);
+
+    TEST_ASSERT(nullptr != script);
+    TEST_ASSERT(4 == script->count);
+
+    TEST_EXPECT(1 == script->commands[0].line);
+    TEST_EXPECT(nullptr == script->commands[0].text);
+    TEST_EXPECT(2 == script->commands[1].line);
+    TEST_EXPECT(
+        "x\n.\n"
+            == std::string(
+                script->commands[1].text, script->commands[1].text_length));
+    TEST_EXPECT(5 == script->commands[2].line);
+    TEST_EXPECT(
+        "y\nz\n.\n"
+            == std::string(
+                script->commands[2].text, script->commands[2].text_length));
+    TEST_EXPECT(9 == script->commands[3].line);
+
+    eroc_script_release(script);
+}
+
+/**
+ * \brief One script runs against many buffers, resolving its addresses
+ * against each.
+ */
+TEST(run_many)
+{
+    size_t error_line;
+    eroc_script* script =
+        make_script("$d\n1a\nnew\n.\n,s/o/0/g", &error_line);
+    eroc_buffer* first = make_buffer({"one", "two", "three"});
+    eroc_buffer* second = make_buffer({"foo", "boo"});
+
+    TEST_ASSERT(nullptr != script);
+    TEST_ASSERT(nullptr != first);
+    TEST_ASSERT(nullptr != second);
+
+    TEST_ASSERT(0 == eroc_script_run(script, first, &error_line));
+    TEST_EXPECT(
+        (std::vector<std::string>{"0ne", "new", "tw0"}) == contents(first));
+
+    TEST_ASSERT(0 == eroc_script_run(script, second, &error_line));
+    TEST_EXPECT((std::vector<std::string>{"f00", "new"}) == contents(second));
+
+    eroc_buffer_release(second);
+    eroc_buffer_release(first);
+    eroc_script_release(script);
+}
+
+/**
+ * \brief Errors report the script line of the failing command.
+ */
+TEST(errors)
+{
+    size_t error_line;
+    eroc_script* script;
+    eroc_buffer* buffer = make_buffer({"a", "b"});
+
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_EXPECT(nullptr == make_script("1p\na\nx\n.\nk\n", &error_line));
+    TEST_EXPECT(5 == error_line);
+
+    script = make_script("1d\n5d\n1d\n", &error_line);
+    TEST_ASSERT(nullptr != script);
+    TEST_EXPECT(0 != eroc_script_run(script, buffer, &error_line));
+    TEST_EXPECT(2 == error_line);
+    TEST_EXPECT((std::vector<std::string>{"b"}) == contents(buffer));
+    eroc_script_release(script);
+
+    /* text without a terminating . is an error. */
+    script = make_script("a\nc", &error_line);
+    TEST_ASSERT(nullptr != script);
+    TEST_EXPECT(0 != eroc_script_run(script, buffer, &error_line));
+    TEST_EXPECT(1 == error_line);
+    eroc_script_release(script);
+
+    eroc_buffer_release(buffer);
+}
+
+/**
+ * \brief A quit stops the script.
+ */
+TEST(quit)
+{
+    size_t error_line;
+    eroc_script* script = make_script("1d\nq\n1d\n", &error_line);
+    eroc_buffer* buffer = make_buffer({"a", "b", "c"});
+
+    TEST_ASSERT(nullptr != script);
+    TEST_ASSERT(nullptr != buffer);
+
+    TEST_ASSERT(0 == eroc_script_run(script, buffer, &error_line));
+    TEST_EXPECT((std::vector<std::string>{"b", "c"}) == contents(buffer));
+
+    eroc_buffer_release(buffer);
+    eroc_script_release(script);
+}
@@ -0,0 +1,437 @@
+/**
+ * \file test/lib/test_eroc_stream.cpp
+ *
+ * \brief Unit tests for streaming scripts.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <eroc/stream.h>
+#include <fcntl.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <unistd.h>
+#include <utility>
+
+TEST_SUITE(eroc_stream);
+
+namespace {
+
+/**
+ * \brief Build a stream from script text.
+ */
+int make_stream(
+    eroc_stream** stream, eroc_script** script, const std::string& text,
+    size_t* error_line)
+{
+    int retval =
+        eroc_script_create(script, text.data(), text.size(), error_line);
+    if (0 != retval)
+    {
+        return -1;
+    }
+
+    retval = eroc_stream_create(stream, *script, error_line);
+    if (0 != retval)
+    {
+        eroc_script_release(*script);
+    }
+
+    return retval;
+}
+
+/**
+ * \brief Check whether a script can be streamed, returning the line of the
+ * command that can't, or 0.
+ */
+size_t refused_line(const std::string& text)
+{
+    eroc_stream* stream;
+    eroc_script* script;
+    size_t error_line = 0;
+
+    if (0 == make_stream(&stream, &script, text, &error_line))
+    {
+        eroc_stream_release(stream);
+        eroc_script_release(script);
+        return 0;
+    }
+
+    return error_line;
+}
+
+/**
+ * \brief Read a whole file.
+ */
+std::string slurp(const std::string& path)
+{
+    std::string result;
+    FILE* fp = fopen(path.c_str(), "r");
+    char data[4096];
+    size_t size;
+
+    if (nullptr == fp)
+    {
+        return "<missing>";
+    }
+
+    while (0 < (size = fread(data, 1, sizeof(data), fp)))
+    {
+        result.append(data, size);
+    }
+
+    fclose(fp);
+    return result;
+}
+
+/**
+ * \brief Write a whole file.
+ */
+void spew(const std::string& path, const std::string& text)
+{
+    FILE* fp = fopen(path.c_str(), "w");
+
+    if (nullptr != fp)
+    {
+        fwrite(text.data(), 1, text.size(), fp);
+        fclose(fp);
+    }
+}
+
+/**
+ * \brief Stream a file through a script, in place.
+ */
+int stream_file(
+    const std::string& script_text, const std::string& path,
+    size_t* error_line)
+{
+    eroc_stream* stream;
+    eroc_script* script;
+
+    int retval = make_stream(&stream, &script, script_text, error_line);
+    if (0 != retval)
+    {
+        return retval;
+    }
+
+    int fd = open(path.c_str(), O_RDONLY);
+    retval = eroc_stream_run(stream, fd, path.c_str(), error_line);
+    close(fd);
+
+    eroc_stream_release(stream);
+    eroc_script_release(script);
+
+    return retval;
+}
+
+/**
+ * \brief Run a function with standard output sent to a file, and return what
+ * it printed.
+ */
+template <typename Fn>
+std::string captured(const std::string& path, Fn fn)
+{
+    fflush(stdout);
+    int saved = dup(STDOUT_FILENO);
+    int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    if (saved < 0 || fd < 0)
+    {
+        return "<redirect failed>";
+    }
+
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+
+    fn();
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    std::string result = slurp(path);
+    unlink(path.c_str());
+    return result;
+}
+
+/**
+ * \brief Run a script over a buffer loaded from a file, as eroc -s does.
+ */
+int buffer_file(const std::string& script_text, const std::string& path)
+{
+    eroc_script* script;
+    eroc_buffer* buffer;
+    size_t size, error_line;
+
+    int retval =
+        eroc_script_create(
+            &script, script_text.data(), script_text.size(), &error_line);
+    if (0 != retval)
+    {
+        return -1;
+    }
+
+    retval = eroc_buffer_load_mapped(&buffer, &size, path.c_str());
+    if (0 == retval)
+    {
+        buffer->flags |= EROC_BUFFER_FLAG_QUIET;
+        retval = eroc_script_run(script, buffer, &error_line);
+        eroc_buffer_release(buffer);
+    }
+
+    eroc_script_release(script);
+    return retval;
+}
+
+} /* namespace */
+
+/**
+ * \brief Scripts that need random access are refused at the command that
+ * needs it.
+ */
+TEST(refused)
+{
+    TEST_EXPECT(0 == refused_line("g/a/d\n,s/x/y/g\n1,$p\nw\nq\n"));
+    TEST_EXPECT(0 == refused_line("v/a/s/b/c/\n%d\n"));
+
+    TEST_EXPECT(1 == refused_line("1d\n"));
+    TEST_EXPECT(2 == refused_line(",p\na\ntext\n.\n"));
+    TEST_EXPECT(1 == refused_line("s/a/b/\n"));
+    TEST_EXPECT(1 == refused_line(",s/a/b/p\n"));
+    TEST_EXPECT(1 == refused_line("g/a/1d\n"));
+    TEST_EXPECT(1 == refused_line("g/a/=\n"));
+    TEST_EXPECT(1 == refused_line("q\n,p\n"));
+    TEST_EXPECT(1 == refused_line("u\n"));
+
+    /* two outputs would interleave. */
+    TEST_EXPECT(2 == refused_line(",p\ng/a/p\n"));
+    TEST_EXPECT(2 == refused_line("w a\nw b\n"));
+}
+
+/**
+ * \brief Streaming a file in place gives the same result as running the script
+ * over a buffer, including for a last line without a newline.
+ */
+TEST(in_place)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    size_t error_line = 0;
+
+    spew(path, "apple\nbanana\ncherry\ndate\nfig");
+
+    TEST_ASSERT(
+        0 == stream_file(
+                "g/an/d\n,s/a/A/g\nv/e/s/g/G/\nw\n", path, &error_line));
+    TEST_EXPECT("Apple\ncherry\ndAte\nfiG\n" == slurp(path));
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief A line longer than a chunk grows the chunk.
+ */
+TEST(long_line)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    std::string out = dir + "/output.txt";
+    size_t error_line = 0;
+
+    std::string big(EROC_STREAM_CHUNK_SIZE * 2 + 17, 'x');
+    spew(path, "a\n" + big + "\nb\n");
+
+    TEST_ASSERT(
+        0 == stream_file(",s/xx/y/\nw " + out + "\n", path, &error_line));
+    TEST_EXPECT("a\ny" + big.substr(2) + "\nb\n" == slurp(out));
+
+    unlink(out.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief A failing command reports its line and leaves the target unchanged.
+ */
+TEST(failure)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    size_t error_line = 0;
+
+    spew(path, "one\ntwo\n");
+
+    /* no line changes. */
+    TEST_EXPECT(0 != stream_file("g/o/d\n,s/z/y/\nw\n", path, &error_line));
+    TEST_EXPECT(2 == error_line);
+    TEST_EXPECT("one\ntwo\n" == slurp(path));
+
+    /* no line changes under g. */
+    TEST_EXPECT(0 != stream_file("g/o/s/z/y/\nw\n", path, &error_line));
+    TEST_EXPECT(1 == error_line);
+    TEST_EXPECT("one\ntwo\n" == slurp(path));
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief A w that would have to overwrite the input in place is refused
+ * before the input changes.
+ */
+TEST(write_input_in_place)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    std::string other = dir + "/other.txt";
+    size_t error_line = 0;
+
+    spew(path, "one\ntwo\n");
+    TEST_ASSERT(0 == link(path.c_str(), other.c_str()));
+
+    TEST_EXPECT(0 != stream_file(",s/o/O/g\nw\n", path, &error_line));
+    TEST_EXPECT("one\ntwo\n" == slurp(path));
+
+    /* writing the other link from a different input is fine. */
+    std::string input = dir + "/input2.txt";
+    spew(input, "three\n");
+    TEST_EXPECT(0 == stream_file("w " + other + "\n", input, &error_line));
+    TEST_EXPECT("three\n" == slurp(path));
+
+    unlink(input.c_str());
+    unlink(other.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief As over a buffer, s under g skips the lines it doesn't change, and
+ * with no lines to run on, changing nothing is not an error.
+ */
+TEST(global_substitute)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    size_t error_line = 0;
+
+    spew(path, "foo bar\nfoo\nfoo bar\nbaz\n");
+
+    TEST_ASSERT(0 == stream_file("g/foo/s/bar/BAZ/\nw\n", path, &error_line));
+    TEST_EXPECT("foo BAZ\nfoo\nfoo BAZ\nbaz\n" == slurp(path));
+
+    TEST_ASSERT(0 == stream_file("g/qux/s/z/y/\nw\n", path, &error_line));
+    TEST_EXPECT("foo BAZ\nfoo\nfoo BAZ\nbaz\n" == slurp(path));
+
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief Lines printed after a substitution are held back until it succeeds.
+ */
+TEST(print_after_substitute)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    std::string out = dir + "/stdout.txt";
+    size_t error_line = 0;
+    int saved;
+
+    spew(path, "one\ntwo\n");
+
+    /* send standard output to a file. */
+    fflush(stdout);
+    saved = dup(STDOUT_FILENO);
+    TEST_ASSERT(saved >= 0);
+    int fd = open(out.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0600);
+    TEST_ASSERT(fd >= 0);
+    dup2(fd, STDOUT_FILENO);
+    close(fd);
+
+    int failed = stream_file(",s/z/y/\n,p\n", path, &error_line);
+    int passed = stream_file(",s/o/O/\n,p\n", path, &error_line);
+
+    fflush(stdout);
+    dup2(saved, STDOUT_FILENO);
+    close(saved);
+
+    TEST_EXPECT(0 != failed);
+    TEST_EXPECT(0 == passed);
+    TEST_EXPECT("One\ntwO\n" == slurp(out));
+
+    unlink(out.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
+
+/**
+ * \brief Streaming gives the same output, status, and written file as running
+ * the script over a buffer, including when a command fails after the print or
+ * the write, or runs on an empty buffer.
+ */
+TEST(same_as_buffer)
+{
+    char templ[] = "/tmp/eroc_stream_XXXXXX";
+    TEST_ASSERT(nullptr != mkdtemp(templ));
+    std::string dir = templ;
+    std::string path = dir + "/input.txt";
+    std::string out = dir + "/output.txt";
+    std::string printed = dir + "/stdout.txt";
+    size_t error_line = 0;
+
+    const std::pair<std::string, std::string> cases[] = {
+        {"a1\nb2\n", "%s/[0-9]/&&/\n%p\n,s/a/O/2\n"},
+        {"ax\nbo\n", "1,$p\ng/x/s/o/0/\n"},
+        {"ax\nbo\n", "g/x/s/o/0/\n1,$p\n"},
+        {"one\n", "w " + out + "\n,s/z/y/\n"},
+        {"one\n", ",s/z/y/\nw " + out + "\n"},
+        {"", "g/a/p\n"},
+        {"", "v/a/d\n"},
+        {"", ",p\n"},
+        {"", "w " + out + "\n"},
+        {"one\ntwo\n", ",d\n,p\n"},
+        {"one\ntwo\n", "g/o/d\nw " + out + "\n"},
+    };
+
+    for (const auto& [input, script] : cases)
+    {
+        int buffer_status = 0, stream_status = 0;
+
+        spew(path, input);
+        unlink(out.c_str());
+        std::string buffer_printed =
+            captured(printed, [&] {
+                buffer_status = buffer_file(script, path); });
+        std::string buffer_written = slurp(out);
+
+        spew(path, input);
+        unlink(out.c_str());
+        std::string stream_printed =
+            captured(printed, [&] {
+                stream_status = stream_file(script, path, &error_line); });
+        std::string stream_written = slurp(out);
+
+        TEST_EXPECT(buffer_printed == stream_printed);
+        TEST_EXPECT((0 == buffer_status) == (0 == stream_status));
+        TEST_EXPECT(buffer_written == stream_written);
+    }
+
+    unlink(out.c_str());
+    unlink(path.c_str());
+    rmdir(dir.c_str());
+}
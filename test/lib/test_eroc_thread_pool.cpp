@@ -0,0 +1,73 @@
+/**
+ * \file test/lib/test_eroc_thread_pool.cpp
+ *
+ * \brief Unit tests for the thread pool.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <eroc/threadpool.h>
+#include <minunit/minunit.h>
+#include <vector>
+
+TEST_SUITE(eroc_thread_pool);
+
+namespace {
+
+struct batch
+{
+    std::vector<int> runs;
+    std::vector<size_t> workers;
+};
+
+void count_task(void* context, size_t worker, size_t task)
+{
+    batch* b = (batch*)context;
+
+    b->runs[task] += 1;
+    b->workers[task] = worker;
+}
+
+} /* namespace */
+
+/**
+ * \brief Every task of every batch runs exactly once, on a valid worker.
+ */
+TEST(run_batches)
+{
+    eroc_thread_pool* pool;
+
+    TEST_ASSERT(0 == eroc_thread_pool_create(&pool, 4));
+    TEST_EXPECT(4 == pool->thread_count);
+
+    for (size_t tasks : {1, 3, 1000, 0, 17})
+    {
+        batch b;
+        b.runs.resize(tasks);
+        b.workers.resize(tasks);
+
+        eroc_thread_pool_run(pool, &count_task, &b, tasks);
+
+        for (size_t i = 0; i < tasks; ++i)
+        {
+            TEST_EXPECT(1 == b.runs[i]);
+            TEST_EXPECT(b.workers[i] < pool->thread_count);
+        }
+    }
+
+    eroc_thread_pool_release(pool);
+}
+
+/**
+ * \brief A pool with no worker count has one worker per CPU.
+ */
+TEST(default_workers)
+{
+    eroc_thread_pool* pool;
+
+    TEST_ASSERT(0 == eroc_thread_pool_create(&pool, 0));
+    TEST_EXPECT(eroc_thread_pool_cpu_count() == pool->thread_count);
+
+    eroc_thread_pool_release(pool);
+}
@@ -0,0 +1,113 @@
+/**
+ * \file test/lib/test_eroc_writer.cpp
+ *
+ * \brief Unit tests for the gathering writer.
+ *
+ * \copyright 2025 Justin Handville.  Please see LICENSE.txt in this
+ * distribution for the license terms under which this software is distributed.
+ */
+
+#include <cstdio>
+#include <eroc/writer.h>
+#include <minunit/minunit.h>
+#include <string>
+#include <unistd.h>
+
+TEST_SUITE(eroc_writer);
+
+namespace {
+
+/**
+ * \brief Read back everything written to a temporary file.
+ */
+std::string contents(FILE* fp)
+{
+    std::string result;
+    char data[4096];
+    size_t size;
+
+    rewind(fp);
+    while (0 < (size = fread(data, 1, sizeof(data), fp)))
+    {
+        result.append(data, size);
+    }
+
+    return result;
+}
+
+} /* namespace */
+
+/**
+ * \brief Short spans are staged and long spans are borrowed, and everything is
+ * written in order.
+ */
+TEST(mixed_spans)
+{
+    FILE* fp = tmpfile();
+    eroc_writer* writer;
+    std::string expected;
+
+    TEST_ASSERT(nullptr != fp);
+    TEST_ASSERT(0 == eroc_writer_create(&writer, fileno(fp)));
+
+    std::string big(EROC_WRITER_COPY_LIMIT * 3, 'b');
+    for (int i = 0; i < 1000; ++i)
+    {
+        std::string small = "line " + std::to_string(i) + "\n";
+        const std::string& span = (0 == i % 100) ? big : small;
+
+        TEST_ASSERT(0 == eroc_writer_add(writer, span.data(), span.size()));
+        expected += span;
+    }
+
+    /* adjacent short spans share one gathered span. */
+    TEST_EXPECT(writer->iov_count < 30);
+
+    TEST_ASSERT(0 == eroc_writer_flush(writer));
+    TEST_EXPECT(expected.size() == writer->written);
+    TEST_EXPECT(0 == writer->pending);
+    TEST_EXPECT(expected == contents(fp));
+
+    eroc_writer_release(writer);
+    fclose(fp);
+}
+
+/**
+ * \brief A writer flushes by itself when it runs out of staging space or
+ * spans, and reports a failed write.
+ */
+TEST(flush_and_failure)
+{
+    FILE* fp = tmpfile();
+    eroc_writer* writer;
+    size_t total = 0;
+
+    TEST_ASSERT(nullptr != fp);
+    TEST_ASSERT(0 == eroc_writer_create(&writer, fileno(fp)));
+
+    std::string span(1000, 'x');
+    for (int i = 0; i < 3000; ++i)
+    {
+        TEST_ASSERT(0 == eroc_writer_add(writer, span.data(), span.size()));
+        total += span.size();
+    }
+
+    TEST_EXPECT(writer->written > 0);
+    TEST_ASSERT(0 == eroc_writer_flush(writer));
+    TEST_EXPECT(total == writer->written);
+    TEST_EXPECT(total == contents(fp).size());
+    eroc_writer_release(writer);
+
+    /* a descriptor open only for reading can't be written. */
+    int fds[2];
+    TEST_ASSERT(0 == pipe(fds));
+    TEST_ASSERT(0 == eroc_writer_create(&writer, fds[0]));
+    TEST_ASSERT(0 == eroc_writer_add(writer, "abc", 3));
+    TEST_EXPECT(0 != eroc_writer_flush(writer));
+    TEST_EXPECT(0 == writer->written);
+    eroc_writer_release(writer);
+
+    close(fds[0]);
+    close(fds[1]);
+    fclose(fp);
+}